@@ -0,0 +1,453 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file AssFlatExporter.cpp
+ *  @brief Implementation of the flat binary scene exporter (.assflat)
+ */
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+#ifndef ASSIMP_BUILD_NO_ASSFLAT_EXPORTER
+
+#include "AssetLib/AssFlat/AssFlatExporter.h"
+#include "AssetLib/AssFlat/AssFlatFormat.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/Exporter.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/scene.h>
+
+#include <cstring>
+#include <vector>
+
+namespace Assimp {
+
+using namespace AssFlat;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Collects the structure and the data section of an AssFlat file. The
+ *  record order written here is the order AssFlatImporter reads back. */
+class AssFlatWriter {
+public:
+    // -------------------------------------------------------------------
+    void WriteScene(const aiScene *scene) {
+        Put<uint32_t>(scene->mFlags);
+        PutString(scene->mName);
+        PutMetadata(scene->mMetaData);
+
+        Put<uint32_t>(scene->mNumMeshes);
+        Put<uint32_t>(scene->mNumMaterials);
+        Put<uint32_t>(scene->mNumAnimations);
+        Put<uint32_t>(scene->mNumTextures);
+        Put<uint32_t>(scene->mNumLights);
+        Put<uint32_t>(scene->mNumCameras);
+
+        Put<uint8_t>(nullptr != scene->mRootNode ? 1 : 0);
+        if (nullptr != scene->mRootNode) {
+            WriteNode(scene->mRootNode);
+        }
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            WriteMesh(scene->mMeshes[i]);
+        }
+        for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+            WriteMaterial(scene->mMaterials[i]);
+        }
+        for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+            WriteAnimation(scene->mAnimations[i]);
+        }
+        for (unsigned int i = 0; i < scene->mNumTextures; ++i) {
+            WriteTexture(scene->mTextures[i]);
+        }
+        for (unsigned int i = 0; i < scene->mNumLights; ++i) {
+            WriteLight(scene->mLights[i]);
+        }
+        for (unsigned int i = 0; i < scene->mNumCameras; ++i) {
+            WriteCamera(scene->mCameras[i]);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void Save(const char *pFile, IOSystem *pIOSystem) {
+        FlatHeader header;
+        ::memset(&header, 0, sizeof(header));
+        ::memcpy(header.mMagic, FlatMagic, sizeof(FlatMagic));
+        header.mVersion = FlatVersion;
+        header.mByteOrder = FlatByteOrderMark;
+        header.mRealSize = static_cast<uint8_t>(sizeof(ai_real));
+        header.mStructureOffset = sizeof(FlatHeader);
+        header.mStructureSize = mStructure.size();
+        header.mDataOffset = AlignUp(header.mStructureOffset + header.mStructureSize);
+        header.mDataSize = mData.size();
+        header.mFileSize = header.mDataOffset + header.mDataSize;
+
+        IOStream *out = pIOSystem->Open(pFile, "wb");
+        if (nullptr == out) {
+            throw DeadlyExportError("Could not open output file ", pFile);
+        }
+
+        const uint8_t padding[FlatAlignment] = {};
+        const size_t paddingSize = static_cast<size_t>(header.mDataOffset - header.mStructureOffset - header.mStructureSize);
+        const bool ok = out->Write(&header, sizeof(header), 1) == 1 &&
+                        (mStructure.empty() || out->Write(mStructure.data(), mStructure.size(), 1) == 1) &&
+                        (0 == paddingSize || out->Write(padding, paddingSize, 1) == 1) &&
+                        (mData.empty() || out->Write(mData.data(), mData.size(), 1) == 1);
+        pIOSystem->Close(out);
+        if (!ok) {
+            throw DeadlyExportError("Could not write ", pFile);
+        }
+    }
+
+private:
+    // -------------------------------------------------------------------
+    static uint64_t AlignUp(uint64_t offset) {
+        return (offset + FlatAlignment - 1) & ~(FlatAlignment - 1);
+    }
+
+    // -------------------------------------------------------------------
+    void PutBytes(const void *data, size_t size) {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        mStructure.insert(mStructure.end(), p, p + size);
+    }
+
+    template <typename T>
+    void Put(const T &value) {
+        PutBytes(&value, sizeof(T));
+    }
+
+    void PutString(const aiString &str) {
+        Put<uint32_t>(str.length);
+        PutBytes(str.data, str.length);
+    }
+
+    void PutOptionalString(const aiString *str) {
+        Put<uint8_t>(nullptr != str ? 1 : 0);
+        if (nullptr != str) {
+            PutString(*str);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    /** Appends an array to the data section and writes its offset. */
+    template <typename T>
+    void PutArray(const T *array, size_t count) {
+        if (nullptr == array) {
+            Put<uint64_t>(FlatNoArray);
+            return;
+        }
+        const uint64_t offset = AlignUp(mData.size());
+        mData.resize(static_cast<size_t>(offset), 0);
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(array);
+        mData.insert(mData.end(), p, p + sizeof(T) * count);
+        Put<uint64_t>(offset);
+    }
+
+    // -------------------------------------------------------------------
+    void PutMetadata(const aiMetadata *meta) {
+        if (nullptr == meta) {
+            Put<uint32_t>(FlatNoMetadata);
+            return;
+        }
+        Put<uint32_t>(meta->mNumProperties);
+        for (unsigned int i = 0; i < meta->mNumProperties; ++i) {
+            const aiMetadataEntry &entry = meta->mValues[i];
+            PutString(meta->mKeys[i]);
+            Put<uint16_t>(static_cast<uint16_t>(entry.mType));
+            switch (entry.mType) {
+            case AI_BOOL:
+                Put<uint8_t>(*static_cast<const bool *>(entry.mData) ? 1 : 0);
+                break;
+            case AI_INT32:
+                Put(*static_cast<const int32_t *>(entry.mData));
+                break;
+            case AI_UINT64:
+                Put(*static_cast<const uint64_t *>(entry.mData));
+                break;
+            case AI_FLOAT:
+                Put(*static_cast<const float *>(entry.mData));
+                break;
+            case AI_DOUBLE:
+                Put(*static_cast<const double *>(entry.mData));
+                break;
+            case AI_AISTRING:
+                PutString(*static_cast<const aiString *>(entry.mData));
+                break;
+            case AI_AIVECTOR3D:
+                Put(*static_cast<const aiVector3D *>(entry.mData));
+                break;
+            case AI_AIMETADATA:
+                PutMetadata(static_cast<const aiMetadata *>(entry.mData));
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void WriteNode(const aiNode *node) {
+        PutString(node->mName);
+        Put(node->mTransformation);
+        Put<uint32_t>(node->mNumMeshes);
+        PutBytes(node->mMeshes, sizeof(unsigned int) * node->mNumMeshes);
+        PutMetadata(node->mMetaData);
+        Put<uint32_t>(node->mNumChildren);
+        for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+            WriteNode(node->mChildren[i]);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void PutVertexStreams(const aiVector3D *vertices, const aiVector3D *normals, const aiVector3D *tangents,
+            const aiVector3D *bitangents, const aiColor4D *const *colors, const aiVector3D *const *uvs, unsigned int n) {
+        PutArray(vertices, n);
+        PutArray(normals, n);
+        PutArray(tangents, n);
+        PutArray(bitangents, n);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            PutArray(colors[c], n);
+        }
+        for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+            PutArray(uvs[t], n);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void WriteMesh(const aiMesh *mesh) {
+        PutString(mesh->mName);
+        Put<uint32_t>(mesh->mPrimitiveTypes);
+        Put<uint32_t>(mesh->mNumVertices);
+        Put<uint32_t>(mesh->mNumFaces);
+        Put<uint32_t>(mesh->mMaterialIndex);
+        Put<uint32_t>(mesh->mMethod);
+        Put(mesh->mAABB);
+        for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+            Put<uint32_t>(mesh->mNumUVComponents[t]);
+            PutOptionalString(mesh->GetTextureCoordsName(t));
+        }
+        PutVertexStreams(mesh->mVertices, mesh->mNormals, mesh->mTangents, mesh->mBitangents,
+                mesh->mColors, mesh->mTextureCoords, mesh->mNumVertices);
+
+        // All indices go into one array. Meshes with a single primitive type
+        // need no per-face sizes, which is the common case after triangulation.
+        uint32_t faceSize = mesh->mNumFaces ? mesh->mFaces[0].mNumIndices : 0;
+        size_t numIndices = 0;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            numIndices += mesh->mFaces[f].mNumIndices;
+            if (mesh->mFaces[f].mNumIndices != faceSize) {
+                faceSize = 0;
+            }
+        }
+        Put<uint32_t>(faceSize);
+        Put<uint64_t>(numIndices);
+        if (mesh->HasIndexBuffer()) {
+            // the faces are stored in order already
+            PutArray(mesh->mNumIndices ? mesh->mIndexBuffer : nullptr, mesh->mNumIndices);
+        } else {
+            std::vector<uint32_t> indices;
+            indices.reserve(numIndices);
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                const aiFace &face = mesh->mFaces[f];
+                indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+            }
+            PutArray(indices.empty() ? nullptr : indices.data(), indices.size());
+        }
+        if (0 == faceSize && mesh->mNumFaces) {
+            std::vector<uint32_t> sizes(mesh->mNumFaces);
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                sizes[f] = mesh->mFaces[f].mNumIndices;
+            }
+            PutArray(sizes.data(), sizes.size());
+        } else {
+            Put<uint64_t>(FlatNoArray);
+        }
+
+        Put<uint32_t>(mesh->mNumMeshlets);
+        Put<uint32_t>(mesh->mNumMeshletVertices);
+        PutArray(mesh->mMeshlets, mesh->mNumMeshlets);
+        PutArray(mesh->mMeshletVertices, mesh->mNumMeshletVertices);
+        PutArray(mesh->mMeshletIndices, mesh->mNumFaces * 3);
+
+        Put<uint32_t>(mesh->mNumBones);
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            const aiBone *bone = mesh->mBones[b];
+            PutString(bone->mName);
+            Put(bone->mOffsetMatrix);
+            Put<uint32_t>(bone->mNumWeights);
+            PutArray(bone->mWeights, bone->mNumWeights);
+            PutOptionalString(nullptr != bone->mArmature ? &bone->mArmature->mName : nullptr);
+            PutOptionalString(nullptr != bone->mNode ? &bone->mNode->mName : nullptr);
+        }
+
+        Put<uint32_t>(mesh->mNumAnimMeshes);
+        for (unsigned int a = 0; a < mesh->mNumAnimMeshes; ++a) {
+            const aiAnimMesh *anim = mesh->mAnimMeshes[a];
+            PutString(anim->mName);
+            Put(anim->mWeight);
+            Put<uint32_t>(anim->mNumVertices);
+            PutVertexStreams(anim->mVertices, anim->mNormals, anim->mTangents, anim->mBitangents,
+                    anim->mColors, anim->mTextureCoords, anim->mNumVertices);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void WriteMaterial(const aiMaterial *mat) {
+        Put<uint32_t>(mat->mNumProperties);
+        for (unsigned int i = 0; i < mat->mNumProperties; ++i) {
+            const aiMaterialProperty *prop = mat->mProperties[i];
+            PutString(prop->mKey);
+            Put<uint32_t>(prop->mSemantic);
+            Put<uint32_t>(prop->mIndex);
+            Put<uint32_t>(prop->mType);
+            Put<uint32_t>(prop->mDataLength);
+            PutBytes(prop->mData, prop->mDataLength);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    template <typename Key>
+    void PutKeys(const Key *keys, unsigned int count) {
+        Put<uint32_t>(count);
+        for (unsigned int k = 0; k < count; ++k) {
+            Put(keys[k].mTime);
+            Put(keys[k].mValue);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void WriteAnimation(const aiAnimation *anim) {
+        PutString(anim->mName);
+        Put(anim->mDuration);
+        Put(anim->mTicksPerSecond);
+
+        Put<uint32_t>(anim->mNumChannels);
+        for (unsigned int i = 0; i < anim->mNumChannels; ++i) {
+            const aiNodeAnim *channel = anim->mChannels[i];
+            PutString(channel->mNodeName);
+            Put<uint32_t>(channel->mPreState);
+            Put<uint32_t>(channel->mPostState);
+            PutKeys(channel->mPositionKeys, channel->mNumPositionKeys);
+            PutKeys(channel->mRotationKeys, channel->mNumRotationKeys);
+            PutKeys(channel->mScalingKeys, channel->mNumScalingKeys);
+        }
+
+        Put<uint32_t>(anim->mNumMeshChannels);
+        for (unsigned int i = 0; i < anim->mNumMeshChannels; ++i) {
+            const aiMeshAnim *channel = anim->mMeshChannels[i];
+            PutString(channel->mName);
+            PutKeys(channel->mKeys, channel->mNumKeys);
+        }
+
+        Put<uint32_t>(anim->mNumMorphMeshChannels);
+        for (unsigned int i = 0; i < anim->mNumMorphMeshChannels; ++i) {
+            const aiMeshMorphAnim *channel = anim->mMorphMeshChannels[i];
+            PutString(channel->mName);
+            Put<uint32_t>(channel->mNumKeys);
+            for (unsigned int k = 0; k < channel->mNumKeys; ++k) {
+                const aiMeshMorphKey &key = channel->mKeys[k];
+                Put(key.mTime);
+                Put<uint32_t>(key.mNumValuesAndWeights);
+                PutBytes(key.mValues, sizeof(unsigned int) * key.mNumValuesAndWeights);
+                PutBytes(key.mWeights, sizeof(double) * key.mNumValuesAndWeights);
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void WriteTexture(const aiTexture *tex) {
+        Put<uint32_t>(tex->mWidth);
+        Put<uint32_t>(tex->mHeight);
+        PutBytes(tex->achFormatHint, HINTMAXTEXTURELEN);
+        PutString(tex->mFilename);
+        const size_t size = tex->mHeight ? size_t(tex->mWidth) * tex->mHeight * sizeof(aiTexel) : tex->mWidth;
+        PutBytes(tex->pcData, size);
+    }
+
+    // -------------------------------------------------------------------
+    void WriteLight(const aiLight *light) {
+        PutString(light->mName);
+        Put<uint32_t>(light->mType);
+        Put(light->mPosition);
+        Put(light->mDirection);
+        Put(light->mUp);
+        Put(light->mAttenuationConstant);
+        Put(light->mAttenuationLinear);
+        Put(light->mAttenuationQuadratic);
+        Put(light->mColorDiffuse);
+        Put(light->mColorSpecular);
+        Put(light->mColorAmbient);
+        Put(light->mAngleInnerCone);
+        Put(light->mAngleOuterCone);
+        Put(light->mSize);
+    }
+
+    // -------------------------------------------------------------------
+    void WriteCamera(const aiCamera *cam) {
+        PutString(cam->mName);
+        Put(cam->mPosition);
+        Put(cam->mUp);
+        Put(cam->mLookAt);
+        Put(cam->mHorizontalFOV);
+        Put(cam->mClipPlaneNear);
+        Put(cam->mClipPlaneFar);
+        Put(cam->mAspect);
+        Put(cam->mOrthographicWidth);
+    }
+
+    std::vector<uint8_t> mStructure;
+    std::vector<uint8_t> mData;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void ExportSceneAssFlat(const char *pFile, IOSystem *pIOSystem, const aiScene *pScene, const ExportProperties * /*pProperties*/) {
+    AssFlatWriter writer;
+    writer.WriteScene(pScene);
+    writer.Save(pFile, pIOSystem);
+}
+
+} // namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_ASSFLAT_EXPORTER
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,103 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file AssFlatFormat.h
+ *  @brief Layout of the flat binary scene format (.assflat)
+ *
+ *  An AssFlat file consists of three parts:
+ *
+ *  - FlatHeader, 64 bytes.
+ *  - The structure section: a sequential record of the scene graph, names,
+ *    materials, animations, lights and cameras, in the order the loader
+ *    reads them (see AssFlatExporter.cpp).
+ *  - The data section, aligned to FlatAlignment: the bulk mesh arrays, each
+ *    one aligned to FlatAlignment and referenced from the structure section
+ *    by its offset relative to the start of the data section. Vertex
+ *    streams are stored in their aiMesh layout and the indices of all faces
+ *    of a mesh form one uint32 array, so the loader can point the mesh
+ *    straight into the file contents. Meshlets are stored the same way.
+ *
+ *  All values use the byte order and the ai_real precision of the writer,
+ *  both are recorded in the header and files that differ are rejected.
+ */
+#pragma once
+#ifndef AI_ASSFLATFORMAT_H_INC
+#define AI_ASSFLATFORMAT_H_INC
+
+#include <cstdint>
+
+namespace Assimp {
+namespace AssFlat {
+
+static const char FlatMagic[8] = { 'A', 'S', 'S', 'F', 'L', 'A', 'T', '\0' };
+static const uint32_t FlatVersion = 2;
+static const uint16_t FlatByteOrderMark = 0x0102;
+static const uint64_t FlatAlignment = 16;
+
+/// Offset of arrays that are not present
+static const uint64_t FlatNoArray = ~static_cast<uint64_t>(0);
+
+/// Metadata of a node or the scene that is not present
+static const uint32_t FlatNoMetadata = 0xffffffffu;
+
+#pragma pack(push, 1)
+struct FlatHeader {
+    char mMagic[8];
+    uint32_t mVersion;
+    uint16_t mByteOrder;
+    uint8_t mRealSize; ///< sizeof(ai_real) of the writer
+    uint8_t mReserved0;
+    uint64_t mFileSize;
+    uint64_t mStructureOffset;
+    uint64_t mStructureSize;
+    uint64_t mDataOffset;
+    uint64_t mDataSize;
+    uint8_t mReserved[8];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FlatHeader) == 64, "AssFlat header must be 64 bytes");
+
+} // namespace AssFlat
+} // namespace Assimp
+
+#endif // AI_ASSFLATFORMAT_H_INC
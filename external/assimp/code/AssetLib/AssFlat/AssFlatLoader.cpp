@@ -0,0 +1,623 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file AssFlatLoader.cpp
+ *  @brief Implementation of the flat binary scene importer (.assflat)
+ */
+
+#ifndef ASSIMP_BUILD_NO_ASSFLAT_IMPORTER
+
+#include "AssetLib/AssFlat/AssFlatLoader.h"
+#include "AssetLib/AssFlat/AssFlatFormat.h"
+#include "Common/SceneBuffer.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/IOSystem.hpp>
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/importerdesc.h>
+#include <assimp/scene.h>
+
+#include <cstring>
+#include <memory>
+
+namespace Assimp {
+
+using namespace AssFlat;
+
+namespace {
+
+static const aiImporterDesc desc = {
+    "Assimp Flat Binary Importer",
+    "",
+    "",
+    "",
+    aiImporterFlags_SupportBinaryFlavour,
+    0,
+    0,
+    0,
+    0,
+    "assflat"
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Reads the structure section sequentially and resolves array offsets
+ *  into the data section. Every access is bounds checked. */
+class AssFlatReader {
+public:
+    AssFlatReader(uint8_t *file, size_t fileSize) :
+            mCur(nullptr), mEnd(nullptr), mData(nullptr), mDataSize(0) {
+        if (fileSize < sizeof(FlatHeader)) {
+            throw DeadlyImportError("AssFlat: file is too small");
+        }
+        FlatHeader header;
+        ::memcpy(&header, file, sizeof(header));
+        if (::memcmp(header.mMagic, FlatMagic, sizeof(FlatMagic)) != 0) {
+            throw DeadlyImportError("AssFlat: invalid file signature");
+        }
+        if (header.mVersion != FlatVersion) {
+            throw DeadlyImportError("AssFlat: unsupported format version ", header.mVersion);
+        }
+        if (header.mByteOrder != FlatByteOrderMark || header.mRealSize != sizeof(ai_real)) {
+            throw DeadlyImportError("AssFlat: file was written with a different byte order or ai_real precision");
+        }
+        if (header.mFileSize > fileSize ||
+                header.mStructureOffset > header.mFileSize || header.mStructureSize > header.mFileSize - header.mStructureOffset ||
+                header.mDataOffset > header.mFileSize || header.mDataSize > header.mFileSize - header.mDataOffset ||
+                0 != header.mDataOffset % FlatAlignment) {
+            throw DeadlyImportError("AssFlat: file is truncated or damaged");
+        }
+        mCur = file + header.mStructureOffset;
+        mEnd = mCur + header.mStructureSize;
+        mData = file + header.mDataOffset;
+        mDataSize = static_cast<size_t>(header.mDataSize);
+    }
+
+    // -------------------------------------------------------------------
+    void ReadScene(aiScene *scene) {
+        scene->mFlags = Get<uint32_t>();
+        GetString(scene->mName);
+        scene->mMetaData = GetMetadata();
+
+        const uint32_t numMeshes = Get<uint32_t>();
+        const uint32_t numMaterials = Get<uint32_t>();
+        const uint32_t numAnimations = Get<uint32_t>();
+        const uint32_t numTextures = Get<uint32_t>();
+        const uint32_t numLights = Get<uint32_t>();
+        const uint32_t numCameras = Get<uint32_t>();
+
+        if (Get<uint8_t>()) {
+            scene->mRootNode = ReadNode(nullptr);
+        }
+
+        // counts are raised one element at a time so that a failure leaves a deletable scene
+        if (numMeshes) {
+            scene->mMeshes = new aiMesh *[numMeshes]();
+            for (uint32_t i = 0; i < numMeshes; ++i) {
+                scene->mMeshes[i] = new aiMesh;
+                scene->mNumMeshes = i + 1;
+                ReadMesh(scene, scene->mMeshes[i]);
+            }
+        }
+        if (numMaterials) {
+            scene->mMaterials = new aiMaterial *[numMaterials]();
+            for (uint32_t i = 0; i < numMaterials; ++i) {
+                scene->mMaterials[i] = new aiMaterial;
+                scene->mNumMaterials = i + 1;
+                ReadMaterial(scene->mMaterials[i]);
+            }
+        }
+        if (numAnimations) {
+            scene->mAnimations = new aiAnimation *[numAnimations]();
+            for (uint32_t i = 0; i < numAnimations; ++i) {
+                scene->mAnimations[i] = new aiAnimation;
+                scene->mNumAnimations = i + 1;
+                ReadAnimation(scene->mAnimations[i]);
+            }
+        }
+        if (numTextures) {
+            scene->mTextures = new aiTexture *[numTextures]();
+            for (uint32_t i = 0; i < numTextures; ++i) {
+                scene->mTextures[i] = new aiTexture;
+                scene->mNumTextures = i + 1;
+                ReadTexture(scene->mTextures[i]);
+            }
+        }
+        if (numLights) {
+            scene->mLights = new aiLight *[numLights]();
+            for (uint32_t i = 0; i < numLights; ++i) {
+                scene->mLights[i] = new aiLight;
+                scene->mNumLights = i + 1;
+                ReadLight(scene->mLights[i]);
+            }
+        }
+        if (numCameras) {
+            scene->mCameras = new aiCamera *[numCameras]();
+            for (uint32_t i = 0; i < numCameras; ++i) {
+                scene->mCameras[i] = new aiCamera;
+                scene->mNumCameras = i + 1;
+                ReadCamera(scene->mCameras[i]);
+            }
+        }
+    }
+
+private:
+    // -------------------------------------------------------------------
+    const uint8_t *Take(size_t size) {
+        if (static_cast<size_t>(mEnd - mCur) < size) {
+            throw DeadlyImportError("AssFlat: unexpected end of the structure section");
+        }
+        const uint8_t *p = mCur;
+        mCur += size;
+        return p;
+    }
+
+    void GetBytes(void *out, size_t size) {
+        ::memcpy(out, Take(size), size);
+    }
+
+    template <typename T>
+    T Get() {
+        T value;
+        GetBytes(&value, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    T *GetCopy(size_t count) {
+        const uint8_t *p = Take(sizeof(T) * count);
+        T *out = new T[count];
+        ::memcpy(out, p, sizeof(T) * count);
+        return out;
+    }
+
+    void GetString(aiString &str) {
+        const uint32_t length = Get<uint32_t>();
+        if (length >= MAXLEN) {
+            throw DeadlyImportError("AssFlat: string too long");
+        }
+        GetBytes(str.data, length);
+        str.data[length] = '\0';
+        str.length = length;
+    }
+
+    bool GetOptionalString(aiString &str) {
+        if (0 == Get<uint8_t>()) {
+            return false;
+        }
+        GetString(str);
+        return true;
+    }
+
+    // -------------------------------------------------------------------
+    /** Resolves the next array offset to a pointer into the data section. */
+    template <typename T>
+    T *GetArray(size_t count) {
+        const uint64_t offset = Get<uint64_t>();
+        if (FlatNoArray == offset) {
+            return nullptr;
+        }
+        if (offset > mDataSize || count > (mDataSize - offset) / sizeof(T) || 0 != offset % alignof(T)) {
+            throw DeadlyImportError("AssFlat: array outside of the data section");
+        }
+        return reinterpret_cast<T *>(mData + offset);
+    }
+
+    // -------------------------------------------------------------------
+    aiMetadata *GetMetadata() {
+        const uint32_t count = Get<uint32_t>();
+        if (FlatNoMetadata == count) {
+            return nullptr;
+        }
+        std::unique_ptr<aiMetadata> meta(new aiMetadata);
+        if (0 == count) {
+            return meta.release();
+        }
+        meta->mKeys = new aiString[count];
+        meta->mValues = new aiMetadataEntry[count];
+        meta->mNumProperties = count;
+        for (uint32_t i = 0; i < count; ++i) {
+            aiMetadataEntry &entry = meta->mValues[i];
+            GetString(meta->mKeys[i]);
+            entry.mType = static_cast<aiMetadataType>(Get<uint16_t>());
+            switch (entry.mType) {
+            case AI_BOOL:
+                entry.mData = new bool(Get<uint8_t>() != 0);
+                break;
+            case AI_INT32:
+                entry.mData = new int32_t(Get<int32_t>());
+                break;
+            case AI_UINT64:
+                entry.mData = new uint64_t(Get<uint64_t>());
+                break;
+            case AI_FLOAT:
+                entry.mData = new float(Get<float>());
+                break;
+            case AI_DOUBLE:
+                entry.mData = new double(Get<double>());
+                break;
+            case AI_AISTRING: {
+                aiString *str = new aiString;
+                entry.mData = str;
+                GetString(*str);
+            } break;
+            case AI_AIVECTOR3D:
+                entry.mData = new aiVector3D(Get<aiVector3D>());
+                break;
+            case AI_AIMETADATA: {
+                aiMetadata *nested = GetMetadata();
+                entry.mData = nullptr != nested ? nested : new aiMetadata;
+            } break;
+            default:
+                throw DeadlyImportError("AssFlat: unknown metadata type");
+            }
+        }
+        return meta.release();
+    }
+
+    // -------------------------------------------------------------------
+    aiNode *ReadNode(aiNode *parent) {
+        std::unique_ptr<aiNode> node(new aiNode);
+        node->mParent = parent;
+        GetString(node->mName);
+        node->mTransformation = Get<aiMatrix4x4>();
+        const uint32_t numMeshes = Get<uint32_t>();
+        if (numMeshes) {
+            node->mMeshes = GetCopy<unsigned int>(numMeshes);
+            node->mNumMeshes = numMeshes;
+        }
+        node->mMetaData = GetMetadata();
+        const uint32_t numChildren = Get<uint32_t>();
+        if (numChildren) {
+            node->mChildren = new aiNode *[numChildren]();
+            for (uint32_t i = 0; i < numChildren; ++i) {
+                node->mChildren[i] = ReadNode(node.get());
+                node->mNumChildren = i + 1;
+            }
+        }
+        return node.release();
+    }
+
+    // -------------------------------------------------------------------
+    void GetVertexStreams(aiVector3D *&vertices, aiVector3D *&normals, aiVector3D *&tangents,
+            aiVector3D *&bitangents, aiColor4D **colors, aiVector3D **uvs, unsigned int n) {
+        vertices = GetArray<aiVector3D>(n);
+        normals = GetArray<aiVector3D>(n);
+        tangents = GetArray<aiVector3D>(n);
+        bitangents = GetArray<aiVector3D>(n);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            colors[c] = GetArray<aiColor4D>(n);
+        }
+        for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+            uvs[t] = GetArray<aiVector3D>(n);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void ReadMesh(aiScene *scene, aiMesh *mesh) {
+        GetString(mesh->mName);
+        mesh->mPrimitiveTypes = Get<uint32_t>();
+        mesh->mNumVertices = Get<uint32_t>();
+        const uint32_t numFaces = Get<uint32_t>();
+        mesh->mMaterialIndex = Get<uint32_t>();
+        mesh->mMethod = Get<uint32_t>();
+        mesh->mAABB = Get<aiAABB>();
+        for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+            mesh->mNumUVComponents[t] = Get<uint32_t>();
+            aiString name;
+            if (GetOptionalString(name)) {
+                mesh->SetTextureCoordsName(t, name);
+            }
+        }
+        GetVertexStreams(mesh->mVertices, mesh->mNormals, mesh->mTangents, mesh->mBitangents,
+                mesh->mColors, mesh->mTextureCoords, mesh->mNumVertices);
+
+        // the index array becomes the index buffer of the mesh, the ScenePreprocessor sets up the faces
+        const uint32_t faceSize = Get<uint32_t>();
+        const uint64_t numIndices = Get<uint64_t>();
+        unsigned int *indices = GetArray<unsigned int>(static_cast<size_t>(numIndices));
+        const uint32_t *sizes = GetArray<uint32_t>(numFaces);
+        if (numFaces) {
+            if (nullptr == indices || (0 == faceSize && nullptr == sizes)) {
+                throw DeadlyImportError("AssFlat: mesh faces without indices");
+            }
+            uint64_t next = static_cast<uint64_t>(numFaces) * faceSize;
+            if (0 == faceSize) {
+                mesh->mFaceOffsets = new unsigned int[numFaces + 1];
+                for (uint32_t f = 0; f < numFaces; ++f) {
+                    mesh->mFaceOffsets[f] = static_cast<unsigned int>(next);
+                    next += sizes[f];
+                    if (next > numIndices) {
+                        break;
+                    }
+                }
+                mesh->mFaceOffsets[numFaces] = static_cast<unsigned int>(next);
+            }
+            if (next > numIndices) {
+                throw DeadlyImportError("AssFlat: face indices exceed the index array");
+            }
+            mesh->mNumFaces = numFaces;
+            mesh->mIndexBuffer = indices;
+            mesh->mNumIndices = static_cast<unsigned int>(next);
+            mesh->mFaceStride = faceSize;
+        }
+
+        const uint32_t numMeshlets = Get<uint32_t>();
+        const uint32_t numMeshletVertices = Get<uint32_t>();
+        aiMeshlet *meshlets = GetArray<aiMeshlet>(numMeshlets);
+        unsigned int *meshletVertices = GetArray<unsigned int>(numMeshletVertices);
+        unsigned char *meshletIndices = GetArray<unsigned char>(static_cast<size_t>(mesh->mNumFaces) * 3);
+        if (numMeshlets) {
+            if (nullptr == meshlets || nullptr == meshletVertices || nullptr == meshletIndices) {
+                throw DeadlyImportError("AssFlat: meshlets without vertices or indices");
+            }
+            mesh->mMeshlets = meshlets;
+            mesh->mNumMeshlets = numMeshlets;
+            mesh->mMeshletVertices = meshletVertices;
+            mesh->mNumMeshletVertices = numMeshletVertices;
+            mesh->mMeshletIndices = meshletIndices;
+        }
+
+        const uint32_t numBones = Get<uint32_t>();
+        if (numBones) {
+            mesh->mBones = new aiBone *[numBones]();
+            for (uint32_t b = 0; b < numBones; ++b) {
+                aiBone *bone = new aiBone;
+                mesh->mBones[b] = bone;
+                mesh->mNumBones = b + 1;
+                GetString(bone->mName);
+                bone->mOffsetMatrix = Get<aiMatrix4x4>();
+                bone->mNumWeights = Get<uint32_t>();
+                bone->mWeights = GetArray<aiVertexWeight>(bone->mNumWeights);
+                aiString name;
+                if (GetOptionalString(name) && nullptr != scene->mRootNode) {
+                    bone->mArmature = scene->mRootNode->FindNode(name);
+                }
+                if (GetOptionalString(name) && nullptr != scene->mRootNode) {
+                    bone->mNode = scene->mRootNode->FindNode(name);
+                }
+            }
+        }
+
+        const uint32_t numAnimMeshes = Get<uint32_t>();
+        if (numAnimMeshes) {
+            mesh->mAnimMeshes = new aiAnimMesh *[numAnimMeshes]();
+            for (uint32_t a = 0; a < numAnimMeshes; ++a) {
+                aiAnimMesh *anim = new aiAnimMesh;
+                mesh->mAnimMeshes[a] = anim;
+                mesh->mNumAnimMeshes = a + 1;
+                GetString(anim->mName);
+                anim->mWeight = Get<float>();
+                anim->mNumVertices = Get<uint32_t>();
+                GetVertexStreams(anim->mVertices, anim->mNormals, anim->mTangents, anim->mBitangents,
+                        anim->mColors, anim->mTextureCoords, anim->mNumVertices);
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void ReadMaterial(aiMaterial *mat) {
+        const uint32_t numProperties = Get<uint32_t>();
+        for (uint32_t i = 0; i < numProperties; ++i) {
+            aiString key;
+            GetString(key);
+            const uint32_t semantic = Get<uint32_t>();
+            const uint32_t index = Get<uint32_t>();
+            const uint32_t type = Get<uint32_t>();
+            const uint32_t length = Get<uint32_t>();
+            mat->AddBinaryProperty(Take(length), length, key.C_Str(), semantic, index, static_cast<aiPropertyTypeInfo>(type));
+        }
+    }
+
+    // -------------------------------------------------------------------
+    template <typename Key>
+    void GetKeys(Key *&keys, unsigned int &count) {
+        const uint32_t n = Get<uint32_t>();
+        if (0 == n) {
+            return;
+        }
+        keys = new Key[n];
+        count = n;
+        for (uint32_t k = 0; k < n; ++k) {
+            keys[k].mTime = Get<double>();
+            GetBytes(&keys[k].mValue, sizeof(keys[k].mValue));
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void ReadAnimation(aiAnimation *anim) {
+        GetString(anim->mName);
+        anim->mDuration = Get<double>();
+        anim->mTicksPerSecond = Get<double>();
+
+        const uint32_t numChannels = Get<uint32_t>();
+        if (numChannels) {
+            anim->mChannels = new aiNodeAnim *[numChannels]();
+            for (uint32_t i = 0; i < numChannels; ++i) {
+                aiNodeAnim *channel = new aiNodeAnim;
+                anim->mChannels[i] = channel;
+                anim->mNumChannels = i + 1;
+                GetString(channel->mNodeName);
+                channel->mPreState = static_cast<aiAnimBehaviour>(Get<uint32_t>());
+                channel->mPostState = static_cast<aiAnimBehaviour>(Get<uint32_t>());
+                GetKeys(channel->mPositionKeys, channel->mNumPositionKeys);
+                GetKeys(channel->mRotationKeys, channel->mNumRotationKeys);
+                GetKeys(channel->mScalingKeys, channel->mNumScalingKeys);
+            }
+        }
+
+        const uint32_t numMeshChannels = Get<uint32_t>();
+        if (numMeshChannels) {
+            anim->mMeshChannels = new aiMeshAnim *[numMeshChannels]();
+            for (uint32_t i = 0; i < numMeshChannels; ++i) {
+                aiMeshAnim *channel = new aiMeshAnim;
+                anim->mMeshChannels[i] = channel;
+                anim->mNumMeshChannels = i + 1;
+                GetString(channel->mName);
+                GetKeys(channel->mKeys, channel->mNumKeys);
+            }
+        }
+
+        const uint32_t numMorphChannels = Get<uint32_t>();
+        if (numMorphChannels) {
+            anim->mMorphMeshChannels = new aiMeshMorphAnim *[numMorphChannels]();
+            for (uint32_t i = 0; i < numMorphChannels; ++i) {
+                aiMeshMorphAnim *channel = new aiMeshMorphAnim;
+                anim->mMorphMeshChannels[i] = channel;
+                anim->mNumMorphMeshChannels = i + 1;
+                GetString(channel->mName);
+                const uint32_t numKeys = Get<uint32_t>();
+                if (0 == numKeys) {
+                    continue;
+                }
+                channel->mKeys = new aiMeshMorphKey[numKeys];
+                channel->mNumKeys = numKeys;
+                for (uint32_t k = 0; k < numKeys; ++k) {
+                    aiMeshMorphKey &key = channel->mKeys[k];
+                    key.mTime = Get<double>();
+                    const uint32_t n = Get<uint32_t>();
+                    if (n) {
+                        // the key only frees its arrays if both are set
+                        std::unique_ptr<unsigned int[]> values(GetCopy<unsigned int>(n));
+                        key.mWeights = GetCopy<double>(n);
+                        key.mValues = values.release();
+                        key.mNumValuesAndWeights = n;
+                    }
+                }
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------
+    void ReadTexture(aiTexture *tex) {
+        tex->mWidth = Get<uint32_t>();
+        tex->mHeight = Get<uint32_t>();
+        GetBytes(tex->achFormatHint, HINTMAXTEXTURELEN);
+        tex->achFormatHint[HINTMAXTEXTURELEN - 1] = '\0';
+        GetString(tex->mFilename);
+
+        // compressed textures store mWidth bytes, the texel array is rounded up to hold them
+        const size_t size = tex->mHeight ? size_t(tex->mWidth) * tex->mHeight * sizeof(aiTexel) : tex->mWidth;
+        const uint8_t *data = Take(size);
+        tex->pcData = new aiTexel[(size + sizeof(aiTexel) - 1) / sizeof(aiTexel)];
+        ::memcpy(tex->pcData, data, size);
+    }
+
+    // -------------------------------------------------------------------
+    void ReadLight(aiLight *light) {
+        GetString(light->mName);
+        light->mType = static_cast<aiLightSourceType>(Get<uint32_t>());
+        light->mPosition = Get<aiVector3D>();
+        light->mDirection = Get<aiVector3D>();
+        light->mUp = Get<aiVector3D>();
+        light->mAttenuationConstant = Get<float>();
+        light->mAttenuationLinear = Get<float>();
+        light->mAttenuationQuadratic = Get<float>();
+        light->mColorDiffuse = Get<aiColor3D>();
+        light->mColorSpecular = Get<aiColor3D>();
+        light->mColorAmbient = Get<aiColor3D>();
+        light->mAngleInnerCone = Get<float>();
+        light->mAngleOuterCone = Get<float>();
+        light->mSize = Get<aiVector2D>();
+    }
+
+    // -------------------------------------------------------------------
+    void ReadCamera(aiCamera *cam) {
+        GetString(cam->mName);
+        cam->mPosition = Get<aiVector3D>();
+        cam->mUp = Get<aiVector3D>();
+        cam->mLookAt = Get<aiVector3D>();
+        cam->mHorizontalFOV = Get<float>();
+        cam->mClipPlaneNear = Get<float>();
+        cam->mClipPlaneFar = Get<float>();
+        cam->mAspect = Get<float>();
+        cam->mOrthographicWidth = Get<float>();
+    }
+
+    const uint8_t *mCur;
+    const uint8_t *mEnd;
+    uint8_t *mData;
+    size_t mDataSize;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+const aiImporterDesc *AssFlatImporter::GetInfo() const {
+    return &desc;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool AssFlatImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool /*checkSig*/) const {
+    return CheckMagicToken(pIOHandler, pFile, FlatMagic, 1, 0, sizeof(FlatMagic));
+}
+
+// ------------------------------------------------------------------------------------------------
+void AssFlatImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
+    IOStream *stream = pIOHandler->Open(pFile, "rb");
+    if (nullptr == stream) {
+        throw DeadlyImportError("AssFlat: could not open ", pFile);
+    }
+
+    // Use a memory mapping in place, read anything else with a single call.
+    // Attach the buffer before any array points into it, a failing import
+    // deletes the partially filled scene.
+    std::shared_ptr<SceneBuffer> buffer;
+    if (MemoryMappedIOStream *mapped = dynamic_cast<MemoryMappedIOStream *>(stream)) {
+        buffer = std::make_shared<MappedSceneBuffer>(mapped);
+    } else {
+        const size_t size = stream->FileSize();
+        buffer = std::make_shared<HeapSceneBuffer>(size);
+        const size_t read = size ? stream->Read(buffer->GetData(), size, 1) : 1;
+        pIOHandler->Close(stream);
+        if (1 != read) {
+            throw DeadlyImportError("AssFlat: could not read ", pFile);
+        }
+    }
+    AttachSceneBuffer(pScene, buffer);
+
+    AssFlatReader reader(buffer->GetData(), buffer->GetSize());
+    reader.ReadScene(pScene);
+}
+
+} // namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_ASSFLAT_IMPORTER
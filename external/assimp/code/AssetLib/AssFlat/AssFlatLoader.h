@@ -0,0 +1,78 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file AssFlatLoader.h
+ *  @brief Declaration of the flat binary scene importer (.assflat)
+ */
+#pragma once
+#ifndef AI_ASSFLATLOADER_H_INC
+#define AI_ASSFLATLOADER_H_INC
+
+#include <assimp/BaseImporter.h>
+
+#ifndef ASSIMP_BUILD_NO_ASSFLAT_IMPORTER
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Importer for AssFlat files, see AssFlatFormat.h.
+ *
+ *  The file is read in one piece, or used in place if the IOSystem memory
+ *  maps it (MemoryMappedIOSystem). Vertex streams, face indices, bone
+ *  weights and anim mesh streams of the resulting scene point into that
+ *  block instead of being copied; the scene owns it through a SceneBuffer.
+ *  Post-processing gives the scene its own copies first, so importing with
+ *  no post-processing flags keeps the zero-copy layout.
+ */
+class AssFlatImporter : public BaseImporter {
+public:
+    bool CanRead(const std::string &pFile, IOSystem *pIOHandler, bool checkSig) const override;
+
+protected:
+    const aiImporterDesc *GetInfo() const override;
+    void InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) override;
+};
+
+} // namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_ASSFLAT_IMPORTER
+#endif // AI_ASSFLATLOADER_H_INC
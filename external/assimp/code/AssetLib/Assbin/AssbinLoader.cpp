@@ -56,6 +56,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
 #include <memory>
+#include <vector>
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #include <zlib.h>
@@ -700,16 +701,24 @@ void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, I
         uLongf uncompressedSize = Read<uint32_t>(stream);
         uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
 
-        unsigned char *compressedData = new unsigned char[compressedSize];
-        size_t len = stream->Read(compressedData, 1, compressedSize);
-        ai_assert(len == compressedSize);
+        // inflate straight from the file contents if the stream holds them in memory
+        std::vector<unsigned char> compressedCopy;
+        const unsigned char *compressedData = stream->GetContents();
+        size_t len = compressedSize;
+        if (nullptr != compressedData) {
+            compressedData += stream->Tell();
+        } else {
+            compressedCopy.resize(compressedSize);
+            len = stream->Read(compressedCopy.data(), 1, compressedSize);
+            ai_assert(len == compressedSize);
+            compressedData = compressedCopy.data();
+        }
 
         unsigned char *uncompressedData = new unsigned char[uncompressedSize];
 
         int res = uncompress(uncompressedData, &uncompressedSize, compressedData, (uLong)len);
         if (res != Z_OK) {
             delete[] uncompressedData;
-            delete[] compressedData;
             pIOHandler->Close(stream);
             throw DeadlyImportError("Zlib decompression failed.");
         }
@@ -719,7 +728,6 @@ void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, I
         ReadBinaryScene(&io, pScene);
 
         delete[] uncompressedData;
-        delete[] compressedData;
     } else {
         ReadBinaryScene(stream, pScene);
     }
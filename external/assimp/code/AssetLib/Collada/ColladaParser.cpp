@@ -1438,19 +1438,13 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
                 SkipSpacesAndLineEnd(&content);
             }
         } else {
-            data.mValues.reserve(count);
+            data.mValues.resize(count);
 
-            for (unsigned int a = 0; a < count; a++) {
-                if (*content == 0) {
-                    throw DeadlyImportError("Expected more values while reading float_array contents.");
-                }
-
-                // read a number
-                ai_real value;
-                content = fast_atoreal_move<ai_real>(content, value);
-                data.mValues.push_back(value);
-                // skip whitespace after it
-                SkipSpacesAndLineEnd(&content);
+            // read all numbers at once
+            size_t numValues = 0;
+            fast_atoreal_array<ai_real>(content, content + v.size(), data.mValues.data(), count, numValues);
+            if (numValues != count) {
+                throw DeadlyImportError("Expected more values while reading float_array contents.");
             }
         }
     }
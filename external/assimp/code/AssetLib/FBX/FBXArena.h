@@ -0,0 +1,137 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  FBXArena.h
+ *  @brief Bump allocator for the FBX parse tree
+ */
+#ifndef INCLUDED_AI_FBX_ARENA_H
+#define INCLUDED_AI_FBX_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Assimp {
+namespace FBX {
+
+/** Hands out memory from large blocks and releases all of it at once when
+ *  it is destroyed. Large files produce millions of elements, allocating
+ *  them one by one dominated both parsing and teardown.
+ *
+ *  Objects that are not trivially destructible get their destructor called
+ *  on destruction of the arena, in reverse order of creation. */
+class Arena
+{
+public:
+    explicit Arena(size_t block_size = 1024 * 1024)
+    : block_size(block_size)
+    , cursor()
+    , remaining()
+    {}
+
+    ~Arena() {
+        for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) {
+            it->second(it->first);
+        }
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator= (const Arena&) = delete;
+
+    void* Allocate(size_t size, size_t align) {
+        size_t padding = (align - reinterpret_cast<uintptr_t>(cursor) % align) % align;
+        if (padding + size > remaining) {
+            // oversized requests get a block of their own, the current one stays in use
+            const size_t capacity = std::max(block_size, size + align);
+            blocks.emplace_back(new char[capacity]);
+            if (size + align > block_size) {
+                char* const block = blocks.back().get();
+                return block + (align - reinterpret_cast<uintptr_t>(block) % align) % align;
+            }
+            cursor = blocks.back().get();
+            remaining = capacity;
+            padding = (align - reinterpret_cast<uintptr_t>(cursor) % align) % align;
+        }
+        char* const result = cursor + padding;
+        cursor = result + size;
+        remaining -= padding + size;
+        return result;
+    }
+
+    template <typename T, typename... Args>
+    T* New(Args&&... args) {
+        T* const obj = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value) {
+            destructors.emplace_back(obj, [](void* p) { static_cast<T*>(p)->~T(); });
+        }
+        return obj;
+    }
+
+    /** copy of a range of trivially copyable values */
+    template <typename T>
+    const T* NewArray(const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "NewArray only copies plain values");
+        if (count == 0) {
+            return nullptr;
+        }
+        T* const out = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        std::copy(data, data + count, out);
+        return out;
+    }
+
+private:
+    const size_t block_size;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* cursor;
+    size_t remaining;
+    std::vector<std::pair<void*, void(*)(void*)>> destructors;
+};
+
+} // ! FBX
+} // ! Assimp
+
+#endif // ! INCLUDED_AI_FBX_ARENA_H
@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXParser.h"
 #include "FBXTokenizer.h"
 #include "FBXUtil.h"
+#include "Common/Importer.h"
 
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/StreamReader.h>
@@ -90,7 +91,8 @@ static const aiImporterDesc desc = {
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by #Importer
-FBXImporter::FBXImporter() {
+FBXImporter::FBXImporter() :
+		scheduler(nullptr) {
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -129,6 +131,7 @@ void FBXImporter::SetupProperties(const Importer *pImp) {
 	settings.useLegacyEmbeddedTextureNaming = pImp->GetPropertyBool(AI_CONFIG_IMPORT_FBX_EMBEDDED_TEXTURES_LEGACY_NAMING, false);
 	settings.removeEmptyBones = pImp->GetPropertyBool(AI_CONFIG_IMPORT_REMOVE_EMPTY_BONES, true);
 	settings.convertToMeters = pImp->GetPropertyBool(AI_CONFIG_FBX_CONVERT_TO_M, false);
+	scheduler = pImp->Pimpl()->mTaskScheduler;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -149,52 +152,52 @@ void FBXImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 	// then becomes very large, too. Assimp doesn't support
 	// streaming for its output data structures so the net win with
 	// streaming input data would be very low.
+	// Binary files are tokenized in place if the stream already holds
+	// them in memory (MemoryMappedIOSystem, ReadFileFromMemory), the
+	// ASCII tokenizer needs a zero-terminated copy.
 	std::vector<char> contents;
-	contents.resize(stream->FileSize() + 1);
-	stream->Read(&*contents.begin(), 1, contents.size() - 1);
-	contents[contents.size() - 1] = 0;
-	const char *const begin = &*contents.begin();
+	const char *begin = reinterpret_cast<const char *>(stream->GetContents());
+	size_t length = stream->FileSize();
+	if (begin == nullptr || length < 18 || strncmp(begin, "Kaydara FBX Binary", 18)) {
+		contents.resize(length + 1);
+		stream->Read(&*contents.begin(), 1, length);
+		contents[length] = 0;
+		begin = &*contents.begin();
+		length = contents.size();
+	}
 
 	// broadphase tokenizing pass in which we identify the core
 	// syntax elements of FBX (brackets, commas, key:value mappings)
-	TokenList tokens;
-	try {
-
-		bool is_binary = false;
-		if (!strncmp(begin, "Kaydara FBX Binary", 18)) {
-			is_binary = true;
-			TokenizeBinary(tokens, begin, contents.size());
-		} else {
-			Tokenize(tokens, begin);
-		}
-
-		// use this information to construct a very rudimentary
-		// parse-tree representing the FBX scope structure
-		Parser parser(tokens, is_binary);
-
-		// take the raw parse-tree and convert it to a FBX DOM
-		Document doc(parser, settings);
-
-		// convert the FBX DOM to aiScene
-		ConvertToAssimpScene(pScene, doc, settings.removeEmptyBones);
-
-		// size relative to cm
-		float size_relative_to_cm = doc.GlobalSettings().UnitScaleFactor();
-        if (size_relative_to_cm == 0.0)
-        {
-			// BaseImporter later asserts that fileScale is non-zero.
-			ThrowException("The UnitScaleFactor must be non-zero");
-        }
-
-		// Set FBX file scale is relative to CM must be converted to M for
-		// assimp universal format (M)
-		SetFileScale(size_relative_to_cm * 0.01f);
-
-		std::for_each(tokens.begin(), tokens.end(), Util::delete_fun<Token>());
-	} catch (std::exception &) {
-		std::for_each(tokens.begin(), tokens.end(), Util::delete_fun<Token>());
-		throw;
+	TokenVector tokens;
+	bool is_binary = false;
+	if (!strncmp(begin, "Kaydara FBX Binary", 18)) {
+		is_binary = true;
+		TokenizeBinary(tokens, begin, length);
+	} else {
+		Tokenize(tokens, begin);
 	}
+
+	// use this information to construct a very rudimentary
+	// parse-tree representing the FBX scope structure, compressed
+	// arrays are inflated in parallel on the way
+	Parser parser(tokens, is_binary, scheduler);
+
+	// take the raw parse-tree and convert it to a FBX DOM
+	Document doc(parser, settings);
+
+	// convert the FBX DOM to aiScene
+	ConvertToAssimpScene(pScene, doc, settings.removeEmptyBones);
+
+	// size relative to cm
+	float size_relative_to_cm = doc.GlobalSettings().UnitScaleFactor();
+	if (size_relative_to_cm == 0.0) {
+		// BaseImporter later asserts that fileScale is non-zero.
+		ThrowException("The UnitScaleFactor must be non-zero");
+	}
+
+	// Set FBX file scale is relative to CM must be converted to M for
+	// assimp universal format (M)
+	SetFileScale(size_relative_to_cm * 0.01f);
 }
 
 #endif // !ASSIMP_BUILD_NO_FBX_IMPORTER
@@ -52,6 +52,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp {
 
+class TaskScheduler;
+
 // TinyFormatter.h
 namespace Formatter {
 
@@ -91,6 +93,7 @@ protected:
 
 private:
     FBX::ImportSettings settings;
+    TaskScheduler *scheduler; // owned by the Importer, nullptr if threading is disabled
 }; // !class FBXImporter
 
 } // end of namespace Assimp
@@ -55,12 +55,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXTokenizer.h"
 #include "FBXParser.h"
 #include "FBXUtil.h"
+#include "Common/TaskScheduler.h"
 
 #include <assimp/ParsingUtils.h>
 #include <assimp/fast_atof.h>
 #include <assimp/ByteSwapper.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace Assimp;
@@ -115,7 +117,8 @@ namespace Assimp {
 namespace FBX {
 
 // ------------------------------------------------------------------------------------------------
-Element::Element(const Token& key_token, Parser& parser) : key_token(key_token) {
+Element::Element(const Token& key_token, Parser& parser) : parser(parser), key_token(key_token), compound() {
+    parser.element_tokens.clear();
     TokenPtr n = nullptr;
     do {
         n = parser.AdvanceToNextToken();
@@ -124,7 +127,7 @@ Element::Element(const Token& key_token, Parser& parser) : key_token(key_token)
         }
 
         if (n->Type() == TokenType_DATA) {
-            tokens.push_back(n);
+            parser.element_tokens.push_back(n);
 			TokenPtr prev = n;
             n = parser.AdvanceToNextToken();
             if(!n) {
@@ -135,7 +138,7 @@ Element::Element(const Token& key_token, Parser& parser) : key_token(key_token)
 
 			// some exporters are missing a comma on the next line
 			if (ty == TokenType_DATA && prev->Type() == TokenType_DATA && (n->Line() == prev->Line() + 1)) {
-				tokens.push_back(n);
+				parser.element_tokens.push_back(n);
 				continue;
 			}
 
@@ -145,7 +148,9 @@ Element::Element(const Token& key_token, Parser& parser) : key_token(key_token)
         }
 
         if (n->Type() == TokenType_OPEN_BRACKET) {
-            compound.reset(new Scope(parser));
+            // store the tokens first, the nested elements reuse the buffer
+            tokens = parser.StoreElementTokens();
+            compound = parser.arena.New<Scope>(parser);
 
             // current token should be a TOK_CLOSE_BRACKET
             n = parser.CurrentToken();
@@ -160,12 +165,8 @@ Element::Element(const Token& key_token, Parser& parser) : key_token(key_token)
         }
     }
     while(n->Type() != TokenType_KEY && n->Type() != TokenType_CLOSE_BRACKET);
-}
 
-// ------------------------------------------------------------------------------------------------
-Element::~Element()
-{
-     // no need to delete tokens, they are owned by the parser
+    tokens = parser.StoreElementTokens();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -194,7 +195,7 @@ Scope::Scope(Parser& parser,bool topLevel)
             ParseError("unexpected content: empty string.");
         }
         
-        elements.insert(ElementMap::value_type(str,new_Element(*n,parser)));
+        elements.insert(ElementMap::value_type(str,parser.arena.New<Element>(*n,parser)));
 
         // Element() should stop at the next Key token (or right after a Close token)
         n = parser.CurrentToken();
@@ -209,21 +210,24 @@ Scope::Scope(Parser& parser,bool topLevel)
 
 // ------------------------------------------------------------------------------------------------
 Scope::~Scope() {
-    for(ElementMap::value_type& v : elements) {
-        delete v.second;
-    }
+    // elements are owned by the arena of the parser
 }
 
 // ------------------------------------------------------------------------------------------------
-Parser::Parser (const TokenList& tokens, bool is_binary)
+Parser::Parser (const TokenVector& tokens, bool is_binary, TaskScheduler* scheduler)
 : tokens(tokens)
 , last()
 , current()
 , cursor(tokens.begin())
+, root()
 , is_binary(is_binary)
 {
+    if (is_binary) {
+        InflateArrays(scheduler);
+    }
+
     ASSIMP_LOG_DEBUG("Parsing FBX tokens");
-    root.reset(new Scope(*this,true));
+    root = arena.New<Scope>(*this,true);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -232,6 +236,94 @@ Parser::~Parser()
     // empty
 }
 
+// ------------------------------------------------------------------------------------------------
+void Parser::InflateArrays(TaskScheduler* scheduler)
+{
+    // array tokens start with a lower case type code, the element count, the
+    // encoding and the compressed length. The tokenizer checked the sizes.
+    for (const Token& token : tokens) {
+        if (token.Type() != TokenType_DATA || static_cast<size_t>(token.end() - token.begin()) < 13) {
+            continue;
+        }
+
+        const char type = *token.begin();
+        if (type != 'f' && type != 'd' && type != 'i' && type != 'l') {
+            continue;
+        }
+
+        BE_NCONST uint32_t encmode = SafeParse<uint32_t>(token.begin() + 5, token.end());
+        AI_SWAP4(encmode);
+        if (encmode == 1) {
+            inflated_arrays.push_back(InflatedArray{ &token, std::vector<char>(), false });
+        }
+    }
+
+    if (inflated_arrays.empty()) {
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("Inflating ", inflated_arrays.size(), " FBX data arrays");
+
+    // largest arrays first, so they do not end up last on a single thread
+    std::vector<unsigned int> order(inflated_arrays.size());
+    for (unsigned int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+        const TokenPtr ta = inflated_arrays[a].token, tb = inflated_arrays[b].token;
+        return ta->end() - ta->begin() > tb->end() - tb->begin();
+    });
+
+    const auto inflate = [this, &order](unsigned int i) {
+        InflatedArray& array = inflated_arrays[order[i]];
+        const char* data = array.token->begin();
+        const char* end = array.token->end();
+
+        BE_NCONST uint32_t count = SafeParse<uint32_t>(data + 1, end);
+        AI_SWAP4(count);
+        BE_NCONST uint32_t comp_len = SafeParse<uint32_t>(data + 9, end);
+        AI_SWAP4(comp_len);
+        data += 13;
+
+        const uint32_t stride = (*array.token->begin() == 'd' || *array.token->begin() == 'l') ? 8 : 4;
+        array.data.resize(static_cast<size_t>(stride) * count);
+
+        // errors are reported when the array is actually read, as if there was no pre-pass
+        try {
+            Compression compress;
+            if (compress.open(Compression::Format::Binary, Compression::FlushMode::Finish, 0)) {
+                compress.decompress(data, comp_len, array.data);
+                compress.close();
+                array.valid = true;
+            }
+        } catch (const DeadlyImportError&) {
+            array.data = std::vector<char>();
+        }
+    };
+
+    if (scheduler) {
+        scheduler->ParallelFor(static_cast<unsigned int>(order.size()), inflate);
+    } else {
+        for (unsigned int i = 0; i < order.size(); ++i) {
+            inflate(i);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Parser::TakeInflatedArray(const Token& token, std::vector<char>& out) const
+{
+    const auto it = std::lower_bound(inflated_arrays.begin(), inflated_arrays.end(), &token,
+        [](const InflatedArray& array, TokenPtr t) { return std::less<TokenPtr>()(array.token, t); });
+    if (it == inflated_arrays.end() || it->token != &token || !it->valid) {
+        return false;
+    }
+    out = std::move(it->data);
+    it->data = std::vector<char>();
+    it->valid = false;
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 TokenPtr Parser::AdvanceToNextToken()
 {
@@ -239,7 +331,7 @@ TokenPtr Parser::AdvanceToNextToken()
     if (cursor == tokens.end()) {
         current = nullptr;
     } else {
-        current = *cursor++;
+        current = &*cursor++;
     }
     return current;
 }
@@ -256,6 +348,12 @@ TokenPtr Parser::LastToken() const
     return last;
 }
 
+// ------------------------------------------------------------------------------------------------
+TokenList Parser::StoreElementTokens()
+{
+    return TokenList(arena.NewArray(element_tokens.data(), element_tokens.size()), element_tokens.size());
+}
+
 // ------------------------------------------------------------------------------------------------
 uint64_t ParseTokenAsID(const Token& t, const char*& err_out)
 {
@@ -523,8 +621,9 @@ void ReadBinaryDataArrayHead(const char*& data, const char* end, char& type, uin
 
 // ------------------------------------------------------------------------------------------------
 // read binary data array, assume cursor points to the 'compression mode' field (i.e. behind the header)
-void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const char* end,
-        std::vector<char>& buff, const Element& /*el*/) {
+// returns buff holding the array taken from the parser pre-pass if there is one, decoded otherwise
+const std::vector<char>& ReadBinaryDataArray(char type, uint32_t count, const char*& data, const char* end,
+        std::vector<char>& buff, const Element& el) {
     BE_NCONST uint32_t encmode = SafeParse<uint32_t>(data, end);
     AI_SWAP4(encmode);
     data += 4;
@@ -536,6 +635,11 @@ void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const cha
 
     ai_assert(data + comp_len == end);
 
+    if (encmode == 1 && el.GetParser().TakeInflatedArray(*el.Tokens()[0], buff)) {
+        data += comp_len;
+        return buff;
+    }
+
     // determine the length of the uncompressed data by looking at the type signature
     uint32_t stride = 0;
     switch(type)
@@ -581,6 +685,37 @@ void ReadBinaryDataArray(char type, uint32_t count, const char*& data, const cha
 
     data += comp_len;
     ai_assert(data == end);
+    return buff;
+}
+
+// ------------------------------------------------------------------------------------------------
+// parse the comma separated numbers of an ASCII array at once
+const char* ParseAsciiValues(const char* begin, const char* end, float* out, size_t count, size_t& numValues) {
+    return fast_atoreal_array<float>(begin, end, out, count, numValues, true);
+}
+
+const char* ParseAsciiValues(const char* begin, const char* end, int* out, size_t count, size_t& numValues) {
+    return strtol10_array(begin, end, out, count, numValues, true);
+}
+
+// ------------------------------------------------------------------------------------------------
+// read the tokens of an ASCII data array in one go. Fails if the text between the tokens is not
+// just commas and whitespace (i.e. comments) or if a token is not an exact match for the bulk
+// parser, the caller then falls back to parsing token by token.
+template <typename T>
+bool ParseAsciiDataArray(std::vector<T>& out, const TokenList& tokens) {
+    if (tokens.empty()) {
+        return true;
+    }
+
+    const char* end = tokens[tokens.size() - 1]->end();
+    out.resize(tokens.size());
+    size_t numValues = 0;
+    if (ParseAsciiValues(tokens[0]->begin(), end, out.data(), out.size(), numValues) != end || numValues != out.size()) {
+        out.clear();
+        return false;
+    }
+    return true;
 }
 
 } // !anon
@@ -616,8 +751,8 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
             ParseError("expected float or double array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> storage;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, storage, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
@@ -666,6 +801,14 @@ void ParseVectorDataArray(std::vector<aiVector3D>& out, const Element& el)
     if (a.Tokens().size() % 3 != 0) {
         ParseError("number of floats is not a multiple of three (3)",&el);
     }
+
+    std::vector<float> values;
+    if (ParseAsciiDataArray(values, a.Tokens())) {
+        for (size_t i = 0; i < values.size(); i += 3) {
+            out.push_back(aiVector3D(values[i], values[i + 1], values[i + 2]));
+        }
+        return;
+    }
     for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         aiVector3D v;
         v.x = ParseTokenAsFloat(**it++);
@@ -705,8 +848,8 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
             ParseError("expected float or double array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> storage;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, storage, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
@@ -746,6 +889,14 @@ void ParseVectorDataArray(std::vector<aiColor4D>& out, const Element& el)
     if (a.Tokens().size() % 4 != 0) {
         ParseError("number of floats is not a multiple of four (4)",&el);
     }
+
+    std::vector<float> values;
+    if (ParseAsciiDataArray(values, a.Tokens())) {
+        for (size_t i = 0; i < values.size(); i += 4) {
+            out.push_back(aiColor4D(values[i], values[i + 1], values[i + 2], values[i + 3]));
+        }
+        return;
+    }
     for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         aiColor4D v;
         v.r = ParseTokenAsFloat(**it++);
@@ -786,8 +937,8 @@ void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el) {
             ParseError("expected float or double array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> storage;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, storage, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
@@ -825,6 +976,14 @@ void ParseVectorDataArray(std::vector<aiVector2D>& out, const Element& el) {
     if (a.Tokens().size() % 2 != 0) {
         ParseError("number of floats is not a multiple of two (2)",&el);
     }
+
+    std::vector<float> values;
+    if (ParseAsciiDataArray(values, a.Tokens())) {
+        for (size_t i = 0; i < values.size(); i += 2) {
+            out.push_back(aiVector2D(values[i], values[i + 1]));
+        }
+        return;
+    }
     for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         aiVector2D v;
         v.x = ParseTokenAsFloat(**it++);
@@ -859,8 +1018,8 @@ void ParseVectorDataArray(std::vector<int>& out, const Element& el) {
             ParseError("expected int array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> storage;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, storage, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * 4;
@@ -888,6 +1047,9 @@ void ParseVectorDataArray(std::vector<int>& out, const Element& el) {
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
 
+    if (ParseAsciiDataArray(out, a.Tokens())) {
+        return;
+    }
     for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         const int ival = ParseTokenAsInt(**it++);
         out.push_back(ival);
@@ -920,8 +1082,8 @@ void ParseVectorDataArray(std::vector<float>& out, const Element& el)
             ParseError("expected float or double array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> storage;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, storage, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * (type == 'd' ? 8 : 4);
@@ -953,6 +1115,9 @@ void ParseVectorDataArray(std::vector<float>& out, const Element& el)
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
 
+    if (ParseAsciiDataArray(out, a.Tokens())) {
+        return;
+    }
     for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         const float ival = ParseTokenAsFloat(**it++);
         out.push_back(ival);
@@ -984,8 +1149,8 @@ void ParseVectorDataArray(std::vector<unsigned int>& out, const Element& el)
             ParseError("expected (u)int array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> storage;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, storage, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * 4;
@@ -1017,6 +1182,16 @@ void ParseVectorDataArray(std::vector<unsigned int>& out, const Element& el)
     const Scope& scope = GetRequiredScope(el);
     const Element& a = GetRequiredElement(scope,"a",&el);
 
+    std::vector<int> values;
+    if (ParseAsciiDataArray(values, a.Tokens())) {
+        for (const int ival : values) {
+            if (ival < 0) {
+                ParseError("encountered negative integer index");
+            }
+            out.push_back(static_cast<unsigned int>(ival));
+        }
+        return;
+    }
     for (TokenList::const_iterator it = a.Tokens().begin(), end = a.Tokens().end(); it != end; ) {
         const int ival = ParseTokenAsInt(**it++);
         if(ival < 0) {
@@ -1052,8 +1227,8 @@ void ParseVectorDataArray(std::vector<uint64_t>& out, const Element& el)
             ParseError("expected long array (binary)",&el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> storage;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, storage, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * 8;
@@ -1113,8 +1288,8 @@ void ParseVectorDataArray(std::vector<int64_t>& out, const Element& el)
             ParseError("expected long array (binary)", &el);
         }
 
-        std::vector<char> buff;
-        ReadBinaryDataArray(type, count, data, end, buff, el);
+        std::vector<char> storage;
+        const std::vector<char>& buff = ReadBinaryDataArray(type, count, data, end, storage, el);
 
         ai_assert(data == end);
         uint64_t dataToRead = static_cast<uint64_t>(count) * 8;
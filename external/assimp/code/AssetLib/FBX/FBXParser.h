@@ -52,25 +52,26 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/LogAux.h>
 #include <assimp/fast_atof.h>
 
+#include "FBXArena.h"
 #include "FBXCompileConfig.h"
 #include "FBXTokenizer.h"
 
 namespace Assimp {
+
+class TaskScheduler;
+
 namespace FBX {
 
 class Scope;
 class Parser;
 class Element;
 
-// XXX should use C++11's unique_ptr - but assimp's need to keep working with 03
+// elements and scopes are owned by the arena of their Parser
 typedef std::vector< Scope* > ScopeList;
 typedef std::fbx_unordered_multimap< std::string, Element* > ElementMap;
 
 typedef std::pair<ElementMap::const_iterator,ElementMap::const_iterator> ElementCollection;
 
-#   define new_Scope new Scope
-#   define new_Element new Element
-
 
 /** FBX data entity that consists of a key:value tuple.
  *
@@ -87,10 +88,9 @@ class Element
 {
 public:
     Element(const Token& key_token, Parser& parser);
-    ~Element();
 
     const Scope* Compound() const {
-        return compound.get();
+        return compound;
     }
 
     const Token& KeyToken() const {
@@ -101,10 +101,15 @@ public:
         return tokens;
     }
 
+    const Parser& GetParser() const {
+        return parser;
+    }
+
 private:
+    const Parser& parser;
     const Token& key_token;
     TokenList tokens;
-    std::unique_ptr<Scope> compound;
+    const Scope* compound;
 };
 
 /** FBX data entity that consists of a 'scope', a collection
@@ -158,18 +163,27 @@ class Parser
 {
 public:
     /** Parse given a token list. Does not take ownership of the tokens -
-     *  the objects must persist during the entire parser lifetime */
-    Parser (const TokenList& tokens,bool is_binary);
+     *  the objects must persist during the entire parser lifetime.
+     *  All scopes and elements are owned by the parser and freed with it.
+     *  For binary files all compressed data arrays are inflated up front,
+     *  concurrently if a scheduler is given. */
+    Parser (const TokenVector& tokens,bool is_binary, TaskScheduler* scheduler = nullptr);
     ~Parser();
 
     const Scope& GetRootScope() const {
-        return *root.get();
+        return *root;
     }
 
     bool IsBinary() const {
         return is_binary;
     }
 
+    /** Move the inflated contents of a compressed binary data array token
+     *  into out. The parser releases its copy, so every array is only held
+     *  until it has been read. Returns false if the token was not decoded
+     *  by the pre-pass or has been taken before. */
+    bool TakeInflatedArray(const Token& token, std::vector<char>& out) const;
+
 private:
     friend class Scope;
     friend class Element;
@@ -178,12 +192,32 @@ private:
     TokenPtr LastToken() const;
     TokenPtr CurrentToken() const;
 
+    // moves the tokens collected in element_tokens into the arena
+    TokenList StoreElementTokens();
+
+    // decodes all zlib compressed data arrays into inflated_arrays
+    void InflateArrays(TaskScheduler* scheduler);
+
 private:
-    const TokenList& tokens;
+    struct InflatedArray {
+        TokenPtr token;
+        std::vector<char> data;
+        bool valid;
+    };
+
+    const TokenVector& tokens;
 
     TokenPtr last, current;
-    TokenList::const_iterator cursor;
-    std::unique_ptr<Scope> root;
+    TokenVector::const_iterator cursor;
+
+    Arena arena;
+    // tokens of the element currently being parsed, reused for every element
+    std::vector<TokenPtr> element_tokens;
+    const Scope* root;
+
+    // sorted by token address, which is also the token order. Entries are
+    // emptied by TakeInflatedArray while the DOM is read.
+    mutable std::vector<InflatedArray> inflated_arrays;
 
     const bool is_binary;
 };
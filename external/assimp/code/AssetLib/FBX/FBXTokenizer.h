@@ -154,11 +154,54 @@ private:
     const unsigned int column;
 };
 
-// XXX should use C++11's unique_ptr - but assimp's need to keep working with 03
 typedef const Token* TokenPtr;
-typedef std::vector< TokenPtr > TokenList;
 
-#define new_Token new Token
+/** All tokens of a file, stored contiguously by value. Tokens only point
+ *  into the input buffer, so the whole list is released in one step. */
+typedef std::vector< Token > TokenVector;
+
+/** Read-only view of the tokens of a single #Element. The pointer array
+ *  lives in the arena of the #Parser that created the element. */
+class TokenList
+{
+public:
+    typedef const TokenPtr* const_iterator;
+
+    TokenList()
+    : first()
+    , count()
+    {}
+
+    TokenList(const TokenPtr* first, size_t count)
+    : first(first)
+    , count(count)
+    {}
+
+    const_iterator begin() const {
+        return first;
+    }
+
+    const_iterator end() const {
+        return first + count;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    const TokenPtr& operator[] (size_t index) const {
+        ai_assert(index < count);
+        return first[index];
+    }
+
+private:
+    const TokenPtr* first;
+    size_t count;
+};
 
 
 /** Main FBX tokenizer function. Transform input buffer into a list of preprocessed tokens.
@@ -168,7 +211,7 @@ typedef std::vector< TokenPtr > TokenList;
  * @param output_tokens Receives a list of all tokens in the input data.
  * @param input_buffer Textual input buffer to be processed, 0-terminated.
  * @throw DeadlyImportError if something goes wrong */
-void Tokenize(TokenList& output_tokens, const char* input);
+void Tokenize(TokenVector& output_tokens, const char* input);
 
 
 /** Tokenizer function for binary FBX files.
@@ -179,7 +222,7 @@ void Tokenize(TokenList& output_tokens, const char* input);
  * @param input_buffer Binary input buffer to be processed.
  * @param length Length of input buffer, in bytes. There is no 0-terminal.
  * @throw DeadlyImportError if something goes wrong */
-void TokenizeBinary(TokenList& output_tokens, const char* input, size_t length);
+void TokenizeBinary(TokenVector& output_tokens, const char* input, size_t length);
 
 
 } // ! FBX
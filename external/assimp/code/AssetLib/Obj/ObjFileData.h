@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/mesh.h>
 #include <assimp/types.h>
+#include <exception>
 #include <map>
 #include <vector>
 #include "Common/Maybe.h"
@@ -337,6 +338,129 @@ struct Model {
     }
 };
 
+// ------------------------------------------------------------------------------------------------
+//! \struct Chunk
+//! \brief  Data parsed from a range of whole lines, independent of all other chunks.
+//!         Faces are merged into the model in file order, relative indices are
+//!         local to the chunk until then.
+// ------------------------------------------------------------------------------------------------
+struct Chunk {
+    //! Bits of RelativeFace::m_arrays
+    enum IndexArrays {
+        VertexIndices = 1,
+        TextureCoordIndices = 2,
+        NormalIndices = 4
+    };
+
+    //! Face with negative indices, resolved against the element counts of the chunk
+    struct RelativeFace {
+        size_t m_face;
+        unsigned int m_arrays;
+    };
+
+    //! Face parsed again during the merge, its indices depend on data before the chunk
+    struct DeferredFace {
+        size_t m_face;
+        size_t m_line;
+        aiPrimitiveType m_type;
+        unsigned int m_numVertices;
+        unsigned int m_numTextureCoords;
+        unsigned int m_numNormals;
+    };
+
+    //! Face with an index in the texture coordinate slot, parsed before the chunk had
+    //! texture coordinates. If the file has none before it either, the merge parses it
+    //! again, the index refers to a normal then.
+    struct TextureCoordSlotFace {
+        size_t m_face;
+        //! Line in the input buffer, which stays valid until the merge
+        const char *m_line;
+        aiPrimitiveType m_type;
+        unsigned int m_numVertices;
+        unsigned int m_numNormals;
+        //! Problems counted for the face, the parser reports them again
+        bool m_pointSeparator;
+        bool m_unsupportedToken;
+    };
+
+    //! Line handled by the parser during the merge (usemtl, mtllib, g, o), applies before m_face
+    struct Command {
+        size_t m_face;
+        size_t m_line;
+    };
+
+    //! Range of the chunk in the input buffer
+    const char *m_begin;
+    const char *m_end;
+    //! State of the free-form geometry section at the start and the end of the chunk
+    bool m_startsInsideCstype;
+    bool m_endsInsideCstype;
+
+    std::vector<aiVector3D> m_Vertices;
+    std::vector<aiVector3D> m_Normals;
+    std::vector<aiVector3D> m_VertexColors;
+    std::vector<aiVector3D> m_TextureCoord;
+    unsigned int m_TextureCoordDim;
+
+    //! Faces in file order, nullptr for deferred faces
+    std::vector<Face *> m_Faces;
+    std::vector<RelativeFace> m_RelativeFaces;
+    std::vector<DeferredFace> m_DeferredFaces;
+    std::vector<TextureCoordSlotFace> m_TextureCoordSlotFaces;
+    std::vector<Command> m_Commands;
+    //! Text of deferred faces and commands, each line followed by '\n' and '\0'
+    std::vector<char> m_Lines;
+
+    //! Problems found while parsing, reported by the merge
+    unsigned int m_numEmptyFaces;
+    unsigned int m_numPointSeparators;
+    unsigned int m_numUnsupportedTokens;
+
+    //! Exception thrown while parsing the chunk
+    std::exception_ptr m_error;
+
+    Chunk() :
+            m_begin(nullptr),
+            m_end(nullptr),
+            m_startsInsideCstype(false),
+            m_endsInsideCstype(false),
+            m_TextureCoordDim(0),
+            m_numEmptyFaces(0),
+            m_numPointSeparators(0),
+            m_numUnsupportedTokens(0) {
+        // empty
+    }
+
+    ~Chunk() {
+        clear();
+    }
+
+    Chunk(const Chunk &) = delete;
+    Chunk &operator=(const Chunk &) = delete;
+
+    //! \brief  Drops all parsed data, keeps the range.
+    void clear() {
+        for (Face *face : m_Faces) {
+            delete face;
+        }
+        m_Faces.clear();
+        m_Vertices.clear();
+        m_Normals.clear();
+        m_VertexColors.clear();
+        m_TextureCoord.clear();
+        m_TextureCoordDim = 0;
+        m_RelativeFaces.clear();
+        m_DeferredFaces.clear();
+        m_TextureCoordSlotFaces.clear();
+        m_Commands.clear();
+        m_Lines.clear();
+        m_numEmptyFaces = 0;
+        m_numPointSeparators = 0;
+        m_numUnsupportedTokens = 0;
+        m_error = nullptr;
+    }
+};
+
 // ------------------------------------------------------------------------------------------------
 
 } // Namespace ObjFile
@@ -44,8 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileImporter.h"
 #include "ObjFileData.h"
 #include "ObjFileParser.h"
+#include "Common/Importer.h"
 #include <assimp/DefaultIOSystem.h>
-#include <assimp/IOStreamBuffer.h>
 #include <assimp/ai_assert.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
@@ -78,7 +78,8 @@ using namespace std;
 ObjFileImporter::ObjFileImporter() :
         m_Buffer(),
         m_pRootObject(nullptr),
-        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())) {}
+        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())),
+        m_scheduler(nullptr) {}
 
 // ------------------------------------------------------------------------------------------------
 //  Destructor.
@@ -99,6 +100,11 @@ const aiImporterDesc *ObjFileImporter::GetInfo() const {
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+void ObjFileImporter::SetupProperties(const Importer *pImp) {
+    m_scheduler = pImp->Pimpl()->mTaskScheduler;
+}
+
 // ------------------------------------------------------------------------------------------------
 //  Obj-file import implementation
 void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, IOSystem *pIOHandler) {
@@ -118,12 +124,6 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
         throw DeadlyImportError("OBJ-file is too small.");
     }
 
-    IOStreamBuffer<char> streamedBuffer;
-    streamedBuffer.open(fileStream.get());
-
-    // Allocate buffer and read file into it
-    //TextFileToBuffer( fileStream.get(),m_Buffer);
-
     // Get the model name
     std::string modelName, folderName;
     std::string::size_type pos = file.find_last_of("\\/");
@@ -137,14 +137,12 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
         modelName = file;
     }
 
-    // parse the file into a temporary representation
-    ObjFileParser parser(streamedBuffer, modelName, pIOHandler, m_progress, file);
+    // parse the file into a temporary representation, chunks of lines are parsed in parallel
+    ObjFileParser parser(fileStream.get(), modelName, pIOHandler, m_progress, file, m_scheduler);
 
     // And create the proper return structures out of it
     CreateDataFromImport(parser.GetModel(), pScene);
 
-    streamedBuffer.close();
-
     // Clean up allocated storage for the next import
     m_Buffer.clear();
 
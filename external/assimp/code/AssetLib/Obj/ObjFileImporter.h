@@ -56,6 +56,8 @@ struct Object;
 struct Model;
 } // namespace ObjFile
 
+class TaskScheduler;
+
 // ------------------------------------------------------------------------------------------------
 /// \class  ObjFileImporter
 /// \brief  Imports a waveform obj file
@@ -76,6 +78,9 @@ protected:
     //! \brief  Appends the supported extension.
     const aiImporterDesc *GetInfo() const override;
 
+    //! \brief  Picks up the thread pool of the importer.
+    void SetupProperties(const Importer *pImp) override;
+
     //! \brief  File import implementation.
     void InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) override;
 
@@ -113,6 +118,8 @@ private:
     ObjFile::Object *m_pRootObject;
     //! Absolute pathname of model in file system
     std::string m_strAbsPath;
+    //! Thread pool owned by the Importer, nullptr if threading is disabled
+    TaskScheduler *m_scheduler;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -44,12 +44,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileData.h"
 #include "ObjFileMtlImporter.h"
 #include "ObjTools.h"
+#include "Common/TaskScheduler.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/ParsingUtils.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -82,20 +85,31 @@ ObjFileParser::ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::stri
         m_originalObjFileName(originalObjFileName) {
     std::fill_n(m_buffer, Buffersize, '\0');
 
-    // Create the model instance to store all the data
-    m_pModel.reset(new ObjFile::Model());
-    m_pModel->m_ModelName = modelName;
-
-    // create default material and store it
-    m_pModel->m_pDefaultMaterial = new ObjFile::Material;
-    m_pModel->m_pDefaultMaterial->MaterialName.Set(DEFAULT_MATERIAL);
-    m_pModel->m_MaterialLib.push_back(DEFAULT_MATERIAL);
-    m_pModel->m_MaterialMap[DEFAULT_MATERIAL] = m_pModel->m_pDefaultMaterial;
+    createModel(modelName);
 
     // Start parsing the file
     parseFile(streamBuffer);
 }
 
+ObjFileParser::ObjFileParser(IOStream *stream, const std::string &modelName,
+        IOSystem *io, ProgressHandler *progress,
+        const std::string &originalObjFileName, TaskScheduler *scheduler) :
+        m_DataIt(),
+        m_DataItEnd(),
+        m_pModel(nullptr),
+        m_uiLine(0),
+        m_buffer(),
+        m_pIO(io),
+        m_progress(progress),
+        m_originalObjFileName(originalObjFileName) {
+    std::fill_n(m_buffer, Buffersize, '\0');
+
+    createModel(modelName);
+
+    // Start parsing the file
+    parseFileChunked(stream, scheduler);
+}
+
 ObjFileParser::~ObjFileParser() {
 }
 
@@ -108,6 +122,18 @@ ObjFile::Model *ObjFileParser::GetModel() const {
     return m_pModel.get();
 }
 
+void ObjFileParser::createModel(const std::string &modelName) {
+    // Create the model instance to store all the data
+    m_pModel.reset(new ObjFile::Model());
+    m_pModel->m_ModelName = modelName;
+
+    // create default material and store it
+    m_pModel->m_pDefaultMaterial = new ObjFile::Material;
+    m_pModel->m_pDefaultMaterial->MaterialName.Set(DEFAULT_MATERIAL);
+    m_pModel->m_MaterialLib.push_back(DEFAULT_MATERIAL);
+    m_pModel->m_MaterialMap[DEFAULT_MATERIAL] = m_pModel->m_pDefaultMaterial;
+}
+
 void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
     // only update every 100KB or it'll be too slow
     //const unsigned int updateProgressEveryBytes = 100 * 1024;
@@ -132,119 +158,123 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
             m_progress->UpdateFileRead(processed, progressTotal);
         }
 
-        // handle cstype section end (http://paulbourke.net/dataformats/obj/)
-        if (insideCstype) {
-            switch (*m_DataIt) {
-            case 'e': {
-                std::string name;
-                getNameNoSpace(m_DataIt, m_DataItEnd, name);
-                insideCstype = name != "end";
-            } break;
-            }
-            goto pf_skip_line;
-        }
+        parseLine(insideCstype);
+    }
+}
 
-        // parse line
+void ObjFileParser::parseLine(bool &insideCstype) {
+    // handle cstype section end (http://paulbourke.net/dataformats/obj/)
+    if (insideCstype) {
         switch (*m_DataIt) {
-        case 'v': // Parse a vertex texture coordinate
-        {
-            ++m_DataIt;
-            if (*m_DataIt == ' ' || *m_DataIt == '\t') {
-                size_t numComponents = getNumComponentsInDataDefinition();
-                if (numComponents == 3) {
-                    // read in vertex definition
-                    getVector3(m_pModel->m_Vertices);
-                } else if (numComponents == 4) {
-                    // read in vertex definition (homogeneous coords)
-                    getHomogeneousVector3(m_pModel->m_Vertices);
-                } else if (numComponents == 6) {
-                    // read vertex and vertex-color
-                    getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
-                }
-            } else if (*m_DataIt == 't') {
-                // read in texture coordinate ( 2D or 3D )
-                ++m_DataIt;
-                size_t dim = getTexCoordVector(m_pModel->m_TextureCoord);
-                m_pModel->m_TextureCoordDim = std::max(m_pModel->m_TextureCoordDim, (unsigned int)dim);
-            } else if (*m_DataIt == 'n') {
-                // Read in normal vector definition
-                ++m_DataIt;
-                getVector3(m_pModel->m_Normals);
-            }
-        } break;
-
-        case 'p': // Parse a face, line or point statement
-        case 'l':
-        case 'f': {
-            getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
-        } break;
-
-        case '#': // Parse a comment
-        {
-            getComment();
-        } break;
-
-        case 'u': // Parse a material desc. setter
-        {
+        case 'e': {
             std::string name;
-
             getNameNoSpace(m_DataIt, m_DataItEnd, name);
+            insideCstype = name != "end";
+        } break;
+        }
+        goto pf_skip_line;
+    }
 
-            size_t nextSpace = name.find(' ');
-            if (nextSpace != std::string::npos)
-                name = name.substr(0, nextSpace);
-
-            if (name == "usemtl") {
-                getMaterialDesc();
+    // parse line
+    switch (*m_DataIt) {
+    case 'v': // Parse a vertex texture coordinate
+    {
+        ++m_DataIt;
+        if (*m_DataIt == ' ' || *m_DataIt == '\t') {
+            size_t numComponents = getNumComponentsInDataDefinition();
+            if (numComponents == 3) {
+                // read in vertex definition
+                getVector3(m_pModel->m_Vertices);
+            } else if (numComponents == 4) {
+                // read in vertex definition (homogeneous coords)
+                getHomogeneousVector3(m_pModel->m_Vertices);
+            } else if (numComponents == 6) {
+                // read vertex and vertex-color
+                getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
             }
-        } break;
+        } else if (*m_DataIt == 't') {
+            // read in texture coordinate ( 2D or 3D )
+            ++m_DataIt;
+            size_t dim = getTexCoordVector(m_pModel->m_TextureCoord);
+            m_pModel->m_TextureCoordDim = std::max(m_pModel->m_TextureCoordDim, (unsigned int)dim);
+        } else if (*m_DataIt == 'n') {
+            // Read in normal vector definition
+            ++m_DataIt;
+            getVector3(m_pModel->m_Normals);
+        }
+    } break;
 
-        case 'm': // Parse a material library or merging group ('mg')
-        {
-            std::string name;
+    case 'p': // Parse a face, line or point statement
+    case 'l':
+    case 'f': {
+        getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
+    } break;
 
-            getNameNoSpace(m_DataIt, m_DataItEnd, name);
+    case '#': // Parse a comment
+    {
+        getComment();
+    } break;
 
-            size_t nextSpace = name.find(' ');
-            if (nextSpace != std::string::npos)
-                name = name.substr(0, nextSpace);
+    case 'u': // Parse a material desc. setter
+    {
+        std::string name;
 
-            if (name == "mg")
-                getGroupNumberAndResolution();
-            else if (name == "mtllib")
-                getMaterialLib();
-            else
-                goto pf_skip_line;
-        } break;
+        getNameNoSpace(m_DataIt, m_DataItEnd, name);
 
-        case 'g': // Parse group name
-        {
-            getGroupName();
-        } break;
+        size_t nextSpace = name.find(' ');
+        if (nextSpace != std::string::npos)
+            name = name.substr(0, nextSpace);
 
-        case 's': // Parse group number
-        {
-            getGroupNumber();
-        } break;
+        if (name == "usemtl") {
+            getMaterialDesc();
+        }
+    } break;
 
-        case 'o': // Parse object name
-        {
-            getObjectName();
-        } break;
+    case 'm': // Parse a material library or merging group ('mg')
+    {
+        std::string name;
 
-        case 'c': // handle cstype section start
-        {
-            std::string name;
-            getNameNoSpace(m_DataIt, m_DataItEnd, name);
-            insideCstype = name == "cstype";
-            goto pf_skip_line;
-        } break;
+        getNameNoSpace(m_DataIt, m_DataItEnd, name);
 
-        default: {
-        pf_skip_line:
-            m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
-        } break;
-        }
+        size_t nextSpace = name.find(' ');
+        if (nextSpace != std::string::npos)
+            name = name.substr(0, nextSpace);
+
+        if (name == "mg")
+            getGroupNumberAndResolution();
+        else if (name == "mtllib")
+            getMaterialLib();
+        else
+            goto pf_skip_line;
+    } break;
+
+    case 'g': // Parse group name
+    {
+        getGroupName();
+    } break;
+
+    case 's': // Parse group number
+    {
+        getGroupNumber();
+    } break;
+
+    case 'o': // Parse object name
+    {
+        getObjectName();
+    } break;
+
+    case 'c': // handle cstype section start
+    {
+        std::string name;
+        getNameNoSpace(m_DataIt, m_DataItEnd, name);
+        insideCstype = name == "cstype";
+        goto pf_skip_line;
+    } break;
+
+    default: {
+    pf_skip_line:
+        m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
+    } break;
     }
 }
 
@@ -285,9 +315,8 @@ static bool isNanOrInf(const char *in) {
            ((in[0] == 'I' || in[0] == 'i') && ASSIMP_strincmp(in, "inf", 3) == 0);
 }
 
-size_t ObjFileParser::getNumComponentsInDataDefinition() {
+static size_t getNumComponents(const char *tmp) {
     size_t numComponents(0);
-    const char *tmp(&m_DataIt[0]);
     bool end_of_definition = false;
     while (!end_of_definition) {
         if (isDataDefinitionEnd(tmp)) {
@@ -310,6 +339,10 @@ size_t ObjFileParser::getNumComponentsInDataDefinition() {
     return numComponents;
 }
 
+size_t ObjFileParser::getNumComponentsInDataDefinition() {
+    return getNumComponents(&m_DataIt[0]);
+}
+
 size_t ObjFileParser::getTexCoordVector(std::vector<aiVector3D> &point3d_array) {
     size_t numComponents = getNumComponentsInDataDefinition();
     ai_real x, y, z;
@@ -426,93 +459,132 @@ void ObjFileParser::getVector2(std::vector<aiVector2D> &point2d_array) {
 
 static const std::string DefaultObjName = "defaultobject";
 
-void ObjFileParser::getFace(aiPrimitiveType type) {
-    m_DataIt = getNextToken<DataArrayIt>(m_DataIt, m_DataItEnd);
-    if (m_DataIt == m_DataItEnd || *m_DataIt == '\0') {
-        return;
+namespace {
+
+// Results of parseFaceIndices besides the face itself
+struct FaceInfo {
+    // the statement has no vertex index
+    bool empty = false;
+    bool pointSeparator = false;
+    bool unsupportedToken = false;
+    // an index was found in the texture coordinate slot
+    bool textureCoordSlot = false;
+    // ObjFile::Chunk::IndexArrays with negative and with positive indices
+    unsigned int relative = 0;
+    unsigned int absolute = 0;
+};
+
+} // namespace
+
+// Parses the indices of a 'f', 'l' or 'p' statement, it points to the keyword. Negative indices are
+// resolved against the given element counts. Returns nullptr if there is no vertex index.
+static ObjFile::Face *parseFaceIndices(const char *it, aiPrimitiveType type, int vSize, int vtSize, int vnSize,
+        bool vt, bool vn, FaceInfo &info) {
+    while (!IsSpaceOrNewLine(*it)) {
+        ++it;
+    }
+    while (IsSpace(*it)) {
+        ++it;
+    }
+    if (*it == '\0') {
+        return nullptr;
     }
 
-    ObjFile::Face *face = new ObjFile::Face(type);
-    bool hasNormal = false;
-
-    const int vSize = static_cast<unsigned int>(m_pModel->m_Vertices.size());
-    const int vtSize = static_cast<unsigned int>(m_pModel->m_TextureCoord.size());
-    const int vnSize = static_cast<unsigned int>(m_pModel->m_Normals.size());
-
-    const bool vt = (!m_pModel->m_TextureCoord.empty());
-    const bool vn = (!m_pModel->m_Normals.empty());
+    std::unique_ptr<ObjFile::Face> face(new ObjFile::Face(type));
     int iPos = 0;
-    while (m_DataIt != m_DataItEnd) {
-        int iStep = 1;
-
-        if (IsLineEnd(*m_DataIt)) {
-            break;
-        }
-
-        if (*m_DataIt == '/') {
+    while (!IsLineEnd(*it)) {
+        if (*it == '/') {
             if (type == aiPrimitiveType_POINT) {
-                ASSIMP_LOG_ERROR("Obj: Separator unexpected in point statement");
+                info.pointSeparator = true;
             }
-            iPos++;
-        } else if (IsSpaceOrNewLine(*m_DataIt)) {
+            ++iPos;
+            ++it;
+            continue;
+        }
+        if (IsSpace(*it)) {
             iPos = 0;
-        } else {
-            //OBJ USES 1 Base ARRAYS!!!!
-            const int iVal(::atoi(&(*m_DataIt)));
+            ++it;
+            continue;
+        }
 
-            // increment iStep position based off of the sign and # of digits
-            int tmp = iVal;
-            if (iVal < 0) {
-                ++iStep;
-            }
-            while ((tmp = tmp / 10) != 0) {
-                ++iStep;
-            }
+        //OBJ USES 1 Base ARRAYS!!!!
+        const bool negative = (*it == '-');
+        if (*it == '-' || *it == '+') {
+            ++it;
+        }
+        unsigned int value = 0;
+        while (*it >= '0' && *it <= '9') {
+            value = value * 10 + static_cast<unsigned int>(*it - '0');
+            ++it;
+        }
+        if (0 == value) {
+            //On error, std::atoi will return 0 which is not a valid value
+            throw DeadlyImportError("OBJ: Invalid face indice");
+        }
+        const int iVal = negative ? -static_cast<int>(value) : static_cast<int>(value);
 
-            if (iPos == 1 && !vt && vn)
+        if (iPos == 1) {
+            info.textureCoordSlot = true;
+            if (!vt && vn) {
                 iPos = 2; // skip texture coords for normals if there are no tex coords
-
-            if (iVal > 0) {
-                // Store parsed index
-                if (0 == iPos) {
-                    face->m_vertices.push_back(iVal - 1);
-                } else if (1 == iPos) {
-                    face->m_texturCoords.push_back(iVal - 1);
-                } else if (2 == iPos) {
-                    face->m_normals.push_back(iVal - 1);
-                    hasNormal = true;
-                } else {
-                    reportErrorTokenInFace();
-                }
-            } else if (iVal < 0) {
-                // Store relatively index
-                if (0 == iPos) {
-                    face->m_vertices.push_back(vSize + iVal);
-                } else if (1 == iPos) {
-                    face->m_texturCoords.push_back(vtSize + iVal);
-                } else if (2 == iPos) {
-                    face->m_normals.push_back(vnSize + iVal);
-                    hasNormal = true;
-                } else {
-                    reportErrorTokenInFace();
-                }
-            } else {
-                //On error, std::atoi will return 0 which is not a valid value
-                delete face;
-                throw DeadlyImportError("OBJ: Invalid face indice");
             }
         }
-        m_DataIt += iStep;
+        if (iPos > 2) {
+            info.unsupportedToken = true;
+            break;
+        }
+
+        ObjFile::Face::IndexArray &indices = (0 == iPos) ? face->m_vertices : (1 == iPos ? face->m_texturCoords : face->m_normals);
+        if (iVal > 0) {
+            // Store parsed index
+            indices.push_back(iVal - 1);
+            info.absolute |= 1u << iPos;
+        } else {
+            // Store relatively index
+            const int size = (0 == iPos) ? vSize : (1 == iPos ? vtSize : vnSize);
+            indices.push_back(size + iVal);
+            info.relative |= 1u << iPos;
+        }
     }
 
     if (face->m_vertices.empty()) {
+        info.empty = true;
+        return nullptr;
+    }
+    return face.release();
+}
+
+ObjFile::Face *ObjFileParser::parseFace(const char *line, aiPrimitiveType type, unsigned int numVertices,
+        unsigned int numTextureCoords, unsigned int numNormals) {
+    FaceInfo info;
+    ObjFile::Face *face = parseFaceIndices(line, type, static_cast<int>(numVertices), static_cast<int>(numTextureCoords),
+            static_cast<int>(numNormals), numTextureCoords > 0, numNormals > 0, info);
+    if (info.pointSeparator) {
+        ASSIMP_LOG_ERROR("Obj: Separator unexpected in point statement");
+    }
+    if (info.unsupportedToken) {
+        ASSIMP_LOG_ERROR("OBJ: Not supported token in face description detected");
+    }
+    if (info.empty) {
         ASSIMP_LOG_ERROR("Obj: Ignoring empty face");
-        // skip line and clean up
-        m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
-        delete face;
-        return;
+    }
+    return face;
+}
+
+void ObjFileParser::getFace(aiPrimitiveType type) {
+    ObjFile::Face *face = parseFace(&(*m_DataIt), type,
+            static_cast<unsigned int>(m_pModel->m_Vertices.size()),
+            static_cast<unsigned int>(m_pModel->m_TextureCoord.size()),
+            static_cast<unsigned int>(m_pModel->m_Normals.size()));
+    if (nullptr != face) {
+        addFace(face);
     }
 
+    // Skip the rest of the line
+    m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
+}
+
+void ObjFileParser::addFace(ObjFile::Face *face) {
     // Set active material, if one set
     if (nullptr != m_pModel->m_pCurrentMaterial) {
         face->m_pMaterial = m_pModel->m_pCurrentMaterial;
@@ -534,11 +606,454 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
     m_pModel->m_pCurrentMesh->m_Faces.push_back(face);
     m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int)face->m_vertices.size();
     m_pModel->m_pCurrentMesh->m_uiUVCoordinates[0] += (unsigned int)face->m_texturCoords.size();
-    if (!m_pModel->m_pCurrentMesh->m_hasNormals && hasNormal) {
+    if (!m_pModel->m_pCurrentMesh->m_hasNormals && !face->m_normals.empty()) {
         m_pModel->m_pCurrentMesh->m_hasNormals = true;
     }
-    // Skip the rest of the line
-    m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
+}
+
+// Size of the windows read from the stream and split into chunks, a window is merged before the next one
+static const size_t ObjWindowSize = 64 * 1024 * 1024;
+// Chunks are not made smaller than this to keep the merge overhead low
+static const size_t ObjMinChunkSize = 1024 * 1024;
+
+// Checks whether the line starting at lineStart is the continuation of the line before it (backslash at the end)
+static bool isContinuedLine(const char *begin, const char *lineStart) {
+    const char *it = lineStart - 1;
+    while (it != begin && it[-1] == '\r') {
+        --it;
+    }
+    return it != begin && it[-1] == '\\';
+}
+
+// Returns the start of the first line behind it, end if there is none
+static const char *findLineStart(const char *begin, const char *it, const char *end) {
+    while (it != end) {
+        it = static_cast<const char *>(std::memchr(it, '\n', end - it));
+        if (nullptr == it) {
+            return end;
+        }
+        ++it;
+        if (!isContinuedLine(begin, it)) {
+            return it;
+        }
+    }
+    return end;
+}
+
+// Returns the start of the last line in the range, begin if there is none
+static const char *findLastLineStart(const char *begin, const char *end) {
+    for (const char *it = end; it != begin; --it) {
+        if (it[-1] == '\n' && !isContinuedLine(begin, it)) {
+            return it;
+        }
+    }
+    return begin;
+}
+
+// Returns the line at it and moves it behind the line, like IOStreamBuffer::getNextDataLine.
+// Continued lines and a last line without line end are joined into scratch, bufferEnd
+// receives the end of the characters which can be read behind the line.
+static const char *nextLine(const char *&it, const char *end, std::vector<char> &scratch, const char *&bufferEnd) {
+    const char *line = it;
+    const char *cur = it;
+    while (cur != end && !IsLineEnd(*cur) && !(*cur == '\\' && cur + 1 != end && IsLineEnd(cur[1]))) {
+        ++cur;
+    }
+    if (cur != end && IsLineEnd(*cur)) {
+        it = cur + 1;
+        bufferEnd = end;
+        return line;
+    }
+
+    scratch.assign(line, cur);
+    while (cur != end && !IsLineEnd(*cur)) {
+        if (*cur == '\\' && cur + 1 != end && IsLineEnd(cur[1])) {
+            // continue behind the line break
+            while (cur != end && *cur != '\n') {
+                ++cur;
+            }
+            if (cur != end) {
+                ++cur;
+            }
+        } else {
+            scratch.push_back(*cur++);
+        }
+    }
+    scratch.push_back('\n');
+    it = (cur != end) ? cur + 1 : end;
+    bufferEnd = scratch.data() + scratch.size();
+    return scratch.data();
+}
+
+// Appends a line followed by '\n' and '\0'. The helpers of the line parser treat
+// the last character of their range as end of the buffer, not as line end.
+static void appendLine(std::vector<char> &lines, const char *line) {
+    const char *end = line;
+    while (!IsLineEnd(*end)) {
+        ++end;
+    }
+    lines.insert(lines.end(), line, end);
+    lines.push_back('\n');
+    lines.push_back('\0');
+}
+
+// Checks whether the first word of the line is keyword
+static bool isKeyword(const char *line, const char *keyword) {
+    const size_t length = std::strlen(keyword);
+    return 0 == std::strncmp(line, keyword, length) && IsSpaceOrNewLine(line[length]);
+}
+
+// Reads the next word as a number, like copyNextWord followed by fast_atof
+static ai_real readReal(const char *&it) {
+    while (IsSpace(*it)) {
+        ++it;
+    }
+    const char *word = it;
+    while (!IsSpaceOrNewLine(*it)) {
+        ++it;
+    }
+
+    ai_real value = ai_real(0.0);
+    const char *digits = (*word == '-' || *word == '+') ? word + 1 : word;
+    if ((*digits >= '0' && *digits <= '9') || (*digits == '.' && digits[1] >= '0' && digits[1] <= '9')) {
+        fast_atoreal_move<ai_real>(word, value);
+    } else {
+        // nan, inf and malformed numbers, the copy keeps error messages inside the word
+        char buffer[ObjFileParser::Buffersize];
+        const size_t length = std::min(static_cast<size_t>(it - word), static_cast<size_t>(ObjFileParser::Buffersize - 1));
+        std::memcpy(buffer, word, length);
+        buffer[length] = '\0';
+        value = fast_atof(buffer);
+    }
+    return value;
+}
+
+// Reads count numbers at once. The bulk parser stops in front of words it does not
+// know, readReal reports them like before. As many numbers as counted by getNumComponents
+// never reach beyond the line, bufferEnd only limits the characters the parser may look at.
+static void readReals(const char *&it, const char *bufferEnd, ai_real *values, size_t count) {
+    size_t numValues = 0;
+    it = fast_atoreal_array<ai_real>(it, bufferEnd, values, count, numValues);
+    for (; numValues < count; ++numValues) {
+        values[numValues] = readReal(it);
+    }
+}
+
+// Parses a 'v', 'vt' or 'vn' statement into the chunk
+static void parseChunkVertexData(ObjFile::Chunk &chunk, const char *line, const char *bufferEnd) {
+    const char *it = line + 1;
+    ai_real v[6];
+    if (*it == ' ' || *it == '\t') {
+        const size_t numComponents = getNumComponents(it);
+        if (numComponents == 3) {
+            readReals(it, bufferEnd, v, 3);
+            chunk.m_Vertices.emplace_back(v[0], v[1], v[2]);
+        } else if (numComponents == 4) {
+            readReals(it, bufferEnd, v, 4);
+            if (v[3] == 0)
+                throw DeadlyImportError("OBJ: Invalid component in homogeneous vector (Division by zero)");
+            chunk.m_Vertices.emplace_back(v[0] / v[3], v[1] / v[3], v[2] / v[3]);
+        } else if (numComponents == 6) {
+            readReals(it, bufferEnd, v, 6);
+            chunk.m_Vertices.emplace_back(v[0], v[1], v[2]);
+            chunk.m_VertexColors.emplace_back(v[3], v[4], v[5]);
+        }
+    } else if (*it == 't') {
+        ++it;
+        const size_t numComponents = getNumComponents(it);
+        if (numComponents != 2 && numComponents != 3) {
+            throw DeadlyImportError("OBJ: Invalid number of components");
+        }
+        v[2] = ai_real(0.0);
+        readReals(it, bufferEnd, v, numComponents);
+        ai_real x = v[0], y = v[1], z = v[2];
+
+        // Coerce nan and inf to 0 as is the OBJ default value
+        if (!std::isfinite(x))
+            x = 0;
+        if (!std::isfinite(y))
+            y = 0;
+        if (!std::isfinite(z))
+            z = 0;
+
+        chunk.m_TextureCoord.emplace_back(x, y, z);
+        chunk.m_TextureCoordDim = std::max(chunk.m_TextureCoordDim, static_cast<unsigned int>(numComponents));
+    } else if (*it == 'n') {
+        ++it;
+        readReals(it, bufferEnd, v, 3);
+        chunk.m_Normals.emplace_back(v[0], v[1], v[2]);
+    }
+}
+
+// Parses a face statement into the chunk. Faces whose indices depend on the data
+// before the chunk in a way that cannot be fixed up later are parsed again by the merge.
+static void parseChunkFace(ObjFile::Chunk &chunk, const char *line) {
+    const aiPrimitiveType type = (*line == 'f') ? aiPrimitiveType_POLYGON : (*line == 'l' ? aiPrimitiveType_LINE : aiPrimitiveType_POINT);
+    const unsigned int numVertices = static_cast<unsigned int>(chunk.m_Vertices.size());
+    const unsigned int numTextureCoords = static_cast<unsigned int>(chunk.m_TextureCoord.size());
+    const unsigned int numNormals = static_cast<unsigned int>(chunk.m_Normals.size());
+
+    // the faces are parsed as if the file had texture coordinates, which it has unless
+    // there are none in the chunk yet. The merge knows whether there are before the chunk.
+    FaceInfo info;
+    std::unique_ptr<ObjFile::Face> face(parseFaceIndices(line, type, static_cast<int>(numVertices),
+            static_cast<int>(numTextureCoords), static_cast<int>(numNormals), true, numNormals > 0, info));
+    if (!face) {
+        chunk.m_numEmptyFaces += info.empty ? 1 : 0;
+        chunk.m_numPointSeparators += info.pointSeparator ? 1 : 0;
+        chunk.m_numUnsupportedTokens += info.unsupportedToken ? 1 : 0;
+        return;
+    }
+
+    // lines joined in the scratch buffer are gone by the merge
+    const bool inBuffer = line >= chunk.m_begin && line < chunk.m_end;
+    const bool textureCoordSlot = info.textureCoordSlot && 0 == numTextureCoords;
+    if ((textureCoordSlot && !inBuffer) || 0 != (info.relative & info.absolute)) {
+        chunk.m_DeferredFaces.push_back({ chunk.m_Faces.size(), chunk.m_Lines.size(), type, numVertices, numTextureCoords, numNormals });
+        appendLine(chunk.m_Lines, line);
+        chunk.m_Faces.push_back(nullptr);
+        return;
+    }
+
+    chunk.m_numPointSeparators += info.pointSeparator ? 1 : 0;
+    chunk.m_numUnsupportedTokens += info.unsupportedToken ? 1 : 0;
+    if (textureCoordSlot) {
+        chunk.m_TextureCoordSlotFaces.push_back({ chunk.m_Faces.size(), line, type, numVertices, numNormals,
+                info.pointSeparator, info.unsupportedToken });
+    }
+    if (0 != info.relative) {
+        chunk.m_RelativeFaces.push_back({ chunk.m_Faces.size(), info.relative });
+    }
+    chunk.m_Faces.push_back(face.release());
+}
+
+// Parses all lines of a chunk, insideCstype is the assumed state at its start
+static void parseChunk(ObjFile::Chunk &chunk, bool insideCstype) {
+    chunk.clear();
+    chunk.m_startsInsideCstype = insideCstype;
+
+    std::vector<char> scratch;
+    const char *it = chunk.m_begin;
+    while (it != chunk.m_end) {
+        const char *bufferEnd = nullptr;
+        const char *line = nextLine(it, chunk.m_end, scratch, bufferEnd);
+
+        // handle cstype section end (http://paulbourke.net/dataformats/obj/)
+        if (insideCstype) {
+            if (*line == 'e') {
+                insideCstype = !isKeyword(line, "end");
+            }
+            continue;
+        }
+
+        switch (*line) {
+        case 'v':
+            parseChunkVertexData(chunk, line, bufferEnd);
+            break;
+
+        case 'p':
+        case 'l':
+        case 'f':
+            parseChunkFace(chunk, line);
+            break;
+
+        case 'u': // material and group changes are applied in order by the merge
+        case 'm':
+        case 'g':
+        case 'o':
+            chunk.m_Commands.push_back({ chunk.m_Faces.size(), chunk.m_Lines.size() });
+            appendLine(chunk.m_Lines, line);
+            break;
+
+        case 'c':
+            insideCstype = isKeyword(line, "cstype");
+            break;
+
+        default:
+            break;
+        }
+    }
+    chunk.m_endsInsideCstype = insideCstype;
+}
+
+void ObjFileParser::parseFileChunked(IOStream *stream, TaskScheduler *scheduler) {
+    const size_t fileSize = stream->FileSize();
+    // files that are already in memory are parsed in place
+    const char *contents = reinterpret_cast<const char *>(stream->GetContents());
+
+    std::vector<char> window;
+    size_t windowSize = ObjWindowSize;
+    size_t filePos = 0; // file offset of the first byte not parsed yet
+    size_t readPos = 0;
+    bool insideCstype = false;
+    while (filePos < fileSize) {
+        const char *begin = nullptr;
+        const char *end = nullptr;
+        if (nullptr != contents) {
+            begin = contents + filePos;
+            end = begin + std::min(windowSize, fileSize - filePos);
+        } else {
+            // the unparsed rest of the previous window is kept at the front
+            const size_t kept = window.size();
+            const size_t toRead = std::min(windowSize, fileSize - readPos);
+            window.resize(kept + toRead);
+            if (stream->Read(window.data() + kept, 1, toRead) != toRead) {
+                throw DeadlyImportError("OBJ: Failed to read file");
+            }
+            readPos += toRead;
+            begin = window.data();
+            end = begin + window.size();
+        }
+
+        const bool last = (filePos + static_cast<size_t>(end - begin) == fileSize);
+        const char *cut = last ? end : findLastLineStart(begin, end);
+        if (cut == begin) {
+            // a single line longer than the window
+            windowSize *= 2;
+            continue;
+        }
+
+        parseWindow(begin, cut, scheduler, insideCstype);
+        filePos += static_cast<size_t>(cut - begin);
+        if (nullptr == contents) {
+            window.erase(window.begin(), window.begin() + (cut - begin));
+        }
+
+        m_progress->UpdateFileRead(static_cast<unsigned int>(filePos), static_cast<unsigned int>(fileSize));
+    }
+}
+
+void ObjFileParser::parseWindow(const char *begin, const char *end, TaskScheduler *scheduler, bool &insideCstype) {
+    const size_t numThreads = (nullptr != scheduler) ? scheduler->GetNumThreads() : 1;
+    const size_t chunkSize = std::max(ObjMinChunkSize, static_cast<size_t>(end - begin) / (numThreads * 4));
+
+    std::vector<const char *> bounds(1, begin);
+    while (bounds.back() != end) {
+        const char *it = bounds.back();
+        bounds.push_back(static_cast<size_t>(end - it) > chunkSize ? findLineStart(begin, it + chunkSize, end) : end);
+    }
+
+    std::vector<ObjFile::Chunk> chunks(bounds.size() - 1);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].m_begin = bounds[i];
+        chunks[i].m_end = bounds[i + 1];
+    }
+
+    // Only the first chunk knows whether it starts inside a cstype section, the others
+    // assume they do not and are parsed again below if that was wrong. Errors are kept
+    // until then, too.
+    const auto parse = [&](unsigned int i) {
+        try {
+            parseChunk(chunks[i], 0 == i ? insideCstype : false);
+        } catch (...) {
+            chunks[i].m_error = std::current_exception();
+        }
+    };
+    if (nullptr != scheduler) {
+        scheduler->ParallelFor(static_cast<unsigned int>(chunks.size()), parse);
+    } else {
+        for (unsigned int i = 0; i < chunks.size(); ++i) {
+            parse(i);
+        }
+    }
+
+    for (ObjFile::Chunk &chunk : chunks) {
+        if (chunk.m_startsInsideCstype != insideCstype) {
+            parseChunk(chunk, insideCstype);
+        } else if (chunk.m_error) {
+            std::rethrow_exception(chunk.m_error);
+        }
+        mergeChunk(chunk);
+        insideCstype = chunk.m_endsInsideCstype;
+        chunk.clear();
+    }
+}
+
+void ObjFileParser::mergeChunk(ObjFile::Chunk &chunk) {
+    const unsigned int numVertices = static_cast<unsigned int>(m_pModel->m_Vertices.size());
+    const unsigned int numTextureCoords = static_cast<unsigned int>(m_pModel->m_TextureCoord.size());
+    const unsigned int numNormals = static_cast<unsigned int>(m_pModel->m_Normals.size());
+
+    m_pModel->m_Vertices.insert(m_pModel->m_Vertices.end(), chunk.m_Vertices.begin(), chunk.m_Vertices.end());
+    m_pModel->m_VertexColors.insert(m_pModel->m_VertexColors.end(), chunk.m_VertexColors.begin(), chunk.m_VertexColors.end());
+    m_pModel->m_TextureCoord.insert(m_pModel->m_TextureCoord.end(), chunk.m_TextureCoord.begin(), chunk.m_TextureCoord.end());
+    m_pModel->m_Normals.insert(m_pModel->m_Normals.end(), chunk.m_Normals.begin(), chunk.m_Normals.end());
+    m_pModel->m_TextureCoordDim = std::max(m_pModel->m_TextureCoordDim, chunk.m_TextureCoordDim);
+
+    // without texture coordinates before the chunk, the faces with an index in their slot are
+    // parsed again below and report their problems themselves
+    const bool reparseTextureCoordSlots = 0 == numTextureCoords;
+    if (reparseTextureCoordSlots) {
+        for (const ObjFile::Chunk::TextureCoordSlotFace &slotFace : chunk.m_TextureCoordSlotFaces) {
+            chunk.m_numPointSeparators -= slotFace.m_pointSeparator ? 1 : 0;
+            chunk.m_numUnsupportedTokens -= slotFace.m_unsupportedToken ? 1 : 0;
+        }
+    }
+
+    if (chunk.m_numPointSeparators > 0) {
+        ASSIMP_LOG_ERROR("Obj: Separator unexpected in point statement (", chunk.m_numPointSeparators, " times)");
+    }
+    if (chunk.m_numUnsupportedTokens > 0) {
+        ASSIMP_LOG_ERROR("OBJ: Not supported token in face description detected (", chunk.m_numUnsupportedTokens, " times)");
+    }
+    if (chunk.m_numEmptyFaces > 0) {
+        ASSIMP_LOG_ERROR("Obj: Ignoring ", chunk.m_numEmptyFaces, " empty faces");
+    }
+
+    std::vector<ObjFile::Chunk::RelativeFace>::const_iterator relative = chunk.m_RelativeFaces.begin();
+    std::vector<ObjFile::Chunk::DeferredFace>::const_iterator deferred = chunk.m_DeferredFaces.begin();
+    std::vector<ObjFile::Chunk::TextureCoordSlotFace>::const_iterator slotFace = chunk.m_TextureCoordSlotFaces.begin();
+    std::vector<ObjFile::Chunk::Command>::const_iterator command = chunk.m_Commands.begin();
+    for (size_t i = 0; i <= chunk.m_Faces.size(); ++i) {
+        for (; command != chunk.m_Commands.end() && command->m_face == i; ++command) {
+            m_DataIt = chunk.m_Lines.begin() + command->m_line;
+            m_DataItEnd = std::find(m_DataIt, chunk.m_Lines.end(), '\0') + 1;
+            bool insideCstype = false;
+            parseLine(insideCstype);
+        }
+        if (i == chunk.m_Faces.size()) {
+            break;
+        }
+
+        ObjFile::Face *face = chunk.m_Faces[i];
+        chunk.m_Faces[i] = nullptr;
+        if (nullptr == face) {
+            ai_assert(deferred != chunk.m_DeferredFaces.end() && deferred->m_face == i);
+            face = parseFace(&chunk.m_Lines[deferred->m_line], deferred->m_type, numVertices + deferred->m_numVertices,
+                    numTextureCoords + deferred->m_numTextureCoords, numNormals + deferred->m_numNormals);
+            ++deferred;
+            if (nullptr == face) {
+                continue;
+            }
+        } else if (reparseTextureCoordSlots && slotFace != chunk.m_TextureCoordSlotFaces.end() && slotFace->m_face == i) {
+            delete face;
+            face = parseFace(slotFace->m_line, slotFace->m_type, numVertices + slotFace->m_numVertices,
+                    0, numNormals + slotFace->m_numNormals);
+            ++slotFace;
+            if (relative != chunk.m_RelativeFaces.end() && relative->m_face == i) {
+                ++relative;
+            }
+            if (nullptr == face) {
+                continue;
+            }
+        } else if (relative != chunk.m_RelativeFaces.end() && relative->m_face == i) {
+            // negative indices were resolved against the chunk only
+            if (relative->m_arrays & ObjFile::Chunk::VertexIndices) {
+                for (unsigned int &index : face->m_vertices)
+                    index += numVertices;
+            }
+            if (relative->m_arrays & ObjFile::Chunk::TextureCoordIndices) {
+                for (unsigned int &index : face->m_texturCoords)
+                    index += numTextureCoords;
+            }
+            if (relative->m_arrays & ObjFile::Chunk::NormalIndices) {
+                for (unsigned int &index : face->m_normals)
+                    index += numNormals;
+            }
+            ++relative;
+        }
+        addFace(face);
+    }
 }
 
 void ObjFileParser::getMaterialDesc() {
@@ -845,13 +1360,6 @@ bool ObjFileParser::needsNewMesh(const std::string &materialName) {
     return newMat;
 }
 
-// -------------------------------------------------------------------
-//  Shows an error in parsing process.
-void ObjFileParser::reportErrorTokenInFace() {
-    m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
-    ASSIMP_LOG_ERROR("OBJ: Not supported token in face description detected");
-}
-
 // -------------------------------------------------------------------
 
 } // Namespace Assimp
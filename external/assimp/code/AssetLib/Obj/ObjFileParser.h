@@ -59,11 +59,15 @@ struct Object;
 struct Material;
 struct Point3;
 struct Point2;
+struct Face;
+struct Chunk;
 } // namespace ObjFile
 
 class ObjFileImporter;
+class IOStream;
 class IOSystem;
 class ProgressHandler;
+class TaskScheduler;
 
 /// \class  ObjFileParser
 /// \brief  Parser for a obj waveform file
@@ -78,6 +82,9 @@ public:
     ObjFileParser();
     /// @brief  Constructor with data array.
     ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::string &modelName, IOSystem *io, ProgressHandler *progress, const std::string &originalObjFileName);
+    /// @brief  Constructor for the chunked parser, splits the file at line boundaries and parses
+    ///         the chunks on the scheduler (serially if it is nullptr) before merging them in order.
+    ObjFileParser(IOStream *stream, const std::string &modelName, IOSystem *io, ProgressHandler *progress, const std::string &originalObjFileName, TaskScheduler *scheduler);
     /// @brief  Destructor
     ~ObjFileParser();
     /// @brief  If you want to load in-core data.
@@ -89,8 +96,18 @@ public:
     ObjFileParser &operator=(const ObjFileParser& ) = delete;
 
 protected:
+    /// Creates the model and its default material
+    void createModel(const std::string &modelName);
     /// Parse the loaded file
     void parseFile(IOStreamBuffer<char> &streamBuffer);
+    /// Parse the line at the current position
+    void parseLine(bool &insideCstype);
+    /// Parse the file in windows of whole lines, see ObjFile::Chunk
+    void parseFileChunked(IOStream *stream, TaskScheduler *scheduler);
+    /// Parse a window of whole lines in parallel and merge it into the model
+    void parseWindow(const char *begin, const char *end, TaskScheduler *scheduler, bool &insideCstype);
+    /// Appends vertex data and faces of a chunk to the model
+    void mergeChunk(ObjFile::Chunk &chunk);
     /// Method to copy the new delimited word in the current line.
     void copyNextWord(char *pBuffer, size_t length);
     /// Method to copy the new line.
@@ -109,6 +126,11 @@ protected:
     void getVector2(std::vector<aiVector2D> &point2d_array);
     /// Stores the following face.
     void getFace(aiPrimitiveType type);
+    /// Parses a face statement, negative indices are resolved against the given element counts
+    ObjFile::Face *parseFace(const char *line, aiPrimitiveType type, unsigned int numVertices,
+            unsigned int numTextureCoords, unsigned int numNormals);
+    /// Assigns a parsed face to the current mesh
+    void addFace(ObjFile::Face *face);
     /// Reads the material description.
     void getMaterialDesc();
     /// Gets a comment.
@@ -133,8 +155,6 @@ protected:
     void createMesh(const std::string &meshName);
     /// Returns true, if a new mesh instance must be created.
     bool needsNewMesh(const std::string &rMaterialName);
-    /// Error report in token
-    void reportErrorTokenInFace();
 
 private:
     // Copy and assignment constructor should be private
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/IOSystem.hpp>
+#include <algorithm>
 #include <memory>
 
 using namespace ::Assimp;
@@ -468,6 +469,168 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Reads a single binary value in native byte order
+static PLY::PropertyInstance::ValueUnion ReadBinaryValue(const char *data, PLY::EDataType eType) {
+    PLY::PropertyInstance::ValueUnion out;
+    out.iUInt = 0;
+    switch (eType) {
+    case EDT_UInt: {
+        uint32_t t;
+        ::memcpy(&t, data, sizeof(t));
+        out.iUInt = t;
+        break;
+    }
+    case EDT_UShort: {
+        uint16_t t;
+        ::memcpy(&t, data, sizeof(t));
+        out.iUInt = t;
+        break;
+    }
+    case EDT_UChar:
+        out.iUInt = static_cast<uint8_t>(*data);
+        break;
+    case EDT_Int: {
+        int32_t t;
+        ::memcpy(&t, data, sizeof(t));
+        out.iInt = t;
+        break;
+    }
+    case EDT_Short: {
+        int16_t t;
+        ::memcpy(&t, data, sizeof(t));
+        out.iInt = t;
+        break;
+    }
+    case EDT_Char:
+        out.iInt = static_cast<int8_t>(*data);
+        break;
+    case EDT_Float:
+        ::memcpy(&out.fFloat, data, sizeof(float));
+        break;
+    case EDT_Double:
+        ::memcpy(&out.fDouble, data, sizeof(double));
+        break;
+    default:
+        break;
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::LoadVertices(const PLY::Element *pcElement, const char *data, unsigned int first, unsigned int count) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != data);
+
+    // byte offset and type of every vertex channel, indexed by the
+    // semantics EST_XCoord ... EST_Alpha. Later properties win, like
+    // in LoadVertex().
+    const unsigned int NumChannels = PLY::EST_Alpha + 1;
+    unsigned int offsets[NumChannels];
+    PLY::EDataType types[NumChannels];
+    std::fill(offsets, offsets + NumChannels, 0xFFFFFFFF);
+    std::fill(types, types + NumChannels, EDT_Char);
+
+    unsigned int stride = 0, cnt = 0;
+    for (const PLY::Property &prop : pcElement->alProperties) {
+        if (prop.Semantic < NumChannels) {
+            ++cnt;
+            offsets[prop.Semantic] = stride;
+            types[prop.Semantic] = prop.eType;
+        }
+        stride += PLY::Property::GetSize(prop.eType);
+    }
+
+    // no valid source for the vertex data
+    if (0 == cnt || 0 == count) {
+        return;
+    }
+
+    auto has = [&](PLY::ESemantic a, PLY::ESemantic b, PLY::ESemantic c) {
+        return 0xFFFFFFFF != offsets[a] || 0xFFFFFFFF != offsets[b] || 0xFFFFFFFF != offsets[c];
+    };
+    const bool haveNormal = has(EST_XNormal, EST_YNormal, EST_ZNormal);
+    const bool haveColor = has(EST_Red, EST_Green, EST_Blue) || 0xFFFFFFFF != offsets[EST_Alpha];
+    const bool haveTextureCoords = 0xFFFFFFFF != offsets[EST_UTextureCoord] || 0xFFFFFFFF != offsets[EST_VTextureCoord];
+
+    //create aiMesh if needed
+    if (nullptr == mGeneratedMesh) {
+        mGeneratedMesh = new aiMesh();
+        mGeneratedMesh->mMaterialIndex = 0;
+    }
+
+    if (nullptr == mGeneratedMesh->mVertices) {
+        mGeneratedMesh->mNumVertices = pcElement->NumOccur;
+        mGeneratedMesh->mVertices = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
+    if (first + count > mGeneratedMesh->mNumVertices) {
+        throw DeadlyImportError("Invalid .ply file: Too many vertices");
+    }
+    if (haveNormal && nullptr == mGeneratedMesh->mNormals) {
+        mGeneratedMesh->mNormals = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
+    if (haveColor && nullptr == mGeneratedMesh->mColors[0]) {
+        mGeneratedMesh->mColors[0] = new aiColor4D[mGeneratedMesh->mNumVertices];
+    }
+    if (haveTextureCoords && nullptr == mGeneratedMesh->mTextureCoords[0]) {
+        mGeneratedMesh->mNumUVComponents[0] = 2;
+        mGeneratedMesh->mTextureCoords[0] = new aiVector3D[mGeneratedMesh->mNumVertices];
+    }
+
+    // decode one channel of all records into a strided output array
+    auto readReal = [&](PLY::ESemantic semantic, ai_real *out, size_t outStride) {
+        if (0xFFFFFFFF == offsets[semantic]) {
+            return;
+        }
+        const char *p = data + offsets[semantic];
+        const PLY::EDataType eType = types[semantic];
+        for (unsigned int i = 0; i < count; ++i, p += stride, out += outStride) {
+            *out = PLY::PropertyInstance::ConvertTo<ai_real>(ReadBinaryValue(p, eType), eType);
+        }
+    };
+    auto readColor = [&](PLY::ESemantic semantic, ai_real *out) {
+        if (0xFFFFFFFF == offsets[semantic]) {
+            return;
+        }
+        const char *p = data + offsets[semantic];
+        const PLY::EDataType eType = types[semantic];
+        for (unsigned int i = 0; i < count; ++i, p += stride, out += 4) {
+            *out = NormalizeColorValue(ReadBinaryValue(p, eType), eType);
+        }
+    };
+
+    aiVector3D *vertices = mGeneratedMesh->mVertices + first;
+    std::fill(vertices, vertices + count, aiVector3D());
+    readReal(EST_XCoord, &vertices->x, 3);
+    readReal(EST_YCoord, &vertices->y, 3);
+    readReal(EST_ZCoord, &vertices->z, 3);
+
+    if (haveNormal) {
+        aiVector3D *normals = mGeneratedMesh->mNormals + first;
+        std::fill(normals, normals + count, aiVector3D());
+        readReal(EST_XNormal, &normals->x, 3);
+        readReal(EST_YNormal, &normals->y, 3);
+        readReal(EST_ZNormal, &normals->z, 3);
+    }
+
+    if (haveColor) {
+        // assume 1.0 for the alpha channel if it is not set
+        aiColor4D *colors = mGeneratedMesh->mColors[0] + first;
+        std::fill(colors, colors + count, aiColor4D(0, 0, 0, 1));
+        readColor(EST_Red, &colors->r);
+        readColor(EST_Green, &colors->g);
+        readColor(EST_Blue, &colors->b);
+        readColor(EST_Alpha, &colors->a);
+    }
+
+    if (haveTextureCoords) {
+        aiVector3D *uvs = mGeneratedMesh->mTextureCoords[0] + first;
+        std::fill(uvs, uvs + count, aiVector3D());
+        readReal(EST_UTextureCoord, &uvs->x, 3);
+        readReal(EST_VTextureCoord, &uvs->y, 3);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Convert a color component to [0...1]
 ai_real PLYImporter::NormalizeColorValue(PLY::PropertyInstance::ValueUnion val, PLY::EDataType eType) {
@@ -79,6 +79,13 @@ public:
     */
     void LoadVertex(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos);
 
+    // -------------------------------------------------------------------
+    /** Extract a block of vertices from binary records with a fixed
+     *  layout, see PLY::Element::GetStride(). The records must be in
+     *  native byte order.
+    */
+    void LoadVertices(const PLY::Element *pcElement, const char *data, unsigned int first, unsigned int count);
+
     // -------------------------------------------------------------------
     /** Extract a face from the DOM
     */
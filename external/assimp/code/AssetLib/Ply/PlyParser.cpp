@@ -48,6 +48,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ByteSwapper.h>
 #include <assimp/fast_atof.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define AI_PLY_USE_SSE2
+#endif
 
 using namespace Assimp;
 
@@ -225,6 +231,32 @@ bool PLY::Property::ParseProperty(std::vector<char> &buffer, PLY::Property *pOut
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int PLY::Property::GetSize(PLY::EDataType eType) {
+    switch (eType) {
+    case EDT_Char:
+    case EDT_UChar:
+        return 1;
+
+    case EDT_UShort:
+    case EDT_Short:
+        return 2;
+
+    case EDT_UInt:
+    case EDT_Int:
+    case EDT_Float:
+        return 4;
+
+    case EDT_Double:
+        return 8;
+
+    case EDT_INVALID:
+    default:
+        break;
+    }
+    return 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 PLY::EElementSemantic PLY::Element::ParseSemantic(std::vector<char> &buffer) {
     ai_assert(!buffer.empty());
@@ -320,6 +352,19 @@ bool PLY::Element::ParseElement(IOStreamBuffer<char> &streamBuffer, std::vector<
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+unsigned int PLY::Element::GetStride() const {
+    unsigned int stride = 0;
+    for (const PLY::Property &prop : alProperties) {
+        const unsigned int size = PLY::Property::GetSize(prop.eType);
+        if (prop.bIsList || 0 == size) {
+            return 0;
+        }
+        stride += size;
+    }
+    return stride;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::DOM::SkipSpaces(std::vector<char> &buffer) {
     const char *pCur = buffer.empty() ? nullptr : (char *)&buffer[0];
@@ -472,7 +517,10 @@ bool PLY::DOM::ParseElementInstanceListsBinary(IOStreamBuffer<char> &streamBuffe
 
     // parse all element instances
     for (; i != alElements.end(); ++i, ++a) {
-        if ((*i).eSemantic == EEST_Vertex || (*i).eSemantic == EEST_Face || (*i).eSemantic == EEST_TriStrip) {
+        if ((*i).eSemantic == EEST_Vertex && 0 != (*i).GetStride()) {
+            // point clouds and most meshes, decoded straight into the output arrays
+            PLY::ElementInstanceList::ParseFixedInstanceListBinary(streamBuffer, buffer, pCur, bufferSize, &(*i), loader, p_bBE);
+        } else if ((*i).eSemantic == EEST_Vertex || (*i).eSemantic == EEST_Face || (*i).eSemantic == EEST_TriStrip) {
             PLY::ElementInstanceList::ParseInstanceListBinary(streamBuffer, buffer, pCur, bufferSize, &(*i), nullptr, loader, p_bBE);
         } else {
             (*a).alInstances.resize((*i).NumOccur);
@@ -627,6 +675,122 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Reverses the byte order of count values of the given size in place
+static void SwapValues(char *data, size_t count, unsigned int size) {
+    size_t i = 0;
+#ifdef AI_PLY_USE_SSE2
+    // swap the bytes of each 16 bit word, then the words of each value
+    const size_t vectorCount = count * size / 16;
+    for (size_t v = 0; v < vectorCount; ++v) {
+        __m128i *p = reinterpret_cast<__m128i *>(data + v * 16);
+        __m128i x = _mm_loadu_si128(p);
+        x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+        if (4 == size) {
+            x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+            x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+        } else if (8 == size) {
+            x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+            x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+        _mm_storeu_si128(p, x);
+    }
+    i = vectorCount * 16 / size;
+#endif
+    for (; i < count; ++i) {
+        char *p = data + i * size;
+        switch (size) {
+        case 2:
+            ByteSwap::Swap2(p);
+            break;
+        case 4:
+            ByteSwap::Swap4(p);
+            break;
+        case 8:
+            ByteSwap::Swap8(p);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Converts count big-endian records of a fixed layout element to native byte order
+static void SwapRecords(char *data, unsigned int count, unsigned int stride, const PLY::Element *pcElement) {
+    // records made of a single value size (e.g. all floats) are swapped as one array
+    unsigned int size = 0;
+    for (const PLY::Property &prop : pcElement->alProperties) {
+        const unsigned int propSize = PLY::Property::GetSize(prop.eType);
+        if (0 == size) {
+            size = propSize;
+        } else if (size != propSize) {
+            size = 0;
+            break;
+        }
+    }
+    if (1 == size) {
+        return;
+    }
+    if (0 != size) {
+        SwapValues(data, static_cast<size_t>(count) * stride / size, size);
+        return;
+    }
+
+    for (unsigned int i = 0; i < count; ++i, data += stride) {
+        char *p = data;
+        for (const PLY::Property &prop : pcElement->alProperties) {
+            const unsigned int propSize = PLY::Property::GetSize(prop.eType);
+            SwapValues(p, 1, propSize);
+            p += propSize;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLY::ElementInstanceList::ParseFixedInstanceListBinary(
+        IOStreamBuffer<char> &streamBuffer,
+        std::vector<char> &buffer,
+        const char *&pCur,
+        unsigned int &bufferSize,
+        const PLY::Element *pcElement,
+        PLYImporter *loader,
+        bool p_bBE) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != loader);
+
+    const unsigned int stride = pcElement->GetStride();
+    ai_assert(0 != stride);
+
+    unsigned int i = 0;
+    while (i < pcElement->NumOccur) {
+        // read the next file block if not even one record is left
+        while (bufferSize < stride) {
+            std::vector<char> nbuffer;
+            if (!streamBuffer.getNextBlock(nbuffer)) {
+                throw DeadlyImportError("Invalid .ply file: File corrupted");
+            }
+            buffer = std::vector<char>(buffer.end() - bufferSize, buffer.end());
+            buffer.insert(buffer.end(), nbuffer.begin(), nbuffer.end());
+            bufferSize = static_cast<unsigned int>(buffer.size());
+            pCur = (char *)&buffer[0];
+        }
+
+        // all complete records of the current block in one go
+        const unsigned int count = std::min(pcElement->NumOccur - i, bufferSize / stride);
+        char *data = &buffer[pCur - &buffer[0]];
+        if (p_bBE) {
+            SwapRecords(data, count, stride, pcElement);
+        }
+        loader->LoadVertices(pcElement, data, i, count);
+
+        pCur += count * stride;
+        bufferSize -= count * stride;
+        i += count;
+    }
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::ElementInstance::ParseInstance(const char *&pCur,
         const PLY::Element *pcElement,
@@ -245,6 +245,10 @@ public:
     // -------------------------------------------------------------------
     //! Parse a semantic from a string
     static ESemantic ParseSemantic(std::vector<char> &buffer);
+
+    // -------------------------------------------------------------------
+    //! Size of a binary value of the given type in bytes
+    static unsigned int GetSize(EDataType eType);
 };
 
 // ---------------------------------------------------------------------------------
@@ -286,6 +290,11 @@ public:
     // -------------------------------------------------------------------
     //! Parse a semantic from a string
     static EElementSemantic ParseSemantic(std::vector<char> &buffer);
+
+    // -------------------------------------------------------------------
+    //! Size of one binary instance in bytes. Returns 0 if the element
+    //! contains list properties and thus has no fixed layout.
+    unsigned int GetStride() const;
 };
 
 // ---------------------------------------------------------------------------------
@@ -403,6 +412,13 @@ public:
     //! Parse a binary element instance list
     static bool ParseInstanceListBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
         const char* &pCur, unsigned int &bufferSize, const Element* pcElement, ElementInstanceList* p_pcOut, PLYImporter* loader, bool p_bBE);
+
+    // -------------------------------------------------------------------
+    //! Parse a binary vertex list with a fixed record layout. Whole
+    //! blocks of records are handed to the loader without building
+    //! element instances.
+    static bool ParseFixedInstanceListBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char* &pCur, unsigned int &bufferSize, const Element* pcElement, PLYImporter* loader, bool p_bBE);
 };
 // ---------------------------------------------------------------------------------
 /** \brief Class to represent the document object model of an ASCII or binary
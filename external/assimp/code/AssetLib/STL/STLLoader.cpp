@@ -44,12 +44,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_STL_IMPORTER
 
 #include "STLLoader.h"
+#include "Common/Importer.h"
+#include "Common/MeshIndexBuffer.h"
+#include "Common/TaskScheduler.h"
 #include <assimp/ParsingUtils.h>
 #include <assimp/fast_atof.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <algorithm>
+#include <functional>
 #include <memory>
 
 using namespace Assimp;
@@ -121,6 +127,113 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
     }
     return isASCII;
 }
+
+// Layout of a binary facet: normal, three vertices, attribute word
+const size_t FacetSize = 50;
+const size_t FacetVertexOffset = 12;
+const size_t FacetAttributeOffset = 48;
+
+// Binary facets are decoded and welded in chunks of this many facets
+const unsigned int FacetsPerChunk = 1u << 16;
+
+// Corners are welded in 2^WeldShardBits independent hash tables
+const unsigned int WeldShardBits = 8;
+const unsigned int NumWeldShards = 1u << WeldShardBits;
+
+// Marks corners which are a duplicate of an earlier one
+const unsigned int DuplicateCorner = 0x80000000u;
+
+// ------------------------------------------------------------------------------------------------
+void ForEachChunk(TaskScheduler *scheduler, unsigned int numChunks, const std::function<void(unsigned int)> &func) {
+    if (nullptr != scheduler) {
+        scheduler->ParallelFor(numChunks, func);
+        return;
+    }
+    for (unsigned int i = 0; i < numChunks; ++i) {
+        func(i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+inline aiVector3D ReadFacetVector(const unsigned char *p) {
+    typedef aiVector3t<float> aiVector3F;
+    aiVector3F theVec3F;
+    ::memcpy(&theVec3F, p, sizeof(aiVector3F));
+    return aiVector3D(theVec3F.x, theVec3F.y, theVec3F.z);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline uint16_t ReadFacetAttribute(const unsigned char *facet) {
+    uint16_t color;
+    ::memcpy(&color, facet + FacetAttributeOffset, sizeof(uint16_t));
+    return color;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline bool HasFacetColor(uint16_t color) {
+    return 0 != (color & (1 << 15));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Decodes the 15 bit color of a facet
+aiColor4D DecodeFacetColor(uint16_t color, bool bIsMaterialise) {
+    aiColor4D clr;
+    clr.a = 1.0;
+    const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
+    if (bIsMaterialise) // this is reversed
+    {
+        clr.r = (color & 0x31u) * invVal;
+        clr.g = ((color & (0x31u << 5)) >> 5u) * invVal;
+        clr.b = ((color & (0x31u << 10)) >> 10u) * invVal;
+    } else {
+        clr.b = (color & 0x31u) * invVal;
+        clr.g = ((color & (0x31u << 5)) >> 5u) * invVal;
+        clr.r = ((color & (0x31u << 10)) >> 10u) * invVal;
+    }
+    return clr;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Keeps only the bits DecodeFacetColor() reads, 0 for facets without color
+inline uint32_t FacetColorKey(uint16_t color) {
+    if (!HasFacetColor(color)) {
+        return 0;
+    }
+    return (color & (0x31u | (0x31u << 5) | (0x31u << 10))) | (1 << 15);
+}
+
+// ------------------------------------------------------------------------------------------------
+// The raw data which makes a facet corner unique: position, normal and color
+struct CornerKey {
+    uint32_t words[7];
+
+    CornerKey(const unsigned char *facets, unsigned int corner, bool withNormal) {
+        const unsigned char *facet = facets + (corner / 3) * FacetSize;
+        ::memcpy(words, facet + FacetVertexOffset + (corner % 3) * 12, 12);
+        if (withNormal) {
+            ::memcpy(words + 3, facet, 12);
+        } else {
+            words[3] = words[4] = words[5] = 0;
+        }
+        words[6] = FacetColorKey(ReadFacetAttribute(facet));
+    }
+
+    bool operator==(const CornerKey &other) const {
+        return 0 == ::memcmp(words, other.words, sizeof(words));
+    }
+
+    uint32_t Hash() const {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (uint32_t w : words) {
+            h = (h ^ w) * 0x100000001b3ull;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return static_cast<uint32_t>(h);
+    }
+};
+
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -128,7 +241,10 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
 STLImporter::STLImporter() :
         mBuffer(),
         mFileSize(0),
-        mScene() {
+        mScene(),
+        mScheduler(nullptr),
+        mWeldVertices(false),
+        mSkipNormals(false) {
    // empty
 }
 
@@ -150,15 +266,18 @@ const aiImporterDesc *STLImporter::GetInfo() const {
     return &desc;
 }
 
-void addFacesToMesh(aiMesh *pMesh) {
-    pMesh->mFaces = new aiFace[pMesh->mNumFaces];
-    for (unsigned int i = 0, p = 0; i < pMesh->mNumFaces; ++i) {
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties
+void STLImporter::SetupProperties(const Importer *pImp) {
+    mWeldVertices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, false);
+    mSkipNormals = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_SKIP_NORMALS, false);
+    mScheduler = pImp->Pimpl()->mTaskScheduler;
+}
 
-        aiFace &face = pMesh->mFaces[i];
-        face.mIndices = new unsigned int[face.mNumIndices = 3];
-        for (unsigned int o = 0; o < 3; ++o, ++p) {
-            face.mIndices[o] = p;
-        }
+void addFacesToMesh(aiMesh *pMesh) {
+    unsigned int *indices = AllocateIndexBuffer(pMesh, pMesh->mNumFaces, 3);
+    for (unsigned int p = 0; p < pMesh->mNumIndices; ++p) {
+        indices[p] = p;
     }
 }
 
@@ -174,13 +293,19 @@ void STLImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 
     mFileSize = (unsigned int)file->FileSize();
 
-    // allocate storage and copy the contents of the file to a memory buffer
+    // binary files are parsed in place if the stream already holds them in memory,
+    // otherwise allocate storage and copy the contents of the file to a memory buffer
     // (terminate it with zero)
     std::vector<char> buffer2;
-    TextFileToBuffer(file.get(), buffer2);
+    const char *contents = reinterpret_cast<const char *>(file->GetContents());
+    if (contents != nullptr && IsBinarySTL(contents, mFileSize)) {
+        mBuffer = contents;
+    } else {
+        TextFileToBuffer(file.get(), buffer2);
+        mBuffer = &buffer2[0];
+    }
 
     mScene = pScene;
-    mBuffer = &buffer2[0];
 
     // the default vertex color is light gray.
     mClrColorDefault.r = mClrColorDefault.g = mClrColorDefault.b = mClrColorDefault.a = (ai_real)0.6;
@@ -447,93 +572,86 @@ bool STLImporter::LoadBinaryFile() {
         throw DeadlyImportError("STL: file is empty. There are no facets defined");
     }
 
-    pMesh->mNumVertices = pMesh->mNumFaces * 3;
-
-    aiVector3D *vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
-    aiVector3D *vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-
-    typedef aiVector3t<float> aiVector3F;
-    aiVector3F *theVec;
-    aiVector3F theVec3F;
+    const unsigned char *facets = sz;
+    const unsigned int numChunks = (pMesh->mNumFaces + FacetsPerChunk - 1) / FacetsPerChunk;
 
-    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
-        // NOTE: Blender sometimes writes empty normals ... this is not
-        // our fault ... the RemoveInvalidData helper step should fix that
-
-        // There's one normal for the face in the STL; use it three times
-        // for vertex normals
-        theVec = (aiVector3F *)sz;
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vn->x = theVec3F.x;
-        vn->y = theVec3F.y;
-        vn->z = theVec3F.z;
-        *(vn + 1) = *vn;
-        *(vn + 2) = *vn;
-        ++theVec;
-        vn += 3;
-
-        // vertex 1
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 2
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 3
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        sz = (const unsigned char *)theVec;
-
-        uint16_t color = *((uint16_t *)sz);
-        sz += 2;
-
-        if (color & (1 << 15)) {
-            // seems we need to take the color
-            if (!pMesh->mColors[0]) {
-                pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-                for (unsigned int j = 0; j < pMesh->mNumVertices; ++j) {
-                    *pMesh->mColors[0]++ = mClrColorDefault;
+    // colors are only stored if at least one facet specifies one
+    std::vector<unsigned char> chunkHasColors(numChunks, 0);
+    const auto hasColors = [&]() {
+        if (std::find(chunkHasColors.begin(), chunkHasColors.end(), 1) == chunkHasColors.end()) {
+            return false;
+        }
+        ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
+        return true;
+    };
+
+    if (mWeldVertices) {
+        // the vertex count is only known after welding, find the colors up front
+        ForEachChunk(mScheduler, numChunks, [&](unsigned int chunk) {
+            const unsigned int end = std::min(pMesh->mNumFaces, (chunk + 1) * FacetsPerChunk);
+            for (unsigned int i = chunk * FacetsPerChunk; i < end; ++i) {
+                if (HasFacetColor(ReadFacetAttribute(facets + i * FacetSize))) {
+                    chunkHasColors[chunk] = 1;
+                    break;
+                }
+            }
+        });
+        WeldBinaryFacets(pMesh, facets, bIsMaterialise, hasColors());
+    } else {
+        pMesh->mNumVertices = pMesh->mNumFaces * 3;
+        pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
+        if (!mSkipNormals) {
+            pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
+        }
+        unsigned int *const indices = AllocateIndexBuffer(pMesh, pMesh->mNumFaces, 3);
+
+        aiVector3D *const vertices = pMesh->mVertices;
+        aiVector3D *const normals = pMesh->mNormals;
+        ForEachChunk(mScheduler, numChunks, [&, vertices, normals, indices](unsigned int chunk) {
+            const unsigned int begin = chunk * FacetsPerChunk;
+            const unsigned int end = std::min(pMesh->mNumFaces, begin + FacetsPerChunk);
+            bool bChunkHasColors = false;
+            for (unsigned int i = begin; i < end; ++i) {
+                const unsigned char *facet = facets + i * FacetSize;
+
+                // NOTE: Blender sometimes writes empty normals ... this is not
+                // our fault ... the RemoveInvalidData helper step should fix that
+
+                // There's one normal for the face in the STL; use it three times
+                // for vertex normals
+                if (normals) {
+                    aiVector3D *vn = normals + i * 3;
+                    vn[0] = vn[1] = vn[2] = ReadFacetVector(facet);
                 }
-                pMesh->mColors[0] -= pMesh->mNumVertices;
 
-                ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
+                aiVector3D *vp = vertices + i * 3;
+                vp[0] = ReadFacetVector(facet + FacetVertexOffset);
+                vp[1] = ReadFacetVector(facet + FacetVertexOffset + 12);
+                vp[2] = ReadFacetVector(facet + FacetVertexOffset + 24);
+
+                bChunkHasColors |= HasFacetColor(ReadFacetAttribute(facet));
             }
-            aiColor4D *clr = &pMesh->mColors[0][i * 3];
-            clr->a = 1.0;
-            const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
-            if (bIsMaterialise) // this is reversed
-            {
-                clr->r = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->b = ((color & (0x31u << 10)) >> 10u) * invVal;
-            } else {
-                clr->b = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->r = ((color & (0x31u << 10)) >> 10u) * invVal;
+            chunkHasColors[chunk] = bChunkHasColors;
+
+            for (unsigned int c = begin * 3; c < end * 3; ++c) {
+                indices[c] = c;
             }
-            // assign the color to all vertices of the face
-            *(clr + 1) = *clr;
-            *(clr + 2) = *clr;
+        });
+
+        if (hasColors()) {
+            pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+            ForEachChunk(mScheduler, numChunks, [&](unsigned int chunk) {
+                const unsigned int end = std::min(pMesh->mNumFaces, (chunk + 1) * FacetsPerChunk);
+                for (unsigned int i = chunk * FacetsPerChunk; i < end; ++i) {
+                    // assign the color to all vertices of the face
+                    const uint16_t color = ReadFacetAttribute(facets + i * FacetSize);
+                    aiColor4D *clr = pMesh->mColors[0] + i * 3;
+                    clr[0] = clr[1] = clr[2] = HasFacetColor(color) ? DecodeFacetColor(color, bIsMaterialise) : mClrColorDefault;
+                }
+            });
         }
     }
 
-    // now copy faces
-    addFacesToMesh(pMesh);
-
     aiNode *root = mScene->mRootNode;
 
     // allocate one node
@@ -558,6 +676,145 @@ bool STLImporter::LoadBinaryFile() {
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Weld the facet corners of a binary file. Corners are sorted into shards by their hash, each
+// shard maps its corners to the first identical one with a hash table of its own. Vertices are
+// numbered by first occurrence, so the result does not depend on the number of threads.
+void STLImporter::WeldBinaryFacets(aiMesh *pMesh, const unsigned char *facets, bool bIsMaterialise, bool bHasColors) {
+    const bool withNormal = !mSkipNormals;
+    const unsigned int numCorners = pMesh->mNumFaces * 3;
+    const unsigned int numChunks = (pMesh->mNumFaces + FacetsPerChunk - 1) / FacetsPerChunk;
+    const auto chunkCorners = [&](unsigned int chunk, unsigned int &begin, unsigned int &end) {
+        begin = chunk * FacetsPerChunk * 3;
+        end = std::min(pMesh->mNumFaces, (chunk + 1) * FacetsPerChunk) * 3;
+    };
+
+    // bucket the corners by shard, keeping them in file order within each shard
+    std::vector<unsigned int> offsets(numChunks * NumWeldShards, 0);
+    ForEachChunk(mScheduler, numChunks, [&](unsigned int chunk) {
+        unsigned int begin, end;
+        chunkCorners(chunk, begin, end);
+        unsigned int *counts = &offsets[chunk * NumWeldShards];
+        for (unsigned int c = begin; c < end; ++c) {
+            ++counts[CornerKey(facets, c, withNormal).Hash() >> (32 - WeldShardBits)];
+        }
+    });
+
+    std::vector<unsigned int> shardBegin(NumWeldShards + 1, 0);
+    unsigned int total = 0;
+    for (unsigned int shard = 0; shard < NumWeldShards; ++shard) {
+        shardBegin[shard] = total;
+        for (unsigned int chunk = 0; chunk < numChunks; ++chunk) {
+            const unsigned int count = offsets[chunk * NumWeldShards + shard];
+            offsets[chunk * NumWeldShards + shard] = total;
+            total += count;
+        }
+    }
+    shardBegin[NumWeldShards] = total;
+
+    std::vector<unsigned int> order(numCorners);
+    ForEachChunk(mScheduler, numChunks, [&](unsigned int chunk) {
+        unsigned int begin, end;
+        chunkCorners(chunk, begin, end);
+        unsigned int *next = &offsets[chunk * NumWeldShards];
+        for (unsigned int c = begin; c < end; ++c) {
+            order[next[CornerKey(facets, c, withNormal).Hash() >> (32 - WeldShardBits)]++] = c;
+        }
+    });
+
+    // map every corner to itself or, flagged as duplicate, to its first occurrence
+    std::vector<unsigned int> remap(numCorners);
+    ForEachChunk(mScheduler, NumWeldShards, [&](unsigned int shard) {
+        const unsigned int count = shardBegin[shard + 1] - shardBegin[shard];
+        unsigned int size = 16;
+        while (size < count * 2) {
+            size *= 2;
+        }
+        const unsigned int mask = size - 1;
+        std::vector<unsigned int> table(size, ~0u);
+
+        for (unsigned int n = shardBegin[shard]; n < shardBegin[shard + 1]; ++n) {
+            const unsigned int c = order[n];
+            const CornerKey key(facets, c, withNormal);
+            unsigned int slot = key.Hash() & mask;
+            while (true) {
+                const unsigned int other = table[slot];
+                if (~0u == other) {
+                    table[slot] = c;
+                    remap[c] = c;
+                    break;
+                }
+                if (CornerKey(facets, other, withNormal) == key) {
+                    remap[c] = other | DuplicateCorner;
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+        }
+    });
+    std::vector<unsigned int>().swap(order);
+
+    // number the unique corners in file order
+    std::vector<unsigned int> chunkBase(numChunks + 1, 0);
+    ForEachChunk(mScheduler, numChunks, [&](unsigned int chunk) {
+        unsigned int begin, end;
+        chunkCorners(chunk, begin, end);
+        unsigned int count = 0;
+        for (unsigned int c = begin; c < end; ++c) {
+            count += (remap[c] == c);
+        }
+        chunkBase[chunk + 1] = count;
+    });
+    for (unsigned int chunk = 0; chunk < numChunks; ++chunk) {
+        chunkBase[chunk + 1] += chunkBase[chunk];
+    }
+
+    pMesh->mNumVertices = chunkBase[numChunks];
+    pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
+    if (withNormal) {
+        pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
+    }
+    if (bHasColors) {
+        pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+    }
+
+    ForEachChunk(mScheduler, numChunks, [&](unsigned int chunk) {
+        unsigned int begin, end;
+        chunkCorners(chunk, begin, end);
+        unsigned int index = chunkBase[chunk];
+        for (unsigned int c = begin; c < end; ++c) {
+            if (remap[c] != c) {
+                continue;
+            }
+            const unsigned char *facet = facets + (c / 3) * FacetSize;
+            pMesh->mVertices[index] = ReadFacetVector(facet + FacetVertexOffset + (c % 3) * 12);
+            if (withNormal) {
+                pMesh->mNormals[index] = ReadFacetVector(facet);
+            }
+            if (bHasColors) {
+                const uint16_t color = ReadFacetAttribute(facet);
+                pMesh->mColors[0][index] = HasFacetColor(color) ? DecodeFacetColor(color, bIsMaterialise) : mClrColorDefault;
+            }
+            remap[c] = index++;
+        }
+    });
+
+    // duplicates point to a unique corner, which holds its final index by now
+    unsigned int *const indices = AllocateIndexBuffer(pMesh, pMesh->mNumFaces, 3);
+    ForEachChunk(mScheduler, numChunks, [&](unsigned int chunk) {
+        unsigned int begin, end;
+        chunkCorners(chunk, begin, end);
+        for (unsigned int c = begin; c < end; ++c) {
+            if (remap[c] & DuplicateCorner) {
+                remap[c] = remap[remap[c] & ~DuplicateCorner];
+            }
+            indices[c] = remap[c];
+        }
+    });
+
+    ASSIMP_LOG_INFO("STL: Welded ", numCorners, " facet corners into ", pMesh->mNumVertices, " vertices");
+}
+
 void STLImporter::pushMeshesToNode(std::vector<unsigned int> &meshIndices, aiNode *node) {
     ai_assert(nullptr != node);
     if (meshIndices.empty()) {
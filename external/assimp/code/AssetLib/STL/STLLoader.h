@@ -50,9 +50,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Forward declarations
 struct aiNode;
+struct aiMesh;
 
 namespace Assimp {
 
+class TaskScheduler;
+
 // ---------------------------------------------------------------------------
 /**
  * @brief   Importer class for the sterolithography STL file format.
@@ -75,6 +78,13 @@ public:
      */
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const override;
 
+    /**
+     * @brief   Called prior to ReadFile().
+     *  The function is a request to the importer to update its configuration
+     *  basing on the Importer's configuration property list.
+     */
+    void SetupProperties(const Importer* pImp) override;
+
 protected:
 
     /**
@@ -101,6 +111,12 @@ protected:
      */
     void LoadASCIIFile( aiNode *root );
 
+    /**
+     * @brief   Welds the corners of all facets of a binary .stl file into
+     *  indexed vertices and faces
+     */
+    void WeldBinaryFacets( aiMesh *pMesh, const unsigned char *facets, bool bIsMaterialise, bool bHasColors );
+
     void pushMeshesToNode( std::vector<unsigned int> &meshIndices, aiNode *node );
 
 protected:
@@ -116,6 +132,15 @@ protected:
 
     /** Default vertex color */
     aiColor4D mClrColorDefault;
+
+    /** Thread pool for binary files, may be nullptr */
+    TaskScheduler* mScheduler;
+
+    /** Configuration option: weld identical vertices of binary files */
+    bool mWeldVertices;
+
+    /** Configuration option: skip the facet normals of binary files */
+    bool mSkipNormals;
 };
 
 } // end of namespace Assimp
@@ -495,6 +495,10 @@ public:
 
     bool LoadFromStream(IOStream &stream, size_t length = 0, size_t baseOffset = 0);
 
+    /// Same as LoadFromStream(), but if the stream holds the file in memory (IOStream::GetContents())
+    /// the buffer refers to those bytes instead of copying them and keeps the stream alive.
+    bool LoadFromSharedStream(const shared_ptr<IOStream> &stream, size_t length = 0, size_t baseOffset = 0);
+
     /// \fn void EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t* pDecodedData, const size_t pDecodedData_Length, const std::string& pID)
     /// Mark region of "bufferView" as encoded. When data is request from such region then "bufferView" use decoded data.
     /// \param [in] pOffset - offset from begin of "bufferView" to encoded region, in bytes.
@@ -602,6 +606,9 @@ struct Accessor : public Object {
             return GetValue<unsigned int>(i);
         }
 
+        //! Accesses the first count values as unsigned ints at once
+        void GetUInts(unsigned int *out, size_t count);
+
         inline bool IsValid() const {
             return data != nullptr;
         }
@@ -867,6 +874,10 @@ struct Mesh : public Object {
         // extension: FB_ngon_encoding
         bool ngonEncoded;
 
+        // extension: KHR_draco_mesh_compression, pending until Mesh::DecodeDraco()
+        Ref<BufferView> dracoBufferView;
+        std::vector<std::pair<Ref<Accessor>, uint32_t>> dracoAttributes; //!< accessor and Draco attribute id
+
         Primitive(): ngonEncoded(false) {}
     };
 
@@ -881,6 +892,11 @@ struct Mesh : public Object {
     /// \param [in] pJSON_Object - reference to pJSON-object from which data are read.
     /// \param [out] pAsset_Root - reference to root asset where data will be stored.
     void Read(Value &pJSON_Object, Asset &pAsset_Root);
+
+    /// Decode the Draco compressed data of a primitive, if it has any, and redirect its accessors
+    /// to the decoded data. Primitives which do not share accessors may be decoded concurrently.
+    /// \param [in] pPrimitive - index of the primitive.
+    void DecodeDraco(unsigned int pPrimitive);
 };
 
 struct Node : public Object {
@@ -157,6 +157,17 @@ inline void CopyData(size_t count, const uint8_t *src, size_t src_stride,
     }
 }
 
+// Copies count elements of Size bytes, the element size is known at compile time so the
+// copies are plain loads and stores instead of memcpy calls
+template <size_t Size>
+inline void CopyElements(size_t count, const uint8_t *src, size_t src_stride, uint8_t *dst, size_t dst_stride) {
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(dst, src, Size);
+        src += src_stride;
+        dst += dst_stride;
+    }
+}
+
 void SetVector(vec4 &v, const float (&in)[4]) {
     v[0] = in[0];
     v[1] = in[1];
@@ -279,6 +290,7 @@ inline void SetDecodedIndexBuffer_Draco(const draco::Mesh &dracoMesh, Mesh::Prim
     // Usually uint32_t but shouldn't assume
     if (sizeof(dracoMesh.face(draco::FaceIndex(0))[0]) == componentBytes) {
         memcpy(decodedIndexBuffer->GetPointer(), &dracoMesh.face(draco::FaceIndex(0))[0], decodedIndexBuffer->byteLength);
+        prim.indices->decodedBuffer.swap(decodedIndexBuffer);
         return;
     }
 
@@ -629,6 +641,24 @@ inline bool Buffer::LoadFromStream(IOStream &stream, size_t length, size_t baseO
     return true;
 }
 
+inline bool Buffer::LoadFromSharedStream(const shared_ptr<IOStream> &stream, size_t length, size_t baseOffset) {
+    const uint8_t *contents = stream->GetContents();
+    if (nullptr == contents) {
+        return LoadFromStream(*stream, length, baseOffset);
+    }
+
+    const size_t fileSize = stream->FileSize();
+    byteLength = length ? length : fileSize;
+    if (baseOffset > fileSize || byteLength > fileSize - baseOffset) {
+        throw DeadlyImportError("GLTF: Invalid byteLength exceeds size of actual data.");
+    }
+
+    // Aliases the stream, so the data lives as long as the buffer. Importing only reads
+    // buffers, and memory mapped streams are copy-on-write in case anything does write.
+    mData = shared_ptr<uint8_t>(stream, const_cast<uint8_t *>(contents) + baseOffset);
+    return true;
+}
+
 inline void Buffer::EncodedRegion_Mark(const size_t pOffset, const size_t pEncodedData_Length, uint8_t *pDecodedData, const size_t pDecodedData_Length, const std::string &pID) {
     // Check pointer to data
     if (pDecodedData == nullptr) throw DeadlyImportError("GLTF: for marking encoded region pointer to decoded data must be provided.");
@@ -987,10 +1017,29 @@ void Accessor::ExtractData(T *&outData) {
     outData = new T[count];
     if (stride == elemSize && targetElemSize == elemSize) {
         memcpy(outData, data, totalSize);
-    } else {
+        return;
+    }
+
+    // interleaved or narrower than T, copy with a fixed element size for the common cases
+    uint8_t *out = reinterpret_cast<uint8_t *>(outData);
+    switch (elemSize) {
+    case 4:
+        CopyElements<4>(count, data, stride, out, targetElemSize);
+        break;
+    case 8:
+        CopyElements<8>(count, data, stride, out, targetElemSize);
+        break;
+    case 12:
+        CopyElements<12>(count, data, stride, out, targetElemSize);
+        break;
+    case 16:
+        CopyElements<16>(count, data, stride, out, targetElemSize);
+        break;
+    default:
         for (size_t i = 0; i < count; ++i) {
             memcpy(outData + i, data + i * stride, elemSize);
         }
+        break;
     }
 }
 
@@ -1057,6 +1106,43 @@ T Accessor::Indexer::GetValue(int i) {
     return value;
 }
 
+//! Accesses the first count values as unsigned ints at once
+inline void Accessor::Indexer::GetUInts(unsigned int *out, size_t count) {
+    ai_assert(data);
+    const size_t maxSize = accessor.GetMaxByteSize();
+    if (count > 0 && (count - 1) * stride >= maxSize) {
+        // report the first index out of range, like GetValue()
+        throw DeadlyImportError("GLTF: Invalid index ", (maxSize + stride - 1) / stride, ", count out of range for buffer with stride ", stride, " and size ", maxSize, ".");
+    }
+
+    // Assume platform endianness matches GLTF binary data (which is little-endian).
+    const uint8_t *in = data;
+    switch (elemSize) {
+    case 1:
+        for (size_t i = 0; i < count; ++i, in += stride) {
+            out[i] = *in;
+        }
+        break;
+    case 2:
+        for (size_t i = 0; i < count; ++i, in += stride) {
+            uint16_t value;
+            memcpy(&value, in, sizeof(value));
+            out[i] = value;
+        }
+        break;
+    case 4:
+        for (size_t i = 0; i < count; ++i, in += stride) {
+            memcpy(out + i, in, sizeof(unsigned int));
+        }
+        break;
+    default:
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = GetUInt(static_cast<int>(i));
+        }
+        break;
+    }
+}
+
 inline Image::Image() :
         width(0),
         height(0),
@@ -1407,26 +1493,9 @@ inline void Mesh::Read(Value &pJSON_Object, Asset &pAsset_Root) {
                 // Skip if any missing
                 if (Value *dracoExt = FindExtension(primitive, "KHR_draco_mesh_compression")) {
                     if (Value *bufView = FindUInt(*dracoExt, "bufferView")) {
-                        // Attempt to load indices and attributes using draco compression
-                        auto bufferView = pAsset_Root.bufferViews.Retrieve(bufView->GetUint());
-                        // Attempt to perform the draco decode on the buffer data
-                        const char *bufferViewData = reinterpret_cast<const char *>(bufferView->buffer->GetPointer() + bufferView->byteOffset);
-                        draco::DecoderBuffer decoderBuffer;
-                        decoderBuffer.Init(bufferViewData, bufferView->byteLength);
-                        draco::Decoder decoder;
-                        auto decodeResult = decoder.DecodeMeshFromBuffer(&decoderBuffer);
-                        if (!decodeResult.ok()) {
-                            // A corrupt Draco isn't actually fatal if the primitive data is also provided in a standard buffer, but does anyone do that?
-                            throw DeadlyImportError("GLTF: Invalid Draco mesh compression in mesh: ", name, " primitive: ", i, ": ", decodeResult.status().error_msg_string());
-                        }
-
-                        // Now we have a draco mesh
-                        const std::unique_ptr<draco::Mesh> &pDracoMesh = decodeResult.value();
-
-                        // Redirect the accessors to the decoded data
-
-                        // Indices
-                        SetDecodedIndexBuffer_Draco(*pDracoMesh, prim);
+                        // Remember the compressed data, decoding is left to DecodeDraco() so
+                        // primitives can be decoded concurrently
+                        prim.dracoBufferView = pAsset_Root.bufferViews.Retrieve(bufView->GetUint());
 
                         // Vertex attributes
                         if (Value *attrs = FindObject(*dracoExt, "attributes")) {
@@ -1452,9 +1521,8 @@ inline void Mesh::Read(Value &pJSON_Object, Asset &pAsset_Root) {
                                     if (attribAccessor.count == 0)
                                         throw DeadlyImportError("GLTF: Invalid draco attribute in mesh: ", name, " primitive: ", i, " attrib: ", attr);
 
-                                    // Redirect this accessor to the appropriate Draco vertex attribute data
-                                    const uint32_t dracoAttribId = it->value.GetUint();
-                                    SetDecodedAttributeBuffer_Draco(*pDracoMesh, dracoAttribId, attribAccessor);
+                                    // This accessor is redirected to the Draco vertex attribute data
+                                    prim.dracoAttributes.emplace_back((*vec)[idx], it->value.GetUint());
                                 }
                             }
                         }
@@ -1517,6 +1585,42 @@ inline void Mesh::Read(Value &pJSON_Object, Asset &pAsset_Root) {
     }
 }
 
+inline void Mesh::DecodeDraco(unsigned int pPrimitive) {
+    Primitive &prim = primitives[pPrimitive];
+    if (!prim.dracoBufferView) {
+        return;
+    }
+
+#ifdef ASSIMP_ENABLE_DRACO
+    // Attempt to perform the draco decode on the buffer data
+    const char *bufferViewData = reinterpret_cast<const char *>(prim.dracoBufferView->buffer->GetPointer() + prim.dracoBufferView->byteOffset);
+    draco::DecoderBuffer decoderBuffer;
+    decoderBuffer.Init(bufferViewData, prim.dracoBufferView->byteLength);
+    draco::Decoder decoder;
+    auto decodeResult = decoder.DecodeMeshFromBuffer(&decoderBuffer);
+    if (!decodeResult.ok()) {
+        // A corrupt Draco isn't actually fatal if the primitive data is also provided in a standard buffer, but does anyone do that?
+        throw DeadlyImportError("GLTF: Invalid Draco mesh compression in mesh: ", name, " primitive: ", pPrimitive, ": ", decodeResult.status().error_msg_string());
+    }
+
+    // Now we have a draco mesh
+    const std::unique_ptr<draco::Mesh> &pDracoMesh = decodeResult.value();
+
+    // Redirect the accessors to the decoded data
+
+    // Indices
+    SetDecodedIndexBuffer_Draco(*pDracoMesh, prim);
+
+    // Vertex attributes
+    for (std::pair<Ref<Accessor>, uint32_t> &attribute : prim.dracoAttributes) {
+        SetDecodedAttributeBuffer_Draco(*pDracoMesh, attribute.second, *attribute.first);
+    }
+#endif
+
+    prim.dracoBufferView = Ref<BufferView>();
+    prim.dracoAttributes.clear();
+}
+
 inline void Camera::Read(Value &obj, Asset & /*r*/) {
     std::string type_string = std::string(MemberOrDefault(obj, "type", "perspective"));
     if (type_string == "orthographic") {
@@ -1906,7 +2010,7 @@ inline void Asset::Load(const std::string &pFile, bool isBinary)
 
     // Fill the buffer instance for the current file embedded contents
     if (mBodyLength > 0) {
-        if (!mBodyBuffer->LoadFromStream(*stream, mBodyLength, mBodyOffset)) {
+        if (!mBodyBuffer->LoadFromSharedStream(stream, mBodyLength, mBodyOffset)) {
             throw DeadlyImportError("GLTF: Unable to read gltf file");
         }
     }
@@ -43,6 +43,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssetLib/glTF2/glTF2Importer.h"
 #include "AssetLib/glTF2/glTF2Asset.h"
+#include "Common/Importer.h"
+#include "Common/MeshIndexBuffer.h"
+#include "Common/TaskScheduler.h"
 #include "PostProcessing/MakeVerboseFormat.h"
 
 #if !defined(ASSIMP_BUILD_NO_EXPORT)
@@ -60,6 +63,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 
@@ -99,7 +103,8 @@ glTF2Importer::glTF2Importer() :
         BaseImporter(),
         meshOffsets(),
         mEmbeddedTexIdxs(),
-        mScene(nullptr) {
+        mScene(nullptr),
+        mScheduler(nullptr) {
     // empty
 }
 
@@ -381,49 +386,38 @@ void glTF2Importer::ImportMaterials(Asset &r) {
     }
 }
 
-static inline void SetFaceAndAdvance1(aiFace *&face, unsigned int numVertices, unsigned int a) {
+// The faces are written to the index buffer of the mesh, the ScenePreprocessor sets up aiMesh::mFaces
+static inline void SetFaceAndAdvance1(unsigned int *&face, unsigned int numVertices, unsigned int a) {
     if (a >= numVertices) {
         return;
     }
-    face->mNumIndices = 1;
-    face->mIndices = new unsigned int[1];
-    face->mIndices[0] = a;
-    ++face;
+    *face++ = a;
 }
 
-static inline void SetFaceAndAdvance2(aiFace *&face, unsigned int numVertices,
+static inline void SetFaceAndAdvance2(unsigned int *&face, unsigned int numVertices,
         unsigned int a, unsigned int b) {
     if ((a >= numVertices) || (b >= numVertices)) {
         return;
     }
-    face->mNumIndices = 2;
-    face->mIndices = new unsigned int[2];
-    face->mIndices[0] = a;
-    face->mIndices[1] = b;
-    ++face;
+    *face++ = a;
+    *face++ = b;
 }
 
-static inline void SetFaceAndAdvance3(aiFace *&face, unsigned int numVertices, unsigned int a,
+static inline void SetFaceAndAdvance3(unsigned int *&face, unsigned int numVertices, unsigned int a,
         unsigned int b, unsigned int c) {
     if ((a >= numVertices) || (b >= numVertices) || (c >= numVertices)) {
         return;
     }
-    face->mNumIndices = 3;
-    face->mIndices = new unsigned int[3];
-    face->mIndices[0] = a;
-    face->mIndices[1] = b;
-    face->mIndices[2] = c;
-    ++face;
+    *face++ = a;
+    *face++ = b;
+    *face++ = c;
 }
 
 #ifdef ASSIMP_BUILD_DEBUG
-static inline bool CheckValidFacesIndices(aiFace *faces, unsigned nFaces, unsigned nVerts) {
-    for (unsigned i = 0; i < nFaces; ++i) {
-        for (unsigned j = 0; j < faces[i].mNumIndices; ++j) {
-            unsigned idx = faces[i].mIndices[j];
-            if (idx >= nVerts) {
-                return false;
-            }
+static inline bool CheckValidFacesIndices(const unsigned int *indices, unsigned nIndices, unsigned nVerts) {
+    for (unsigned i = 0; i < nIndices; ++i) {
+        if (indices[i] >= nVerts) {
+            return false;
         }
     }
     return true;
@@ -445,384 +439,492 @@ aiColor4D *GetVertexColorsForType(Ref<Accessor> input) {
     return output;
 }
 
-void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
-    ASSIMP_LOG_DEBUG("Importing ", r.meshes.Size(), " meshes");
-    std::vector<std::unique_ptr<aiMesh>> meshes;
+namespace {
+// Warnings raised while converting one primitive. The logger is not thread-safe, so primitives
+// converted concurrently collect their messages and ImportMeshes() logs them in order.
+struct PrimitiveLog {
+    std::vector<std::string> warnings;
+
+    template <typename... T>
+    void warn(T &&...args) {
+        warnings.push_back(formatMessage(Assimp::Formatter::format(), std::forward<T>(args)...));
+    }
 
-    unsigned int k = 0;
-    meshOffsets.clear();
+private:
+    static std::string formatMessage(Assimp::Formatter::format f) {
+        return f;
+    }
 
-    for (unsigned int m = 0; m < r.meshes.Size(); ++m) {
-        Mesh &mesh = r.meshes[m];
+    template <typename... T, typename U>
+    static std::string formatMessage(Assimp::Formatter::format f, U &&u, T &&...args) {
+        return formatMessage(std::move(f << std::forward<U>(u)), std::forward<T>(args)...);
+    }
+};
 
-        meshOffsets.push_back(k);
-        k += unsigned(mesh.primitives.size());
+void LogPrimitiveWarnings(const std::vector<PrimitiveLog> &logs) {
+    for (const PrimitiveLog &log : logs) {
+        for (const std::string &warning : log.warnings) {
+            ASSIMP_LOG_WARN(warning);
+        }
+    }
+}
+} // namespace
 
-        for (unsigned int p = 0; p < mesh.primitives.size(); ++p) {
-            Mesh::Primitive &prim = mesh.primitives[p];
+// Converts primitive p of mesh into aim. Only reads from the asset, so distinct primitives may
+// be converted concurrently.
+static void ImportPrimitive(Mesh &mesh, unsigned int p, unsigned int defaultMaterial, aiMesh *aim, PrimitiveLog &log) {
+    Mesh::Primitive &prim = mesh.primitives[p];
 
-            aiMesh *aim = new aiMesh();
-            meshes.push_back(std::unique_ptr<aiMesh>(aim));
+    aim->mName = mesh.name.empty() ? mesh.id : mesh.name;
 
-            aim->mName = mesh.name.empty() ? mesh.id : mesh.name;
+    if (mesh.primitives.size() > 1) {
+        ai_uint32 &len = aim->mName.length;
+        aim->mName.data[len] = '-';
+        len += 1 + ASSIMP_itoa10(aim->mName.data + len + 1, unsigned(MAXLEN - len - 1), p);
+    }
 
-            if (mesh.primitives.size() > 1) {
-                ai_uint32 &len = aim->mName.length;
-                aim->mName.data[len] = '-';
-                len += 1 + ASSIMP_itoa10(aim->mName.data + len + 1, unsigned(MAXLEN - len - 1), p);
-            }
+    switch (prim.mode) {
+    case PrimitiveMode_POINTS:
+        aim->mPrimitiveTypes |= aiPrimitiveType_POINT;
+        break;
+
+    case PrimitiveMode_LINES:
+    case PrimitiveMode_LINE_LOOP:
+    case PrimitiveMode_LINE_STRIP:
+        aim->mPrimitiveTypes |= aiPrimitiveType_LINE;
+        break;
+
+    case PrimitiveMode_TRIANGLES:
+    case PrimitiveMode_TRIANGLE_STRIP:
+    case PrimitiveMode_TRIANGLE_FAN:
+        aim->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+        break;
+    }
 
-            switch (prim.mode) {
-            case PrimitiveMode_POINTS:
-                aim->mPrimitiveTypes |= aiPrimitiveType_POINT;
-                break;
-
-            case PrimitiveMode_LINES:
-            case PrimitiveMode_LINE_LOOP:
-            case PrimitiveMode_LINE_STRIP:
-                aim->mPrimitiveTypes |= aiPrimitiveType_LINE;
-                break;
-
-            case PrimitiveMode_TRIANGLES:
-            case PrimitiveMode_TRIANGLE_STRIP:
-            case PrimitiveMode_TRIANGLE_FAN:
-                aim->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-                break;
-            }
+    Mesh::Primitive::Attributes &attr = prim.attributes;
 
-            Mesh::Primitive::Attributes &attr = prim.attributes;
+    if (!attr.position.empty() && attr.position[0]) {
+        aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->count);
+        attr.position[0]->ExtractData(aim->mVertices);
+    }
 
-            if (!attr.position.empty() && attr.position[0]) {
-                aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->count);
-                attr.position[0]->ExtractData(aim->mVertices);
-            }
+    if (!attr.normal.empty() && attr.normal[0]) {
+        if (attr.normal[0]->count != aim->mNumVertices) {
+            log.warn("Normal count in mesh \"", mesh.name, "\" does not match the vertex count, normals ignored.");
+        } else {
+            attr.normal[0]->ExtractData(aim->mNormals);
 
-            if (!attr.normal.empty() && attr.normal[0]) {
-                if (attr.normal[0]->count != aim->mNumVertices) {
-                    DefaultLogger::get()->warn("Normal count in mesh \"", mesh.name, "\" does not match the vertex count, normals ignored.");
+            // only extract tangents if normals are present
+            if (!attr.tangent.empty() && attr.tangent[0]) {
+                if (attr.tangent[0]->count != aim->mNumVertices) {
+                    log.warn("Tangent count in mesh \"", mesh.name, "\" does not match the vertex count, tangents ignored.");
                 } else {
-                    attr.normal[0]->ExtractData(aim->mNormals);
-
-                    // only extract tangents if normals are present
-                    if (!attr.tangent.empty() && attr.tangent[0]) {
-                        if (attr.tangent[0]->count != aim->mNumVertices) {
-                            DefaultLogger::get()->warn("Tangent count in mesh \"", mesh.name, "\" does not match the vertex count, tangents ignored.");
-                        } else {
-                            // generate bitangents from normals and tangents according to spec
-                            Tangent *tangents = nullptr;
-
-                            attr.tangent[0]->ExtractData(tangents);
+                    // generate bitangents from normals and tangents according to spec
+                    Tangent *tangents = nullptr;
 
-                            aim->mTangents = new aiVector3D[aim->mNumVertices];
-                            aim->mBitangents = new aiVector3D[aim->mNumVertices];
+                    attr.tangent[0]->ExtractData(tangents);
 
-                            for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
-                                aim->mTangents[i] = tangents[i].xyz;
-                                aim->mBitangents[i] = (aim->mNormals[i] ^ tangents[i].xyz) * tangents[i].w;
-                            }
+                    aim->mTangents = new aiVector3D[aim->mNumVertices];
+                    aim->mBitangents = new aiVector3D[aim->mNumVertices];
 
-                            delete[] tangents;
-                        }
+                    for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+                        aim->mTangents[i] = tangents[i].xyz;
+                        aim->mBitangents[i] = (aim->mNormals[i] ^ tangents[i].xyz) * tangents[i].w;
                     }
+
+                    delete[] tangents;
                 }
             }
+        }
+    }
 
-            for (size_t c = 0; c < attr.color.size() && c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
-                if (attr.color[c]->count != aim->mNumVertices) {
-                    DefaultLogger::get()->warn("Color stream size in mesh \"", mesh.name,
-                            "\" does not match the vertex count");
-                    continue;
-                }
+    for (size_t c = 0; c < attr.color.size() && c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        if (attr.color[c]->count != aim->mNumVertices) {
+            log.warn("Color stream size in mesh \"", mesh.name,
+                    "\" does not match the vertex count");
+            continue;
+        }
 
-                auto componentType = attr.color[c]->componentType;
-                if (componentType == glTF2::ComponentType_FLOAT) {
-                    attr.color[c]->ExtractData(aim->mColors[c]);
-                } else {
-                    if (componentType == glTF2::ComponentType_UNSIGNED_BYTE) {
-                        aim->mColors[c] = GetVertexColorsForType<unsigned char>(attr.color[c]);
-                    } else if (componentType == glTF2::ComponentType_UNSIGNED_SHORT) {
-                        aim->mColors[c] = GetVertexColorsForType<unsigned short>(attr.color[c]);
-                    }
-                }
+        auto componentType = attr.color[c]->componentType;
+        if (componentType == glTF2::ComponentType_FLOAT) {
+            attr.color[c]->ExtractData(aim->mColors[c]);
+        } else {
+            if (componentType == glTF2::ComponentType_UNSIGNED_BYTE) {
+                aim->mColors[c] = GetVertexColorsForType<unsigned char>(attr.color[c]);
+            } else if (componentType == glTF2::ComponentType_UNSIGNED_SHORT) {
+                aim->mColors[c] = GetVertexColorsForType<unsigned short>(attr.color[c]);
             }
-            for (size_t tc = 0; tc < attr.texcoord.size() && tc < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++tc) {
-                if (!attr.texcoord[tc]) {
-                    DefaultLogger::get()->warn("Texture coordinate accessor not found or non-contiguous texture coordinate sets.");
-                    continue;
-                }
+        }
+    }
+    for (size_t tc = 0; tc < attr.texcoord.size() && tc < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++tc) {
+        if (!attr.texcoord[tc]) {
+            log.warn("Texture coordinate accessor not found or non-contiguous texture coordinate sets.");
+            continue;
+        }
 
-                if (attr.texcoord[tc]->count != aim->mNumVertices) {
-                    DefaultLogger::get()->warn("Texcoord stream size in mesh \"", mesh.name,
-                            "\" does not match the vertex count");
-                    continue;
-                }
+        if (attr.texcoord[tc]->count != aim->mNumVertices) {
+            log.warn("Texcoord stream size in mesh \"", mesh.name,
+                    "\" does not match the vertex count");
+            continue;
+        }
 
-                attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc]);
-                aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
+        attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc]);
+        aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
 
-                aiVector3D *values = aim->mTextureCoords[tc];
-                for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
-                    values[i].y = 1 - values[i].y; // Flip Y coords
-                }
-            }
+        aiVector3D *values = aim->mTextureCoords[tc];
+        for (unsigned int i = 0; i < aim->mNumVertices; ++i) {
+            values[i].y = 1 - values[i].y; // Flip Y coords
+        }
+    }
 
-            std::vector<Mesh::Primitive::Target> &targets = prim.targets;
-            if (!targets.empty()) {
-                aim->mNumAnimMeshes = (unsigned int)targets.size();
-                aim->mAnimMeshes = new aiAnimMesh *[aim->mNumAnimMeshes];
-                std::fill(aim->mAnimMeshes, aim->mAnimMeshes + aim->mNumAnimMeshes, nullptr);
-                for (size_t i = 0; i < targets.size(); i++) {
-                    bool needPositions = targets[i].position.size() > 0;
-                    bool needNormals = (targets[i].normal.size() > 0) && aim->HasNormals();
-                    bool needTangents = (targets[i].tangent.size() > 0) && aim->HasTangentsAndBitangents();
-                    // GLTF morph does not support colors and texCoords
-                    aim->mAnimMeshes[i] = aiCreateAnimMesh(aim,
-                            needPositions, needNormals, needTangents, false, false);
-                    aiAnimMesh &aiAnimMesh = *(aim->mAnimMeshes[i]);
-                    Mesh::Primitive::Target &target = targets[i];
-
-                    if (needPositions) {
-                        if (target.position[0]->count != aim->mNumVertices) {
-                            ASSIMP_LOG_WARN("Positions of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
-                        } else {
-                            aiVector3D *positionDiff = nullptr;
-                            target.position[0]->ExtractData(positionDiff);
-                            for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
-                                aiAnimMesh.mVertices[vertexId] += positionDiff[vertexId];
-                            }
-                            delete[] positionDiff;
-                        }
-                    }
-                    if (needNormals) {
-                        if (target.normal[0]->count != aim->mNumVertices) {
-                            ASSIMP_LOG_WARN("Normals of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
-                        } else {
-                            aiVector3D *normalDiff = nullptr;
-                            target.normal[0]->ExtractData(normalDiff);
-                            for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
-                                aiAnimMesh.mNormals[vertexId] += normalDiff[vertexId];
-                            }
-                            delete[] normalDiff;
-                        }
-                    }
-                    if (needTangents) {
-                        if (!aiAnimMesh.HasNormals()) {
-                            // prevent nullptr access to aiAnimMesh.mNormals below when no normals are available
-                            ASSIMP_LOG_WARN("Bitangents of target ", i, " in mesh \"", mesh.name, "\" can't be computed, because mesh has no normals.");
-                        } else if (target.tangent[0]->count != aim->mNumVertices) {
-                            ASSIMP_LOG_WARN("Tangents of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
-                        } else {
-                            Tangent *tangent = nullptr;
-                            attr.tangent[0]->ExtractData(tangent);
-
-                            aiVector3D *tangentDiff = nullptr;
-                            target.tangent[0]->ExtractData(tangentDiff);
-
-                            for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; ++vertexId) {
-                                tangent[vertexId].xyz += tangentDiff[vertexId];
-                                aiAnimMesh.mTangents[vertexId] = tangent[vertexId].xyz;
-                                aiAnimMesh.mBitangents[vertexId] = (aiAnimMesh.mNormals[vertexId] ^ tangent[vertexId].xyz) * tangent[vertexId].w;
-                            }
-                            delete[] tangent;
-                            delete[] tangentDiff;
-                        }
-                    }
-                    if (mesh.weights.size() > i) {
-                        aiAnimMesh.mWeight = mesh.weights[i];
+    std::vector<Mesh::Primitive::Target> &targets = prim.targets;
+    if (!targets.empty()) {
+        aim->mNumAnimMeshes = (unsigned int)targets.size();
+        aim->mAnimMeshes = new aiAnimMesh *[aim->mNumAnimMeshes];
+        std::fill(aim->mAnimMeshes, aim->mAnimMeshes + aim->mNumAnimMeshes, nullptr);
+        for (size_t i = 0; i < targets.size(); i++) {
+            bool needPositions = targets[i].position.size() > 0;
+            bool needNormals = (targets[i].normal.size() > 0) && aim->HasNormals();
+            bool needTangents = (targets[i].tangent.size() > 0) && aim->HasTangentsAndBitangents();
+            // GLTF morph does not support colors and texCoords
+            aim->mAnimMeshes[i] = aiCreateAnimMesh(aim,
+                    needPositions, needNormals, needTangents, false, false);
+            aiAnimMesh &aiAnimMesh = *(aim->mAnimMeshes[i]);
+            Mesh::Primitive::Target &target = targets[i];
+
+            if (needPositions) {
+                if (target.position[0]->count != aim->mNumVertices) {
+                    log.warn("Positions of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
+                } else {
+                    aiVector3D *positionDiff = nullptr;
+                    target.position[0]->ExtractData(positionDiff);
+                    for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
+                        aiAnimMesh.mVertices[vertexId] += positionDiff[vertexId];
                     }
-                    if (mesh.targetNames.size() > i) {
-                        aiAnimMesh.mName = mesh.targetNames[i];
+                    delete[] positionDiff;
+                }
+            }
+            if (needNormals) {
+                if (target.normal[0]->count != aim->mNumVertices) {
+                    log.warn("Normals of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
+                } else {
+                    aiVector3D *normalDiff = nullptr;
+                    target.normal[0]->ExtractData(normalDiff);
+                    for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
+                        aiAnimMesh.mNormals[vertexId] += normalDiff[vertexId];
                     }
+                    delete[] normalDiff;
                 }
             }
+            if (needTangents) {
+                if (!aiAnimMesh.HasNormals()) {
+                    // prevent nullptr access to aiAnimMesh.mNormals below when no normals are available
+                    log.warn("Bitangents of target ", i, " in mesh \"", mesh.name, "\" can't be computed, because mesh has no normals.");
+                } else if (target.tangent[0]->count != aim->mNumVertices) {
+                    log.warn("Tangents of target ", i, " in mesh \"", mesh.name, "\" does not match the vertex count");
+                } else {
+                    Tangent *tangent = nullptr;
+                    attr.tangent[0]->ExtractData(tangent);
 
-            aiFace *faces = nullptr;
-            aiFace *facePtr = nullptr;
-            size_t nFaces = 0;
-
-            if (prim.indices) {
-                size_t count = prim.indices->count;
-
-                Accessor::Indexer data = prim.indices->GetIndexer();
-                if (!data.IsValid()) {
-                    throw DeadlyImportError("GLTF: Invalid accessor without data in mesh ", getContextForErrorMessages(mesh.id, mesh.name));
-                }
+                    aiVector3D *tangentDiff = nullptr;
+                    target.tangent[0]->ExtractData(tangentDiff);
 
-                switch (prim.mode) {
-                case PrimitiveMode_POINTS: {
-                    nFaces = count;
-                    facePtr = faces = new aiFace[nFaces];
-                    for (unsigned int i = 0; i < count; ++i) {
-                        SetFaceAndAdvance1(facePtr, aim->mNumVertices, data.GetUInt(i));
+                    for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; ++vertexId) {
+                        tangent[vertexId].xyz += tangentDiff[vertexId];
+                        aiAnimMesh.mTangents[vertexId] = tangent[vertexId].xyz;
+                        aiAnimMesh.mBitangents[vertexId] = (aiAnimMesh.mNormals[vertexId] ^ tangent[vertexId].xyz) * tangent[vertexId].w;
                     }
-                    break;
+                    delete[] tangent;
+                    delete[] tangentDiff;
                 }
+            }
+            if (mesh.weights.size() > i) {
+                aiAnimMesh.mWeight = mesh.weights[i];
+            }
+            if (mesh.targetNames.size() > i) {
+                aiAnimMesh.mName = mesh.targetNames[i];
+            }
+        }
+    }
 
-                case PrimitiveMode_LINES: {
-                    nFaces = count / 2;
-                    if (nFaces * 2 != count) {
-                        ASSIMP_LOG_WARN("The number of vertices was not compatible with the LINES mode. Some vertices were dropped.");
-                        count = nFaces * 2;
-                    }
-                    facePtr = faces = new aiFace[nFaces];
-                    for (unsigned int i = 0; i < count; i += 2) {
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1));
-                    }
-                    break;
-                }
+    unsigned int *faces = nullptr;
+    unsigned int *facePtr = nullptr;
+    size_t nFaces = 0;
 
-                case PrimitiveMode_LINE_LOOP:
-                case PrimitiveMode_LINE_STRIP: {
-                    nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
-                    facePtr = faces = new aiFace[nFaces];
-                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(1));
-                    for (unsigned int i = 2; i < count; ++i) {
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(i - 1), data.GetUInt(i));
-                    }
-                    if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, data.GetUInt(static_cast<int>(count) - 1), faces[0].mIndices[0]);
-                    }
-                    break;
-                }
+    if (prim.indices) {
+        size_t count = prim.indices->count;
 
-                case PrimitiveMode_TRIANGLES: {
-                    nFaces = count / 3;
-                    if (nFaces * 3 != count) {
-                        ASSIMP_LOG_WARN("The number of vertices was not compatible with the TRIANGLES mode. Some vertices were dropped.");
-                        count = nFaces * 3;
-                    }
-                    facePtr = faces = new aiFace[nFaces];
-                    for (unsigned int i = 0; i < count; i += 3) {
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
-                    }
-                    break;
-                }
-                case PrimitiveMode_TRIANGLE_STRIP: {
-                    nFaces = count - 2;
-                    facePtr = faces = new aiFace[nFaces];
-                    for (unsigned int i = 0; i < nFaces; ++i) {
-                        // The ordering is to ensure that the triangles are all drawn with the same orientation
-                        if ((i + 1) % 2 == 0) {
-                            // For even n, vertices n + 1, n, and n + 2 define triangle n
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i + 1), data.GetUInt(i), data.GetUInt(i + 2));
-                        } else {
-                            // For odd n, vertices n, n+1, and n+2 define triangle n
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(i), data.GetUInt(i + 1), data.GetUInt(i + 2));
-                        }
-                    }
-                    break;
-                }
-                case PrimitiveMode_TRIANGLE_FAN:
-                    nFaces = count - 2;
-                    facePtr = faces = new aiFace[nFaces];
-                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(1), data.GetUInt(2));
-                    for (unsigned int i = 1; i < nFaces; ++i) {
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, data.GetUInt(0), data.GetUInt(i + 1), data.GetUInt(i + 2));
-                    }
-                    break;
-                }
-            } else { // no indices provided so directly generate from counts
+        Accessor::Indexer data = prim.indices->GetIndexer();
+        if (!data.IsValid()) {
+            throw DeadlyImportError("GLTF: Invalid accessor without data in mesh ", getContextForErrorMessages(mesh.id, mesh.name));
+        }
 
-                // use the already determined count as it includes checks
-                unsigned int count = aim->mNumVertices;
+        // fetch all index values the primitive mode reads in one go
+        size_t numIndices = count;
+        switch (prim.mode) {
+        case PrimitiveMode_LINES:
+            numIndices = count / 2 * 2;
+            break;
+        case PrimitiveMode_LINE_LOOP:
+        case PrimitiveMode_LINE_STRIP:
+            numIndices = std::max<size_t>(count, 2);
+            break;
+        case PrimitiveMode_TRIANGLES:
+            numIndices = count / 3 * 3;
+            break;
+        case PrimitiveMode_TRIANGLE_FAN:
+            numIndices = std::max<size_t>(count, 3);
+            break;
+        default:
+            break;
+        }
+        std::vector<unsigned int> indices(numIndices);
+        data.GetUInts(indices.data(), numIndices);
+
+        switch (prim.mode) {
+        case PrimitiveMode_POINTS: {
+            nFaces = count;
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 1);
+            for (unsigned int i = 0; i < count; ++i) {
+                SetFaceAndAdvance1(facePtr, aim->mNumVertices, indices[i]);
+            }
+            break;
+        }
 
-                switch (prim.mode) {
-                case PrimitiveMode_POINTS: {
-                    nFaces = count;
-                    facePtr = faces = new aiFace[nFaces];
-                    for (unsigned int i = 0; i < count; ++i) {
-                        SetFaceAndAdvance1(facePtr, aim->mNumVertices, i);
-                    }
-                    break;
-                }
+        case PrimitiveMode_LINES: {
+            nFaces = count / 2;
+            if (nFaces * 2 != count) {
+                log.warn("The number of vertices was not compatible with the LINES mode. Some vertices were dropped.");
+                count = nFaces * 2;
+            }
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 2);
+            for (unsigned int i = 0; i < count; i += 2) {
+                SetFaceAndAdvance2(facePtr, aim->mNumVertices, indices[i], indices[i + 1]);
+            }
+            break;
+        }
 
-                case PrimitiveMode_LINES: {
-                    nFaces = count / 2;
-                    if (nFaces * 2 != count) {
-                        ASSIMP_LOG_WARN("The number of vertices was not compatible with the LINES mode. Some vertices were dropped.");
-                        count = (unsigned int)nFaces * 2;
-                    }
-                    facePtr = faces = new aiFace[nFaces];
-                    for (unsigned int i = 0; i < count; i += 2) {
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, i, i + 1);
-                    }
-                    break;
-                }
+        case PrimitiveMode_LINE_LOOP:
+        case PrimitiveMode_LINE_STRIP: {
+            nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 2);
+            SetFaceAndAdvance2(facePtr, aim->mNumVertices, indices[0], indices[1]);
+            for (unsigned int i = 2; i < count; ++i) {
+                SetFaceAndAdvance2(facePtr, aim->mNumVertices, indices[i - 1], indices[i]);
+            }
+            if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
+                SetFaceAndAdvance2(facePtr, aim->mNumVertices, indices[count - 1], faces[0]);
+            }
+            break;
+        }
 
-                case PrimitiveMode_LINE_LOOP:
-                case PrimitiveMode_LINE_STRIP: {
-                    nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
-                    facePtr = faces = new aiFace[nFaces];
-                    SetFaceAndAdvance2(facePtr, aim->mNumVertices, 0, 1);
-                    for (unsigned int i = 2; i < count; ++i) {
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, i - 1, i);
-                    }
-                    if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
-                        SetFaceAndAdvance2(facePtr, aim->mNumVertices, count - 1, 0);
-                    }
-                    break;
+        case PrimitiveMode_TRIANGLES: {
+            nFaces = count / 3;
+            if (nFaces * 3 != count) {
+                log.warn("The number of vertices was not compatible with the TRIANGLES mode. Some vertices were dropped.");
+                count = nFaces * 3;
+            }
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 3);
+            for (unsigned int i = 0; i < count; i += 3) {
+                SetFaceAndAdvance3(facePtr, aim->mNumVertices, indices[i], indices[i + 1], indices[i + 2]);
+            }
+            break;
+        }
+        case PrimitiveMode_TRIANGLE_STRIP: {
+            nFaces = count - 2;
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 3);
+            for (unsigned int i = 0; i < nFaces; ++i) {
+                // The ordering is to ensure that the triangles are all drawn with the same orientation
+                if ((i + 1) % 2 == 0) {
+                    // For even n, vertices n + 1, n, and n + 2 define triangle n
+                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, indices[i + 1], indices[i], indices[i + 2]);
+                } else {
+                    // For odd n, vertices n, n+1, and n+2 define triangle n
+                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, indices[i], indices[i + 1], indices[i + 2]);
                 }
+            }
+            break;
+        }
+        case PrimitiveMode_TRIANGLE_FAN:
+            nFaces = count - 2;
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 3);
+            SetFaceAndAdvance3(facePtr, aim->mNumVertices, indices[0], indices[1], indices[2]);
+            for (unsigned int i = 1; i < nFaces; ++i) {
+                SetFaceAndAdvance3(facePtr, aim->mNumVertices, indices[0], indices[i + 1], indices[i + 2]);
+            }
+            break;
+        }
+    } else { // no indices provided so directly generate from counts
 
-                case PrimitiveMode_TRIANGLES: {
-                    nFaces = count / 3;
-                    if (nFaces * 3 != count) {
-                        ASSIMP_LOG_WARN("The number of vertices was not compatible with the TRIANGLES mode. Some vertices were dropped.");
-                        count = (unsigned int)nFaces * 3;
-                    }
-                    facePtr = faces = new aiFace[nFaces];
-                    for (unsigned int i = 0; i < count; i += 3) {
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
-                    }
-                    break;
-                }
-                case PrimitiveMode_TRIANGLE_STRIP: {
-                    nFaces = count - 2;
-                    facePtr = faces = new aiFace[nFaces];
-                    for (unsigned int i = 0; i < nFaces; ++i) {
-                        // The ordering is to ensure that the triangles are all drawn with the same orientation
-                        if ((i + 1) % 2 == 0) {
-                            // For even n, vertices n + 1, n, and n + 2 define triangle n
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, i + 1, i, i + 2);
-                        } else {
-                            // For odd n, vertices n, n+1, and n+2 define triangle n
-                            SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
-                        }
-                    }
-                    break;
-                }
-                case PrimitiveMode_TRIANGLE_FAN:
-                    nFaces = count - 2;
-                    facePtr = faces = new aiFace[nFaces];
-                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, 1, 2);
-                    for (unsigned int i = 1; i < nFaces; ++i) {
-                        SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, i + 1, i + 2);
-                    }
-                    break;
-                }
+        // use the already determined count as it includes checks
+        unsigned int count = aim->mNumVertices;
+
+        switch (prim.mode) {
+        case PrimitiveMode_POINTS: {
+            nFaces = count;
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 1);
+            for (unsigned int i = 0; i < count; ++i) {
+                SetFaceAndAdvance1(facePtr, aim->mNumVertices, i);
             }
+            break;
+        }
 
-            if (faces) {
-                aim->mFaces = faces;
-                const unsigned int actualNumFaces = static_cast<unsigned int>(facePtr - faces);
-                if (actualNumFaces < nFaces) {
-                    ASSIMP_LOG_WARN("Some faces had out-of-range indices. Those faces were dropped.");
-                }
-                if (actualNumFaces == 0) {
-                    throw DeadlyImportError("Mesh \"", aim->mName.C_Str(), "\" has no faces");
+        case PrimitiveMode_LINES: {
+            nFaces = count / 2;
+            if (nFaces * 2 != count) {
+                log.warn("The number of vertices was not compatible with the LINES mode. Some vertices were dropped.");
+                count = (unsigned int)nFaces * 2;
+            }
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 2);
+            for (unsigned int i = 0; i < count; i += 2) {
+                SetFaceAndAdvance2(facePtr, aim->mNumVertices, i, i + 1);
+            }
+            break;
+        }
+
+        case PrimitiveMode_LINE_LOOP:
+        case PrimitiveMode_LINE_STRIP: {
+            nFaces = count - ((prim.mode == PrimitiveMode_LINE_STRIP) ? 1 : 0);
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 2);
+            SetFaceAndAdvance2(facePtr, aim->mNumVertices, 0, 1);
+            for (unsigned int i = 2; i < count; ++i) {
+                SetFaceAndAdvance2(facePtr, aim->mNumVertices, i - 1, i);
+            }
+            if (prim.mode == PrimitiveMode_LINE_LOOP) { // close the loop
+                SetFaceAndAdvance2(facePtr, aim->mNumVertices, count - 1, 0);
+            }
+            break;
+        }
+
+        case PrimitiveMode_TRIANGLES: {
+            nFaces = count / 3;
+            if (nFaces * 3 != count) {
+                log.warn("The number of vertices was not compatible with the TRIANGLES mode. Some vertices were dropped.");
+                count = (unsigned int)nFaces * 3;
+            }
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 3);
+            for (unsigned int i = 0; i < count; i += 3) {
+                SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
+            }
+            break;
+        }
+        case PrimitiveMode_TRIANGLE_STRIP: {
+            nFaces = count - 2;
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 3);
+            for (unsigned int i = 0; i < nFaces; ++i) {
+                // The ordering is to ensure that the triangles are all drawn with the same orientation
+                if ((i + 1) % 2 == 0) {
+                    // For even n, vertices n + 1, n, and n + 2 define triangle n
+                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, i + 1, i, i + 2);
+                } else {
+                    // For odd n, vertices n, n+1, and n+2 define triangle n
+                    SetFaceAndAdvance3(facePtr, aim->mNumVertices, i, i + 1, i + 2);
                 }
-                aim->mNumFaces = actualNumFaces;
-                ai_assert(CheckValidFacesIndices(faces, actualNumFaces, aim->mNumVertices));
             }
+            break;
+        }
+        case PrimitiveMode_TRIANGLE_FAN:
+            nFaces = count - 2;
+            facePtr = faces = AllocateIndexBuffer(aim, static_cast<unsigned int>(nFaces), 3);
+            SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, 1, 2);
+            for (unsigned int i = 1; i < nFaces; ++i) {
+                SetFaceAndAdvance3(facePtr, aim->mNumVertices, 0, i + 1, i + 2);
+            }
+            break;
+        }
+    }
+
+    if (faces) {
+        const unsigned int actualNumIndices = static_cast<unsigned int>(facePtr - faces);
+        const unsigned int actualNumFaces = actualNumIndices / aim->mFaceStride;
+        if (actualNumFaces < nFaces) {
+            log.warn("Some faces had out-of-range indices. Those faces were dropped.");
+        }
+        if (actualNumFaces == 0) {
+            throw DeadlyImportError("Mesh \"", aim->mName.C_Str(), "\" has no faces");
+        }
+        aim->mNumFaces = actualNumFaces;
+        aim->mNumIndices = actualNumIndices;
+        ai_assert(CheckValidFacesIndices(faces, actualNumIndices, aim->mNumVertices));
+    }
+
+    if (prim.material) {
+        aim->mMaterialIndex = prim.material.GetIndex();
+    } else {
+        aim->mMaterialIndex = defaultMaterial;
+    }
+}
 
-            if (prim.material) {
-                aim->mMaterialIndex = prim.material.GetIndex();
-            } else {
-                aim->mMaterialIndex = mScene->mNumMaterials - 1;
+void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
+    ASSIMP_LOG_DEBUG("Importing ", r.meshes.Size(), " meshes");
+
+    // flatten the primitives, every one of them becomes an aiMesh
+    std::vector<std::pair<unsigned int, unsigned int>> primitives;
+    std::vector<std::pair<unsigned int, unsigned int>> dracoPrimitives;
+    meshOffsets.clear();
+    for (unsigned int m = 0; m < r.meshes.Size(); ++m) {
+        Mesh &mesh = r.meshes[m];
+        meshOffsets.push_back(static_cast<unsigned int>(primitives.size()));
+        for (unsigned int p = 0; p < mesh.primitives.size(); ++p) {
+            primitives.emplace_back(m, p);
+            if (mesh.primitives[p].dracoBufferView) {
+                dracoPrimitives.emplace_back(m, p);
             }
         }
     }
+    meshOffsets.push_back(static_cast<unsigned int>(primitives.size()));
+
+    // Decode Draco compressed primitives first. Decoding redirects the primitive's accessors, so
+    // it can only run concurrently if no accessor is shared between the compressed primitives.
+    if (!dracoPrimitives.empty()) {
+        std::vector<Accessor *> dracoAccessors;
+        for (const std::pair<unsigned int, unsigned int> &it : dracoPrimitives) {
+            Mesh::Primitive &prim = r.meshes[it.first].primitives[it.second];
+            if (prim.indices) {
+                dracoAccessors.push_back(&*prim.indices);
+            }
+            for (std::pair<Ref<Accessor>, uint32_t> &attribute : prim.dracoAttributes) {
+                dracoAccessors.push_back(&*attribute.first);
+            }
+        }
+        std::sort(dracoAccessors.begin(), dracoAccessors.end());
+        const bool shared = std::adjacent_find(dracoAccessors.begin(), dracoAccessors.end()) != dracoAccessors.end();
+
+        auto decode = [&](unsigned int i) {
+            r.meshes[dracoPrimitives[i].first].DecodeDraco(dracoPrimitives[i].second);
+        };
+        if (mScheduler != nullptr && !shared) {
+            mScheduler->ParallelFor(static_cast<unsigned int>(dracoPrimitives.size()), decode);
+        } else {
+            for (unsigned int i = 0; i < dracoPrimitives.size(); ++i) {
+                decode(i);
+            }
+        }
+    }
+
+    // convert the primitives, results are stored by index so the mesh order does not depend on
+    // the scheduling
+    std::vector<std::unique_ptr<aiMesh>> meshes(primitives.size());
+    std::vector<PrimitiveLog> logs(primitives.size());
+    const unsigned int defaultMaterial = mScene->mNumMaterials - 1;
+    auto convert = [&](unsigned int i) {
+        meshes[i].reset(new aiMesh());
+        ImportPrimitive(r.meshes[primitives[i].first], primitives[i].second, defaultMaterial, meshes[i].get(), logs[i]);
+    };
 
-    meshOffsets.push_back(k);
+    try {
+        if (mScheduler != nullptr) {
+            mScheduler->ParallelFor(static_cast<unsigned int>(primitives.size()), convert);
+        } else {
+            for (unsigned int i = 0; i < primitives.size(); ++i) {
+                convert(i);
+            }
+        }
+    } catch (...) {
+        LogPrimitiveWarnings(logs);
+        throw;
+    }
+    LogPrimitiveWarnings(logs);
 
     CopyVector(meshes, mScene->mMeshes, mScene->mNumMeshes);
 }
@@ -1636,6 +1738,7 @@ void glTF2Importer::InternReadFile(const std::string &pFile, aiScene *pScene, IO
 
 void glTF2Importer::SetupProperties(const Importer *pImp) {
     mSchemaDocumentProvider = static_cast<rapidjson::IRemoteSchemaDocumentProvider *>(pImp->GetPropertyPointer(AI_CONFIG_IMPORT_SCHEMA_DOCUMENT_PROVIDER));
+    mScheduler = pImp->Pimpl()->mTaskScheduler;
 }
 
 #endif // ASSIMP_BUILD_NO_GLTF_IMPORTER
@@ -52,6 +52,8 @@ namespace glTF2 {
 
 namespace Assimp {
 
+class TaskScheduler;
+
 /**
  * Load the glTF2 format.
  * https://github.com/KhronosGroup/glTF/tree/master/specification
@@ -81,6 +83,7 @@ private:
     std::vector<unsigned int> meshOffsets;
     std::vector<int> mEmbeddedTexIdxs;
     aiScene *mScene;
+    TaskScheduler *mScheduler; // converts primitives concurrently, may be null
 
     /// An instance of rapidjson::IRemoteSchemaDocumentProvider
     void *mSchemaDocumentProvider = nullptr;
@@ -42,7 +42,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /** @file Implementation of BaseProcess */
 
 #include "BaseProcess.h"
+#include "DeferredLog.h"
 #include "Importer.h"
+#include "MeshIndexBuffer.h"
+#include "Meshlets.h"
+#include "TaskScheduler.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
@@ -53,7 +57,8 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseProcess::BaseProcess() AI_NO_EXCEPT
         : shared(),
-          progress() {
+          progress(),
+          scheduler() {
     // empty
 }
 
@@ -71,6 +76,15 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
     progress = pImp->GetProgressHandler();
     ai_assert(nullptr != progress);
 
+    scheduler = pImp->Pimpl()->mTaskScheduler;
+
+    if (!SupportsIndexBuffers()) {
+        ReleaseIndexBuffers(pImp->Pimpl()->mScene);
+    }
+    if (!KeepsMeshlets()) {
+        ReleaseMeshlets(pImp->Pimpl()->mScene);
+    }
+
     SetupProperties(pImp);
 
     // catch exceptions thrown inside the PostProcess-Step
@@ -89,6 +103,37 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ForEachMesh(unsigned int numMeshes, const std::function<void(unsigned int)> &func) {
+    if (nullptr != scheduler && scheduler->GetNumThreads() > 1 && numMeshes > 1) {
+        if (DefaultLogger::isNullLogger()) {
+            scheduler->ParallelFor(numMeshes, func);
+            return;
+        }
+
+        // the logger isn't thread-safe, the messages of each mesh are emitted after the loop
+        std::vector<DeferredLog> logs(numMeshes);
+        try {
+            scheduler->ParallelFor(numMeshes, [&](unsigned int i) {
+                DeferredLog::Scope scope(logs[i]);
+                func(i);
+            });
+        } catch (...) {
+            for (DeferredLog &log : logs) {
+                log.Flush();
+            }
+            throw;
+        }
+        for (DeferredLog &log : logs) {
+            log.Flush();
+        }
+        return;
+    }
+    for (unsigned int a = 0; a < numMeshes; ++a) {
+        func(a);
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseProcess::SetupProperties(const Importer * /*pImp*/) {
     // the default implementation does nothing
@@ -98,3 +143,13 @@ void BaseProcess::SetupProperties(const Importer * /*pImp*/) {
 bool BaseProcess::RequireVerboseFormat() const {
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::SupportsIndexBuffers() const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::KeepsMeshlets() const {
+    return false;
+}
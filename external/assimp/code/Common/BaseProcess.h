@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/GenericProperty.h>
 
+#include <functional>
 #include <map>
 
 struct aiScene;
@@ -52,6 +53,7 @@ struct aiScene;
 namespace Assimp {
 
 class Importer;
+class TaskScheduler;
 
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
@@ -199,6 +201,19 @@ public:
      *  in verbose format. */
     virtual bool RequireVerboseFormat() const;
 
+    // -------------------------------------------------------------------
+    /** Check whether this step handles meshes with a flat index buffer,
+     *  see aiMesh::mIndexBuffer. The index buffers of all meshes are
+     *  released before a step that does not is executed. */
+    virtual bool SupportsIndexBuffers() const;
+
+    // -------------------------------------------------------------------
+    /** Check whether this step leaves the faces and vertex positions of
+     *  all meshes untouched, so their meshlets stay valid, see
+     *  aiMesh::mMeshlets. The meshlets of all meshes are released before
+     *  a step that does not is executed. */
+    virtual bool KeepsMeshlets() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * The function deletes the scene if the postprocess step fails (
@@ -239,11 +254,25 @@ public:
     }
 
 protected:
+    // -------------------------------------------------------------------
+    /** Calls func(i) for every mesh index i in [0, numMeshes).
+     *  The calls run concurrently if the importer was configured with
+     *  #AI_CONFIG_PP_THREAD_COUNT other than 1, serially otherwise.
+     *  func may only modify mesh i and per-index output slots, results
+     *  must be combined in index order afterwards to stay deterministic.
+     *  Messages logged by func are collected per mesh and passed to the
+     *  logger in mesh order once all calls returned.
+     */
+    void ForEachMesh(unsigned int numMeshes, const std::function<void(unsigned int)> &func);
+
     /** See the doc of #SharedPostProcessInfo for more details */
     SharedPostProcessInfo *shared;
 
     /** Currently active progress handler */
     ProgressHandler *progress;
+
+    /** Thread pool of the importer, nullptr if threading is disabled */
+    TaskScheduler *scheduler;
 };
 
 } // end of namespace Assimp
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileLogStream.h"
 #include "StdOStreamLogStream.h"
 #include "Win32DebugLogStream.h"
+#include "DeferredLog.h"
 #include <assimp/StringUtils.h>
 
 #include <assimp/DefaultIOSystem.h>
@@ -164,6 +165,10 @@ Logger *DefaultLogger::create(const char *name /*= "AssimpLog.txt"*/,
 
 // ----------------------------------------------------------------------------------
 void Logger::debug(const char *message) {
+    // messages of parallel tasks are emitted later, in order
+    if (DeferredLog *log = DeferredLog::Current()) {
+        return log->Add(this, DeferredLog::Debug, message);
+    }
 
     // SECURITY FIX: otherwise it's easy to produce overruns since
     // sometimes importers will include data from the input file
@@ -176,6 +181,10 @@ void Logger::debug(const char *message) {
 
 // ----------------------------------------------------------------------------------
 void Logger::verboseDebug(const char *message) {
+    if (DeferredLog *log = DeferredLog::Current()) {
+        return log->Add(this, DeferredLog::VerboseDebug, message);
+    }
+
 
     // SECURITY FIX: see above
     if (strlen(message) > MAX_LOG_MESSAGE_LENGTH) {
@@ -186,6 +195,10 @@ void Logger::verboseDebug(const char *message) {
 
 // ----------------------------------------------------------------------------------
 void Logger::info(const char *message) {
+    if (DeferredLog *log = DeferredLog::Current()) {
+        return log->Add(this, DeferredLog::Info, message);
+    }
+
 
     // SECURITY FIX: see above
     if (strlen(message) > MAX_LOG_MESSAGE_LENGTH) {
@@ -196,6 +209,10 @@ void Logger::info(const char *message) {
 
 // ----------------------------------------------------------------------------------
 void Logger::warn(const char *message) {
+    if (DeferredLog *log = DeferredLog::Current()) {
+        return log->Add(this, DeferredLog::Warn, message);
+    }
+
 
     // SECURITY FIX: see above
     if (strlen(message) > MAX_LOG_MESSAGE_LENGTH) {
@@ -206,6 +223,10 @@ void Logger::warn(const char *message) {
 
 // ----------------------------------------------------------------------------------
 void Logger::error(const char *message) {
+    if (DeferredLog *log = DeferredLog::Current()) {
+        return log->Add(this, DeferredLog::Error, message);
+    }
+
     // SECURITY FIX: see above
     if (strlen(message) > MAX_LOG_MESSAGE_LENGTH) {
         return OnError("<fixme: long message discarded>");
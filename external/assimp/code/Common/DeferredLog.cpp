@@ -0,0 +1,108 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file DeferredLog.cpp
+ *  @brief Implementation of DeferredLog
+ */
+
+#include "Common/DeferredLog.h"
+
+namespace Assimp {
+
+namespace {
+    // log of the innermost Scope of this thread
+    thread_local DeferredLog *gCurrentLog = nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+DeferredLog::Scope::Scope(DeferredLog &log) :
+        mPrevious(gCurrentLog) {
+    gCurrentLog = &log;
+}
+
+// ------------------------------------------------------------------------------------------------
+DeferredLog::Scope::~Scope() {
+    gCurrentLog = mPrevious;
+}
+
+// ------------------------------------------------------------------------------------------------
+DeferredLog *DeferredLog::Current() {
+    return gCurrentLog;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DeferredLog::Add(Logger *logger, Kind kind, const char *message) {
+    // don't store what the logger would filter anyway
+    if ((kind == Debug && logger->getLogSeverity() < Logger::DEBUGGING) ||
+            (kind == VerboseDebug && logger->getLogSeverity() < Logger::VERBOSE)) {
+        return;
+    }
+    mMessages.push_back({ logger, kind, message });
+}
+
+// ------------------------------------------------------------------------------------------------
+void DeferredLog::Flush() {
+    std::vector<Message> messages;
+    messages.swap(mMessages);
+    for (const Message &message : messages) {
+        const char *text = message.mText.c_str();
+        switch (message.mKind) {
+        case Debug:
+            message.mLogger->debug(text);
+            break;
+        case VerboseDebug:
+            message.mLogger->verboseDebug(text);
+            break;
+        case Info:
+            message.mLogger->info(text);
+            break;
+        case Warn:
+            message.mLogger->warn(text);
+            break;
+        case Error:
+            message.mLogger->error(text);
+            break;
+        }
+    }
+}
+
+} // namespace Assimp
@@ -0,0 +1,115 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file DeferredLog.h
+ *  @brief Collects log messages of tasks running in parallel, see
+ *    BaseProcess::ForEachMesh
+ */
+#pragma once
+#ifndef AI_DEFERREDLOG_H_INC
+#define AI_DEFERREDLOG_H_INC
+
+#include <assimp/Logger.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Messages logged by one task. The loggers are not thread-safe, so a task
+ *  running on a worker thread records its messages here, and the caller
+ *  emits them in task order once all tasks are done. This also keeps the
+ *  log independent of the thread count. */
+class DeferredLog {
+public:
+    // -------------------------------------------------------------------
+    /** Redirects the messages the calling thread logs through any Logger
+     *  into a DeferredLog for the lifetime of the scope. Scopes nest. */
+    class Scope {
+    public:
+        explicit Scope(DeferredLog &log);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        DeferredLog *mPrevious;
+    };
+
+    /** Kind of a recorded message, one per Logger method */
+    enum Kind {
+        Debug,
+        VerboseDebug,
+        Info,
+        Warn,
+        Error
+    };
+
+    // -------------------------------------------------------------------
+    /** Returns the log recording the messages of the calling thread,
+     *  nullptr if they go to the logger directly. */
+    static DeferredLog *Current();
+
+    // -------------------------------------------------------------------
+    /** Records a message for the given logger. */
+    void Add(Logger *logger, Kind kind, const char *message);
+
+    // -------------------------------------------------------------------
+    /** Passes the recorded messages on in order and clears the log. Inside
+     *  a Scope they end up in the log of the scope. */
+    void Flush();
+
+private:
+    struct Message {
+        Logger *mLogger;
+        Kind mKind;
+        std::string mText;
+    };
+
+    std::vector<Message> mMessages;
+};
+
+} // namespace Assimp
+
+#endif // AI_DEFERREDLOG_H_INC
@@ -64,6 +64,9 @@ Here we implement only the C++ interface (Assimp::Exporter).
 #include "Common/DefaultProgressHandler.h"
 #include "Common/BaseProcess.h"
 #include "Common/ScenePrivate.h"
+#include "Common/SceneBuffer.h"
+#include "Common/MeshIndexBuffer.h"
+#include "Common/Meshlets.h"
 #include "PostProcessing/CalcTangentsProcess.h"
 #include "PostProcessing/MakeVerboseFormat.h"
 #include "PostProcessing/JoinVerticesProcess.h"
@@ -118,6 +121,9 @@ void ExportSceneGLB2(const char*, IOSystem*, const aiScene*, const ExportPropert
 #ifndef ASSIMP_BUILD_NO_ASSBIN_EXPORTER
 void ExportSceneAssbin(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 #endif
+#ifndef ASSIMP_BUILD_NO_ASSFLAT_EXPORTER
+void ExportSceneAssFlat(const char*, IOSystem*, const aiScene*, const ExportProperties*);
+#endif
 #ifndef ASSIMP_BUILD_NO_ASSXML_EXPORTER
 void ExportSceneAssxml(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 #endif
@@ -202,6 +208,10 @@ static void setupExporterArray(std::vector<Exporter::ExportFormatEntry> &exporte
 	exporters.push_back(Exporter::ExportFormatEntry("assbin", "Assimp Binary File", "assbin", &ExportSceneAssbin, 0));
 #endif
 
+#ifndef ASSIMP_BUILD_NO_ASSFLAT_EXPORTER
+	exporters.push_back(Exporter::ExportFormatEntry("assflat", "Assimp Flat Binary Scene", "assflat", &ExportSceneAssFlat, 0));
+#endif
+
 #ifndef ASSIMP_BUILD_NO_ASSXML_EXPORTER
 	exporters.push_back(Exporter::ExportFormatEntry("assxml", "Assimp XML Document", "assxml", &ExportSceneAssxml, 0));
 #endif
@@ -379,10 +389,10 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
         const Exporter::ExportFormatEntry& exp = pimpl->mExporters[i];
         if (!strcmp(exp.mDescription.id,pFormatId)) {
             try {
-                // Always create a full copy of the scene. We might optimize this one day,
-                // but for now it is the most pragmatic way.
+                // Always create a copy of the scene. Arrays the source keeps in shared scene
+                // buffers are shared, the steps below copy those they write to.
                 aiScene* scenecopy_tmp = nullptr;
-                SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
+                SceneCombiner::CopySceneShared(&scenecopy_tmp,pScene);
 
                 pimpl->mProgressHandler->UpdateFileWrite(1, 4);
 
@@ -423,6 +433,8 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                     if (verbosify || (exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {
                         ASSIMP_LOG_DEBUG("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
 
+                        CopySceneBuffers(scenecopy.get(), aiProcess_JoinIdenticalVertices);
+                        ReleaseMeshlets(scenecopy.get());
                         MakeVerboseFormatProcess proc;
                         proc.Execute(scenecopy.get());
 
@@ -435,10 +447,13 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                 pimpl->mProgressHandler->UpdateFileWrite(2, 4);
 
                 if (pp) {
+                    CopySceneBuffers(scenecopy.get(), pp);
+
                     // the three 'conversion' steps need to be executed first because all other steps rely on the standard data layout
                     {
                         FlipWindingOrderProcess step;
                         if (step.IsActive(pp)) {
+                            ReleaseMeshlets(scenecopy.get());
                             step.Execute(scenecopy.get());
                         }
                     }
@@ -453,6 +468,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                     {
                         MakeLeftHandedProcess step;
                         if (step.IsActive(pp)) {
+                            ReleaseMeshlets(scenecopy.get());
                             step.Execute(scenecopy.get());
                         }
                     }
@@ -473,6 +489,12 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                             if (dynamic_cast<PretransformVertices*>(p) && exportPointCloud) {
                                 continue;
                             }
+                            if (!p->SupportsIndexBuffers()) {
+                                ReleaseIndexBuffers(scenecopy.get());
+                            }
+                            if (!p->KeepsMeshlets()) {
+                                ReleaseMeshlets(scenecopy.get());
+                            }
                             p->Execute(scenecopy.get());
                         }
                     }
@@ -485,6 +507,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                 pimpl->mProgressHandler->UpdateFileWrite(3, 4);
 
                 if(must_join_again) {
+                    ReleaseMeshlets(scenecopy.get());
                     JoinVerticesProcess proc;
                     proc.Execute(scenecopy.get());
                 }
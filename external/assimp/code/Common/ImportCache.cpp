@@ -0,0 +1,1015 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file ImportCache.cpp
+ *  @brief Implementation of the on-disk import cache
+ */
+
+#include "Common/ImportCache.h"
+#include "Common/Importer.h"
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/Exceptional.h>
+#include <assimp/config.h>
+#include <assimp/Hash.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/scene.h>
+#include <assimp/version.h>
+
+#if !defined(ASSIMP_BUILD_NO_EXPORT) && !defined(ASSIMP_BUILD_NO_ASSBIN_EXPORTER) && !defined(ASSIMP_BUILD_NO_ASSBIN_IMPORTER)
+#   define AI_IMPORTCACHE_ENABLED
+#   include "AssetLib/Assbin/AssbinFileWriter.h"
+#   include "AssetLib/Assbin/AssbinLoader.h"
+#   include <assimp/BlobIOSystem.h>
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Assimp {
+
+#ifdef AI_IMPORTCACHE_ENABLED
+
+namespace {
+
+// Bump whenever the entry layout or the key computation changes
+const uint32_t CacheFormatVersion = 3;
+const char CacheMagic[8] = { 'A', 'I', 'C', 'A', 'C', 'H', 'E', '\0' };
+const uint32_t NoMetadata = 0xffffffffu;
+
+// ------------------------------------------------------------------------------------------------
+// 64 bit finalizer of MurmurHash3
+inline uint64_t Mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Fast non-cryptographic 64 bit hash, consumes 8 bytes per step
+uint64_t Hash64(const void *data, size_t len, uint64_t seed) {
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    uint64_t h = seed ^ (len * 0x9e3779b97f4a7c15ULL);
+    for (; len >= 8; len -= 8, p += 8) {
+        uint64_t w;
+        ::memcpy(&w, p, 8);
+        h = (h ^ Mix64(w)) * 0x9e3779b97f4a7c15ULL;
+    }
+    if (len) {
+        uint64_t w = 0;
+        ::memcpy(&w, p, len);
+        h = (h ^ Mix64(w)) * 0x9e3779b97f4a7c15ULL;
+    }
+    return Mix64(h);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+inline uint64_t Hash64(const T &value, uint64_t seed) {
+    return Hash64(&value, sizeof(T), seed);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline uint64_t Hash64(const std::string &value, uint64_t seed) {
+    return Hash64(value.data(), value.length(), Hash64(value.length(), seed));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hashes the complete contents of a file, returns false if it cannot be opened
+bool HashFile(IOSystem *io, const std::string &file, uint64_t &size, uint64_t &hash) {
+    IOStream *stream = io->Open(file, "rb");
+    if (nullptr == stream) {
+        return false;
+    }
+
+    size = stream->FileSize();
+    hash = Hash64(size, 0);
+    if (const uint8_t *contents = stream->GetContents()) {
+        hash = Hash64(contents, static_cast<size_t>(size), hash);
+    } else {
+        // chunks are a multiple of 8 bytes, so the result does not depend on the path taken
+        std::vector<uint8_t> buffer(1 << 20);
+        size_t read;
+        while ((read = stream->Read(buffer.data(), 1, buffer.size())) > 0) {
+            hash = Hash64(buffer.data(), read, hash);
+            if (read < buffer.size()) {
+                break;
+            }
+        }
+    }
+    io->Close(stream);
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hashes all entries of one property map except the ones that do not affect the imported scene.
+// The ignored entries must not count in any way, ReadFile adds some of them itself.
+template <typename Map, typename Func>
+uint64_t HashProperties(const Map &map, const std::set<ImporterPimpl::KeyType> &ignored, uint64_t seed, Func hashValue) {
+    uint64_t hash = seed;
+    uint64_t count = 0;
+    for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it) {
+        if (ignored.count(it->first)) {
+            continue;
+        }
+        hash = hashValue(it->second, Hash64(it->first, hash));
+        ++count;
+    }
+    // separates the maps, so an entry can't pass for one of the next map
+    return Hash64(count, hash);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Appends binary data to an entry
+class EntryWriter {
+public:
+    template <typename T>
+    void Write(const T &value) {
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void *data, size_t len) {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        mData.insert(mData.end(), p, p + len);
+    }
+
+    void WriteString(const aiString &str) {
+        Write<uint32_t>(str.length);
+        WriteBytes(str.data, str.length);
+    }
+
+    void WriteString(const std::string &str) {
+        Write<uint32_t>(static_cast<uint32_t>(str.length()));
+        WriteBytes(str.data(), str.length());
+    }
+
+    template <typename T>
+    void WriteArray(const T *data, unsigned int count) {
+        WriteBytes(data, sizeof(T) * count);
+    }
+
+    std::vector<uint8_t> mData;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Reads binary data from an entry, throws on truncated data
+class EntryReader {
+public:
+    EntryReader(const uint8_t *data, size_t len) :
+            mCur(data), mEnd(data + len) {}
+
+    template <typename T>
+    T Read() {
+        T value;
+        ReadBytes(&value, sizeof(T));
+        return value;
+    }
+
+    void ReadBytes(void *out, size_t len) {
+        ::memcpy(out, Skip(len), len);
+    }
+
+    const uint8_t *Skip(size_t len) {
+        if (static_cast<size_t>(mEnd - mCur) < len) {
+            throw DeadlyImportError("Import cache entry is truncated");
+        }
+        const uint8_t *p = mCur;
+        mCur += len;
+        return p;
+    }
+
+    void ReadString(aiString &str) {
+        const uint32_t len = Read<uint32_t>();
+        if (len >= MAXLEN) {
+            throw DeadlyImportError("Import cache entry holds an invalid string");
+        }
+        ReadBytes(str.data, len);
+        str.data[len] = '\0';
+        str.length = len;
+    }
+
+    std::string ReadStdString() {
+        const uint32_t len = Read<uint32_t>();
+        const char *p = reinterpret_cast<const char *>(Skip(len));
+        return std::string(p, len);
+    }
+
+    template <typename T>
+    T *ReadArray(unsigned int count) {
+        const uint8_t *p = Skip(sizeof(T) * count);
+        T *out = new T[count];
+        ::memcpy(out, p, sizeof(T) * count);
+        return out;
+    }
+
+    template <typename T>
+    void ReadCount(T expected) {
+        if (Read<T>() != expected) {
+            throw DeadlyImportError("Import cache entry does not match its scene");
+        }
+    }
+
+private:
+    const uint8_t *mCur;
+    const uint8_t *mEnd;
+};
+
+// ------------------------------------------------------------------------------------------------
+void WriteMetadata(EntryWriter &out, const aiMetadata *meta) {
+    if (nullptr == meta) {
+        out.Write<uint32_t>(NoMetadata);
+        return;
+    }
+    out.Write<uint32_t>(meta->mNumProperties);
+    for (unsigned int i = 0; i < meta->mNumProperties; ++i) {
+        const aiMetadataEntry &entry = meta->mValues[i];
+        out.WriteString(meta->mKeys[i]);
+        out.Write<uint16_t>(static_cast<uint16_t>(entry.mType));
+        switch (entry.mType) {
+        case AI_BOOL:
+            out.Write<uint8_t>(*static_cast<const bool *>(entry.mData) ? 1 : 0);
+            break;
+        case AI_INT32:
+            out.Write(*static_cast<const int32_t *>(entry.mData));
+            break;
+        case AI_UINT64:
+            out.Write(*static_cast<const uint64_t *>(entry.mData));
+            break;
+        case AI_FLOAT:
+            out.Write(*static_cast<const float *>(entry.mData));
+            break;
+        case AI_DOUBLE:
+            out.Write(*static_cast<const double *>(entry.mData));
+            break;
+        case AI_AISTRING:
+            out.WriteString(*static_cast<const aiString *>(entry.mData));
+            break;
+        case AI_AIVECTOR3D:
+            out.Write(*static_cast<const aiVector3D *>(entry.mData));
+            break;
+        case AI_AIMETADATA:
+            WriteMetadata(out, static_cast<const aiMetadata *>(entry.mData));
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+aiMetadata *ReadMetadata(EntryReader &in) {
+    const uint32_t count = in.Read<uint32_t>();
+    if (NoMetadata == count) {
+        return nullptr;
+    }
+
+    std::unique_ptr<aiMetadata> meta(new aiMetadata);
+    meta->mKeys = new aiString[count];
+    meta->mValues = new aiMetadataEntry[count];
+    meta->mNumProperties = count;
+    for (uint32_t i = 0; i < count; ++i) {
+        aiMetadataEntry &entry = meta->mValues[i];
+        in.ReadString(meta->mKeys[i]);
+        entry.mType = static_cast<aiMetadataType>(in.Read<uint16_t>());
+        switch (entry.mType) {
+        case AI_BOOL:
+            entry.mData = new bool(in.Read<uint8_t>() != 0);
+            break;
+        case AI_INT32:
+            entry.mData = new int32_t(in.Read<int32_t>());
+            break;
+        case AI_UINT64:
+            entry.mData = new uint64_t(in.Read<uint64_t>());
+            break;
+        case AI_FLOAT:
+            entry.mData = new float(in.Read<float>());
+            break;
+        case AI_DOUBLE:
+            entry.mData = new double(in.Read<double>());
+            break;
+        case AI_AISTRING: {
+            aiString *str = new aiString;
+            entry.mData = str;
+            in.ReadString(*str);
+        } break;
+        case AI_AIVECTOR3D:
+            entry.mData = new aiVector3D(in.Read<aiVector3D>());
+            break;
+        case AI_AIMETADATA: {
+            aiMetadata *nested = ReadMetadata(in);
+            entry.mData = nullptr != nested ? nested : new aiMetadata;
+        } break;
+        default:
+            break;
+        }
+    }
+    return meta.release();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool HasNestedMetadata(const aiMetadata *meta) {
+    if (nullptr == meta) {
+        return false;
+    }
+    for (unsigned int i = 0; i < meta->mNumProperties; ++i) {
+        if (AI_AIMETADATA == meta->mValues[i].mType) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Assbin drops nested node metadata; such nodes get their metadata replaced
+void WriteNodeExtras(EntryWriter &out, const aiNode *node) {
+    const bool nested = HasNestedMetadata(node->mMetaData);
+    out.Write<uint8_t>(nested ? 1 : 0);
+    if (nested) {
+        WriteMetadata(out, node->mMetaData);
+    }
+    out.Write<uint32_t>(node->mNumChildren);
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        WriteNodeExtras(out, node->mChildren[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReadNodeExtras(EntryReader &in, aiNode *node) {
+    if (in.Read<uint8_t>()) {
+        aiMetadata *meta = ReadMetadata(in);
+        delete node->mMetaData;
+        node->mMetaData = meta;
+    }
+    in.ReadCount<uint32_t>(node->mNumChildren);
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        ReadNodeExtras(in, node->mChildren[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteMeshExtras(EntryWriter &out, const aiMesh *mesh) {
+    out.WriteString(mesh->mName);
+    out.Write<uint32_t>(mesh->mMethod);
+    out.Write(mesh->mAABB);
+
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        const aiString *name = mesh->GetTextureCoordsName(i);
+        out.Write<uint8_t>(nullptr != name ? 1 : 0);
+        if (nullptr != name) {
+            out.WriteString(*name);
+        }
+    }
+
+    out.Write<uint32_t>(mesh->mNumBones);
+    for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
+        const aiBone *bone = mesh->mBones[i];
+        out.Write<uint8_t>(nullptr != bone->mArmature ? 1 : 0);
+        if (nullptr != bone->mArmature) {
+            out.WriteString(bone->mArmature->mName);
+        }
+        out.Write<uint8_t>(nullptr != bone->mNode ? 1 : 0);
+        if (nullptr != bone->mNode) {
+            out.WriteString(bone->mNode->mName);
+        }
+    }
+
+    out.Write<uint32_t>(mesh->mNumMeshlets);
+    if (mesh->mNumMeshlets) {
+        out.WriteArray(mesh->mMeshlets, mesh->mNumMeshlets);
+        out.Write<uint32_t>(mesh->mNumMeshletVertices);
+        out.WriteArray(mesh->mMeshletVertices, mesh->mNumMeshletVertices);
+        out.WriteArray(mesh->mMeshletIndices, mesh->mNumFaces * 3);
+    }
+
+    out.Write<uint32_t>(mesh->mNumAnimMeshes);
+    for (unsigned int i = 0; i < mesh->mNumAnimMeshes; ++i) {
+        const aiAnimMesh *anim = mesh->mAnimMeshes[i];
+        const unsigned int n = anim->mNumVertices;
+        out.WriteString(anim->mName);
+        out.Write<uint32_t>(n);
+        out.Write(anim->mWeight);
+
+        // one bit per present array, in the order they are written below
+        uint32_t present = 0;
+        present |= anim->mVertices ? 1u : 0u;
+        present |= anim->mNormals ? 2u : 0u;
+        present |= anim->mTangents ? 4u : 0u;
+        present |= anim->mBitangents ? 8u : 0u;
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            present |= anim->mColors[c] ? 1u << (4 + c) : 0u;
+        }
+        for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+            present |= anim->mTextureCoords[t] ? 1u << (4 + AI_MAX_NUMBER_OF_COLOR_SETS + t) : 0u;
+        }
+        out.Write(present);
+
+        if (anim->mVertices) out.WriteArray(anim->mVertices, n);
+        if (anim->mNormals) out.WriteArray(anim->mNormals, n);
+        if (anim->mTangents) out.WriteArray(anim->mTangents, n);
+        if (anim->mBitangents) out.WriteArray(anim->mBitangents, n);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            if (anim->mColors[c]) out.WriteArray(anim->mColors[c], n);
+        }
+        for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+            if (anim->mTextureCoords[t]) out.WriteArray(anim->mTextureCoords[t], n);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReadMeshExtras(EntryReader &in, aiScene *scene, aiMesh *mesh) {
+    in.ReadString(mesh->mName);
+    mesh->mMethod = in.Read<uint32_t>();
+    mesh->mAABB = in.Read<aiAABB>();
+
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        if (in.Read<uint8_t>()) {
+            aiString name;
+            in.ReadString(name);
+            mesh->SetTextureCoordsName(i, name);
+        }
+    }
+
+    in.ReadCount<uint32_t>(mesh->mNumBones);
+    for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
+        aiBone *bone = mesh->mBones[i];
+        aiString name;
+        if (in.Read<uint8_t>()) {
+            in.ReadString(name);
+            bone->mArmature = scene->mRootNode->FindNode(name);
+        }
+        if (in.Read<uint8_t>()) {
+            in.ReadString(name);
+            bone->mNode = scene->mRootNode->FindNode(name);
+        }
+    }
+
+    const uint32_t numMeshlets = in.Read<uint32_t>();
+    if (numMeshlets) {
+        mesh->mMeshlets = in.ReadArray<aiMeshlet>(numMeshlets);
+        mesh->mNumMeshlets = numMeshlets;
+        mesh->mNumMeshletVertices = in.Read<uint32_t>();
+        mesh->mMeshletVertices = in.ReadArray<unsigned int>(mesh->mNumMeshletVertices);
+        mesh->mMeshletIndices = in.ReadArray<unsigned char>(mesh->mNumFaces * 3);
+    }
+
+    const uint32_t numAnimMeshes = in.Read<uint32_t>();
+    if (0 == numAnimMeshes) {
+        return;
+    }
+    mesh->mAnimMeshes = new aiAnimMesh *[numAnimMeshes]();
+    for (unsigned int i = 0; i < numAnimMeshes; ++i) {
+        aiAnimMesh *anim = new aiAnimMesh;
+        mesh->mAnimMeshes[i] = anim;
+        mesh->mNumAnimMeshes = i + 1;
+
+        in.ReadString(anim->mName);
+        const unsigned int n = anim->mNumVertices = in.Read<uint32_t>();
+        anim->mWeight = in.Read<float>();
+
+        const uint32_t present = in.Read<uint32_t>();
+        if (present & 1u) anim->mVertices = in.ReadArray<aiVector3D>(n);
+        if (present & 2u) anim->mNormals = in.ReadArray<aiVector3D>(n);
+        if (present & 4u) anim->mTangents = in.ReadArray<aiVector3D>(n);
+        if (present & 8u) anim->mBitangents = in.ReadArray<aiVector3D>(n);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            if (present & (1u << (4 + c))) anim->mColors[c] = in.ReadArray<aiColor4D>(n);
+        }
+        for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+            if (present & (1u << (4 + AI_MAX_NUMBER_OF_COLOR_SETS + t))) anim->mTextureCoords[t] = in.ReadArray<aiVector3D>(n);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void WriteAnimationExtras(EntryWriter &out, const aiAnimation *anim) {
+    out.Write<uint32_t>(anim->mNumMeshChannels);
+    for (unsigned int i = 0; i < anim->mNumMeshChannels; ++i) {
+        const aiMeshAnim *channel = anim->mMeshChannels[i];
+        out.WriteString(channel->mName);
+        out.Write<uint32_t>(channel->mNumKeys);
+        for (unsigned int k = 0; k < channel->mNumKeys; ++k) {
+            out.Write(channel->mKeys[k].mTime);
+            out.Write<uint32_t>(channel->mKeys[k].mValue);
+        }
+    }
+
+    out.Write<uint32_t>(anim->mNumMorphMeshChannels);
+    for (unsigned int i = 0; i < anim->mNumMorphMeshChannels; ++i) {
+        const aiMeshMorphAnim *channel = anim->mMorphMeshChannels[i];
+        out.WriteString(channel->mName);
+        out.Write<uint32_t>(channel->mNumKeys);
+        for (unsigned int k = 0; k < channel->mNumKeys; ++k) {
+            const aiMeshMorphKey &key = channel->mKeys[k];
+            out.Write(key.mTime);
+            out.Write<uint32_t>(key.mNumValuesAndWeights);
+            out.WriteArray(key.mValues, key.mNumValuesAndWeights);
+            out.WriteArray(key.mWeights, key.mNumValuesAndWeights);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReadAnimationExtras(EntryReader &in, aiAnimation *anim) {
+    const uint32_t numMeshChannels = in.Read<uint32_t>();
+    if (numMeshChannels) {
+        anim->mMeshChannels = new aiMeshAnim *[numMeshChannels]();
+        for (unsigned int i = 0; i < numMeshChannels; ++i) {
+            aiMeshAnim *channel = new aiMeshAnim;
+            anim->mMeshChannels[i] = channel;
+            anim->mNumMeshChannels = i + 1;
+
+            in.ReadString(channel->mName);
+            const uint32_t numKeys = in.Read<uint32_t>();
+            channel->mKeys = new aiMeshKey[numKeys];
+            channel->mNumKeys = numKeys;
+            for (unsigned int k = 0; k < numKeys; ++k) {
+                channel->mKeys[k].mTime = in.Read<double>();
+                channel->mKeys[k].mValue = in.Read<uint32_t>();
+            }
+        }
+    }
+
+    const uint32_t numMorphChannels = in.Read<uint32_t>();
+    if (numMorphChannels) {
+        anim->mMorphMeshChannels = new aiMeshMorphAnim *[numMorphChannels]();
+        for (unsigned int i = 0; i < numMorphChannels; ++i) {
+            aiMeshMorphAnim *channel = new aiMeshMorphAnim;
+            anim->mMorphMeshChannels[i] = channel;
+            anim->mNumMorphMeshChannels = i + 1;
+
+            in.ReadString(channel->mName);
+            const uint32_t numKeys = in.Read<uint32_t>();
+            channel->mKeys = new aiMeshMorphKey[numKeys];
+            channel->mNumKeys = numKeys;
+            for (unsigned int k = 0; k < numKeys; ++k) {
+                aiMeshMorphKey &key = channel->mKeys[k];
+                key.mTime = in.Read<double>();
+                const uint32_t n = in.Read<uint32_t>();
+                if (n) {
+                    // the key only frees its arrays if both are set
+                    std::unique_ptr<unsigned int[]> values(in.ReadArray<unsigned int>(n));
+                    key.mWeights = in.ReadArray<double>(n);
+                    key.mValues = values.release();
+                    key.mNumValuesAndWeights = n;
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Everything the Assbin format does not store, in scene order
+void WriteSceneExtras(EntryWriter &out, const aiScene *scene) {
+    out.WriteString(scene->mName);
+    WriteMetadata(out, scene->mMetaData);
+    WriteNodeExtras(out, scene->mRootNode);
+
+    out.Write<uint32_t>(scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        WriteMeshExtras(out, scene->mMeshes[i]);
+    }
+
+    out.Write<uint32_t>(scene->mNumAnimations);
+    for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+        WriteAnimationExtras(out, scene->mAnimations[i]);
+    }
+
+    out.Write<uint32_t>(scene->mNumTextures);
+    for (unsigned int i = 0; i < scene->mNumTextures; ++i) {
+        out.WriteString(scene->mTextures[i]->mFilename);
+    }
+
+    // Assbin writes only the members used by the respective light type
+    out.Write<uint32_t>(scene->mNumLights);
+    for (unsigned int i = 0; i < scene->mNumLights; ++i) {
+        const aiLight *light = scene->mLights[i];
+        out.Write(light->mPosition);
+        out.Write(light->mDirection);
+        out.Write(light->mUp);
+        out.Write(light->mAttenuationConstant);
+        out.Write(light->mAttenuationLinear);
+        out.Write(light->mAttenuationQuadratic);
+        out.Write(light->mAngleInnerCone);
+        out.Write(light->mAngleOuterCone);
+        out.Write(light->mSize);
+    }
+
+    out.Write<uint32_t>(scene->mNumCameras);
+    for (unsigned int i = 0; i < scene->mNumCameras; ++i) {
+        out.Write(scene->mCameras[i]->mOrthographicWidth);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReadSceneExtras(EntryReader &in, aiScene *scene) {
+    in.ReadString(scene->mName);
+    delete scene->mMetaData;
+    scene->mMetaData = ReadMetadata(in);
+    ReadNodeExtras(in, scene->mRootNode);
+
+    in.ReadCount<uint32_t>(scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        ReadMeshExtras(in, scene, scene->mMeshes[i]);
+    }
+
+    in.ReadCount<uint32_t>(scene->mNumAnimations);
+    for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+        ReadAnimationExtras(in, scene->mAnimations[i]);
+    }
+
+    in.ReadCount<uint32_t>(scene->mNumTextures);
+    for (unsigned int i = 0; i < scene->mNumTextures; ++i) {
+        in.ReadString(scene->mTextures[i]->mFilename);
+    }
+
+    in.ReadCount<uint32_t>(scene->mNumLights);
+    for (unsigned int i = 0; i < scene->mNumLights; ++i) {
+        aiLight *light = scene->mLights[i];
+        light->mPosition = in.Read<aiVector3D>();
+        light->mDirection = in.Read<aiVector3D>();
+        light->mUp = in.Read<aiVector3D>();
+        light->mAttenuationConstant = in.Read<float>();
+        light->mAttenuationLinear = in.Read<float>();
+        light->mAttenuationQuadratic = in.Read<float>();
+        light->mAngleInnerCone = in.Read<float>();
+        light->mAngleOuterCone = in.Read<float>();
+        light->mSize = in.Read<aiVector2D>();
+    }
+
+    in.ReadCount<uint32_t>(scene->mNumCameras);
+    for (unsigned int i = 0; i < scene->mNumCameras; ++i) {
+        scene->mCameras[i]->mOrthographicWidth = in.Read<float>();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string KeyToString(uint64_t key) {
+    char buffer[17];
+    ::snprintf(buffer, sizeof(buffer), "%08x%08x", static_cast<unsigned int>(key >> 32), static_cast<unsigned int>(key));
+    return buffer;
+}
+
+} // namespace
+
+#endif // AI_IMPORTCACHE_ENABLED
+
+// ------------------------------------------------------------------------------------------------
+// Forwards everything to the wrapped IOSystem and remembers the files opened successfully.
+// The streams are returned unwrapped so loaders keep direct access to their contents.
+class ImportCache::Recorder : public IOSystem {
+public:
+    explicit Recorder(IOSystem *io) :
+            mWrapped(io) {}
+
+    bool Exists(const char *pFile) const override {
+        return mWrapped->Exists(pFile);
+    }
+
+    char getOsSeparator() const override {
+        return mWrapped->getOsSeparator();
+    }
+
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override {
+        IOStream *stream = mWrapped->Open(pFile, pMode);
+        if (nullptr != stream) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFiles.insert(pFile);
+        }
+        return stream;
+    }
+
+    void Close(IOStream *pFile) override {
+        mWrapped->Close(pFile);
+    }
+
+    bool ComparePaths(const char *one, const char *second) const override {
+        return mWrapped->ComparePaths(one, second);
+    }
+
+    bool PushDirectory(const std::string &path) override {
+        return mWrapped->PushDirectory(path);
+    }
+
+    const std::string &CurrentDirectory() const override {
+        return mWrapped->CurrentDirectory();
+    }
+
+    size_t StackSize() const override {
+        return mWrapped->StackSize();
+    }
+
+    bool PopDirectory() override {
+        return mWrapped->PopDirectory();
+    }
+
+    bool CreateDirectory(const std::string &path) override {
+        return mWrapped->CreateDirectory(path);
+    }
+
+    bool ChangeDirectory(const std::string &path) override {
+        return mWrapped->ChangeDirectory(path);
+    }
+
+    bool DeleteFile(const std::string &file) override {
+        return mWrapped->DeleteFile(file);
+    }
+
+    std::set<std::string> GetFiles() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mFiles;
+    }
+
+private:
+    IOSystem *mWrapped;
+    std::mutex mMutex;
+    std::set<std::string> mFiles;
+};
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::ImportCache(const std::string &directory, IOSystem *io) :
+        mDirectory(directory),
+        mIOHandler(io),
+        mRecorder(new Recorder(io)),
+        mKey(0),
+        mPrepared(false) {
+    if (!mDirectory.empty() && mDirectory.back() != '/' && mDirectory.back() != '\\') {
+        mDirectory += '/';
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::~ImportCache() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+IOSystem *ImportCache::GetIOSystem() const {
+    return mRecorder.get();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::Prepare(const ImporterPimpl &pimpl, const std::string &file, unsigned int flags) {
+#ifndef AI_IMPORTCACHE_ENABLED
+    (void)pimpl;
+    (void)file;
+    (void)flags;
+    ASSIMP_LOG_WARN("Import cache requires the Assbin importer and exporter, ignoring " AI_CONFIG_IMPORT_CACHE_DIRECTORY);
+    return false;
+#else
+    uint64_t size = 0, contentHash = 0;
+    if (!HashFile(mIOHandler, file, size, contentHash)) {
+        return false;
+    }
+
+    uint64_t key = Hash64(CacheFormatVersion, 0);
+    key = Hash64(aiGetVersionMajor(), key);
+    key = Hash64(aiGetVersionMinor(), key);
+    key = Hash64(aiGetVersionPatch(), key);
+    key = Hash64(aiGetVersionRevision(), key);
+    key = Hash64(aiGetCompileFlags(), key);
+    key = Hash64(file, key);
+    key = Hash64(size, key);
+    key = Hash64(contentHash, key);
+    key = Hash64(flags, key);
+
+    // Properties that only steer how the import runs, or that are written by the import itself
+    std::set<ImporterPimpl::KeyType> ignored;
+    ignored.insert(SuperFastHash(AI_CONFIG_IMPORT_CACHE_DIRECTORY));
+    ignored.insert(SuperFastHash(AI_CONFIG_GLOB_MEASURE_TIME));
+    ignored.insert(SuperFastHash(AI_CONFIG_PP_THREAD_COUNT));
+    ignored.insert(SuperFastHash(AI_CONFIG_APP_SCALE_KEY));
+    ignored.insert(SuperFastHash("importerIndex"));
+    ignored.insert(SuperFastHash("sourceFilePath"));
+
+    key = HashProperties(pimpl.mIntProperties, ignored, key, [](int value, uint64_t seed) {
+        return Hash64(value, seed);
+    });
+    key = HashProperties(pimpl.mFloatProperties, ignored, key, [](ai_real value, uint64_t seed) {
+        return Hash64(value, seed);
+    });
+    key = HashProperties(pimpl.mStringProperties, ignored, key, [](const std::string &value, uint64_t seed) {
+        return Hash64(value, seed);
+    });
+    key = HashProperties(pimpl.mMatrixProperties, ignored, key, [](const aiMatrix4x4 &value, uint64_t seed) {
+        return Hash64(value, seed);
+    });
+    // The objects behind pointer properties cannot be hashed, only their presence counts
+    key = HashProperties(pimpl.mPointerProperties, ignored, key, [](void *, uint64_t seed) {
+        return seed;
+    });
+
+    mFile = file;
+    mKey = key;
+    mPrepared = true;
+    return true;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene *ImportCache::Load(Importer *importer) {
+#ifndef AI_IMPORTCACHE_ENABLED
+    (void)importer;
+    return nullptr;
+#else
+    if (!mPrepared) {
+        return nullptr;
+    }
+
+    const std::string path = mDirectory + KeyToString(mKey) + ".aicache";
+    DefaultIOSystem fs;
+    std::vector<uint8_t> data;
+    {
+        std::unique_ptr<IOStream> stream(fs.Open(path.c_str(), "rb"));
+        if (!stream) {
+            ASSIMP_LOG_DEBUG("Import cache miss for ", mFile);
+            return nullptr;
+        }
+        data.resize(stream->FileSize());
+        if (stream->Read(data.data(), 1, data.size()) != data.size()) {
+            ASSIMP_LOG_WARN("Import cache: failed to read ", path);
+            return nullptr;
+        }
+    }
+
+    try {
+        EntryReader in(data.data(), data.size());
+        char magic[sizeof(CacheMagic)];
+        in.ReadBytes(magic, sizeof(magic));
+        if (::memcmp(magic, CacheMagic, sizeof(magic)) != 0 || in.Read<uint32_t>() != CacheFormatVersion || in.Read<uint64_t>() != mKey) {
+            ASSIMP_LOG_WARN("Import cache: ignoring foreign or outdated entry ", path);
+            return nullptr;
+        }
+
+        // the source file itself is part of the key, only the files it references need checking
+        const uint32_t numDependencies = in.Read<uint32_t>();
+        for (uint32_t i = 0; i < numDependencies; ++i) {
+            const std::string dependency = in.ReadStdString();
+            const uint64_t size = in.Read<uint64_t>();
+            const uint64_t hash = in.Read<uint64_t>();
+            if (dependency == mFile) {
+                continue;
+            }
+            uint64_t currentSize = 0, currentHash = 0;
+            if (!HashFile(mIOHandler, dependency, currentSize, currentHash) || currentSize != size || currentHash != hash) {
+                ASSIMP_LOG_INFO("Import cache: ", dependency, " has changed, reimporting ", mFile);
+                return nullptr;
+            }
+        }
+
+        const float appScale = in.Read<float>();
+        const uint64_t assbinSize = in.Read<uint64_t>();
+        const uint8_t *assbin = in.Skip(static_cast<size_t>(assbinSize));
+
+        MemoryIOSystem io(assbin, static_cast<size_t>(assbinSize), nullptr);
+        AssbinImporter loader;
+        std::unique_ptr<aiScene> scene(loader.ReadFile(importer, AI_MEMORYIO_MAGIC_FILENAME, &io));
+        if (!scene) {
+            ASSIMP_LOG_WARN("Import cache: damaged entry ", path, ": ", loader.GetErrorText());
+            return nullptr;
+        }
+        ReadSceneExtras(in, scene.get());
+
+        importer->SetPropertyFloat(AI_CONFIG_APP_SCALE_KEY, appScale);
+        ASSIMP_LOG_INFO("Import cache hit for ", mFile);
+        return scene.release();
+    } catch (const std::exception &e) {
+        ASSIMP_LOG_WARN("Import cache: damaged entry ", path, ": ", e.what());
+        return nullptr;
+    }
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::Store(const aiScene *scene, float appScale) {
+#ifndef AI_IMPORTCACHE_ENABLED
+    (void)scene;
+    (void)appScale;
+#else
+    if (!mPrepared || nullptr == scene) {
+        return;
+    }
+
+    const std::string path = mDirectory + KeyToString(mKey) + ".aicache";
+    try {
+        EntryWriter out;
+        out.WriteBytes(CacheMagic, sizeof(CacheMagic));
+        out.Write<uint32_t>(CacheFormatVersion);
+        out.Write<uint64_t>(mKey);
+
+        std::set<std::string> files = mRecorder->GetFiles();
+        files.insert(mFile);
+        out.Write<uint32_t>(static_cast<uint32_t>(files.size()));
+        for (std::set<std::string>::const_iterator it = files.begin(); it != files.end(); ++it) {
+            uint64_t size = 0, hash = 0;
+            if (!HashFile(mIOHandler, *it, size, hash)) {
+                ASSIMP_LOG_WARN("Import cache: cannot reopen ", *it, ", not caching ", mFile);
+                return;
+            }
+            out.WriteString(*it);
+            out.Write(size);
+            out.Write(hash);
+        }
+        out.Write(appScale);
+
+        BlobIOSystem blobIO;
+        DumpSceneToAssbin(blobIO.GetMagicFileName(), "", &blobIO, scene, false, false);
+        std::unique_ptr<aiExportDataBlob> blob(blobIO.GetBlobChain());
+        if (!blob) {
+            ASSIMP_LOG_WARN("Import cache: failed to serialize ", mFile);
+            return;
+        }
+        out.Write<uint64_t>(blob->size);
+        out.WriteBytes(blob->data, blob->size);
+        blob.reset();
+
+        WriteSceneExtras(out, scene);
+
+        // write under a private name first so readers never see a partial entry
+        DefaultIOSystem fs;
+        fs.CreateDirectory(mDirectory);
+        const size_t unique = std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+                              static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        const std::string temp = path + "." + KeyToString(unique) + ".tmp";
+        {
+            std::unique_ptr<IOStream> stream(fs.Open(temp.c_str(), "wb"));
+            if (!stream) {
+                ASSIMP_LOG_WARN("Import cache: cannot write to ", mDirectory);
+                return;
+            }
+            if (stream->Write(out.mData.data(), 1, out.mData.size()) != out.mData.size()) {
+                stream.reset();
+                fs.DeleteFile(temp);
+                ASSIMP_LOG_WARN("Import cache: failed to write ", temp);
+                return;
+            }
+        }
+        if (0 != std::rename(temp.c_str(), path.c_str())) {
+            // rename() does not replace existing files on all platforms
+            std::remove(path.c_str());
+            if (0 != std::rename(temp.c_str(), path.c_str())) {
+                fs.DeleteFile(temp);
+                ASSIMP_LOG_WARN("Import cache: failed to create ", path);
+                return;
+            }
+        }
+        ASSIMP_LOG_INFO("Import cache: stored ", mFile, " as ", path);
+    } catch (const std::exception &e) {
+        ASSIMP_LOG_WARN("Import cache: failed to store ", mFile, ": ", e.what());
+    }
+#endif
+}
+
+} // namespace Assimp
@@ -0,0 +1,126 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ImportCache.h
+ *  @brief On-disk cache of imported and post-processed scenes,
+ *    see #AI_CONFIG_IMPORT_CACHE_DIRECTORY
+ */
+#pragma once
+#ifndef AI_IMPORTCACHE_H_INC
+#define AI_IMPORTCACHE_H_INC
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct aiScene;
+
+namespace Assimp {
+
+class Importer;
+class ImporterPimpl;
+class IOSystem;
+
+// ---------------------------------------------------------------------------
+/** One lookup in the import cache.
+ *
+ *  An entry is a single file <directory>/<key>.aicache. It holds the list of
+ *  files read during the original import together with their sizes and
+ *  content hashes, an uncompressed Assbin dump of the final scene and an
+ *  extension block for the scene data Assbin does not cover. The key hashes
+ *  the source file's path and content, the post-processing flags and all
+ *  import properties, so any change of the configuration selects a different
+ *  entry while a change of a referenced file invalidates the entry.
+ *
+ *  Usage by Importer::ReadFile(): Prepare(), then Load(). On a miss the
+ *  import runs on GetIOSystem() so the opened files are recorded, and
+ *  Store() writes the resulting scene. Errors never propagate to the caller,
+ *  an unusable entry is a miss and a failed store is logged as a warning.
+ */
+class ImportCache {
+public:
+    // -------------------------------------------------------------------
+    /** @param directory Cache directory, created on first store.
+     *  @param io IOSystem used for the source file and its dependencies. */
+    ImportCache(const std::string &directory, IOSystem *io);
+    ~ImportCache();
+
+    ImportCache(const ImportCache &) = delete;
+    ImportCache &operator=(const ImportCache &) = delete;
+
+    // -------------------------------------------------------------------
+    /** Computes the key of the given import. Must be called before the
+     *  import modifies any properties.
+     *  @return false if the cache cannot be used for this file. */
+    bool Prepare(const ImporterPimpl &pimpl, const std::string &file, unsigned int flags);
+
+    // -------------------------------------------------------------------
+    /** Loads the scene stored under the prepared key.
+     *  @return The scene or nullptr on a miss. On a hit the importer's
+     *    #AI_CONFIG_APP_SCALE_KEY is restored to its value after the
+     *    original import. */
+    aiScene *Load(Importer *importer);
+
+    // -------------------------------------------------------------------
+    /** IOSystem to import through on a miss. It forwards to the IOSystem
+     *  passed to the constructor and records every file opened. */
+    IOSystem *GetIOSystem() const;
+
+    // -------------------------------------------------------------------
+    /** Writes the scene under the prepared key.
+     *  @param appScale Value of #AI_CONFIG_APP_SCALE_KEY after the import. */
+    void Store(const aiScene *scene, float appScale);
+
+private:
+    class Recorder;
+
+    std::string mDirectory;
+    IOSystem *mIOHandler;
+    std::unique_ptr<Recorder> mRecorder;
+    std::string mFile;
+    uint64_t mKey;
+    bool mPrepared;
+};
+
+} // namespace Assimp
+
+#endif // AI_IMPORTCACHE_H_INC
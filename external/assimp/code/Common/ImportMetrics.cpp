@@ -0,0 +1,242 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ImportMetrics.cpp
+ *  @brief Implementation of the per-step import measurements
+ */
+
+#include <assimp/ImportMetrics.h>
+#include <assimp/mesh.h>
+#include <assimp/scene.h>
+
+#include <cstdio>
+
+#ifdef _WIN32
+#    include <windows.h>
+#    include <psapi.h>
+#    ifdef _MSC_VER
+#        pragma comment(lib, "psapi.lib")
+#    endif
+#else
+#    include <sys/resource.h>
+#    include <sys/time.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// CPU time used by all threads of the process in seconds
+double GetProcessCpuTime() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    const uint64_t k = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+    const uint64_t u = (static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+    return static_cast<double>(k + u) * 1e-7; // 100ns units
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// Peak resident set size of the process in bytes
+uint64_t GetPeakMemory() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss); // bytes
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void CountGeometry(const aiScene *scene, unsigned int &meshes, uint64_t &vertices, uint64_t &faces) {
+    meshes = 0;
+    vertices = faces = 0;
+    if (nullptr == scene || nullptr == scene->mMeshes) {
+        return;
+    }
+    meshes = scene->mNumMeshes;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        if (const aiMesh *mesh = scene->mMeshes[i]) {
+            vertices += mesh->mNumVertices;
+            faces += mesh->mNumFaces;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void AppendJsonString(std::string &out, const std::string &in) {
+    out += '"';
+    for (const char c : in) {
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                out += escaped;
+            } else {
+                out += c;
+            }
+            break;
+        }
+    }
+    out += '"';
+}
+
+// ------------------------------------------------------------------------------------------------
+// Writes seconds as microseconds with three decimals, independent of the C locale
+void AppendMicroseconds(std::string &out, double seconds) {
+    const long long ns = seconds > 0.0 ? static_cast<long long>(seconds * 1e9 + 0.5) : 0;
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%lld.%03lld", ns / 1000, ns % 1000);
+    out += buffer;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+ImportMetrics::ImportMetrics() :
+        mFile(), mSteps(), mOrigin(std::chrono::steady_clock::now()), mStepStart(mOrigin), mStepCpuStart(0.0), mInStep(false) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportMetrics::Clear() {
+    mFile.clear();
+    mSteps.clear();
+    mOrigin = std::chrono::steady_clock::now();
+    mInStep = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+double ImportMetrics::GetTotalWallTime() const {
+    if (mSteps.empty()) {
+        return 0.0;
+    }
+    const ImportStep &last = mSteps.back();
+    return last.mStart + last.mWallTime;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportMetrics::BeginStep(const char *name, const aiScene *scene) {
+    mSteps.push_back(ImportStep());
+    ImportStep &step = mSteps.back();
+    step.mName = name;
+    CountGeometry(scene, step.mMeshesIn, step.mVerticesIn, step.mFacesIn);
+
+    mInStep = true;
+    mStepCpuStart = GetProcessCpuTime();
+    mStepStart = std::chrono::steady_clock::now();
+    step.mStart = std::chrono::duration<double>(mStepStart - mOrigin).count();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportMetrics::EndStep(const aiScene *scene) {
+    if (!mInStep) {
+        return;
+    }
+    mInStep = false;
+
+    ImportStep &step = mSteps.back();
+    step.mWallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - mStepStart).count();
+    step.mCpuTime = GetProcessCpuTime() - mStepCpuStart;
+    step.mPeakMemory = GetPeakMemory();
+    CountGeometry(scene, step.mMeshesOut, step.mVerticesOut, step.mFacesOut);
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportMetrics::ToChromeTrace() const {
+    // complete events ("ph":"X") with microsecond timestamps, one track for the importing thread
+    std::string out = "{\"traceEvents\":[";
+    char buffer[256];
+    for (size_t i = 0; i < mSteps.size(); ++i) {
+        const ImportStep &step = mSteps[i];
+        out += (i == 0) ? "\n" : ",\n";
+        out += "{\"name\":";
+        AppendJsonString(out, step.mName);
+        out += ",\"cat\":\"assimp\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":";
+        AppendMicroseconds(out, step.mStart);
+        out += ",\"dur\":";
+        AppendMicroseconds(out, step.mWallTime);
+        out += ",\"args\":{\"cpu_us\":";
+        AppendMicroseconds(out, step.mCpuTime);
+        snprintf(buffer, sizeof(buffer),
+                ",\"peak_memory\":%llu,"
+                "\"meshes_in\":%u,\"vertices_in\":%llu,\"faces_in\":%llu,"
+                "\"meshes_out\":%u,\"vertices_out\":%llu,\"faces_out\":%llu}}",
+                static_cast<unsigned long long>(step.mPeakMemory),
+                step.mMeshesIn, static_cast<unsigned long long>(step.mVerticesIn), static_cast<unsigned long long>(step.mFacesIn),
+                step.mMeshesOut, static_cast<unsigned long long>(step.mVerticesOut), static_cast<unsigned long long>(step.mFacesOut));
+        out += buffer;
+    }
+    out += "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"file\":";
+    AppendJsonString(out, mFile);
+    out += "}}\n";
+    return out;
+}
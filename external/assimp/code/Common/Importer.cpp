@@ -65,9 +65,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/Importer.h"
 #include "Common/BaseProcess.h"
 #include "Common/DefaultProgressHandler.h"
+#include "Common/ImportCache.h"
 #include "PostProcessing/ProcessHelper.h"
+#include "Common/SceneBuffer.h"
 #include "Common/ScenePreprocessor.h"
 #include "Common/ScenePrivate.h"
+#include "Common/TaskScheduler.h"
 
 #include <assimp/BaseImporter.h>
 #include <assimp/GenericProperty.h>
@@ -82,6 +85,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <set>
 #include <memory>
 #include <cctype>
+#include <cstdlib>
+#include <typeinfo>
+#if defined(__GNUC__) || defined(__clang__)
+#   include <cxxabi.h>
+#endif
 
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
@@ -105,6 +113,38 @@ namespace Assimp {
 using namespace Assimp;
 using namespace Assimp::Intern;
 
+// ------------------------------------------------------------------------------------------------
+// (Re-)create the thread pool for importers and mesh-local steps if the requested size changed
+static void UpdateTaskScheduler(const Importer *pImp, ImporterPimpl *pimpl) {
+    const int numThreads = pImp->GetPropertyInteger(AI_CONFIG_PP_THREAD_COUNT, 1);
+    if (numThreads == 1 || numThreads < 0) {
+        delete pimpl->mTaskScheduler;
+        pimpl->mTaskScheduler = nullptr;
+    } else {
+        const unsigned int requested = numThreads ? static_cast<unsigned int>(numThreads) : std::max(1u, std::thread::hardware_concurrency());
+        if (nullptr == pimpl->mTaskScheduler || pimpl->mTaskScheduler->GetNumThreads() != requested) {
+            delete pimpl->mTaskScheduler;
+            pimpl->mTaskScheduler = new TaskScheduler(requested);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Class name of a post-processing step without namespace, used to label the import metrics
+static std::string GetPostProcessingStepName(const BaseProcess *process) {
+    std::string name = typeid(*process).name();
+#if defined(__GNUC__) || defined(__clang__)
+    int status = 0;
+    if (char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status)) {
+        name = demangled;
+        free(demangled);
+    }
+#endif
+    // MSVC reports "class Assimp::XYZProcess"
+    const std::string::size_type pos = name.find_last_of(": ");
+    return (std::string::npos != pos) ? name.substr(pos + 1) : name;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Intern::AllocateFromAssimpHeap serves as abstract base class. It overrides
 // new and delete (and their array counterparts) of public API classes (e.g. Logger) to
@@ -193,6 +233,9 @@ Importer::~Importer() {
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    // Stop the post-processing threads
+    delete pimpl->mTaskScheduler;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -603,6 +646,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             ASSIMP_LOG_DEBUG("(Deleting previous scene)");
             FreeScene();
         }
+        pimpl->mMetrics.Clear();
 
         // First check if the file is accessible at all
         if( !pimpl->mIOHandler->Exists( pFile)) {
@@ -615,6 +659,37 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
         if (profiler) {
             profiler->BeginRegion("total");
+            pimpl->mMetrics.mFile = pFile;
+        }
+
+        // Serve the finished scene from the import cache if it is enabled and up to date
+        std::unique_ptr<ImportCache> cache;
+        const std::string cacheDirectory = GetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY, "");
+        if (!cacheDirectory.empty()) {
+            cache.reset(new ImportCache(cacheDirectory, pimpl->mIOHandler));
+            if (profiler) {
+                pimpl->mMetrics.BeginStep("cache", nullptr);
+            }
+            if (cache->Prepare(*pimpl, pFile, pFlags)) {
+                pimpl->mScene = cache->Load(this);
+            } else {
+                cache.reset();
+            }
+            if (profiler) {
+                pimpl->mMetrics.EndStep(pimpl->mScene);
+            }
+            if (pimpl->mScene) {
+                ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
+                SetPropertyString("sourceFilePath", pFile);
+                if (profiler) {
+                    profiler->EndRegion("total");
+                }
+                return pimpl->mScene;
+            }
+        }
+
+        if (profiler) {
+            pimpl->mMetrics.BeginStep("read", nullptr);
         }
 
         // Find an worker class which can handle the file extension.
@@ -711,14 +786,18 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         pimpl->mProgressHandler->UpdateFileRead( 0, fileSize );
 
         if (profiler) {
+            pimpl->mMetrics.EndStep(nullptr);
             profiler->BeginRegion("import");
+            pimpl->mMetrics.BeginStep("import", nullptr);
         }
 
-        pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
+        UpdateTaskScheduler(this, pimpl);
+        pimpl->mScene = imp->ReadFile( this, pFile, cache ? cache->GetIOSystem() : pimpl->mIOHandler);
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
         if (profiler) {
             profiler->EndRegion("import");
+            pimpl->mMetrics.EndStep(pimpl->mScene);
         }
 
         SetPropertyString("sourceFilePath", pFile);
@@ -735,8 +814,14 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
             // The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
             if (pFlags & aiProcess_ValidateDataStructure) {
+                if (profiler) {
+                    pimpl->mMetrics.BeginStep("validate", pimpl->mScene);
+                }
                 ValidateDSProcess ds;
                 ds.ExecuteOnScene (this);
+                if (profiler) {
+                    pimpl->mMetrics.EndStep(pimpl->mScene);
+                }
                 if (!pimpl->mScene) {
                     return nullptr;
                 }
@@ -746,6 +831,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             // Preprocess the scene and prepare it for post-processing
             if (profiler) {
                 profiler->BeginRegion("preprocess");
+                pimpl->mMetrics.BeginStep("preprocess", pimpl->mScene);
             }
 
             ScenePreprocessor pre(pimpl->mScene);
@@ -753,10 +839,21 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
             if (profiler) {
                 profiler->EndRegion("preprocess");
+                pimpl->mMetrics.EndStep(pimpl->mScene);
             }
 
             // Ensure that the validation process won't be called twice
             ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+
+            if (cache && pimpl->mScene) {
+                if (profiler) {
+                    pimpl->mMetrics.BeginStep("cache-store", pimpl->mScene);
+                }
+                cache->Store(pimpl->mScene, GetPropertyFloat(AI_CONFIG_APP_SCALE_KEY, 1.0f));
+                if (profiler) {
+                    pimpl->mMetrics.EndStep(pimpl->mScene);
+                }
+            }
         }
         // if failed, extract the error string
         else if( !pimpl->mScene) {
@@ -808,16 +905,27 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
         return pimpl->mScene;
     }
 
+    // Post-processing steps free and replace arrays, give the parts they write to their own copies
+    CopySceneBuffers(pimpl->mScene, pFlags);
+
     // In debug builds: run basic flag validation
     ai_assert(_ValidateFlags(pFlags));
     ASSIMP_LOG_INFO("Entering post processing pipeline");
 
+    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
     // The ValidateDS process plays an exceptional role. It isn't contained in the global
     // list of post-processing steps, so we need to call it manually.
     if (pFlags & aiProcess_ValidateDataStructure) {
+        if (profiler) {
+            pimpl->mMetrics.BeginStep("validate", pimpl->mScene);
+        }
         ValidateDSProcess ds;
         ds.ExecuteOnScene (this);
+        if (profiler) {
+            pimpl->mMetrics.EndStep(pimpl->mScene);
+        }
         if (!pimpl->mScene) {
             return nullptr;
         }
@@ -837,19 +945,22 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+    UpdateTaskScheduler(this, pimpl);
+
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
         if( process->IsActive( pFlags)) {
             if (profiler) {
                 profiler->BeginRegion("postprocess");
+                pimpl->mMetrics.BeginStep(GetPostProcessingStepName(process).c_str(), pimpl->mScene);
             }
 
             process->ExecuteOnScene ( this );
 
             if (profiler) {
                 profiler->EndRegion("postprocess");
+                pimpl->mMetrics.EndStep(pimpl->mScene);
             }
         }
         if( !pimpl->mScene) {
@@ -907,6 +1018,8 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
         return pimpl->mScene;
     }
 
+    CopySceneBuffers(pimpl->mScene);
+
     // In debug builds: run basic flag validation
     ASSIMP_LOG_INFO( "Entering customized post processing pipeline" );
 
@@ -939,12 +1052,14 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
 
     if ( profiler ) {
         profiler->BeginRegion( "postprocess" );
+        pimpl->mMetrics.BeginStep( "postprocess", pimpl->mScene );
     }
 
     rootProcess->ExecuteOnScene( this );
 
     if ( profiler ) {
         profiler->EndRegion( "postprocess" );
+        pimpl->mMetrics.EndStep( pimpl->mScene );
     }
 
     // If the extra verbose mode is active, execute the ValidateDataStructureStep again - after each step
@@ -1182,6 +1297,13 @@ void AddNodeWeight(unsigned int& iScene,const aiNode* pcNode) {
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Get the measurements of the last import
+const ImportMetrics& Importer::GetImportMetrics() const {
+    ai_assert(nullptr != pimpl);
+    return pimpl->mMetrics;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get the memory requirements of the scene
 void Importer::GetMemoryRequirements(aiMemoryInfo& in) const {
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include <string>
 #include <assimp/matrix4x4.h>
+#include <assimp/ImportMetrics.h>
 
 struct aiScene;
 
@@ -58,6 +59,7 @@ namespace Assimp    {
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    class TaskScheduler;
 
 
 //! @cond never
@@ -126,6 +128,12 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Thread pool for mesh-local post-process steps, see #AI_CONFIG_PP_THREAD_COUNT */
+    TaskScheduler* mTaskScheduler;
+
+    /** Measurements of the last import, see #AI_CONFIG_GLOB_MEASURE_TIME */
+    ImportMetrics mMetrics;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
 };
@@ -147,7 +155,9 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mMatrixProperties(),
         mPointerProperties(),
         bExtraVerbose( false ),
-        mPPShared( nullptr ) {
+        mPPShared( nullptr ),
+        mTaskScheduler( nullptr ),
+        mMetrics() {
     // empty
 }
 //! @endcond
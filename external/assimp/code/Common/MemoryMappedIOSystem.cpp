@@ -0,0 +1,212 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Memory mapped implementation of IOSystem */
+
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Only plain read modes are mapped, anything that may write goes to DefaultIOSystem
+bool IsReadOnlyMode(const char *mode) {
+    return mode[0] == 'r' && nullptr == ::strchr(mode, '+');
+}
+
+#ifdef _WIN32
+std::wstring Utf8ToWide(const char *in) {
+    int size = MultiByteToWideChar(CP_UTF8, 0, in, -1, nullptr, 0);
+    if (size <= 1) {
+        return std::wstring();
+    }
+    std::wstring out(static_cast<size_t>(size) - 1, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, in, -1, &out[0], size);
+    return out;
+}
+#endif
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedIOStream::MemoryMappedIOStream(uint8_t *pData, size_t pSize, void *pMapping) :
+        mData(pData),
+        mSize(pSize),
+        mPos(0),
+        mMapping(pMapping) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+MemoryMappedIOStream::~MemoryMappedIOStream() {
+#ifdef _WIN32
+    ::UnmapViewOfFile(mData);
+    ::CloseHandle(static_cast<HANDLE>(mMapping));
+#else
+    ::munmap(mData, mSize);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Read(void *pvBuffer, size_t pSize, size_t pCount) {
+    if (0 == pCount) {
+        return 0;
+    }
+    ai_assert(nullptr != pvBuffer);
+    ai_assert(0 != pSize);
+
+    // like fread(), only complete elements are read
+    const size_t cnt = std::min(pCount, (mSize - mPos) / pSize);
+    const size_t ofs = pSize * cnt;
+    ::memcpy(pvBuffer, mData + mPos, ofs);
+    mPos += ofs;
+    return cnt;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Write(const void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+    return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiReturn MemoryMappedIOStream::Seek(size_t pOffset, aiOrigin pOrigin) {
+    if (aiOrigin_SET == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        mPos = pOffset;
+    } else if (aiOrigin_END == pOrigin) {
+        if (pOffset > mSize) {
+            return AI_FAILURE;
+        }
+        mPos = mSize - pOffset;
+    } else {
+        if (pOffset + mPos > mSize) {
+            return AI_FAILURE;
+        }
+        mPos += pOffset;
+    }
+    return AI_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::Tell() const {
+    return mPos;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t MemoryMappedIOStream::FileSize() const {
+    return mSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MemoryMappedIOStream::Flush() {
+    // nothing to flush, the mapping is read-only for the file
+}
+
+// ------------------------------------------------------------------------------------------------
+const uint8_t *MemoryMappedIOStream::GetContents() const {
+    return mData;
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream *MemoryMappedIOSystem::Open(const char *strFile, const char *strMode) {
+    ai_assert(strFile != nullptr);
+    ai_assert(strMode != nullptr);
+    if (!IsReadOnlyMode(strMode)) {
+        return DefaultIOSystem::Open(strFile, strMode);
+    }
+
+#ifdef _WIN32
+    const std::wstring name = Utf8ToWide(strFile);
+    HANDLE file = ::CreateFileW(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file) {
+        return nullptr;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (::GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        // copy-on-write so loaders may patch the data in place
+        mapping = ::CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    }
+    ::CloseHandle(file);
+    if (nullptr == mapping) {
+        return DefaultIOSystem::Open(strFile, strMode);
+    }
+    void *data = ::MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (nullptr == data) {
+        ::CloseHandle(mapping);
+        return DefaultIOSystem::Open(strFile, strMode);
+    }
+    return new MemoryMappedIOStream(static_cast<uint8_t *>(data), static_cast<size_t>(size.QuadPart), mapping);
+#else
+    const int fd = ::open(strFile, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    void *data = MAP_FAILED;
+    if (0 == ::fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0) {
+        // private mapping: pages a loader writes to are copied, the file stays untouched
+        data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (MAP_FAILED == data) {
+        return DefaultIOSystem::Open(strFile, strMode);
+    }
+    return new MemoryMappedIOStream(static_cast<uint8_t *>(data), static_cast<size_t>(st.st_size), nullptr);
+#endif
+}
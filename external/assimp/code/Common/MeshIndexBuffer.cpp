@@ -0,0 +1,214 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file MeshIndexBuffer.cpp
+ *  @brief Implementation of the flat index buffer helpers
+ */
+
+#include "Common/MeshIndexBuffer.h"
+
+#include <assimp/ai_assert.h>
+#include <assimp/mesh.h>
+#include <assimp/scene.h>
+
+#include <cstring>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+unsigned int *AllocateIndexBuffer(aiMesh *mesh, unsigned int numFaces, unsigned int faceSize) {
+    ai_assert(nullptr == mesh->mFaces && nullptr == mesh->mIndexBuffer);
+
+    mesh->mNumFaces = numFaces;
+    mesh->mNumIndices = numFaces * faceSize;
+    mesh->mIndexBuffer = new unsigned int[mesh->mNumIndices];
+    mesh->mFaceOffsets = nullptr;
+    mesh->mFaceStride = faceSize;
+    return mesh->mIndexBuffer;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int *AllocateIndexBuffer(aiMesh *mesh, const unsigned int *faceSizes, unsigned int numFaces) {
+    ai_assert(nullptr == mesh->mFaces && nullptr == mesh->mIndexBuffer);
+
+    bool uniform = true;
+    unsigned int numIndices = 0;
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        uniform = uniform && faceSizes[i] == faceSizes[0];
+        numIndices += faceSizes[i];
+    }
+    if (uniform) {
+        return AllocateIndexBuffer(mesh, numFaces, numFaces ? faceSizes[0] : 0);
+    }
+
+    mesh->mNumFaces = numFaces;
+    mesh->mNumIndices = numIndices;
+    mesh->mIndexBuffer = new unsigned int[numIndices];
+    mesh->mFaceOffsets = new unsigned int[numFaces + 1];
+    mesh->mFaceStride = 0;
+
+    unsigned int offset = 0;
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        mesh->mFaceOffsets[i] = offset;
+        offset += faceSizes[i];
+    }
+    mesh->mFaceOffsets[numFaces] = offset;
+    return mesh->mIndexBuffer;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AttachIndexBuffer(aiMesh *mesh, unsigned int *buffer, unsigned int numIndices) {
+    ai_assert(nullptr == mesh->mIndexBuffer);
+
+    mesh->mIndexBuffer = buffer;
+    mesh->mNumIndices = numIndices;
+    mesh->mFaceOffsets = nullptr;
+    mesh->mFaceStride = mesh->mNumFaces ? mesh->mFaces[0].mNumIndices : 0;
+
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        ai_assert(mesh->mFaces[i].mIndices >= buffer);
+        ai_assert(mesh->mFaces[i].mIndices + mesh->mFaces[i].mNumIndices <= buffer + numIndices);
+        if (mesh->mFaces[i].mNumIndices != mesh->mFaceStride) {
+            mesh->mFaceStride = 0;
+            break;
+        }
+    }
+    if (mesh->mFaceStride) {
+        return;
+    }
+
+    mesh->mFaceOffsets = new unsigned int[mesh->mNumFaces + 1];
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        mesh->mFaceOffsets[i] = static_cast<unsigned int>(mesh->mFaces[i].mIndices - buffer);
+    }
+    mesh->mFaceOffsets[mesh->mNumFaces] = numIndices;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BuildFaceViews(aiMesh *mesh) {
+    if (nullptr == mesh->mIndexBuffer || nullptr != mesh->mFaces) {
+        return;
+    }
+
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        aiFace &face = mesh->mFaces[i];
+        face.mNumIndices = mesh->GetFaceSize(i);
+        face.mIndices = mesh->mIndexBuffer + mesh->GetFaceOffset(i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReleaseIndexBuffer(aiMesh *mesh) {
+    if (nullptr == mesh->mIndexBuffer) {
+        return;
+    }
+
+    BuildFaceViews(mesh);
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        aiFace &face = mesh->mFaces[i];
+        unsigned int *indices = new unsigned int[face.mNumIndices];
+        ::memcpy(indices, face.mIndices, face.mNumIndices * sizeof(unsigned int));
+        face.mIndices = indices;
+    }
+
+    delete[] mesh->mIndexBuffer;
+    delete[] mesh->mFaceOffsets;
+    mesh->mIndexBuffer = nullptr;
+    mesh->mFaceOffsets = nullptr;
+    mesh->mNumIndices = 0;
+    mesh->mFaceStride = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ReleaseIndexBuffers(aiScene *scene) {
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        if (scene->mMeshes[i]) {
+            ReleaseIndexBuffer(scene->mMeshes[i]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void DeleteFaces(aiMesh *mesh) {
+    if (mesh->mIndexBuffer && mesh->mFaces) {
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            mesh->mFaces[i].mIndices = nullptr;
+        }
+    }
+    delete[] mesh->mFaces;
+    delete[] mesh->mIndexBuffer;
+    delete[] mesh->mFaceOffsets;
+
+    mesh->mFaces = nullptr;
+    mesh->mNumFaces = 0;
+    mesh->mIndexBuffer = nullptr;
+    mesh->mFaceOffsets = nullptr;
+    mesh->mNumIndices = 0;
+    mesh->mFaceStride = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CopyIndexBuffer(aiMesh *dest, const aiMesh *src) {
+    dest->mIndexBuffer = nullptr;
+    dest->mFaceOffsets = nullptr;
+    dest->mFaces = nullptr;
+    if (nullptr == src->mIndexBuffer) {
+        return;
+    }
+
+    dest->mIndexBuffer = new unsigned int[src->mNumIndices];
+    ::memcpy(dest->mIndexBuffer, src->mIndexBuffer, src->mNumIndices * sizeof(unsigned int));
+    if (src->mFaceOffsets) {
+        dest->mFaceOffsets = new unsigned int[src->mNumFaces + 1];
+        ::memcpy(dest->mFaceOffsets, src->mFaceOffsets, (src->mNumFaces + 1) * sizeof(unsigned int));
+    }
+    if (src->mFaces) {
+        dest->mFaces = new aiFace[src->mNumFaces];
+        for (unsigned int i = 0; i < src->mNumFaces; ++i) {
+            dest->mFaces[i].mNumIndices = src->mFaces[i].mNumIndices;
+            dest->mFaces[i].mIndices = dest->mIndexBuffer + (src->mFaces[i].mIndices - src->mIndexBuffer);
+        }
+    }
+}
+
+} // namespace Assimp
@@ -0,0 +1,101 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file MeshIndexBuffer.h
+ *  @brief Helpers for meshes storing their face indices in a flat buffer,
+ *    see aiMesh::mIndexBuffer
+ */
+#pragma once
+#ifndef AI_MESHINDEXBUFFER_H_INC
+#define AI_MESHINDEXBUFFER_H_INC
+
+struct aiMesh;
+struct aiScene;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Allocates the index buffer of a mesh whose faces all have faceSize
+ *  indices. The mesh must not have faces yet. mFaces remains nullptr, the
+ *  ScenePreprocessor builds the face views once the importer is done.
+ *  @return The index buffer, numFaces * faceSize in size. */
+unsigned int *AllocateIndexBuffer(aiMesh *mesh, unsigned int numFaces, unsigned int faceSize);
+
+// ---------------------------------------------------------------------------
+/** Allocates the index buffer of a mesh whose faces differ in size.
+ *  @param faceSizes Number of indices of each face, numFaces in size.
+ *  @return The index buffer. */
+unsigned int *AllocateIndexBuffer(aiMesh *mesh, const unsigned int *faceSizes, unsigned int numFaces);
+
+// ---------------------------------------------------------------------------
+/** Makes buffer the index buffer of a mesh whose faces already point into
+ *  it, face after face, and sets up the stride or the face offsets. The
+ *  mesh takes ownership of the buffer. */
+void AttachIndexBuffer(aiMesh *mesh, unsigned int *buffer, unsigned int numIndices);
+
+// ---------------------------------------------------------------------------
+/** Creates the faces of a mesh that only has an index buffer so far, their
+ *  index arrays point into the buffer. */
+void BuildFaceViews(aiMesh *mesh);
+
+// ---------------------------------------------------------------------------
+/** Gives each face of the mesh its own index array and frees the index
+ *  buffer. Afterwards the faces can be modified freely. */
+void ReleaseIndexBuffer(aiMesh *mesh);
+
+// ---------------------------------------------------------------------------
+/** ReleaseIndexBuffer() for all meshes of a scene. Runs before any
+ *  post-processing step that does not support index buffers. */
+void ReleaseIndexBuffers(aiScene *scene);
+
+// ---------------------------------------------------------------------------
+/** Frees the faces of a mesh along with its index buffer. */
+void DeleteFaces(aiMesh *mesh);
+
+// ---------------------------------------------------------------------------
+/** Gives dest, a flat copy of src, its own copy of the index buffer, the
+ *  face offsets and the faces. */
+void CopyIndexBuffer(aiMesh *dest, const aiMesh *src);
+
+} // namespace Assimp
+
+#endif // AI_MESHINDEXBUFFER_H_INC
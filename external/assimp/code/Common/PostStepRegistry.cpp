@@ -89,6 +89,12 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS
 #   include "PostProcessing/ImproveCacheLocality.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_GENERATELODS_PROCESS
+#   include "PostProcessing/GenerateLODsProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+#   include "PostProcessing/GenerateMeshletsProcess.h"
+#endif
 #ifndef ASSIMP_BUILD_NO_FIXINFACINGNORMALS_PROCESS
 #   include "PostProcessing/FixNormalsStep.h"
 #endif
@@ -254,9 +260,15 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_LIMITBONEWEIGHTS_PROCESS)
     out.push_back( new LimitBoneWeightsProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENERATELODS_PROCESS)
+    out.push_back( new GenerateLODsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
     out.push_back( new ImproveCacheLocalityProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENMESHLETS_PROCESS)
+    out.push_back( new GenerateMeshletsProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_GENBOUNDINGBOXES_PROCESS)
     out.push_back(new GenBoundingBoxesProcess);
 #endif
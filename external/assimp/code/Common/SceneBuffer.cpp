@@ -0,0 +1,697 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file SceneBuffer.cpp
+ *  @brief Implementation of scene owned memory blocks
+ */
+
+#include "Common/SceneBuffer.h"
+#include "Common/ScenePrivate.h"
+
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+typedef std::vector<std::shared_ptr<SceneBuffer>> SceneBufferList;
+
+// Parts of a scene a visit covers
+enum SceneParts {
+    SceneParts_Meshes = 0x1,
+    SceneParts_Textures = 0x2,
+    SceneParts_Animations = 0x4,
+    SceneParts_All = 0x7
+};
+
+// Post-processing steps that modify neither the arrays of a mesh nor free them
+const unsigned int ReadOnlyMeshSteps = aiProcess_ValidateDataStructure | aiProcess_RemoveRedundantMaterials |
+                                       aiProcess_EmbedTextures | aiProcess_GenBoundingBoxes | aiProcess_PopulateArmatureData;
+
+// Post-processing steps that modify or free animation keys
+const unsigned int AnimationSteps = aiProcess_MakeLeftHanded | aiProcess_GlobalScale | aiProcess_FindInvalidData |
+                                    aiProcess_RemoveComponent | aiProcess_PreTransformVertices;
+
+// Post-processing steps that free textures
+const unsigned int TextureSteps = aiProcess_RemoveComponent;
+
+// Arrays packed into a buffer start at multiples of this
+const size_t PackAlignment = 16;
+
+// ------------------------------------------------------------------------------------------------
+size_t AlignPackOffset(size_t offset) {
+    return (offset + PackAlignment - 1) & ~(PackAlignment - 1);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Size of the pixel data of a texture in bytes, see SceneCombiner::Copy(aiTexture**, ...)
+size_t GetTextureDataSize(const aiTexture *texture) {
+    if (0 == texture->mHeight) {
+        return texture->mWidth;
+    }
+    return static_cast<size_t>(texture->mWidth) * texture->mHeight * sizeof(aiTexel);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Calls visit(array, count) for every array of a mesh that may live in a buffer. The faces are
+// passed along with their mesh, the visitors handle the indices and the index buffer themselves.
+template <typename Visitor>
+void VisitMeshArrays(aiMesh *mesh, Visitor &visit) {
+    const unsigned int n = mesh->mNumVertices;
+    visit(mesh->mVertices, n);
+    visit(mesh->mNormals, n);
+    visit(mesh->mTangents, n);
+    visit(mesh->mBitangents, n);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        visit(mesh->mColors[c], n);
+    }
+    for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+        visit(mesh->mTextureCoords[t], n);
+    }
+
+    visit(mesh);
+    visit(mesh->mMeshlets, mesh->mNumMeshlets);
+    visit(mesh->mMeshletVertices, mesh->mNumMeshletVertices);
+    visit(mesh->mMeshletIndices, mesh->mNumFaces * 3);
+
+    if (mesh->mBones) {
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            if (aiBone *bone = mesh->mBones[b]) {
+                visit(bone->mWeights, bone->mNumWeights);
+            }
+        }
+    }
+
+    if (mesh->mAnimMeshes) {
+        for (unsigned int a = 0; a < mesh->mNumAnimMeshes; ++a) {
+            aiAnimMesh *anim = mesh->mAnimMeshes[a];
+            if (nullptr == anim) {
+                continue;
+            }
+            const unsigned int na = anim->mNumVertices;
+            visit(anim->mVertices, na);
+            visit(anim->mNormals, na);
+            visit(anim->mTangents, na);
+            visit(anim->mBitangents, na);
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                visit(anim->mColors[c], na);
+            }
+            for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+                visit(anim->mTextureCoords[t], na);
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Morph keys own their value arrays and are never placed in buffers
+template <typename Visitor>
+void VisitAnimationArrays(aiAnimation *anim, Visitor &visit) {
+    if (anim->mChannels) {
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+            if (aiNodeAnim *channel = anim->mChannels[c]) {
+                visit(channel->mPositionKeys, channel->mNumPositionKeys);
+                visit(channel->mRotationKeys, channel->mNumRotationKeys);
+                visit(channel->mScalingKeys, channel->mNumScalingKeys);
+            }
+        }
+    }
+    if (anim->mMeshChannels) {
+        for (unsigned int c = 0; c < anim->mNumMeshChannels; ++c) {
+            if (aiMeshAnim *channel = anim->mMeshChannels[c]) {
+                visit(channel->mKeys, channel->mNumKeys);
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Visitor>
+void VisitSceneArrays(aiScene *scene, unsigned int parts, Visitor &visit) {
+    if ((parts & SceneParts_Meshes) && scene->mMeshes) {
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            if (scene->mMeshes[i]) {
+                VisitMeshArrays(scene->mMeshes[i], visit);
+            }
+        }
+    }
+    if ((parts & SceneParts_Textures) && scene->mTextures) {
+        for (unsigned int i = 0; i < scene->mNumTextures; ++i) {
+            if (scene->mTextures[i]) {
+                visit(scene->mTextures[i]);
+            }
+        }
+    }
+    if ((parts & SceneParts_Animations) && scene->mAnimations) {
+        for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+            if (scene->mAnimations[i]) {
+                VisitAnimationArrays(scene->mAnimations[i], visit);
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Parts of a scene the given post-processing steps may write to
+unsigned int GetWrittenParts(unsigned int steps) {
+    unsigned int parts = 0;
+    if (steps & ~ReadOnlyMeshSteps) {
+        parts |= SceneParts_Meshes;
+    }
+    if (steps & TextureSteps) {
+        parts |= SceneParts_Textures;
+    }
+    if (steps & AnimationSteps) {
+        parts |= SceneParts_Animations;
+    }
+    return parts;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sets arrays in buffers to nullptr. The indices of a face array in a buffer are left alone, the
+// face array itself is shared and must not be written to.
+struct DetachArray {
+    explicit DetachArray(const SceneBufferSet &buffers) :
+            mBuffers(buffers) {}
+
+    template <typename T>
+    void operator()(T *&array, unsigned int) {
+        if (nullptr != array && mBuffers.Contains(array)) {
+            array = nullptr;
+        }
+    }
+
+    void operator()(aiFace *&faces, unsigned int count) {
+        if (nullptr == faces) {
+            return;
+        }
+        if (mBuffers.Contains(faces)) {
+            faces = nullptr;
+            return;
+        }
+        for (unsigned int i = 0; i < count; ++i) {
+            (*this)(faces[i].mIndices, faces[i].mNumIndices);
+        }
+    }
+
+    void operator()(aiMesh *mesh) {
+        if (nullptr == mesh->mIndexBuffer) {
+            (*this)(mesh->mFaces, mesh->mNumFaces);
+            return;
+        }
+        (*this)(mesh->mFaceOffsets, 0);
+        if (nullptr != mesh->mFaces && mBuffers.Contains(mesh->mFaces)) {
+            mesh->mFaces = nullptr;
+        }
+        if (mBuffers.Contains(mesh->mIndexBuffer)) {
+            // faces on the heap must not free their views into the buffer
+            for (unsigned int i = 0; mesh->mFaces && i < mesh->mNumFaces; ++i) {
+                mesh->mFaces[i].mIndices = nullptr;
+            }
+            mesh->mIndexBuffer = nullptr;
+        }
+    }
+
+    void operator()(aiTexture *texture) {
+        (*this)(texture->pcData, 0);
+    }
+
+    const SceneBufferSet &mBuffers;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Replaces arrays in buffers with heap copies
+struct CopyArray {
+    explicit CopyArray(const SceneBufferSet &buffers) :
+            mBuffers(buffers) {}
+
+    template <typename T>
+    void operator()(T *&array, unsigned int count) {
+        if (nullptr != array && mBuffers.Contains(array)) {
+            T *copy = new T[count];
+            std::copy(array, array + count, copy);
+            array = copy;
+        }
+    }
+
+    void operator()(aiFace *&faces, unsigned int count) {
+        if (nullptr == faces) {
+            return;
+        }
+        if (mBuffers.Contains(faces)) {
+            aiFace *copy = new aiFace[count];
+            for (unsigned int i = 0; i < count; ++i) {
+                copy[i].mNumIndices = faces[i].mNumIndices;
+                copy[i].mIndices = faces[i].mIndices;
+            }
+            faces = copy;
+        }
+        for (unsigned int i = 0; i < count; ++i) {
+            (*this)(faces[i].mIndices, faces[i].mNumIndices);
+        }
+    }
+
+    void operator()(aiMesh *mesh) {
+        if (nullptr == mesh->mIndexBuffer) {
+            (*this)(mesh->mFaces, mesh->mNumFaces);
+            return;
+        }
+        (*this)(mesh->mFaceOffsets, mesh->mNumFaces + 1);
+
+        const unsigned int *buffer = mesh->mIndexBuffer;
+        (*this)(mesh->mIndexBuffer, mesh->mNumIndices);
+        if (nullptr == mesh->mFaces) {
+            return;
+        }
+        if (mBuffers.Contains(mesh->mFaces)) {
+            aiFace *copy = new aiFace[mesh->mNumFaces];
+            for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+                copy[i].mNumIndices = mesh->mFaces[i].mNumIndices;
+                copy[i].mIndices = mesh->mFaces[i].mIndices;
+            }
+            mesh->mFaces = copy;
+        }
+
+        // the faces are views into the index buffer
+        if (buffer != mesh->mIndexBuffer) {
+            for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+                mesh->mFaces[i].mIndices = mesh->mIndexBuffer + (mesh->mFaces[i].mIndices - buffer);
+            }
+        }
+    }
+
+    void operator()(aiTexture *texture) {
+        if (nullptr != texture->pcData && mBuffers.Contains(texture->pcData)) {
+            const size_t size = GetTextureDataSize(texture);
+            aiTexel *copy = new aiTexel[(size + sizeof(aiTexel) - 1) / sizeof(aiTexel)];
+            ::memcpy(copy, texture->pcData, size);
+            texture->pcData = copy;
+        }
+    }
+
+    const SceneBufferSet &mBuffers;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Collects the buffers arrays point into
+struct MarkArray {
+    explicit MarkArray(const SceneBufferSet &buffers) :
+            mBuffers(buffers) {}
+
+    template <typename T>
+    void operator()(T *array, unsigned int) {
+        Mark(array);
+    }
+
+    void operator()(aiFace *faces, unsigned int count) {
+        if (nullptr == faces) {
+            return;
+        }
+        Mark(faces);
+        for (unsigned int i = 0; i < count; ++i) {
+            Mark(faces[i].mIndices);
+        }
+    }
+
+    void operator()(aiMesh *mesh) {
+        if (nullptr == mesh->mIndexBuffer) {
+            (*this)(mesh->mFaces, mesh->mNumFaces);
+            return;
+        }
+        Mark(mesh->mFaces);
+        Mark(mesh->mIndexBuffer);
+        Mark(mesh->mFaceOffsets);
+    }
+
+    void operator()(aiTexture *texture) {
+        Mark(texture->pcData);
+    }
+
+    void Mark(const void *array) {
+        if (nullptr != array) {
+            if (const SceneBuffer *buffer = mBuffers.Find(array)) {
+                mUsed.insert(buffer);
+            }
+        }
+    }
+
+    const SceneBufferSet &mBuffers;
+    std::set<const SceneBuffer *> mUsed;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Sums up the space needed to pack the heap arrays of an object
+struct MeasureArray {
+    explicit MeasureArray(const SceneBufferSet &buffers) :
+            mBuffers(buffers), mSize(0) {}
+
+    template <typename T>
+    void operator()(T *array, unsigned int count) {
+        if (nullptr != array && count && !mBuffers.Contains(array)) {
+            Add(sizeof(T) * count);
+        }
+    }
+
+    void operator()(aiFace *faces, unsigned int count) {
+        if (nullptr == faces) {
+            return;
+        }
+        for (unsigned int i = 0; i < count; ++i) {
+            (*this)(faces[i].mIndices, faces[i].mNumIndices);
+        }
+        if (!mBuffers.Contains(faces)) {
+            Add(sizeof(aiFace) * count);
+        }
+    }
+
+    void operator()(aiMesh *mesh) {
+        if (nullptr == mesh->mIndexBuffer) {
+            (*this)(mesh->mFaces, mesh->mNumFaces);
+            return;
+        }
+        (*this)(mesh->mIndexBuffer, mesh->mNumIndices);
+        (*this)(mesh->mFaceOffsets, mesh->mNumFaces + 1);
+        if (nullptr != mesh->mFaces && !mBuffers.Contains(mesh->mFaces)) {
+            Add(sizeof(aiFace) * mesh->mNumFaces);
+        }
+    }
+
+    void operator()(aiTexture *texture) {
+        const size_t size = GetTextureDataSize(texture);
+        if (nullptr != texture->pcData && size && !mBuffers.Contains(texture->pcData)) {
+            Add(size);
+        }
+    }
+
+    void Add(size_t size) {
+        mSize = AlignPackOffset(mSize) + size;
+    }
+
+    const SceneBufferSet &mBuffers;
+    size_t mSize;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Moves the heap arrays of an object into a buffer sized by MeasureArray
+struct PackArray {
+    PackArray(const SceneBufferSet &buffers, SceneBuffer &target) :
+            mBuffers(buffers), mTarget(target), mOffset(0) {}
+
+    template <typename T>
+    void operator()(T *&array, unsigned int count) {
+        if (nullptr != array && count && !mBuffers.Contains(array)) {
+            T *packed = static_cast<T *>(Add(array, sizeof(T) * count));
+            delete[] array;
+            array = packed;
+        }
+    }
+
+    void operator()(aiFace *&faces, unsigned int count) {
+        if (nullptr == faces) {
+            return;
+        }
+        for (unsigned int i = 0; i < count; ++i) {
+            (*this)(faces[i].mIndices, faces[i].mNumIndices);
+        }
+        if (!mBuffers.Contains(faces)) {
+            aiFace *packed = static_cast<aiFace *>(Add(faces, sizeof(aiFace) * count));
+
+            // the indices belong to the packed copy now
+            for (unsigned int i = 0; i < count; ++i) {
+                faces[i].mIndices = nullptr;
+            }
+            delete[] faces;
+            faces = packed;
+        }
+    }
+
+    void operator()(aiMesh *mesh) {
+        if (nullptr == mesh->mIndexBuffer) {
+            (*this)(mesh->mFaces, mesh->mNumFaces);
+            return;
+        }
+        (*this)(mesh->mFaceOffsets, mesh->mNumFaces + 1);
+
+        unsigned int *buffer = mesh->mIndexBuffer;
+        if (mesh->mNumIndices && !mBuffers.Contains(buffer)) {
+            unsigned int *packed = static_cast<unsigned int *>(Add(buffer, sizeof(unsigned int) * mesh->mNumIndices));
+
+            // the faces are views into the index buffer and live on the heap as long as it does
+            ai_assert(nullptr == mesh->mFaces || !mBuffers.Contains(mesh->mFaces));
+            for (unsigned int i = 0; mesh->mFaces && i < mesh->mNumFaces; ++i) {
+                mesh->mFaces[i].mIndices = packed + (mesh->mFaces[i].mIndices - buffer);
+            }
+            delete[] buffer;
+            mesh->mIndexBuffer = packed;
+        }
+        if (nullptr != mesh->mFaces && !mBuffers.Contains(mesh->mFaces)) {
+            aiFace *packed = static_cast<aiFace *>(Add(mesh->mFaces, sizeof(aiFace) * mesh->mNumFaces));
+            for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+                mesh->mFaces[i].mIndices = nullptr;
+            }
+            delete[] mesh->mFaces;
+            mesh->mFaces = packed;
+        }
+    }
+
+    void operator()(aiTexture *texture) {
+        const size_t size = GetTextureDataSize(texture);
+        if (nullptr != texture->pcData && size && !mBuffers.Contains(texture->pcData)) {
+            aiTexel *packed = static_cast<aiTexel *>(Add(texture->pcData, size));
+            delete[] texture->pcData;
+            texture->pcData = packed;
+        }
+    }
+
+    void *Add(const void *data, size_t size) {
+        mOffset = AlignPackOffset(mOffset);
+        ai_assert(mOffset + size <= mTarget.GetSize());
+        uint8_t *out = mTarget.GetData() + mOffset;
+        ::memcpy(out, data, size);
+        mOffset += size;
+        return out;
+    }
+
+    const SceneBufferSet &mBuffers;
+    SceneBuffer &mTarget;
+    size_t mOffset;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Packs the heap arrays reached by visitObject into a new buffer attached to the scene
+template <typename Object>
+void PackObject(aiScene *scene, Object *object, void (*visitObject)(Object *, MeasureArray &),
+        void (*packObject)(Object *, PackArray &)) {
+    if (nullptr == object) {
+        return;
+    }
+    const SceneBufferSet buffers(scene);
+    MeasureArray measure(buffers);
+    visitObject(object, measure);
+    if (0 == measure.mSize) {
+        return;
+    }
+
+    std::shared_ptr<SceneBuffer> buffer = std::make_shared<HeapSceneBuffer>(measure.mSize);
+    PackArray pack(buffers, *buffer);
+    packObject(object, pack);
+    AttachSceneBuffer(scene, std::move(buffer));
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Visitor>
+void VisitTextureArrays(aiTexture *texture, Visitor &visit) {
+    visit(texture);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+SceneBuffer::SceneBuffer(uint8_t *data, size_t size) :
+        mData(data), mSize(size) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SceneBuffer::~SceneBuffer() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+HeapSceneBuffer::HeapSceneBuffer(size_t size) :
+        SceneBuffer(reinterpret_cast<uint8_t *>(new uint64_t[(size + 7) / 8]), size) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+HeapSceneBuffer::~HeapSceneBuffer() {
+    delete[] reinterpret_cast<uint64_t *>(mData);
+}
+
+// ------------------------------------------------------------------------------------------------
+// The mapping is private and writable, see MemoryMappedIOStream
+MappedSceneBuffer::MappedSceneBuffer(MemoryMappedIOStream *stream) :
+        SceneBuffer(const_cast<uint8_t *>(stream->GetContents()), stream->FileSize()),
+        mStream(stream) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+MappedSceneBuffer::~MappedSceneBuffer() {
+    delete mStream;
+}
+
+// ------------------------------------------------------------------------------------------------
+SceneBufferSet::SceneBufferSet(const aiScene *scene) {
+    const ScenePrivateData *priv = ScenePriv(scene);
+    if (nullptr == priv) {
+        return;
+    }
+    mBuffers.reserve(priv->mBuffers.size());
+    for (SceneBufferList::const_iterator it = priv->mBuffers.begin(); it != priv->mBuffers.end(); ++it) {
+        mBuffers.push_back(it->get());
+    }
+    std::sort(mBuffers.begin(), mBuffers.end(), [](const SceneBuffer *a, const SceneBuffer *b) {
+        return a->GetData() < b->GetData();
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+const SceneBuffer *SceneBufferSet::Find(const void *p) const {
+    // last buffer starting at or before p
+    const uint8_t *c = static_cast<const uint8_t *>(p);
+    std::vector<const SceneBuffer *>::const_iterator it = std::upper_bound(mBuffers.begin(), mBuffers.end(), c,
+            [](const uint8_t *a, const SceneBuffer *b) {
+                return a < b->GetData();
+            });
+    if (it == mBuffers.begin()) {
+        return nullptr;
+    }
+    --it;
+    return (*it)->Contains(p) ? *it : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AttachSceneBuffer(aiScene *scene, std::shared_ptr<SceneBuffer> buffer) {
+    ScenePriv(scene)->mBuffers.push_back(std::move(buffer));
+}
+
+// ------------------------------------------------------------------------------------------------
+bool HasSceneBuffers(const aiScene *scene) {
+    const ScenePrivateData *priv = ScenePriv(scene);
+    return nullptr != priv && !priv->mBuffers.empty();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ShareSceneBuffers(aiScene *dest, const aiScene *src) {
+    if (!HasSceneBuffers(src)) {
+        return;
+    }
+    const SceneBufferList &buffers = ScenePriv(src)->mBuffers;
+    SceneBufferList &out = ScenePriv(dest)->mBuffers;
+    out.insert(out.end(), buffers.begin(), buffers.end());
+}
+
+// ------------------------------------------------------------------------------------------------
+void PackSceneBuffers(aiScene *scene) {
+    if (nullptr == ScenePriv(scene)) {
+        return;
+    }
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        PackObject<aiMesh>(scene, scene->mMeshes[i], &VisitMeshArrays<MeasureArray>, &VisitMeshArrays<PackArray>);
+    }
+    for (unsigned int i = 0; i < scene->mNumTextures; ++i) {
+        PackObject<aiTexture>(scene, scene->mTextures[i], &VisitTextureArrays<MeasureArray>, &VisitTextureArrays<PackArray>);
+    }
+    for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+        PackObject<aiAnimation>(scene, scene->mAnimations[i], &VisitAnimationArrays<MeasureArray>,
+                &VisitAnimationArrays<PackArray>);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void DetachSceneBuffers(aiScene *scene) {
+    if (!HasSceneBuffers(scene)) {
+        return;
+    }
+    const SceneBufferSet buffers(scene);
+    DetachArray detach(buffers);
+    VisitSceneArrays(scene, SceneParts_All, detach);
+}
+
+// ------------------------------------------------------------------------------------------------
+void CopySceneBuffers(aiScene *scene, unsigned int steps) {
+    if (!HasSceneBuffers(scene)) {
+        return;
+    }
+    const unsigned int parts = GetWrittenParts(steps);
+    if (0 == parts) {
+        return;
+    }
+
+    ScenePrivateData *priv = ScenePriv(scene);
+    const SceneBufferSet buffers(scene);
+    CopyArray copy(buffers);
+    VisitSceneArrays(scene, parts, copy);
+    if (SceneParts_All == parts) {
+        priv->mBuffers.clear();
+        return;
+    }
+
+    // keep only the buffers the remaining parts still point into
+    MarkArray mark(buffers);
+    VisitSceneArrays(scene, SceneParts_All & ~parts, mark);
+    priv->mBuffers.erase(std::remove_if(priv->mBuffers.begin(), priv->mBuffers.end(),
+                                 [&mark](const std::shared_ptr<SceneBuffer> &buffer) {
+                                     return 0 == mark.mUsed.count(buffer.get());
+                                 }),
+            priv->mBuffers.end());
+}
+
+} // namespace Assimp
@@ -0,0 +1,180 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file SceneBuffer.h
+ *  @brief Memory blocks owned by a scene that its arrays point into
+ */
+#pragma once
+#ifndef AI_SCENEBUFFER_H_INC
+#define AI_SCENEBUFFER_H_INC
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct aiScene;
+
+namespace Assimp {
+
+class MemoryMappedIOStream;
+
+// ---------------------------------------------------------------------------
+/** A block of memory that mesh, texture and animation arrays of a scene
+ *  may point into.
+ *
+ *  Loaders that parse a file in place, such as the AssFlat loader, attach
+ *  the block holding the file to the scene with AttachSceneBuffer() and set
+ *  aiMesh::mVertices, the face indices and other arrays to addresses inside
+ *  it instead of allocating them. PackSceneBuffers() moves the arrays of any
+ *  scene into buffers so that SceneCombiner::CopySceneShared() can share
+ *  them between copies. The scenes keep the buffer alive through reference
+ *  counting and make sure those arrays are never passed to delete[], see
+ *  DetachSceneBuffers() and CopySceneBuffers(). Data in a buffer is treated
+ *  as immutable once more than one scene refers to it.
+ */
+class SceneBuffer {
+public:
+    virtual ~SceneBuffer();
+
+    SceneBuffer(const SceneBuffer &) = delete;
+    SceneBuffer &operator=(const SceneBuffer &) = delete;
+
+    uint8_t *GetData() const {
+        return mData;
+    }
+
+    size_t GetSize() const {
+        return mSize;
+    }
+
+    /** Whether p points into the buffer. */
+    bool Contains(const void *p) const {
+        const uint8_t *c = static_cast<const uint8_t *>(p);
+        return c >= mData && c < mData + mSize;
+    }
+
+protected:
+    SceneBuffer(uint8_t *data, size_t size);
+
+    uint8_t *mData;
+    size_t mSize;
+};
+
+// ---------------------------------------------------------------------------
+/** Heap allocated buffer, aligned to 8 bytes. */
+class HeapSceneBuffer : public SceneBuffer {
+public:
+    explicit HeapSceneBuffer(size_t size);
+    ~HeapSceneBuffer() override;
+};
+
+// ---------------------------------------------------------------------------
+/** Keeps a memory mapped file open and exposes its private, copy-on-write
+ *  mapping. Takes ownership of the stream. */
+class MappedSceneBuffer : public SceneBuffer {
+public:
+    explicit MappedSceneBuffer(MemoryMappedIOStream *stream);
+    ~MappedSceneBuffer() override;
+
+private:
+    MemoryMappedIOStream *mStream;
+};
+
+// ---------------------------------------------------------------------------
+/** The buffers attached to a scene, sorted by address for fast lookups. */
+class SceneBufferSet {
+public:
+    explicit SceneBufferSet(const aiScene *scene);
+
+    /** The buffer p points into or nullptr. */
+    const SceneBuffer *Find(const void *p) const;
+
+    /** Whether p points into one of the buffers. */
+    bool Contains(const void *p) const {
+        return nullptr != Find(p);
+    }
+
+    bool IsEmpty() const {
+        return mBuffers.empty();
+    }
+
+private:
+    std::vector<const SceneBuffer *> mBuffers;
+};
+
+// ---------------------------------------------------------------------------
+/** Makes the scene share ownership of the buffer. Must be called before
+ *  any array of the scene is set to point into the buffer. */
+void AttachSceneBuffer(aiScene *scene, std::shared_ptr<SceneBuffer> buffer);
+
+// ---------------------------------------------------------------------------
+/** Whether arrays of the scene may point into attached buffers. */
+bool HasSceneBuffers(const aiScene *scene);
+
+// ---------------------------------------------------------------------------
+/** Makes dest share ownership of all buffers attached to src. */
+void ShareSceneBuffers(aiScene *dest, const aiScene *src);
+
+// ---------------------------------------------------------------------------
+/** Moves all mesh, texture and animation arrays that are not yet in an
+ *  attached buffer into new heap buffers, one per mesh, texture and
+ *  animation. The contents of the scene do not change. */
+void PackSceneBuffers(aiScene *scene);
+
+// ---------------------------------------------------------------------------
+/** Sets all arrays pointing into attached buffers to nullptr so that
+ *  deleting the scene does not free them. Never writes to the buffers.
+ *  Called by the aiScene destructor. */
+void DetachSceneBuffers(aiScene *scene);
+
+// ---------------------------------------------------------------------------
+/** Gives the scene its own heap copies of the arrays in attached buffers
+ *  that the given post-processing steps may modify or free, and releases
+ *  the buffers no array points into anymore. Runs before post-processing.
+ *  @param steps aiPostProcessSteps flags, ~0u makes the whole scene
+ *    writable. */
+void CopySceneBuffers(aiScene *scene, unsigned int steps = ~0u);
+
+} // namespace Assimp
+
+#endif // AI_SCENEBUFFER_H_INC
@@ -53,6 +53,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
   */
 // ----------------------------------------------------------------------------
 #include "ScenePrivate.h"
+#include "SceneBuffer.h"
+#include "MeshIndexBuffer.h"
+#include "Material/MaterialSystem.h"
 #include "time.h"
 #include <assimp/Hash.h>
 #include <assimp/SceneCombiner.h>
@@ -876,6 +879,11 @@ void SceneCombiner::MergeMeshes(aiMesh **_out, unsigned int /*flags*/,
 
     if (out->mNumFaces) // just for safety
     {
+        // the faces take over the index arrays of the input meshes
+        for (std::vector<aiMesh *>::const_iterator it = begin; it != end; ++it) {
+            ReleaseIndexBuffer(*it);
+        }
+
         // copy faces
         out->mFaces = new aiFace[out->mNumFaces];
         aiFace *pf2 = out->mFaces;
@@ -957,6 +965,7 @@ void SceneCombiner::MergeMaterials(aiMaterial **dest,
                 prop->mType = sprop->mType;
 
                 out->mNumProperties++;
+                UpdateMaterialPropertyIndex(out);
             }
         }
     }
@@ -988,33 +997,156 @@ inline void GetArrayCopy(Type *&dest, ai_uint num) {
 }
 
 // ------------------------------------------------------------------------------------------------
-void SceneCombiner::CopySceneFlat(aiScene **_dest, const aiScene *src) {
-    if (nullptr == _dest || nullptr == src) {
-        return;
+// Keeps arrays in shared scene buffers, copies all others
+template <typename Type>
+inline void GetSharedArrayCopy(Type *&dest, ai_uint num, const SceneBufferSet &shared) {
+    if (dest && !shared.Contains(dest)) {
+        GetArrayCopy(dest, num);
     }
+}
 
-    // reuse the old scene or allocate a new?
-    if (*_dest) {
-        (*_dest)->~aiScene();
-        new (*_dest) aiScene();
+// ------------------------------------------------------------------------------------------------
+static void CopyShared(aiMesh **_dest, const aiMesh *src, const SceneBufferSet &shared) {
+    aiMesh *dest = *_dest = new aiMesh();
+
+    // get a flat copy
+    *dest = *src;
+
+    // and reallocate all arrays that are not shared
+    GetSharedArrayCopy(dest->mVertices, dest->mNumVertices, shared);
+    GetSharedArrayCopy(dest->mNormals, dest->mNumVertices, shared);
+    GetSharedArrayCopy(dest->mTangents, dest->mNumVertices, shared);
+    GetSharedArrayCopy(dest->mBitangents, dest->mNumVertices, shared);
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+        GetSharedArrayCopy(dest->mTextureCoords[n], dest->mNumVertices, shared);
+    }
+    for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+        GetSharedArrayCopy(dest->mColors[n], dest->mNumVertices, shared);
+    }
+
+    // the bones themselves are never shared, their weights might be
+    if (dest->mNumBones) {
+        dest->mBones = new aiBone *[dest->mNumBones];
+        for (unsigned int i = 0; i < dest->mNumBones; ++i) {
+            const aiBone *sbone = src->mBones[i];
+            aiBone *bone = dest->mBones[i] = new aiBone();
+            bone->mName = sbone->mName;
+            bone->mNumWeights = sbone->mNumWeights;
+            bone->mOffsetMatrix = sbone->mOffsetMatrix;
+            bone->mWeights = sbone->mWeights;
+            GetSharedArrayCopy(bone->mWeights, bone->mNumWeights, shared);
+        }
     } else {
-        *_dest = new aiScene();
+        dest->mBones = nullptr;
+    }
+
+    // a shared index buffer comes with shared faces, unless they live on the heap
+    if (src->mIndexBuffer && !shared.Contains(src->mIndexBuffer)) {
+        CopyIndexBuffer(dest, src);
+    } else if (src->mIndexBuffer) {
+        GetSharedArrayCopy(dest->mFaceOffsets, dest->mNumFaces + 1, shared);
+        if (dest->mFaces && !shared.Contains(dest->mFaces)) {
+            dest->mFaces = new aiFace[dest->mNumFaces];
+            for (unsigned int i = 0; i < dest->mNumFaces; ++i) {
+                dest->mFaces[i].mNumIndices = src->mFaces[i].mNumIndices;
+                dest->mFaces[i].mIndices = src->mFaces[i].mIndices;
+            }
+        }
+    } else if (dest->mFaces && !shared.Contains(dest->mFaces)) {
+        // a shared face array comes with shared indices
+        dest->mFaces = new aiFace[dest->mNumFaces];
+        for (unsigned int i = 0; i < dest->mNumFaces; ++i) {
+            aiFace &f = dest->mFaces[i];
+            f.mNumIndices = src->mFaces[i].mNumIndices;
+            f.mIndices = src->mFaces[i].mIndices;
+            GetSharedArrayCopy(f.mIndices, f.mNumIndices, shared);
+        }
+    }
+
+    GetSharedArrayCopy(dest->mMeshlets, dest->mNumMeshlets, shared);
+    GetSharedArrayCopy(dest->mMeshletVertices, dest->mNumMeshletVertices, shared);
+    GetSharedArrayCopy(dest->mMeshletIndices, dest->mNumFaces * 3, shared);
+
+    if (dest->mNumAnimMeshes) {
+        dest->mAnimMeshes = new aiAnimMesh *[dest->mNumAnimMeshes];
+        for (unsigned int i = 0; i < dest->mNumAnimMeshes; ++i) {
+            aiAnimMesh *anim = dest->mAnimMeshes[i] = new aiAnimMesh();
+            *anim = *src->mAnimMeshes[i];
+
+            GetSharedArrayCopy(anim->mVertices, anim->mNumVertices, shared);
+            GetSharedArrayCopy(anim->mNormals, anim->mNumVertices, shared);
+            GetSharedArrayCopy(anim->mTangents, anim->mNumVertices, shared);
+            GetSharedArrayCopy(anim->mBitangents, anim->mNumVertices, shared);
+            for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+                GetSharedArrayCopy(anim->mTextureCoords[n], anim->mNumVertices, shared);
+            }
+            for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+                GetSharedArrayCopy(anim->mColors[n], anim->mNumVertices, shared);
+            }
+        }
+    } else {
+        dest->mAnimMeshes = nullptr;
+    }
+
+    if (src->mTextureCoordsNames != nullptr) {
+        dest->mTextureCoordsNames = new aiString *[AI_MAX_NUMBER_OF_TEXTURECOORDS] {};
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            SceneCombiner::Copy(&dest->mTextureCoordsNames[i], src->mTextureCoordsNames[i]);
+        }
     }
-    CopyScene(_dest, src, false);
 }
 
 // ------------------------------------------------------------------------------------------------
-void SceneCombiner::CopyScene(aiScene **_dest, const aiScene *src, bool allocate) {
-    if (nullptr == _dest || nullptr == src) {
+static void CopyShared(aiTexture **_dest, const aiTexture *src, const SceneBufferSet &shared) {
+    if (!src->pcData || !shared.Contains(src->pcData)) {
+        SceneCombiner::Copy(_dest, src);
         return;
     }
 
-    if (allocate) {
-        *_dest = new aiScene();
+    aiTexture *dest = *_dest = new aiTexture();
+    *dest = *src;
+}
+
+// ------------------------------------------------------------------------------------------------
+static void CopyShared(aiAnimation **_dest, const aiAnimation *src, const SceneBufferSet &shared) {
+    aiAnimation *dest = *_dest = new aiAnimation();
+
+    // get a flat copy
+    *dest = *src;
+
+    if (dest->mNumChannels) {
+        dest->mChannels = new aiNodeAnim *[dest->mNumChannels];
+        for (unsigned int i = 0; i < dest->mNumChannels; ++i) {
+            aiNodeAnim *channel = dest->mChannels[i] = new aiNodeAnim();
+            *channel = *src->mChannels[i];
+
+            GetSharedArrayCopy(channel->mPositionKeys, channel->mNumPositionKeys, shared);
+            GetSharedArrayCopy(channel->mScalingKeys, channel->mNumScalingKeys, shared);
+            GetSharedArrayCopy(channel->mRotationKeys, channel->mNumRotationKeys, shared);
+        }
+    } else {
+        dest->mChannels = nullptr;
+    }
+
+    if (dest->mNumMeshChannels) {
+        dest->mMeshChannels = new aiMeshAnim *[dest->mNumMeshChannels];
+        for (unsigned int i = 0; i < dest->mNumMeshChannels; ++i) {
+            aiMeshAnim *channel = dest->mMeshChannels[i] = new aiMeshAnim();
+            *channel = *src->mMeshChannels[i];
+
+            GetSharedArrayCopy(channel->mKeys, channel->mNumKeys, shared);
+        }
+    } else {
+        dest->mMeshChannels = nullptr;
     }
-    aiScene *dest = *_dest;
-    ai_assert(nullptr != dest);
 
+    // morph keys own their value arrays, these are never shared
+    CopyPtrArray(dest->mMorphMeshChannels, src->mMorphMeshChannels, dest->mNumMorphMeshChannels);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copies the shared parts with CopyShared() if shared is not nullptr
+static void CopySceneContents(aiScene *dest, const aiScene *src, const SceneBufferSet *shared) {
     // copy metadata
     if (nullptr != src->mMetaData) {
         dest->mMetaData = new aiMetadata(*src->mMetaData);
@@ -1022,13 +1154,27 @@ void SceneCombiner::CopyScene(aiScene **_dest, const aiScene *src, bool allocate
 
     // copy animations
     dest->mNumAnimations = src->mNumAnimations;
-    CopyPtrArray(dest->mAnimations, src->mAnimations,
-            dest->mNumAnimations);
+    if (shared && dest->mNumAnimations) {
+        dest->mAnimations = new aiAnimation *[dest->mNumAnimations];
+        for (unsigned int i = 0; i < dest->mNumAnimations; ++i) {
+            CopyShared(&dest->mAnimations[i], src->mAnimations[i], *shared);
+        }
+    } else {
+        CopyPtrArray(dest->mAnimations, src->mAnimations,
+                dest->mNumAnimations);
+    }
 
     // copy textures
     dest->mNumTextures = src->mNumTextures;
-    CopyPtrArray(dest->mTextures, src->mTextures,
-            dest->mNumTextures);
+    if (shared && dest->mNumTextures) {
+        dest->mTextures = new aiTexture *[dest->mNumTextures];
+        for (unsigned int i = 0; i < dest->mNumTextures; ++i) {
+            CopyShared(&dest->mTextures[i], src->mTextures[i], *shared);
+        }
+    } else {
+        CopyPtrArray(dest->mTextures, src->mTextures,
+                dest->mNumTextures);
+    }
 
     // copy materials
     dest->mNumMaterials = src->mNumMaterials;
@@ -1047,14 +1193,22 @@ void SceneCombiner::CopyScene(aiScene **_dest, const aiScene *src, bool allocate
 
     // copy meshes
     dest->mNumMeshes = src->mNumMeshes;
-    CopyPtrArray(dest->mMeshes, src->mMeshes,
-            dest->mNumMeshes);
+    if (shared && dest->mNumMeshes) {
+        dest->mMeshes = new aiMesh *[dest->mNumMeshes];
+        for (unsigned int i = 0; i < dest->mNumMeshes; ++i) {
+            CopyShared(&dest->mMeshes[i], src->mMeshes[i], *shared);
+        }
+    } else {
+        CopyPtrArray(dest->mMeshes, src->mMeshes,
+                dest->mNumMeshes);
+    }
 
     // now - copy the root node of the scene (deep copy, too)
-    Copy(&dest->mRootNode, src->mRootNode);
+    SceneCombiner::Copy(&dest->mRootNode, src->mRootNode);
 
-    // and keep the flags ...
+    // and keep the flags and the name ...
     dest->mFlags = src->mFlags;
+    dest->mName = src->mName;
 
     // source private data might be nullptr if the scene is user-allocated (i.e. for use with the export API)
     if (dest->mPrivate != nullptr) {
@@ -1062,6 +1216,63 @@ void SceneCombiner::CopyScene(aiScene **_dest, const aiScene *src, bool allocate
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::CopySceneFlat(aiScene **_dest, const aiScene *src) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    // reuse the old scene or allocate a new?
+    if (*_dest) {
+        (*_dest)->~aiScene();
+        new (*_dest) aiScene();
+    } else {
+        *_dest = new aiScene();
+    }
+    CopyScene(_dest, src, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::CopyScene(aiScene **_dest, const aiScene *src, bool allocate) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    if (allocate) {
+        *_dest = new aiScene();
+    }
+    aiScene *dest = *_dest;
+    ai_assert(nullptr != dest);
+
+    CopySceneContents(dest, src, nullptr);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::CopySceneShared(aiScene **_dest, const aiScene *src) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    aiScene *dest = *_dest = new aiScene();
+    const SceneBufferSet shared(src);
+    if (shared.IsEmpty()) {
+        CopySceneContents(dest, src, nullptr);
+        return;
+    }
+
+    // the buffers must be attached before any array points into them
+    ShareSceneBuffers(dest, src);
+    CopySceneContents(dest, src, &shared);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::MakeSceneShareable(aiScene *scene) {
+    if (nullptr == scene) {
+        return;
+    }
+    PackSceneBuffers(scene);
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
     if (nullptr == _dest || nullptr == src) {
@@ -1093,12 +1304,21 @@ void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
     CopyPtrArray(dest->mBones, dest->mBones, dest->mNumBones);
 
     // make a deep copy of all faces
-    GetArrayCopy(dest->mFaces, dest->mNumFaces);
-    for (unsigned int i = 0; i < dest->mNumFaces; ++i) {
-        aiFace &f = dest->mFaces[i];
-        GetArrayCopy(f.mIndices, f.mNumIndices);
+    if (src->mIndexBuffer) {
+        CopyIndexBuffer(dest, src);
+    } else {
+        GetArrayCopy(dest->mFaces, dest->mNumFaces);
+        for (unsigned int i = 0; i < dest->mNumFaces; ++i) {
+            aiFace &f = dest->mFaces[i];
+            GetArrayCopy(f.mIndices, f.mNumIndices);
+        }
     }
 
+    // and of the meshlets
+    GetArrayCopy(dest->mMeshlets, dest->mNumMeshlets);
+    GetArrayCopy(dest->mMeshletVertices, dest->mNumMeshletVertices);
+    GetArrayCopy(dest->mMeshletIndices, dest->mNumFaces * 3);
+
     // make a deep copy of all blend shapes
     CopyPtrArray(dest->mAnimMeshes, dest->mAnimMeshes, dest->mNumAnimMeshes);
 
@@ -1165,6 +1385,7 @@ void SceneCombiner::Copy(aiMaterial **_dest, const aiMaterial *src) {
         prop->mKey = sprop->mKey;
         prop->mType = sprop->mType;
     }
+    UpdateMaterialPropertyIndex(dest);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1349,6 +1570,9 @@ void SceneCombiner::Copy(aiMetadata **_dest, const aiMetadata *src) {
         case AI_AIVECTOR3D:
             out.mData = new aiVector3D(*static_cast<aiVector3D *>(in.mData));
             break;
+        case AI_AIMETADATA:
+            out.mData = new aiMetadata(*static_cast<aiMetadata *>(in.mData));
+            break;
         default:
             ai_assert(false);
             break;
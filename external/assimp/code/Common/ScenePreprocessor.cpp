@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ScenePreprocessor.h"
+#include "MeshIndexBuffer.h"
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
@@ -114,14 +115,18 @@ void ScenePreprocessor::ProcessMesh(aiMesh *mesh) {
 
             // Ensure unused components are zeroed. This will make 1D texture channels work
             // as if they were 2D channels .. just in case an application doesn't handle
-            // this case
+            // this case. Only write where needed, the array may live in a copy-on-write mapping.
             if (2 == mesh->mNumUVComponents[i]) {
                 for (; p != end; ++p) {
-                    p->z = 0.f;
+                    if (p->z != 0.f) {
+                        p->z = 0.f;
+                    }
                 }
             } else if (1 == mesh->mNumUVComponents[i]) {
                 for (; p != end; ++p) {
-                    p->z = p->y = 0.f;
+                    if (p->z != 0.f || p->y != 0.f) {
+                        p->z = p->y = 0.f;
+                    }
                 }
             } else if (3 == mesh->mNumUVComponents[i]) {
                 // Really 3D coordinates? Check whether the third coordinate is != 0 for at least one element
@@ -138,6 +143,9 @@ void ScenePreprocessor::ProcessMesh(aiMesh *mesh) {
         }
     }
 
+    // Importers filling an index buffer leave it to us to set up the faces
+    BuildFaceViews(mesh);
+
     // If the information which primitive types are there in the
     // mesh is currently not available, compute it.
     if (!mesh->mPrimitiveTypes) {
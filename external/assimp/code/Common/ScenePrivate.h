@@ -49,10 +49,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 
+#include <memory>
+#include <vector>
+
 namespace Assimp {
 
 // Forward declarations
 class Importer;
+class SceneBuffer;
 
 struct ScenePrivateData {
     //  The struct constructor.
@@ -71,6 +75,10 @@ struct ScenePrivateData {
     // and mOrigImporter are no longer safe to rely on and only
     // serve informative purposes.
     bool mIsCopy;
+
+    // Memory blocks that mesh arrays may point into instead of owning
+    // their storage, see SceneBuffer.h
+    std::vector<std::shared_ptr<SceneBuffer>> mBuffers;
 };
 
 inline
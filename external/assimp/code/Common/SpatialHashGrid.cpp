@@ -0,0 +1,321 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the hash grid used to quickly find vertices close to a given position */
+
+#include <assimp/SpatialHashGrid.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+using namespace Assimp;
+
+namespace {
+
+// 21 bits per axis so three coordinates fit into one 64-bit Morton key
+const uint32_t MaxCellCoord = (1u << 21) - 1;
+
+// ------------------------------------------------------------------------------------------------
+// Spreads the lower 21 bits of v so there are two zero bits between each of them
+inline uint64_t SpreadBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | (v << 32)) & 0x1f00000000ffffull;
+    v = (v | (v << 16)) & 0x1f0000ff0000ffull;
+    v = (v | (v << 8)) & 0x100f00f00f00f00full;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ull;
+    v = (v | (v << 2)) & 0x1249249249249249ull;
+    return v;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline uint64_t MortonKey(uint32_t x, uint32_t y, uint32_t z) {
+    return SpreadBits(x) | (SpreadBits(y) << 1) | (SpreadBits(z) << 2);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline size_t HashKey(uint64_t key, size_t mask) {
+    // Fibonacci hashing, the upper bits are the best mixed ones
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+// ------------------------------------------------------------------------------------------------
+// true if a and b differ by at most four units in the last place
+inline bool IsIdentical(ai_real a, ai_real b) {
+    static const ai_real tolerance = 4 * std::numeric_limits<ai_real>::epsilon();
+    return std::abs(a - b) <= tolerance * std::max(std::abs(a), std::abs(b));
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+SpatialHashGrid::SpatialHashGrid() :
+        mCellSize(1),
+        mInvCellSize(1),
+        mFinalized(false) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SpatialHashGrid::SpatialHashGrid(const aiVector3D *pPositions, unsigned int pNumPositions, unsigned int pElementOffset) :
+        mCellSize(1),
+        mInvCellSize(1),
+        mFinalized(false) {
+    Fill(pPositions, pNumPositions, pElementOffset);
+}
+
+// ------------------------------------------------------------------------------------------------
+SpatialHashGrid::~SpatialHashGrid() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Fill(const aiVector3D *pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset,
+        bool pFinalize /*= true */) {
+    mPositions.clear();
+    mCells.clear();
+    mTable.clear();
+    mFinalized = false;
+    Append(pPositions, pNumPositions, pElementOffset, pFinalize);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Append(const aiVector3D *pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset,
+        bool pFinalize /*= true */) {
+    ai_assert(!mFinalized && "You cannot add positions to the SpatialHashGrid object after it has been finalized.");
+    const size_t initial = mPositions.size();
+    mPositions.reserve(initial + pNumPositions);
+    for (unsigned int a = 0; a < pNumPositions; a++) {
+        const char *tempPointer = reinterpret_cast<const char *>(pPositions);
+        const aiVector3D *vec = reinterpret_cast<const aiVector3D *>(tempPointer + a * pElementOffset);
+        mPositions.push_back(Entry(static_cast<unsigned int>(a + initial), *vec));
+    }
+
+    if (pFinalize) {
+        Finalize();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::Finalize() {
+    mCells.clear();
+    mTable.clear();
+    mFinalized = true;
+    if (mPositions.empty()) {
+        return;
+    }
+
+    aiVector3D maxVec;
+    mMin = maxVec = mPositions.front().mPosition;
+    for (const Entry &e : mPositions) {
+        for (unsigned int axis = 0; axis < 3; ++axis) {
+            mMin[axis] = std::min(mMin[axis], e.mPosition[axis]);
+            maxVec[axis] = std::max(maxVec[axis], e.mPosition[axis]);
+        }
+    }
+    const aiVector3D size = maxVec - mMin;
+    const ai_real extent = std::max(size.x, std::max(size.y, size.z));
+
+    // Meshes are surfaces, so their vertices are roughly extent / sqrt(n) apart. Cells of that
+    // size hold a handful of positions each, while the tiny radii used for welding and smoothing
+    // still touch no more than eight cells.
+    mCellSize = 1;
+    if (extent > 0) {
+        mCellSize = extent / std::sqrt(static_cast<ai_real>(mPositions.size()));
+        mCellSize = std::max(mCellSize, extent / MaxCellCoord);
+    }
+    mInvCellSize = 1 / mCellSize;
+
+    for (Entry &e : mPositions) {
+        e.mKey = MortonKey(CellCoord(e.mPosition.x, 0), CellCoord(e.mPosition.y, 1), CellCoord(e.mPosition.z, 2));
+    }
+    std::sort(mPositions.begin(), mPositions.end());
+
+    for (unsigned int i = 0; i < mPositions.size(); ++i) {
+        if (mCells.empty() || mCells.back().mKey != mPositions[i].mKey) {
+            mCells.push_back(Cell{ mPositions[i].mKey, i, i });
+        }
+        mCells.back().mEnd = i + 1;
+    }
+
+    // keep the table at most half full so probe sequences stay short
+    size_t tableSize = 16;
+    while (tableSize < mCells.size() * 2) {
+        tableSize *= 2;
+    }
+    mTable.assign(tableSize, 0);
+    const size_t mask = tableSize - 1;
+    for (unsigned int c = 0; c < mCells.size(); ++c) {
+        size_t slot = HashKey(mCells[c].mKey, mask);
+        while (mTable[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        mTable[slot] = c + 1;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+uint32_t SpatialHashGrid::CellCoord(ai_real pValue, unsigned int pAxis) const {
+    const ai_real v = (pValue - mMin[pAxis]) * mInvCellSize;
+    // written so that NaN ends up in the first cell
+    if (!(v > 0)) {
+        return 0;
+    }
+    if (v >= static_cast<ai_real>(MaxCellCoord)) {
+        return MaxCellCoord;
+    }
+    return static_cast<uint32_t>(v);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int SpatialHashGrid::FindCell(uint64_t pKey) const {
+    const size_t mask = mTable.size() - 1;
+    for (size_t slot = HashKey(pKey, mask); mTable[slot] != 0; slot = (slot + 1) & mask) {
+        const unsigned int c = mTable[slot] - 1;
+        if (mCells[c].mKey == pKey) {
+            return c;
+        }
+    }
+    return UINT_MAX;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Calls pFunc for all entries in cells overlapping the cube of half size pRadius around pPosition.
+// The exact distance test is left to the caller.
+template <typename Func>
+void SpatialHashGrid::ForEachCandidate(const aiVector3D &pPosition, ai_real pRadius, Func pFunc) const {
+    if (mPositions.empty()) {
+        return;
+    }
+
+    uint32_t lo[3], hi[3];
+    uint64_t numCells = 1;
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+        lo[axis] = CellCoord(pPosition[axis] - pRadius, axis);
+        hi[axis] = CellCoord(pPosition[axis] + pRadius, axis);
+        numCells *= hi[axis] - lo[axis] + 1;
+    }
+
+    // a huge radius covers more cells than there are occupied ones, just test everything
+    if (numCells > mCells.size()) {
+        for (const Entry &e : mPositions) {
+            pFunc(e);
+        }
+        return;
+    }
+
+    for (uint32_t z = lo[2]; z <= hi[2]; ++z) {
+        for (uint32_t y = lo[1]; y <= hi[1]; ++y) {
+            for (uint32_t x = lo[0]; x <= hi[0]; ++x) {
+                const unsigned int c = FindCell(MortonKey(x, y, z));
+                if (c == UINT_MAX) {
+                    continue;
+                }
+                for (unsigned int i = mCells[c].mBegin; i < mCells[c].mEnd; ++i) {
+                    pFunc(mPositions[i]);
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::FindPositions(const aiVector3D &pPosition,
+        ai_real pRadius, std::vector<unsigned int> &poResults) const {
+    ai_assert(mFinalized && "The SpatialHashGrid object must be finalized before FindPositions can be called.");
+    poResults.clear();
+
+    const ai_real pSquared = pRadius * pRadius;
+    ForEachCandidate(pPosition, pRadius, [&](const Entry &e) {
+        if ((e.mPosition - pPosition).SquareLength() < pSquared) {
+            poResults.push_back(e.mIndex);
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHashGrid::FindIdenticalPositions(const aiVector3D &pPosition, std::vector<unsigned int> &poResults) const {
+    ai_assert(mFinalized && "The SpatialHashGrid object must be finalized before FindIdenticalPositions can be called.");
+    poResults.clear();
+
+    // identical positions may still straddle a cell border, so look a few ULPs around
+    const ai_real magnitude = std::max(std::abs(pPosition.x), std::max(std::abs(pPosition.y), std::abs(pPosition.z)));
+    const ai_real radius = 4 * std::numeric_limits<ai_real>::epsilon() * magnitude;
+    ForEachCandidate(pPosition, radius, [&](const Entry &e) {
+        if (IsIdentical(e.mPosition.x, pPosition.x) && IsIdentical(e.mPosition.y, pPosition.y) &&
+                IsIdentical(e.mPosition.z, pPosition.z)) {
+            poResults.push_back(e.mIndex);
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int SpatialHashGrid::GenerateMappingTable(std::vector<unsigned int> &fill, ai_real pRadius) const {
+    ai_assert(mFinalized && "The SpatialHashGrid object must be finalized before GenerateMappingTable can be called.");
+    fill.assign(mPositions.size(), UINT_MAX);
+
+    // entries are sorted by cell, find them by vertex index
+    std::vector<unsigned int> entryOf(mPositions.size());
+    for (unsigned int i = 0; i < mPositions.size(); ++i) {
+        entryOf[mPositions[i].mIndex] = i;
+    }
+
+    unsigned int t = 0;
+    const ai_real pSquared = pRadius * pRadius;
+    for (unsigned int i = 0; i < mPositions.size(); ++i) {
+        if (fill[i] != UINT_MAX) {
+            continue;
+        }
+        const aiVector3D &pos = mPositions[entryOf[i]].mPosition;
+        fill[i] = t;
+        ForEachCandidate(pos, pRadius, [&](const Entry &e) {
+            if (fill[e.mIndex] == UINT_MAX && (e.mPosition - pos).SquareLength() < pSquared) {
+                fill[e.mIndex] = t;
+            }
+        });
+        ++t;
+    }
+    return t;
+}
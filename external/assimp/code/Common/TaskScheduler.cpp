@@ -0,0 +1,210 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the TaskScheduler */
+
+#include "TaskScheduler.h"
+
+#include <algorithm>
+
+using namespace Assimp;
+
+namespace {
+    // set while a thread executes a task, nested ParallelFor calls run serially
+    thread_local bool gInsideTask = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+TaskScheduler::TaskScheduler(unsigned int numThreads) :
+        mJob(nullptr),
+        mGeneration(0),
+        mBusyWorkers(0),
+        mStop(false),
+        mErrorIndex(0) {
+    if (0 == numThreads) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    mQueues.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        mQueues.emplace_back(new Queue());
+    }
+
+    // queue 0 belongs to the thread calling ParallelFor
+    mThreads.reserve(numThreads - 1);
+    for (unsigned int i = 1; i < numThreads; ++i) {
+        mThreads.emplace_back(&TaskScheduler::WorkerLoop, this, i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    for (std::thread &thread : mThreads) {
+        thread.join();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TaskScheduler::ParallelFor(unsigned int count, const std::function<void(unsigned int)> &func) {
+    if (count == 0) {
+        return;
+    }
+
+    if (gInsideTask || mThreads.empty() || count == 1) {
+        for (unsigned int i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> callLock(mCallMutex);
+
+    // hand out contiguous ranges, stealing balances uneven work later on
+    const unsigned int numQueues = GetNumThreads();
+    for (unsigned int q = 0; q < numQueues; ++q) {
+        const unsigned int begin = static_cast<unsigned int>((static_cast<unsigned long long>(count) * q) / numQueues);
+        const unsigned int end = static_cast<unsigned int>((static_cast<unsigned long long>(count) * (q + 1)) / numQueues);
+        std::lock_guard<std::mutex> lock(mQueues[q]->mutex);
+        for (unsigned int i = begin; i < end; ++i) {
+            mQueues[q]->items.push_back(i);
+        }
+    }
+
+    mError = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = &func;
+        mBusyWorkers = static_cast<unsigned int>(mThreads.size());
+        ++mGeneration;
+    }
+    mWake.notify_all();
+
+    RunJob(0);
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [this] { return mBusyWorkers == 0; });
+        mJob = nullptr;
+    }
+
+    if (mError) {
+        std::exception_ptr error = mError;
+        mError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TaskScheduler::Pop(unsigned int self, unsigned int &item) {
+    {
+        Queue &own = *mQueues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.items.empty()) {
+            item = own.items.front();
+            own.items.pop_front();
+            return true;
+        }
+    }
+
+    const unsigned int numQueues = GetNumThreads();
+    for (unsigned int offset = 1; offset < numQueues; ++offset) {
+        Queue &victim = *mQueues[(self + offset) % numQueues];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.items.empty()) {
+            item = victim.items.back();
+            victim.items.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void TaskScheduler::RunJob(unsigned int self) {
+    const std::function<void(unsigned int)> &func = *mJob;
+    gInsideTask = true;
+
+    unsigned int item;
+    while (Pop(self, item)) {
+        try {
+            func(item);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mErrorMutex);
+            if (!mError || item < mErrorIndex) {
+                mError = std::current_exception();
+                mErrorIndex = item;
+            }
+        }
+    }
+
+    gInsideTask = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void TaskScheduler::WorkerLoop(unsigned int self) {
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [&] { return mStop || mGeneration != seen; });
+            if (mStop) {
+                return;
+            }
+            seen = mGeneration;
+        }
+
+        RunJob(self);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (--mBusyWorkers == 0) {
+                mDone.notify_one();
+            }
+        }
+    }
+}
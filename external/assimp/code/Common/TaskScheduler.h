@@ -0,0 +1,123 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a small work-stealing thread pool used to run
+ *  independent parts of post-processing steps concurrently */
+#pragma once
+#ifndef AI_TASKSCHEDULER_H_INC
+#define AI_TASKSCHEDULER_H_INC
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** A fixed set of worker threads executing index ranges.
+ *
+ *  Every thread owns a queue of indices; it takes work from the front of its
+ *  own queue and steals from the back of the others once it runs dry. The
+ *  thread calling ParallelFor() takes part in the work. Nested calls from
+ *  inside a running task are executed serially on the calling thread.
+ *
+ *  Exceptions thrown by a task are collected and the one with the lowest
+ *  index is rethrown by ParallelFor() after all other indices completed,
+ *  so the reported error does not depend on thread timing.
+ */
+class TaskScheduler {
+public:
+    // -------------------------------------------------------------------
+    /** @param numThreads Total number of threads including the caller,
+     *    0 selects std::thread::hardware_concurrency(). */
+    explicit TaskScheduler(unsigned int numThreads);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+    // -------------------------------------------------------------------
+    /** Total number of threads, including the calling thread. */
+    unsigned int GetNumThreads() const {
+        return static_cast<unsigned int>(mQueues.size());
+    }
+
+    // -------------------------------------------------------------------
+    /** Calls func(i) for every i in [0, count) and blocks until all calls
+     *  returned. The calls may run concurrently and in any order. */
+    void ParallelFor(unsigned int count, const std::function<void(unsigned int)> &func);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<unsigned int> items;
+    };
+
+    bool Pop(unsigned int self, unsigned int &item);
+    void RunJob(unsigned int self);
+    void WorkerLoop(unsigned int self);
+
+    std::vector<std::thread> mThreads;
+    std::vector<std::unique_ptr<Queue>> mQueues;
+
+    std::mutex mCallMutex; // one ParallelFor at a time
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    const std::function<void(unsigned int)> *mJob;
+    unsigned long long mGeneration;
+    unsigned int mBusyWorkers;
+    bool mStop;
+
+    std::mutex mErrorMutex;
+    std::exception_ptr mError;
+    unsigned int mErrorIndex;
+};
+
+} // namespace Assimp
+
+#endif // AI_TASKSCHEDULER_H_INC
@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Actually just a dummy, used by the compiler to build the pre-compiled header.
 
+#include "SceneBuffer.h"
 #include "ScenePrivate.h"
 #include <assimp/scene.h>
 #include <assimp/version.h>
@@ -141,6 +142,9 @@ ASSIMP_API aiScene::aiScene() :
 
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API aiScene::~aiScene() {
+    // arrays inside buffers of the scene are released with the buffers
+    Assimp::DetachSceneBuffers(this);
+
     // delete all sub-objects recursively
     delete mRootNode;
 
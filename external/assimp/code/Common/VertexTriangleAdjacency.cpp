@@ -50,20 +50,60 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Face access for an aiFace array
+struct FaceArrayAccess {
+    const aiFace *mFaces;
+
+    unsigned int Size(unsigned int i) const { return mFaces[i].mNumIndices; }
+    const unsigned int *Indices(unsigned int i) const { return mFaces[i].mIndices; }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Face access for a flat triangle index buffer
+struct TriangleBufferAccess {
+    const unsigned int *mIndices;
+
+    unsigned int Size(unsigned int) const { return 3; }
+    const unsigned int *Indices(unsigned int i) const { return mIndices + i * 3; }
+};
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 VertexTriangleAdjacency::VertexTriangleAdjacency(aiFace *pcFaces,
         unsigned int iNumFaces,
         unsigned int iNumVertices /*= 0*/,
         bool bComputeNumTriangles /*= false*/) {
+    FaceArrayAccess faces = { pcFaces };
+    Init(faces, iNumFaces, iNumVertices, bComputeNumTriangles);
+}
+
+// ------------------------------------------------------------------------------------------------
+VertexTriangleAdjacency::VertexTriangleAdjacency(const unsigned int *piIndices,
+        unsigned int iNumTriangles,
+        unsigned int iNumVertices /*= 0*/,
+        bool bComputeNumTriangles /*= false*/) {
+    TriangleBufferAccess faces = { piIndices };
+    Init(faces, iNumTriangles, iNumVertices, bComputeNumTriangles);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename FaceAccess>
+void VertexTriangleAdjacency::Init(const FaceAccess &faces,
+        unsigned int iNumFaces,
+        unsigned int iNumVertices,
+        bool bComputeNumTriangles) {
     // compute the number of referenced vertices if it wasn't specified by the caller
-    const aiFace *const pcFaceEnd = pcFaces + iNumFaces;
     if (0 == iNumVertices) {
-        for (aiFace *pcFace = pcFaces; pcFace != pcFaceEnd; ++pcFace) {
-            ai_assert(nullptr != pcFace);
-            ai_assert(3 == pcFace->mNumIndices);
-            iNumVertices = std::max(iNumVertices, pcFace->mIndices[0]);
-            iNumVertices = std::max(iNumVertices, pcFace->mIndices[1]);
-            iNumVertices = std::max(iNumVertices, pcFace->mIndices[2]);
+        for (unsigned int i = 0; i < iNumFaces; ++i) {
+            ai_assert(3 == faces.Size(i));
+            const unsigned int *ind = faces.Indices(i);
+            iNumVertices = std::max(iNumVertices, ind[0]);
+            iNumVertices = std::max(iNumVertices, ind[1]);
+            iNumVertices = std::max(iNumVertices, ind[2]);
         }
     }
 
@@ -87,9 +127,9 @@ VertexTriangleAdjacency::VertexTriangleAdjacency(aiFace *pcFaces,
     *piEnd++ = 0u;
 
     // first pass: compute the number of faces referencing each vertex
-    for (aiFace *pcFace = pcFaces; pcFace != pcFaceEnd; ++pcFace) {
-        unsigned nind = pcFace->mNumIndices;
-        unsigned *ind = pcFace->mIndices;
+    for (unsigned int i = 0; i < iNumFaces; ++i) {
+        unsigned nind = faces.Size(i);
+        const unsigned *ind = faces.Indices(i);
         if (nind > 0) pi[ind[0]]++;
         if (nind > 1) pi[ind[1]]++;
         if (nind > 2) pi[ind[2]]++;
@@ -108,20 +148,20 @@ VertexTriangleAdjacency::VertexTriangleAdjacency(aiFace *pcFaces,
 
     // third pass: compute the final table
     this->mAdjacencyTable = new unsigned int[iSum];
-    iSum = 0;
-    for (aiFace *pcFace = pcFaces; pcFace != pcFaceEnd; ++pcFace, ++iSum) {
-        unsigned nind = pcFace->mNumIndices;
-        unsigned *ind = pcFace->mIndices;
-
-        if (nind > 0) mAdjacencyTable[pi[ind[0]]++] = iSum;
-        if (nind > 1) mAdjacencyTable[pi[ind[1]]++] = iSum;
-        if (nind > 2) mAdjacencyTable[pi[ind[2]]++] = iSum;
+    for (unsigned int i = 0; i < iNumFaces; ++i) {
+        unsigned nind = faces.Size(i);
+        const unsigned *ind = faces.Indices(i);
+
+        if (nind > 0) mAdjacencyTable[pi[ind[0]]++] = i;
+        if (nind > 1) mAdjacencyTable[pi[ind[1]]++] = i;
+        if (nind > 2) mAdjacencyTable[pi[ind[2]]++] = i;
     }
     // fourth pass: undo the offset computations made during the third pass
     // We could do this in a separate buffer, but this would be TIMES slower.
     --mOffsetTable;
     *mOffsetTable = 0u;
 }
+
 // ------------------------------------------------------------------------------------------------
 VertexTriangleAdjacency::~VertexTriangleAdjacency() {
     // delete allocated storage
@@ -75,6 +75,20 @@ public:
         unsigned int iNumVertices = 0,
         bool bComputeNumTriangles = true);
 
+    // ----------------------------------------------------------------------------
+    /** @brief Construction from a flat triangle index buffer
+     *  @param piIndices Index buffer, three indices per triangle,
+     *    see aiMesh::mIndexBuffer
+     *  @param iNumTriangles Number of triangles in the buffer
+     *  @param iNumVertices Number of referenced vertices. This value
+     *    is computed automatically if 0 is specified.
+     *  @param bComputeNumTriangles If you want the class to compute
+     *    a list containing the number of referenced triangles per vertex
+     *    per vertex - pass true.  */
+    VertexTriangleAdjacency(const unsigned int* piIndices,unsigned int iNumTriangles,
+        unsigned int iNumVertices = 0,
+        bool bComputeNumTriangles = true);
+
     // ----------------------------------------------------------------------------
     /** @brief Destructor */
     ~VertexTriangleAdjacency();
@@ -99,6 +113,12 @@ public:
         return mLiveTriangles[iVertIndex];
     }
 
+private:
+    template <typename FaceAccess>
+    void Init(const FaceAccess &faces, unsigned int iNumFaces,
+        unsigned int iNumVertices, bool bComputeNumTriangles);
+
+public:
     //! Offset table
     unsigned int* mOffsetTable;
 
@@ -52,8 +52,120 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/types.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <vector>
+
 using namespace Assimp;
 
+namespace {
+
+// Materials with fewer properties are searched linearly, which is faster than hashing the key
+const unsigned int MinIndexedProperties = 8;
+
+// ------------------------------------------------------------------------------------------------
+// Hash table over the properties of a material, keyed on key, semantic and index, stored in
+// aiMaterial::mPrivate. Only the non-const aiMaterial members modify it, lookups just read it
+// so they remain safe to run concurrently. It remembers the property array it was built for,
+// if mProperties was replaced or resized behind its back lookups fall back to a linear search.
+class PropertyIndex {
+public:
+    static const unsigned int NotFound = UINT_MAX;
+
+    static uint32_t Hash(const char *key, unsigned int length, unsigned int semantic, unsigned int index) {
+        uint32_t hash = SuperFastHash(key, length);
+        hash = SuperFastHash((const char *)&semantic, sizeof(unsigned int), hash);
+        return SuperFastHash((const char *)&index, sizeof(unsigned int), hash);
+    }
+
+    bool IsValidFor(const aiMaterial *mat) const {
+        return mArray == mat->mProperties && mHashes.size() == mat->mNumProperties;
+    }
+
+    // Returns the position of the first property matching exactly
+    unsigned int Find(const aiMaterial *mat, const char *key, unsigned int semantic, unsigned int index) const {
+        ai_assert(IsValidFor(mat));
+        const uint32_t hash = Hash(key, static_cast<unsigned int>(::strlen(key)), semantic, index);
+        const size_t mask = mSlots.size() - 1;
+        for (size_t slot = hash & mask; mSlots[slot] != 0; slot = (slot + 1) & mask) {
+            const unsigned int position = mSlots[slot] - 1;
+            if (mHashes[position] != hash) {
+                continue;
+            }
+            const aiMaterialProperty *prop = mat->mProperties[position];
+            if (prop->mSemantic == semantic && prop->mIndex == index && !strcmp(prop->mKey.data, key)) {
+                return position;
+            }
+        }
+        return NotFound;
+    }
+
+    // Adds the properties appended to the array since the last update
+    void Update(const aiMaterial *mat) {
+        if (mArray != mat->mProperties || mHashes.size() > mat->mNumProperties) {
+            Rebuild(mat);
+            return;
+        }
+        if ((mat->mNumProperties + 1) * 2 > mSlots.size()) {
+            Rebuild(mat);
+            return;
+        }
+        for (unsigned int i = static_cast<unsigned int>(mHashes.size()); i < mat->mNumProperties; ++i) {
+            Insert(mat, i);
+        }
+    }
+
+    void Rebuild(const aiMaterial *mat) {
+        size_t numSlots = 16;
+        while (numSlots < (mat->mNumProperties + 1) * 2) {
+            numSlots *= 2;
+        }
+        mArray = mat->mProperties;
+        mHashes.clear();
+        mHashes.reserve(mat->mNumProperties);
+        mSlots.assign(numSlots, 0);
+        for (unsigned int i = 0; i < mat->mNumProperties; ++i) {
+            Insert(mat, i);
+        }
+    }
+
+private:
+    // Duplicates and null entries keep their position but are not reachable through the table,
+    // a linear search would return the first match as well
+    void Insert(const aiMaterial *mat, unsigned int position) {
+        ai_assert(position == mHashes.size());
+        const aiMaterialProperty *prop = mat->mProperties[position];
+        if (nullptr == prop) {
+            mHashes.push_back(0);
+            return;
+        }
+
+        const uint32_t hash = Hash(prop->mKey.data, prop->mKey.length, prop->mSemantic, prop->mIndex);
+        const size_t mask = mSlots.size() - 1;
+        size_t slot = hash & mask;
+        for (; mSlots[slot] != 0; slot = (slot + 1) & mask) {
+            const unsigned int other = mSlots[slot] - 1;
+            const aiMaterialProperty *otherProp = mat->mProperties[other];
+            if (mHashes[other] == hash && otherProp->mSemantic == prop->mSemantic && otherProp->mIndex == prop->mIndex && otherProp->mKey == prop->mKey) {
+                mHashes.push_back(hash);
+                return;
+            }
+        }
+        mSlots[slot] = position + 1;
+        mHashes.push_back(hash);
+    }
+
+    const aiMaterialProperty *const *mArray = nullptr;
+    std::vector<uint32_t> mHashes; // per property position
+    std::vector<unsigned int> mSlots; // property position + 1, 0 marks an empty slot
+};
+
+// ------------------------------------------------------------------------------------------------
+inline const PropertyIndex *GetValidIndex(const aiMaterial *mat) {
+    const PropertyIndex *index = static_cast<const PropertyIndex *>(mat->mPrivate);
+    return (nullptr != index && index->IsValidFor(mat)) ? index : nullptr;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Get a specific property from a material
 aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
@@ -65,10 +177,16 @@ aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
     ai_assert(pKey != nullptr);
     ai_assert(pPropOut != nullptr);
 
+    // Exact lookups go through the hash index once the material has one
+    const PropertyIndex *propIndex = GetValidIndex(pMat);
+    if (nullptr != propIndex && UINT_MAX != type && UINT_MAX != index) {
+        const unsigned int i = propIndex->Find(pMat, pKey, type, index);
+        *pPropOut = (PropertyIndex::NotFound != i) ? pMat->mProperties[i] : nullptr;
+        return (nullptr != *pPropOut) ? AI_SUCCESS : AI_FAILURE;
+    }
+
     /*  Just search for a property with exactly this name ..
-     *  could be improved by hashing, but it's possibly
-     *  no worth the effort (we're bound to C structures,
-     *  thus std::map or derivates are not applicable. */
+     *  UINT_MAX wild-cards and small materials end up here. */
     for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
         aiMaterialProperty *prop = pMat->mProperties[i];
 
@@ -388,7 +506,7 @@ static const unsigned int DefaultNumAllocated = 5;
 // ------------------------------------------------------------------------------------------------
 // Construction. Actually the one and only way to get an aiMaterial instance
 aiMaterial::aiMaterial() :
-        mProperties(nullptr), mNumProperties(0), mNumAllocated(DefaultNumAllocated) {
+        mProperties(nullptr), mNumProperties(0), mNumAllocated(DefaultNumAllocated), mPrivate(nullptr) {
     // Allocate 5 entries by default
     mProperties = new aiMaterialProperty *[DefaultNumAllocated];
 }
@@ -400,6 +518,24 @@ aiMaterial::~aiMaterial() {
     delete[] mProperties;
 }
 
+// ------------------------------------------------------------------------------------------------
+void Assimp::UpdateMaterialPropertyIndex(aiMaterial *mat) {
+    ai_assert(nullptr != mat);
+
+    PropertyIndex *index = static_cast<PropertyIndex *>(mat->mPrivate);
+    if (mat->mNumProperties < MinIndexedProperties) {
+        delete index;
+        mat->mPrivate = nullptr;
+        return;
+    }
+    if (nullptr == index) {
+        mat->mPrivate = index = new PropertyIndex();
+        index->Rebuild(mat);
+        return;
+    }
+    index->Update(mat);
+}
+
 // ------------------------------------------------------------------------------------------------
 aiString aiMaterial::GetName() const {
     aiString name;
@@ -417,6 +553,9 @@ void aiMaterial::Clear() {
     }
     mNumProperties = 0;
 
+    delete static_cast<PropertyIndex *>(mPrivate);
+    mPrivate = nullptr;
+
     // The array remains allocated, we just invalidated its contents
 }
 
@@ -424,7 +563,15 @@ void aiMaterial::Clear() {
 aiReturn aiMaterial::RemoveProperty(const char *pKey, unsigned int type, unsigned int index) {
     ai_assert(nullptr != pKey);
 
-    for (unsigned int i = 0; i < mNumProperties; ++i) {
+    unsigned int i = 0;
+    if (const PropertyIndex *propIndex = GetValidIndex(this)) {
+        i = propIndex->Find(this, pKey, type, index);
+        if (PropertyIndex::NotFound == i) {
+            return AI_FAILURE;
+        }
+    }
+
+    for (; i < mNumProperties; ++i) {
         aiMaterialProperty *prop = mProperties[i];
 
         if (prop && !strcmp(prop->mKey.data, pKey) &&
@@ -437,6 +584,9 @@ aiReturn aiMaterial::RemoveProperty(const char *pKey, unsigned int type, unsigne
             for (unsigned int a = i; a < mNumProperties; ++a) {
                 mProperties[a] = mProperties[a + 1];
             }
+
+            // positions behind the removed entry changed, this rebuilds the index
+            UpdateMaterialPropertyIndex(this);
             return AI_SUCCESS;
         }
     }
@@ -461,14 +611,21 @@ aiReturn aiMaterial::AddBinaryProperty(const void *pInput,
 
     // first search the list whether there is already an entry with this key
     unsigned int iOutIndex(UINT_MAX);
-    for (unsigned int i = 0; i < mNumProperties; ++i) {
-        aiMaterialProperty *prop(mProperties[i]);
+    if (const PropertyIndex *propIndex = GetValidIndex(this)) {
+        iOutIndex = propIndex->Find(this, pKey, type, index);
+        if (UINT_MAX != iOutIndex) {
+            delete mProperties[iOutIndex];
+        }
+    } else {
+        for (unsigned int i = 0; i < mNumProperties; ++i) {
+            aiMaterialProperty *prop(mProperties[i]);
 
-        if (prop /* just for safety */ && !strcmp(prop->mKey.data, pKey) &&
-                prop->mSemantic == type && prop->mIndex == index) {
+            if (prop /* just for safety */ && !strcmp(prop->mKey.data, pKey) &&
+                    prop->mSemantic == type && prop->mIndex == index) {
 
-            delete mProperties[i];
-            iOutIndex = i;
+                delete mProperties[i];
+                iOutIndex = i;
+            }
         }
     }
 
@@ -514,6 +671,7 @@ aiReturn aiMaterial::AddBinaryProperty(const void *pInput,
     }
     // push back ...
     mProperties[mNumProperties++] = pcNew;
+    UpdateMaterialPropertyIndex(this);
 
     return AI_SUCCESS;
 }
@@ -611,4 +769,6 @@ void aiMaterial::CopyPropertyList(aiMaterial *const pcDest,
         prop->mData = new char[propSrc->mDataLength];
         memcpy(prop->mData, propSrc->mData, prop->mDataLength);
     }
+
+    UpdateMaterialPropertyIndex(pcDest);
 }
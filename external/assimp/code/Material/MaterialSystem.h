@@ -66,6 +66,17 @@ namespace Assimp    {
  */
 uint32_t ComputeMaterialHash(const aiMaterial* mat, bool includeMatName = false);
 
+// ------------------------------------------------------------------------------
+/** Brings the property lookup index of a material up to date.
+ *
+ *  The aiMaterial member functions keep the index current on their own. Code
+ *  that fills aiMaterial::mProperties directly calls this afterwards, properties
+ *  appended since the last call are added, any other change rebuilds the index.
+ *  Until then lookups on the material fall back to a linear search.
+ *
+ *  @param  mat Material whose property list was modified */
+void UpdateMaterialPropertyIndex(aiMaterial* mat);
+
 
 } // ! namespace Assimp
 
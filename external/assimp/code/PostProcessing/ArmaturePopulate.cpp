@@ -62,6 +62,18 @@ bool ArmaturePopulate::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_PopulateArmatureData) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are not touched
+bool ArmaturePopulate::SupportsIndexBuffers() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Neither the faces nor the vertices are touched
+bool ArmaturePopulate::KeepsMeshlets() const {
+    return true;
+}
+
 void ArmaturePopulate::SetupProperties(const Importer *) {
     // do nothing
 }
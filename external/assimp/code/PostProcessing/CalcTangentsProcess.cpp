@@ -51,6 +51,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/TinyFormatter.h>
 #include <assimp/qnan.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
@@ -72,6 +75,12 @@ bool CalcTangentsProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_CalcTangentSpace) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool CalcTangentsProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void CalcTangentsProcess::SetupProperties(const Importer *pImp) {
@@ -83,6 +92,8 @@ void CalcTangentsProcess::SetupProperties(const Importer *pImp) {
     configMaxAngle = AI_DEG_TO_RAD(configMaxAngle);
 
     configSourceUV = pImp->GetPropertyInteger(AI_CONFIG_PP_CT_TEXTURE_CHANNEL_INDEX, 0);
+
+    configHashGrid = pImp->GetPropertyBool(AI_CONFIG_PP_SPATIAL_HASH_GRID, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -92,10 +103,12 @@ void CalcTangentsProcess::Execute(aiScene *pScene) {
 
     ASSIMP_LOG_DEBUG("CalcTangentsProcess begin");
 
-    bool bHas = false;
-    for (unsigned int a = 0; a < pScene->mNumMeshes; a++) {
-        if (ProcessMesh(pScene->mMeshes[a], a)) bHas = true;
-    }
+    // meshes are independent of each other
+    std::vector<char> processed(pScene->mNumMeshes, 0);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        processed[a] = ProcessMesh(pScene->mMeshes[a], a);
+    });
+    const bool bHas = std::find(processed.begin(), processed.end(), char(1)) != processed.end();
 
     if (bHas) {
         ASSIMP_LOG_INFO("CalcTangentsProcess finished. Tangents have been calculated");
@@ -225,15 +238,15 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
     }
 
     // create a helper to quickly find locally close vertices among the vertex array
-    // FIX: check whether we can reuse the SpatialSort of a previous step
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
+    // FIX: check whether we can reuse the SpatialIndex of a previous step
+    SpatialIndex *vertexFinder = nullptr;
+    SpatialIndex _vertexFinder(configHashGrid);
     float posEpsilon = 10e-6f;
     if (shared) {
-        std::vector<std::pair<SpatialSort, float>> *avf;
+        std::vector<std::pair<SpatialIndex, ai_real>> *avf;
         shared->GetProperty(AI_SPP_SPATIAL_SORT, avf);
         if (avf) {
-            std::pair<SpatialSort, float> &blubb = avf->operator[](meshIndex);
+            std::pair<SpatialIndex, ai_real> &blubb = avf->operator[](meshIndex);
             vertexFinder = &blubb.first;
             posEpsilon = blubb.second;
             ;
@@ -76,6 +76,9 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const;
+
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
     * The function is a request to the process to update its configuration
@@ -110,6 +113,7 @@ private:
     /** Configuration option: maximum smoothing angle, in radians*/
     float configMaxAngle;
     unsigned int configSourceUV;
+    bool configHashGrid = false;
 };
 
 } // end of namespace Assimp
@@ -78,6 +78,12 @@ bool ComputeUVMappingProcess::IsActive( unsigned int pFlags) const
     return  (pFlags & aiProcess_GenUVCoords) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool ComputeUVMappingProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Check whether a ray intersects a plane and find the intersection point
 inline bool PlaneIntersect(const aiRay& ray, const aiVector3D& planePos,
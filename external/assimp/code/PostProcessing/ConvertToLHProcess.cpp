@@ -98,6 +98,12 @@ bool MakeLeftHandedProcess::IsActive(unsigned int pFlags) const {
     return 0 != (pFlags & aiProcess_MakeLeftHanded);
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are not touched
+bool MakeLeftHandedProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void MakeLeftHandedProcess::Execute(aiScene *pScene) {
@@ -262,6 +268,12 @@ bool FlipUVsProcess::IsActive(unsigned int pFlags) const {
     return 0 != (pFlags & aiProcess_FlipUVs);
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are not touched
+bool FlipUVsProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FlipUVsProcess::Execute(aiScene *pScene) {
@@ -324,6 +336,12 @@ bool FlipWindingOrderProcess::IsActive(unsigned int pFlags) const {
     return 0 != (pFlags & aiProcess_FlipWindingOrder);
 }
 
+// ------------------------------------------------------------------------------------------------
+// The indices of each face are reversed in place
+bool FlipWindingOrderProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FlipWindingOrderProcess::Execute(aiScene *pScene) {
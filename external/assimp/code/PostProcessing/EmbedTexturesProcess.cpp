@@ -62,6 +62,18 @@ bool EmbedTexturesProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_EmbedTextures) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are not touched
+bool EmbedTexturesProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Neither the faces nor the vertices are touched
+bool EmbedTexturesProcess::KeepsMeshlets() const {
+    return true;
+}
+
 void EmbedTexturesProcess::SetupProperties(const Importer* pImp) {
     mRootPath = pImp->GetPropertyString("sourceFilePath");
     mRootPath = mRootPath.substr(0, mRootPath.find_last_of("\\/") + 1u);
@@ -69,6 +69,8 @@ public:
 
     /// Overwritten, @see BaseProcess
     virtual bool IsActive(unsigned int pFlags) const;
+    virtual bool SupportsIndexBuffers() const;
+    virtual bool KeepsMeshlets() const;
 
     /// Overwritten, @see BaseProcess
     virtual void SetupProperties(const Importer* pImp);
@@ -72,6 +72,12 @@ bool FindInvalidDataProcess::IsActive(unsigned int pFlags) const {
     return 0 != (pFlags & aiProcess_FindInvalidData);
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool FindInvalidDataProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup import configuration
 void FindInvalidDataProcess::SetupProperties(const Importer *pImp) {
@@ -71,6 +71,9 @@ public:
     //
     bool IsActive(unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const;
+
     // -------------------------------------------------------------------
     // Setup import settings
     void SetupProperties(const Importer *pImp);
@@ -78,6 +78,12 @@ bool FixInfacingNormalsProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_FixInfacingNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The indices of each face are reversed in place
+bool FixInfacingNormalsProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FixInfacingNormalsProcess::Execute( aiScene* pScene)
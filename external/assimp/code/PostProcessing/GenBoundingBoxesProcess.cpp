@@ -61,6 +61,18 @@ bool GenBoundingBoxesProcess::IsActive(unsigned int pFlags) const {
     return 0 != ( pFlags & aiProcess_GenBoundingBoxes );
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are not touched
+bool GenBoundingBoxesProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Neither the faces nor the vertices are touched
+bool GenBoundingBoxesProcess::KeepsMeshlets() const {
+    return true;
+}
+
 void checkMesh(aiMesh* mesh, aiVector3D& min, aiVector3D& max) {
     ai_assert(nullptr != mesh);
 
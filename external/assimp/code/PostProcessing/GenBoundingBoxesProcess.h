@@ -65,6 +65,10 @@ public:
     ~GenBoundingBoxesProcess();
     /// Will return true, if aiProcess_GenBoundingBoxes is defined.
     bool IsActive(unsigned int pFlags) const override;
+    /// The faces are not touched.
+    bool SupportsIndexBuffers() const override;
+    /// Neither the faces nor the vertices are touched.
+    bool KeepsMeshlets() const override;
     /// The execution callback.
     void Execute(aiScene* pScene) override;
 };
@@ -69,6 +69,9 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
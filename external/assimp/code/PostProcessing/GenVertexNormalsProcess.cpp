@@ -51,6 +51,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exceptional.h>
 #include <assimp/qnan.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
@@ -74,12 +77,19 @@ bool GenVertexNormalsProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_GenSmoothNormals) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are only read
+bool GenVertexNormalsProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenVertexNormalsProcess::SetupProperties(const Importer *pImp) {
     // Get the current value of the AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE property
     configMaxAngle = pImp->GetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, (ai_real)175.0);
     configMaxAngle = AI_DEG_TO_RAD(std::max(std::min(configMaxAngle, (ai_real)175.0), (ai_real)0.0));
+    configHashGrid = pImp->GetPropertyBool(AI_CONFIG_PP_SPATIAL_HASH_GRID, false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -91,11 +101,12 @@ void GenVertexNormalsProcess::Execute(aiScene *pScene) {
         throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
     }
 
-    bool bHas = false;
-    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
-        if (GenMeshVertexNormals(pScene->mMeshes[a], a))
-            bHas = true;
-    }
+    // meshes are independent of each other
+    std::vector<char> generated(pScene->mNumMeshes, 0);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        generated[a] = GenMeshVertexNormals(pScene->mMeshes[a], a);
+    });
+    const bool bHas = std::find(generated.begin(), generated.end(), char(1)) != generated.end();
 
     if (bHas) {
         ASSIMP_LOG_INFO("GenVertexNormalsProcess finished. "
@@ -152,16 +163,16 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
         }
     }
 
-    // Set up a SpatialSort to quickly find all vertices close to a given position
-    // check whether we can reuse the SpatialSort of a previous step.
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
+    // Set up a SpatialIndex to quickly find all vertices close to a given position
+    // check whether we can reuse the SpatialIndex of a previous step.
+    SpatialIndex *vertexFinder = nullptr;
+    SpatialIndex _vertexFinder(configHashGrid);
     ai_real posEpsilon = ai_real(1e-5);
     if (shared) {
-        std::vector<std::pair<SpatialSort, ai_real>> *avf;
+        std::vector<std::pair<SpatialIndex, ai_real>> *avf;
         shared->GetProperty(AI_SPP_SPATIAL_SORT, avf);
         if (avf) {
-            std::pair<SpatialSort, ai_real> &blubb = avf->operator[](meshIndex);
+            std::pair<SpatialIndex, ai_real> &blubb = avf->operator[](meshIndex);
             vertexFinder = &blubb.first;
             posEpsilon = blubb.second;
         }
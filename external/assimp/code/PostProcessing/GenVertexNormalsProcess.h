@@ -72,6 +72,9 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const;
+
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
     * The function is a request to the process to update its configuration
@@ -103,6 +106,8 @@ public:
 private:
     /** Configuration option: maximum smoothing angle, in radians*/
     ai_real configMaxAngle;
+    /** Use a SpatialHashGrid instead of a SpatialSort to find close vertices */
+    bool configHashGrid = false;
     mutable bool force_ = false;
     mutable bool flippedWindingOrder_ = false;
 };
@@ -0,0 +1,880 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file GenerateLODsProcess.cpp
+ *  @brief Implementation of the post-processing step generating simplified
+ *    level of detail meshes.
+ *
+ * Edges are collapsed in the order of their quadric error, see Garland and
+ * Heckbert, "Surface Simplification Using Quadric Error Metrics". Vertices
+ * sharing a position with different attributes are classified the way
+ * meshoptimizer's simplifier does it: a vertex on a seam only moves along
+ * the seam, together with its counterpart on the other side.
+ */
+
+#include "PostProcessing/GenerateLODsProcess.h"
+#include "Common/MeshIndexBuffer.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Sum of squared distances to a set of weighted planes
+struct Quadric {
+    double a00, a01, a02, a11, a12, a22;
+    double b0, b1, b2;
+    double c;
+    double w;
+};
+
+// ------------------------------------------------------------------------------------------------
+void AddPlane(Quadric &q, const aiVector3D &n, const aiVector3D &p, double w) {
+    const double nx = n.x, ny = n.y, nz = n.z;
+    const double d = -(nx * p.x + ny * p.y + nz * p.z);
+    q.a00 += w * nx * nx;
+    q.a01 += w * nx * ny;
+    q.a02 += w * nx * nz;
+    q.a11 += w * ny * ny;
+    q.a12 += w * ny * nz;
+    q.a22 += w * nz * nz;
+    q.b0 += w * nx * d;
+    q.b1 += w * ny * d;
+    q.b2 += w * nz * d;
+    q.c += w * d * d;
+    q.w += w;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AddQuadric(Quadric &q, const Quadric &o) {
+    q.a00 += o.a00;
+    q.a01 += o.a01;
+    q.a02 += o.a02;
+    q.a11 += o.a11;
+    q.a12 += o.a12;
+    q.a22 += o.a22;
+    q.b0 += o.b0;
+    q.b1 += o.b1;
+    q.b2 += o.b2;
+    q.c += o.c;
+    q.w += o.w;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Mean squared distance of p to the planes of q
+double QuadricError(const Quadric &q, const aiVector3D &p) {
+    if (q.w <= 0.0) {
+        return 0.0;
+    }
+    const double x = p.x, y = p.y, z = p.z;
+    const double e = q.a00 * x * x + q.a11 * y * y + q.a22 * z * z +
+                     2.0 * (q.a01 * x * y + q.a02 * x * z + q.a12 * y * z) +
+                     2.0 * (q.b0 * x + q.b1 * y + q.b2 * z) + q.c;
+    return std::fabs(e) / q.w;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Half-edges leaving each vertex, optionally after mapping the vertices to their position
+class EdgeAdjacency {
+public:
+    void Build(const std::vector<unsigned int> &indices, const unsigned int *remap, unsigned int numVertices) {
+        mOffsets.assign(numVertices + 1, 0);
+        for (unsigned int i : indices) {
+            ++mOffsets[Map(remap, i) + 1];
+        }
+        for (unsigned int v = 0; v < numVertices; ++v) {
+            mOffsets[v + 1] += mOffsets[v];
+        }
+        mEdges.resize(indices.size());
+        std::vector<unsigned int> fill(mOffsets.begin(), mOffsets.end() - 1);
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            for (unsigned int k = 0; k < 3; ++k) {
+                const unsigned int v = Map(remap, indices[t + k]);
+                Edge &e = mEdges[fill[v]++];
+                e.mNext = Map(remap, indices[t + (k + 1) % 3]);
+                e.mPrev = Map(remap, indices[t + (k + 2) % 3]);
+            }
+        }
+    }
+
+    bool HasEdge(unsigned int a, unsigned int b) const {
+        for (unsigned int e = mOffsets[a]; e < mOffsets[a + 1]; ++e) {
+            if (mEdges[e].mNext == b) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    struct Edge {
+        unsigned int mNext, mPrev;
+    };
+
+    const Edge *Begin(unsigned int v) const { return mEdges.data() + mOffsets[v]; }
+    const Edge *End(unsigned int v) const { return mEdges.data() + mOffsets[v + 1]; }
+
+private:
+    static unsigned int Map(const unsigned int *remap, unsigned int v) {
+        return remap ? remap[v] : v;
+    }
+
+    std::vector<unsigned int> mOffsets;
+    std::vector<Edge> mEdges;
+};
+
+// ------------------------------------------------------------------------------------------------
+enum VertexKind : unsigned char {
+    Kind_Manifold, // single attribute set, every edge has an opposite
+    Kind_Border, // single attribute set, on one open edge loop
+    Kind_Seam, // two attribute sets split along one edge loop
+    Kind_Locked // everything else, never moves
+};
+
+// weight of the planes keeping open edges in place, relative to the triangle planes
+const double BorderWeight = 10.0;
+
+// collapses must not bend the vertex normal more than this (cosine)
+const ai_real MinNormalDot = ai_real(0.5);
+
+// nor turn one of the remaining triangles more than this (cosine)
+const ai_real MinTriangleDot = ai_real(0.25);
+
+// ------------------------------------------------------------------------------------------------
+// Incremental simplification of one triangle mesh. Each pass collapses an independent set of
+// the cheapest edges; a vertex moves only if no other vertex of its triangles moves in the same
+// pass, which keeps the flip test exact.
+class Simplifier {
+public:
+    explicit Simplifier(const aiMesh *mesh);
+
+    // Collapses edges until at most target triangles remain or every remaining collapse
+    // exceeds maxError (a squared distance).
+    void Simplify(size_t target, double maxError);
+
+    const std::vector<unsigned int> &GetIndices() const { return mIndices; }
+    size_t GetNumTriangles() const { return mIndices.size() / 3; }
+
+    // Largest squared error of the collapses so far
+    double GetError() const { return mError; }
+
+private:
+    struct Collapse {
+        unsigned int mFrom, mTo;
+        double mCost;
+
+        bool operator<(const Collapse &o) const {
+            if (mCost != o.mCost) {
+                return mCost < o.mCost;
+            }
+            return mFrom != o.mFrom ? mFrom < o.mFrom : mTo < o.mTo;
+        }
+    };
+
+    void BuildPositionRemap();
+    void ClassifyVertices();
+    void ComputeQuadrics();
+    void ComputeDominantBones();
+    bool CanCollapse(unsigned int from, unsigned int to, bool open) const;
+    unsigned int SeamTarget(unsigned int from, unsigned int to) const;
+    bool FlipsTriangle(unsigned int from, unsigned int to) const;
+    bool FoldsSurface(unsigned int from, unsigned int to) const;
+
+    const aiMesh *mMesh;
+    unsigned int mNumVertices;
+    std::vector<unsigned int> mIndices;
+    std::vector<unsigned int> mRemap; // first vertex with the same position
+    std::vector<unsigned int> mWedge; // next vertex with the same position, cyclic
+    std::vector<VertexKind> mKind;
+    std::vector<Quadric> mQuadrics; // per position, indexed by mRemap
+    std::vector<unsigned int> mBone; // most influential bone, UINT_MAX if none
+    EdgeAdjacency mAdjacency; // by vertex
+    EdgeAdjacency mPositionAdjacency; // by position
+    mutable std::vector<unsigned int> mNeighbours; // scratch for FoldsSurface()
+    double mError;
+};
+
+// ------------------------------------------------------------------------------------------------
+Simplifier::Simplifier(const aiMesh *mesh) :
+        mMesh(mesh), mNumVertices(mesh->mNumVertices), mError(0.0) {
+    mIndices.resize(mesh->mNumFaces * 3);
+    for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
+        const aiFace &face = mesh->mFaces[a];
+        std::copy(face.mIndices, face.mIndices + 3, mIndices.begin() + a * 3);
+    }
+
+    BuildPositionRemap();
+    mAdjacency.Build(mIndices, nullptr, mNumVertices);
+    ClassifyVertices();
+    ComputeQuadrics();
+    ComputeDominantBones();
+}
+
+// ------------------------------------------------------------------------------------------------
+void Simplifier::BuildPositionRemap() {
+    const aiVector3D *pos = mMesh->mVertices;
+    std::vector<unsigned int> order(mNumVertices);
+    for (unsigned int v = 0; v < mNumVertices; ++v) {
+        order[v] = v;
+    }
+    std::sort(order.begin(), order.end(), [pos](unsigned int a, unsigned int b) {
+        if (pos[a].x != pos[b].x) {
+            return pos[a].x < pos[b].x;
+        }
+        if (pos[a].y != pos[b].y) {
+            return pos[a].y < pos[b].y;
+        }
+        if (pos[a].z != pos[b].z) {
+            return pos[a].z < pos[b].z;
+        }
+        return a < b;
+    });
+
+    mRemap.resize(mNumVertices);
+    mWedge.resize(mNumVertices);
+    for (unsigned int begin = 0; begin < mNumVertices;) {
+        unsigned int end = begin + 1;
+        while (end < mNumVertices && pos[order[end]] == pos[order[begin]]) {
+            ++end;
+        }
+        for (unsigned int i = begin; i < end; ++i) {
+            mRemap[order[i]] = order[begin];
+            mWedge[order[i]] = order[i + 1 < end ? i + 1 : begin];
+        }
+        begin = end;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Simplifier::ClassifyVertices() {
+    // the open edge entering and leaving each vertex, the vertex itself if there are several
+    const unsigned int None = UINT_MAX;
+    std::vector<unsigned int> openIn(mNumVertices, None), openOut(mNumVertices, None);
+    for (unsigned int v = 0; v < mNumVertices; ++v) {
+        for (const EdgeAdjacency::Edge *e = mAdjacency.Begin(v); e != mAdjacency.End(v); ++e) {
+            const unsigned int w = e->mNext;
+            if (mAdjacency.HasEdge(w, v)) {
+                continue;
+            }
+            openOut[v] = (openOut[v] == None) ? w : v;
+            openIn[w] = (openIn[w] == None) ? v : w;
+        }
+    }
+
+    mKind.resize(mNumVertices, Kind_Locked);
+    for (unsigned int v = 0; v < mNumVertices; ++v) {
+        if (mRemap[v] != v) {
+            continue;
+        }
+        VertexKind kind = Kind_Locked;
+        if (mWedge[v] == v) {
+            if (openIn[v] == None && openOut[v] == None) {
+                kind = Kind_Manifold;
+            } else if (openIn[v] != None && openIn[v] != v && openOut[v] != None && openOut[v] != v) {
+                kind = Kind_Border;
+            }
+        } else if (mWedge[mWedge[v]] == v) {
+            // both sides must continue the seam to the same positions, in opposite directions
+            const unsigned int w = mWedge[v];
+            const unsigned int in0 = openIn[v], out0 = openOut[v], in1 = openIn[w], out1 = openOut[w];
+            if (in0 != None && in0 != v && out0 != None && out0 != v &&
+                    in1 != None && in1 != w && out1 != None && out1 != w &&
+                    mRemap[in0] == mRemap[out1] && mRemap[out0] == mRemap[in1] &&
+                    mRemap[in0] != mRemap[out0]) {
+                kind = Kind_Seam;
+            }
+        }
+        for (unsigned int w = v;;) {
+            mKind[w] = kind;
+            w = mWedge[w];
+            if (w == v) {
+                break;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Simplifier::ComputeQuadrics() {
+    const aiVector3D *pos = mMesh->mVertices;
+    mQuadrics.assign(mNumVertices, Quadric());
+
+    for (size_t t = 0; t < mIndices.size(); t += 3) {
+        const unsigned int *tri = &mIndices[t];
+        aiVector3D n = (pos[tri[1]] - pos[tri[0]]) ^ (pos[tri[2]] - pos[tri[0]]);
+        const ai_real area = n.Length();
+        if (area <= ai_real(0.0)) {
+            continue;
+        }
+        n /= area;
+        for (unsigned int k = 0; k < 3; ++k) {
+            AddPlane(mQuadrics[mRemap[tri[k]]], n, pos[tri[k]], area * 0.5);
+        }
+
+        // keep open edges, borders as well as seams, from moving sideways
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int a = tri[k], b = tri[(k + 1) % 3];
+            if (mAdjacency.HasEdge(b, a)) {
+                continue;
+            }
+            const aiVector3D edge = pos[b] - pos[a];
+            aiVector3D m = edge ^ n;
+            const ai_real len = m.Length();
+            if (len <= ai_real(0.0)) {
+                continue;
+            }
+            m /= len;
+            const double w = BorderWeight * edge.SquareLength();
+            AddPlane(mQuadrics[mRemap[a]], m, pos[a], w);
+            AddPlane(mQuadrics[mRemap[b]], m, pos[a], w);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void Simplifier::ComputeDominantBones() {
+    mBone.assign(mNumVertices, UINT_MAX);
+    std::vector<float> weight(mMesh->mNumBones ? mNumVertices : 0, 0.f);
+    for (unsigned int b = 0; b < mMesh->mNumBones; ++b) {
+        const aiBone *bone = mMesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight &vw = bone->mWeights[w];
+            if (vw.mVertexId < mNumVertices && vw.mWeight > weight[vw.mVertexId]) {
+                weight[vw.mVertexId] = vw.mWeight;
+                mBone[vw.mVertexId] = b;
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether vertex from may be merged into vertex to. open tells whether the edge between
+// them lacks an opposite half-edge.
+bool Simplifier::CanCollapse(unsigned int from, unsigned int to, bool open) const {
+    switch (mKind[from]) {
+    case Kind_Manifold:
+        break;
+    case Kind_Border:
+        if (!open || mKind[to] != Kind_Border) {
+            return false;
+        }
+        break;
+    case Kind_Seam:
+        if (!open || mKind[to] != Kind_Seam || UINT_MAX == SeamTarget(from, to)) {
+            return false;
+        }
+        break;
+    default:
+        return false;
+    }
+
+    // the triangles of from take over the attributes of to
+    if (mBone[from] != mBone[to]) {
+        return false;
+    }
+    if (mMesh->HasNormals() && mMesh->mNormals[from] * mMesh->mNormals[to] < MinNormalDot) {
+        return false;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The vertex the other side of the seam at from is merged into, UINT_MAX if the seam does not
+// continue along the edge
+unsigned int Simplifier::SeamTarget(unsigned int from, unsigned int to) const {
+    const unsigned int s = mWedge[from], t = mWedge[to];
+    if (mAdjacency.HasEdge(s, t) || mAdjacency.HasEdge(t, s)) {
+        return t;
+    }
+    return UINT_MAX;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether moving the position of from onto to flips one of the remaining triangles.
+// Both arguments are positions, i.e. entries of mRemap.
+bool Simplifier::FlipsTriangle(unsigned int from, unsigned int to) const {
+    const aiVector3D *pos = mMesh->mVertices;
+    for (const EdgeAdjacency::Edge *e = mPositionAdjacency.Begin(from); e != mPositionAdjacency.End(from); ++e) {
+        if (e->mNext == to || e->mPrev == to) {
+            continue;
+        }
+        const aiVector3D &p1 = pos[e->mNext], &p2 = pos[e->mPrev];
+        const aiVector3D n0 = (p1 - pos[from]) ^ (p2 - pos[from]);
+        const aiVector3D n1 = (p1 - pos[to]) ^ (p2 - pos[to]);
+        // turning a triangle on its side is as bad as flipping it, it leaves a sliver
+        const ai_real len0 = n0.SquareLength();
+        if (len0 > ai_real(0.0) && n0 * n1 <= MinTriangleDot * std::sqrt(len0 * n1.SquareLength())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks the link condition: the positions next to both ends of the edge must be the ones
+// opposite to it, any other common neighbour makes the collapse fold the surface onto itself.
+bool Simplifier::FoldsSurface(unsigned int from, unsigned int to) const {
+    mNeighbours.clear();
+    for (const EdgeAdjacency::Edge *e = mPositionAdjacency.Begin(to); e != mPositionAdjacency.End(to); ++e) {
+        mNeighbours.push_back(e->mNext);
+        mNeighbours.push_back(e->mPrev);
+    }
+    std::sort(mNeighbours.begin(), mNeighbours.end());
+
+    unsigned int opposite = 0;
+    std::vector<unsigned int>::iterator end = mNeighbours.end();
+    for (const EdgeAdjacency::Edge *e = mPositionAdjacency.Begin(from); e != mPositionAdjacency.End(from); ++e) {
+        if (e->mNext == to || e->mPrev == to) {
+            ++opposite;
+        }
+    }
+    unsigned int common = 0;
+    for (const EdgeAdjacency::Edge *e = mPositionAdjacency.Begin(from); e != mPositionAdjacency.End(from); ++e) {
+        for (unsigned int n : { e->mNext, e->mPrev }) {
+            if (n == to) {
+                continue;
+            }
+            // count each common neighbour once by removing it from the sorted range
+            std::vector<unsigned int>::iterator it = std::lower_bound(mNeighbours.begin(), end, n);
+            if (it != end && *it == n) {
+                ++common;
+                end = std::remove(it, end, n);
+            }
+        }
+    }
+    return common > opposite;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Simplifier::Simplify(size_t target, double maxError) {
+    const aiVector3D *pos = mMesh->mVertices;
+    std::vector<Collapse> candidates;
+    std::vector<unsigned int> collapse(mNumVertices);
+    std::vector<unsigned char> locked(mNumVertices);
+
+    while (GetNumTriangles() > target) {
+        const size_t numTriangles = GetNumTriangles();
+        mAdjacency.Build(mIndices, nullptr, mNumVertices);
+        mPositionAdjacency.Build(mIndices, mRemap.data(), mNumVertices);
+
+        // gather the possible collapses of each edge, the cheaper direction if both work
+        candidates.clear();
+        for (size_t t = 0; t < mIndices.size(); t += 3) {
+            for (unsigned int k = 0; k < 3; ++k) {
+                const unsigned int a = mIndices[t + k], b = mIndices[t + (k + 1) % 3];
+                const bool open = !mAdjacency.HasEdge(b, a);
+                // shared edges are seen from both triangles
+                if (!open && mRemap[a] > mRemap[b]) {
+                    continue;
+                }
+                Collapse c = { UINT_MAX, UINT_MAX, 0.0 };
+                if (CanCollapse(a, b, open)) {
+                    c.mFrom = a;
+                    c.mTo = b;
+                    c.mCost = QuadricError(mQuadrics[mRemap[a]], pos[b]);
+                }
+                if (CanCollapse(b, a, open)) {
+                    const double cost = QuadricError(mQuadrics[mRemap[b]], pos[a]);
+                    if (UINT_MAX == c.mFrom || cost < c.mCost) {
+                        c.mFrom = b;
+                        c.mTo = a;
+                        c.mCost = cost;
+                    }
+                }
+                if (UINT_MAX != c.mFrom && c.mCost <= maxError) {
+                    candidates.push_back(c);
+                }
+            }
+        }
+        if (candidates.empty()) {
+            break;
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // many of the cheapest collapses get blocked by their neighbours, allow some slack over
+        // the cost of the last collapse needed to reach the target. Close to the target that
+        // would leave a handful of collapses per pass, a pass always gets a share of all edges.
+        const size_t goal = std::max((numTriangles - target) / 2, candidates.size() / 8);
+        const double passError = goal < candidates.size() ? 1.5 * candidates[goal].mCost : maxError;
+
+        for (unsigned int v = 0; v < mNumVertices; ++v) {
+            collapse[v] = v;
+        }
+        std::fill(locked.begin(), locked.end(), 0);
+        size_t removed = 0, collapsed = 0;
+        for (const Collapse &c : candidates) {
+            if (c.mCost > passError && collapsed > 0) {
+                break;
+            }
+            const unsigned int from = mRemap[c.mFrom], to = mRemap[c.mTo];
+            if (locked[from] || locked[to] || FlipsTriangle(from, to) || FoldsSurface(from, to)) {
+                continue;
+            }
+
+            collapse[c.mFrom] = c.mTo;
+            if (Kind_Seam == mKind[c.mFrom]) {
+                collapse[mWedge[c.mFrom]] = SeamTarget(c.mFrom, c.mTo);
+            }
+            AddQuadric(mQuadrics[to], mQuadrics[from]);
+
+            // none of the triangles around from may change otherwise
+            locked[from] = locked[to] = 1;
+            for (const EdgeAdjacency::Edge *e = mPositionAdjacency.Begin(from); e != mPositionAdjacency.End(from); ++e) {
+                locked[e->mNext] = locked[e->mPrev] = 1;
+            }
+
+            mError = std::max(mError, c.mCost);
+            ++collapsed;
+            removed += (Kind_Border == mKind[c.mFrom]) ? 1 : 2;
+            if (removed >= numTriangles - target) {
+                break;
+            }
+        }
+        if (0 == collapsed) {
+            break;
+        }
+
+        // drop the triangles that lost an edge
+        size_t out = 0;
+        for (size_t t = 0; t < mIndices.size(); t += 3) {
+            const unsigned int a = collapse[mIndices[t]], b = collapse[mIndices[t + 1]], c = collapse[mIndices[t + 2]];
+            if (mRemap[a] == mRemap[b] || mRemap[b] == mRemap[c] || mRemap[c] == mRemap[a]) {
+                continue;
+            }
+            mIndices[out++] = a;
+            mIndices[out++] = b;
+            mIndices[out++] = c;
+        }
+        mIndices.resize(out);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Builds a mesh from the given triangles of mesh and the vertices they use
+aiMesh *MakeLODMesh(const aiMesh *mesh, const std::vector<unsigned int> &indices, unsigned int level) {
+    aiMesh *out = new aiMesh();
+    out->mName = mesh->mName;
+    out->mName.Append("_LOD");
+    out->mName.Append(std::to_string(level).c_str());
+    out->mMaterialIndex = mesh->mMaterialIndex;
+    out->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+
+    // number the vertices in order of first use
+    std::vector<unsigned int> vMap(mesh->mNumVertices, UINT_MAX);
+    unsigned int numVertices = 0;
+    const unsigned int numFaces = static_cast<unsigned int>(indices.size() / 3);
+    unsigned int *buffer = AllocateIndexBuffer(out, numFaces, 3);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        unsigned int &v = vMap[indices[i]];
+        if (UINT_MAX == v) {
+            v = numVertices++;
+        }
+        buffer[i] = v;
+    }
+    BuildFaceViews(out);
+
+    out->mNumVertices = numVertices;
+    out->mVertices = new aiVector3D[numVertices];
+    if (mesh->HasNormals()) {
+        out->mNormals = new aiVector3D[numVertices];
+    }
+    if (mesh->HasTangentsAndBitangents()) {
+        out->mTangents = new aiVector3D[numVertices];
+        out->mBitangents = new aiVector3D[numVertices];
+    }
+    for (unsigned int c = 0; mesh->HasTextureCoords(c); ++c) {
+        out->mTextureCoords[c] = new aiVector3D[numVertices];
+        out->mNumUVComponents[c] = mesh->mNumUVComponents[c];
+        if (mesh->HasTextureCoordsName(c)) {
+            out->SetTextureCoordsName(c, *mesh->mTextureCoordsNames[c]);
+        }
+    }
+    for (unsigned int c = 0; mesh->HasVertexColors(c); ++c) {
+        out->mColors[c] = new aiColor4D[numVertices];
+    }
+
+    for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+        const unsigned int nv = vMap[v];
+        if (UINT_MAX == nv) {
+            continue;
+        }
+        out->mVertices[nv] = mesh->mVertices[v];
+        if (mesh->HasNormals()) {
+            out->mNormals[nv] = mesh->mNormals[v];
+        }
+        if (mesh->HasTangentsAndBitangents()) {
+            out->mTangents[nv] = mesh->mTangents[v];
+            out->mBitangents[nv] = mesh->mBitangents[v];
+        }
+        for (unsigned int c = 0; mesh->HasTextureCoords(c); ++c) {
+            out->mTextureCoords[c][nv] = mesh->mTextureCoords[c][v];
+        }
+        for (unsigned int c = 0; mesh->HasVertexColors(c); ++c) {
+            out->mColors[c][nv] = mesh->mColors[c][v];
+        }
+    }
+
+    // bones without weights on the remaining vertices are dropped
+    std::vector<aiBone *> bones;
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        const aiBone *bone = mesh->mBones[b];
+        unsigned int numWeights = 0;
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            numWeights += (UINT_MAX != vMap[bone->mWeights[w].mVertexId]) ? 1 : 0;
+        }
+        if (0 == numWeights) {
+            continue;
+        }
+        aiBone *newBone = new aiBone();
+        newBone->mName = bone->mName;
+        newBone->mArmature = bone->mArmature;
+        newBone->mNode = bone->mNode;
+        newBone->mOffsetMatrix = bone->mOffsetMatrix;
+        newBone->mWeights = new aiVertexWeight[numWeights];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const unsigned int nv = vMap[bone->mWeights[w].mVertexId];
+            if (UINT_MAX != nv) {
+                newBone->mWeights[newBone->mNumWeights++] = aiVertexWeight(nv, bone->mWeights[w].mWeight);
+            }
+        }
+        bones.push_back(newBone);
+    }
+    if (!bones.empty()) {
+        out->mNumBones = static_cast<unsigned int>(bones.size());
+        out->mBones = new aiBone *[bones.size()];
+        std::copy(bones.begin(), bones.end(), out->mBones);
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Adds the LOD children below node and its descendants. lods[m] holds the indices of the LODs
+// of mesh m in the scene's mesh list, errors[m] their errors.
+void AddLODNodes(aiNode *node, const std::vector<std::vector<unsigned int>> &lods,
+        const std::vector<std::vector<float>> &errors) {
+    for (unsigned int a = 0; a < node->mNumChildren; ++a) {
+        AddLODNodes(node->mChildren[a], lods, errors);
+    }
+
+    size_t levels = 0;
+    for (unsigned int a = 0; a < node->mNumMeshes; ++a) {
+        levels = std::max(levels, lods[node->mMeshes[a]].size());
+    }
+    if (0 == levels) {
+        return;
+    }
+
+    aiNode **children = new aiNode *[node->mNumChildren + levels];
+    std::copy(node->mChildren, node->mChildren + node->mNumChildren, children);
+    delete[] node->mChildren;
+    node->mChildren = children;
+
+    for (size_t level = 1; level <= levels; ++level) {
+        aiNode *child = new aiNode();
+        child->mName = node->mName;
+        child->mName.Append("_LOD");
+        child->mName.Append(std::to_string(level).c_str());
+        child->mParent = node;
+
+        float error = 0.f;
+        child->mNumMeshes = node->mNumMeshes;
+        child->mMeshes = new unsigned int[node->mNumMeshes];
+        for (unsigned int a = 0; a < node->mNumMeshes; ++a) {
+            const unsigned int mesh = node->mMeshes[a];
+            const size_t available = std::min(level, lods[mesh].size());
+            child->mMeshes[a] = available ? lods[mesh][available - 1] : mesh;
+            if (available) {
+                error = std::max(error, errors[mesh][available - 1]);
+            }
+        }
+
+        child->mMetaData = aiMetadata::Alloc(2);
+        child->mMetaData->Set(0, "LodLevel", static_cast<int32_t>(level));
+        child->mMetaData->Set(1, "LodError", error);
+        node->mChildren[node->mNumChildren++] = child;
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+GenerateLODsProcess::GenerateLODsProcess() :
+        mConfigLevels(0), mConfigRatio(AI_GLOD_DEFAULT_RATIO), mConfigMaxError(AI_GLOD_DEFAULT_MAX_ERROR) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenerateLODsProcess::~GenerateLODsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// All flag bits are taken, the step rides along with the one it depends on
+bool GenerateLODsProcess::IsActive(unsigned int pFlags) const {
+    return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The source meshes are only read, the LODs are created with an index buffer
+bool GenerateLODsProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsProcess::SetupProperties(const Importer *pImp) {
+    const int levels = pImp->GetPropertyInteger(AI_CONFIG_PP_GLOD_LEVELS, 0);
+    mConfigLevels = levels > 0 ? static_cast<unsigned int>(levels) : 0;
+
+    mConfigRatio = pImp->GetPropertyFloat(AI_CONFIG_PP_GLOD_RATIO, AI_GLOD_DEFAULT_RATIO);
+    if (!(mConfigRatio > 0.f && mConfigRatio < 1.f)) {
+        ASSIMP_LOG_WARN("GenerateLODsProcess: AI_CONFIG_PP_GLOD_RATIO must be in (0,1), using the default");
+        mConfigRatio = AI_GLOD_DEFAULT_RATIO;
+    }
+
+    mConfigMaxError = pImp->GetPropertyFloat(AI_CONFIG_PP_GLOD_MAX_ERROR, AI_GLOD_DEFAULT_MAX_ERROR);
+    if (!(mConfigMaxError >= 0.f)) {
+        ASSIMP_LOG_WARN("GenerateLODsProcess: AI_CONFIG_PP_GLOD_MAX_ERROR must not be negative, using the default");
+        mConfigMaxError = AI_GLOD_DEFAULT_MAX_ERROR;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateLODsProcess::Execute(aiScene *pScene) {
+    if (0 == mConfigLevels || 0 == pScene->mNumMeshes) {
+        return;
+    }
+    ASSIMP_LOG_DEBUG("GenerateLODsProcess begin");
+
+    std::vector<std::vector<aiMesh *>> meshes(pScene->mNumMeshes);
+    std::vector<std::vector<float>> errors(pScene->mNumMeshes);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        meshes[a] = ProcessMesh(pScene->mMeshes[a], errors[a]);
+    });
+
+    // append the LODs in mesh order
+    std::vector<std::vector<unsigned int>> lods(pScene->mNumMeshes);
+    unsigned int numMeshes = pScene->mNumMeshes, numSimplified = 0;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        for (size_t l = 0; l < meshes[a].size(); ++l) {
+            lods[a].push_back(numMeshes++);
+        }
+        numSimplified += meshes[a].empty() ? 0 : 1;
+    }
+    if (numMeshes == pScene->mNumMeshes) {
+        ASSIMP_LOG_DEBUG("GenerateLODsProcess finished. No mesh could be simplified");
+        return;
+    }
+
+    aiMesh **out = new aiMesh *[numMeshes];
+    std::copy(pScene->mMeshes, pScene->mMeshes + pScene->mNumMeshes, out);
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        for (size_t l = 0; l < meshes[a].size(); ++l) {
+            out[lods[a][l]] = meshes[a][l];
+        }
+    }
+    const unsigned int numGenerated = numMeshes - pScene->mNumMeshes;
+    delete[] pScene->mMeshes;
+    pScene->mMeshes = out;
+    pScene->mNumMeshes = numMeshes;
+
+    AddLODNodes(pScene->mRootNode, lods, errors);
+
+    ASSIMP_LOG_INFO("GenerateLODsProcess finished. Generated ", numGenerated, " LOD meshes for ",
+            numSimplified, " meshes");
+}
+
+// ------------------------------------------------------------------------------------------------
+std::vector<aiMesh *> GenerateLODsProcess::ProcessMesh(const aiMesh *mesh, std::vector<float> &errors) const {
+    std::vector<aiMesh *> lods;
+
+    // morph targets would need to be simplified along with the mesh
+    if (aiPrimitiveType_TRIANGLE != mesh->mPrimitiveTypes || mesh->mNumAnimMeshes || !mesh->HasFaces()) {
+        return lods;
+    }
+
+    aiVector3D min = mesh->mVertices[0], max = mesh->mVertices[0];
+    for (unsigned int v = 1; v < mesh->mNumVertices; ++v) {
+        min = aiVector3D(std::min(min.x, mesh->mVertices[v].x), std::min(min.y, mesh->mVertices[v].y), std::min(min.z, mesh->mVertices[v].z));
+        max = aiVector3D(std::max(max.x, mesh->mVertices[v].x), std::max(max.y, mesh->mVertices[v].y), std::max(max.z, mesh->mVertices[v].z));
+    }
+    const double size = (max - min).Length();
+    if (!(size > 0.0)) {
+        return lods;
+    }
+    const double maxError = static_cast<double>(mConfigMaxError) * size;
+
+    Simplifier simplifier(mesh);
+    size_t previous = mesh->mNumFaces;
+    double target = mesh->mNumFaces;
+    for (unsigned int level = 1; level <= mConfigLevels; ++level) {
+        target *= mConfigRatio;
+        const size_t goal = static_cast<size_t>(target);
+        if (0 == goal) {
+            break;
+        }
+        simplifier.Simplify(goal, maxError * maxError);
+
+        // a level saving less than 5% of the triangles is not worth drawing
+        const size_t count = simplifier.GetNumTriangles();
+        if (0 == count || count * 20 > previous * 19) {
+            break;
+        }
+        lods.push_back(MakeLODMesh(mesh, simplifier.GetIndices(), level));
+        errors.push_back(static_cast<float>(std::sqrt(simplifier.GetError()) / size));
+        previous = count;
+
+        // the error limit was hit, the next level would be the same
+        if (count > goal) {
+            break;
+        }
+    }
+    return lods;
+}
@@ -0,0 +1,106 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file GenerateLODsProcess.h
+ *  @brief Defines a post-processing step generating simplified level of
+ *    detail meshes, see #AI_CONFIG_PP_GLOD_LEVELS.
+ */
+#pragma once
+#ifndef AI_GENERATELODSPROCESS_H_INC
+#define AI_GENERATELODSPROCESS_H_INC
+
+#include "Common/BaseProcess.h"
+
+#include <vector>
+
+struct aiMesh;
+struct aiNode;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The GenerateLODsProcess builds a chain of simplified versions of each
+ *  triangle mesh by quadric error edge collapse and links them from the
+ *  node graph. There is no aiPostProcessSteps flag left for it, the step is
+ *  enabled with #AI_CONFIG_PP_GLOD_LEVELS and runs as part of
+ *  #aiProcess_JoinIdenticalVertices.
+ */
+class ASSIMP_API GenerateLODsProcess : public BaseProcess {
+public:
+    GenerateLODsProcess();
+    ~GenerateLODsProcess();
+
+    // -------------------------------------------------------------------
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const override;
+
+    // -------------------------------------------------------------------
+    void SetupProperties(const Importer *pImp) override;
+
+    // -------------------------------------------------------------------
+    void Execute(aiScene *pScene) override;
+
+protected:
+    // -------------------------------------------------------------------
+    /** Simplifies a mesh level by level.
+     *  @param mesh The mesh to simplify, not modified.
+     *  @param errors Receives the error of each LOD relative to the
+     *    mesh size.
+     *  @return The LOD meshes, most detailed first. */
+    std::vector<aiMesh *> ProcessMesh(const aiMesh *mesh, std::vector<float> &errors) const;
+
+private:
+    //! Configuration parameter: number of LODs per mesh, 0 disables the step
+    unsigned int mConfigLevels;
+
+    //! Configuration parameter: triangle ratio between successive levels
+    float mConfigRatio;
+
+    //! Configuration parameter: maximum error relative to the mesh size
+    float mConfigMaxError;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENERATELODSPROCESS_H_INC
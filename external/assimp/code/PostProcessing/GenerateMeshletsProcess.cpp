@@ -0,0 +1,399 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file GenerateMeshletsProcess.cpp
+ *  @brief Implementation of the post-processing step splitting meshes into
+ *    meshlets.
+ *
+ * Meshlets are grown greedily the way meshoptimizer's meshopt_buildMeshlets
+ * does it: the next triangle is the neighbour adding the fewest vertices,
+ * with ties going to the one closest to the meshlet's center and average
+ * normal, which keeps meshlets round and their normal cones narrow. Once
+ * the neighbourhood of a meshlet is used up, the next unused face in the
+ * order of the ImproveCacheLocality step continues it. The normal cones
+ * follow meshopt_computeMeshletBounds.
+ */
+
+#include "PostProcessing/GenerateMeshletsProcess.h"
+#include "Common/VertexTriangleAdjacency.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+using namespace Assimp;
+
+namespace {
+
+// Weight of the normal deviation against the distance when choosing between
+// neighbours that add the same number of vertices
+const float ConeWeight = 0.25f;
+
+// Normal cones wider than this (the cosine of the half angle) cannot cull
+// anything useful and are disabled
+const ai_real MinConeDot = ai_real(0.1);
+
+// Marks vertices not in the current meshlet
+const unsigned int NotInMeshlet = ~0u;
+
+// ------------------------------------------------------------------------------------------------
+// Removes all occurrences of a triangle from the live part of a vertex's adjacency list
+void RemoveTriangle(VertexTriangleAdjacency &adj, unsigned int vertex, unsigned int tri) {
+    unsigned int *list = adj.GetAdjacentTriangles(vertex);
+    unsigned int &live = adj.GetNumTrianglesPtr(vertex);
+    for (unsigned int i = 0; i < live;) {
+        if (list[i] == tri) {
+            list[i] = list[--live];
+        } else {
+            ++i;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Bounding sphere of the meshlet's vertices, see Ritter, "An Efficient Bounding Sphere"
+void ComputeSphere(const aiMesh *mesh, const unsigned int *vertices, unsigned int count, aiMeshlet &meshlet) {
+    // the pair of extreme points along the axis they are furthest apart on
+    unsigned int minIdx[3] = { 0, 0, 0 }, maxIdx[3] = { 0, 0, 0 };
+    for (unsigned int i = 1; i < count; ++i) {
+        const aiVector3D &p = mesh->mVertices[vertices[i]];
+        for (unsigned int axis = 0; axis < 3; ++axis) {
+            if (p[axis] < mesh->mVertices[vertices[minIdx[axis]]][axis]) minIdx[axis] = i;
+            if (p[axis] > mesh->mVertices[vertices[maxIdx[axis]]][axis]) maxIdx[axis] = i;
+        }
+    }
+    unsigned int best = 0;
+    ai_real bestDist = -1;
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+        const ai_real dist = (mesh->mVertices[vertices[maxIdx[axis]]] - mesh->mVertices[vertices[minIdx[axis]]]).SquareLength();
+        if (dist > bestDist) {
+            bestDist = dist;
+            best = axis;
+        }
+    }
+    const aiVector3D &p0 = mesh->mVertices[vertices[minIdx[best]]];
+    const aiVector3D &p1 = mesh->mVertices[vertices[maxIdx[best]]];
+    aiVector3D center = (p0 + p1) * ai_real(0.5);
+    ai_real radius = std::sqrt(bestDist) * ai_real(0.5);
+
+    // grow the sphere to include the remaining points
+    for (unsigned int i = 0; i < count; ++i) {
+        const aiVector3D &p = mesh->mVertices[vertices[i]];
+        const ai_real dist = (p - center).Length();
+        if (dist > radius) {
+            const ai_real grow = (dist - radius) * ai_real(0.5);
+            center += (p - center) * (grow / dist);
+            radius += grow;
+        }
+    }
+    meshlet.mCenter = center;
+    meshlet.mRadius = radius;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Normal cone of the meshlet's triangles. The apex is placed on the axis behind the sphere center,
+// so that it lies behind the planes of all triangles.
+void ComputeCone(const aiMesh *mesh, const unsigned int *indices, const std::vector<aiVector3D> &normals,
+        const unsigned int *faces, aiMeshlet &meshlet) {
+    aiVector3D axis;
+    for (unsigned int i = 0; i < meshlet.mFaceCount; ++i) {
+        axis += normals[faces[i]];
+    }
+    const ai_real length = axis.Length();
+    meshlet.mConeApex = meshlet.mCenter;
+    meshlet.mConeCutoff = 1;
+    if (!(length > 0)) {
+        return;
+    }
+    axis /= length;
+    meshlet.mConeAxis = axis;
+
+    ai_real minDot = 1;
+    for (unsigned int i = 0; i < meshlet.mFaceCount; ++i) {
+        const aiVector3D &n = normals[faces[i]];
+        if (n.SquareLength() > 0) {
+            minDot = std::min(minDot, n * axis);
+        }
+    }
+    if (minDot <= MinConeDot) {
+        return;
+    }
+
+    ai_real maxT = 0;
+    for (unsigned int i = 0; i < meshlet.mFaceCount; ++i) {
+        const aiVector3D &n = normals[faces[i]];
+        if (n.SquareLength() > 0) {
+            // dot(center - t * axis - corner, n) = 0
+            const aiVector3D &corner = mesh->mVertices[indices[faces[i] * 3]];
+            maxT = std::max(maxT, ((meshlet.mCenter - corner) * n) / (axis * n));
+        }
+    }
+    meshlet.mConeApex = meshlet.mCenter - axis * maxT;
+
+    // the cone of view directions seeing only back faces is the normal cone widened by 90 degrees
+    // and inverted, its cutoff is -cos(a + 90) = sin(a)
+    meshlet.mConeCutoff = std::sqrt(ai_real(1) - minDot * minDot);
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+GenerateMeshletsProcess::GenerateMeshletsProcess() :
+        mConfigMaxVertices(0), mConfigMaxFaces(AI_GML_DEFAULT_MAX_FACES) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+GenerateMeshletsProcess::~GenerateMeshletsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+// All flag bits are taken, the step rides along with the one whose face order it builds on
+bool GenerateMeshletsProcess::IsActive(unsigned int pFlags) const {
+    return (pFlags & aiProcess_ImproveCacheLocality) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The triangles are reordered within the index buffer
+bool GenerateMeshletsProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::SetupProperties(const Importer *pImp) {
+    const int maxVertices = pImp->GetPropertyInteger(AI_CONFIG_PP_GML_MAX_VERTICES, 0);
+    mConfigMaxVertices = maxVertices > 0 ? static_cast<unsigned int>(maxVertices) : 0;
+    if (mConfigMaxVertices > 0 && mConfigMaxVertices < 3) {
+        ASSIMP_LOG_WARN("GenerateMeshletsProcess: AI_CONFIG_PP_GML_MAX_VERTICES must be at least 3");
+        mConfigMaxVertices = 3;
+    }
+    if (mConfigMaxVertices > AI_MAX_MESHLET_VERTICES) {
+        ASSIMP_LOG_WARN("GenerateMeshletsProcess: AI_CONFIG_PP_GML_MAX_VERTICES is larger than AI_MAX_MESHLET_VERTICES");
+        mConfigMaxVertices = AI_MAX_MESHLET_VERTICES;
+    }
+
+    const int maxFaces = pImp->GetPropertyInteger(AI_CONFIG_PP_GML_MAX_FACES, AI_GML_DEFAULT_MAX_FACES);
+    if (maxFaces <= 0) {
+        ASSIMP_LOG_WARN("GenerateMeshletsProcess: AI_CONFIG_PP_GML_MAX_FACES must be positive, using the default");
+        mConfigMaxFaces = AI_GML_DEFAULT_MAX_FACES;
+    } else {
+        mConfigMaxFaces = static_cast<unsigned int>(maxFaces);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsProcess::Execute(aiScene *pScene) {
+    if (0 == mConfigMaxVertices || 0 == pScene->mNumMeshes) {
+        return;
+    }
+    ASSIMP_LOG_DEBUG("GenerateMeshletsProcess begin");
+
+    std::vector<unsigned int> results(pScene->mNumMeshes, 0);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        results[a] = ProcessMesh(pScene->mMeshes[a]);
+    });
+
+    unsigned int numMeshlets = 0, numMeshes = 0;
+    for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        numMeshlets += results[a];
+        numMeshes += results[a] ? 1 : 0;
+    }
+    ASSIMP_LOG_INFO("GenerateMeshletsProcess finished. Split ", numMeshes, " meshes into ", numMeshlets, " meshlets");
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int GenerateMeshletsProcess::ProcessMesh(aiMesh *mesh) const {
+    if (aiPrimitiveType_TRIANGLE != mesh->mPrimitiveTypes || !mesh->HasFaces() || !mesh->HasPositions()) {
+        return 0;
+    }
+    const unsigned int numFaces = mesh->mNumFaces;
+
+    // work on a flat copy of the triangles, it is written back in meshlet order at the end
+    unsigned int *const triangles = 3 == mesh->mFaceStride ? mesh->mIndexBuffer : nullptr;
+    std::vector<unsigned int> indices(numFaces * 3);
+    if (triangles) {
+        std::copy(triangles, triangles + numFaces * 3, indices.begin());
+    } else {
+        for (unsigned int f = 0; f < numFaces; ++f) {
+            std::copy(mesh->mFaces[f].mIndices, mesh->mFaces[f].mIndices + 3, indices.begin() + f * 3);
+        }
+    }
+
+    std::vector<aiVector3D> normals(numFaces), centers(numFaces);
+    double area = 0.0;
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        const aiVector3D &p0 = mesh->mVertices[indices[f * 3]];
+        const aiVector3D &p1 = mesh->mVertices[indices[f * 3 + 1]];
+        const aiVector3D &p2 = mesh->mVertices[indices[f * 3 + 2]];
+        const aiVector3D n = (p1 - p0) ^ (p2 - p0);
+        const ai_real length = n.Length();
+        if (length > 0) {
+            normals[f] = n / length;
+        }
+        centers[f] = (p0 + p1 + p2) / ai_real(3);
+        area += 0.5 * length;
+    }
+
+    // radius of a round meshlet with the maximum number of average sized triangles
+    float expectedRadius = static_cast<float>(std::sqrt(area / numFaces * mConfigMaxFaces / AI_MATH_PI));
+    if (!(expectedRadius > 0.f)) {
+        expectedRadius = 1.f;
+    }
+
+    // the live part of each adjacency list holds the triangles not assigned to a meshlet yet
+    VertexTriangleAdjacency adj(indices.data(), numFaces, mesh->mNumVertices, true);
+
+    std::vector<unsigned int> localIndex(mesh->mNumVertices, NotInMeshlet);
+    std::vector<bool> assigned(numFaces, false);
+    std::vector<unsigned int> order;
+    order.reserve(numFaces);
+    std::vector<aiMeshlet> meshlets;
+    std::vector<unsigned int> meshletVertices;
+    std::vector<unsigned char> meshletIndices;
+    meshletIndices.reserve(numFaces * 3);
+
+    aiMeshlet current;
+    aiVector3D normalSum, positionSum;
+    unsigned int nextSeed = 0;
+    while (order.size() < numFaces) {
+        // the neighbour adding the fewest vertices. Triangles that are the last ones of a vertex
+        // come right after those adding none, they would be expensive to pick up later on.
+        aiVector3D axis = normalSum;
+        const ai_real length = axis.Length();
+        if (length > 0) {
+            axis /= length;
+        }
+        const aiVector3D center = current.mVertexCount ? positionSum / static_cast<ai_real>(current.mVertexCount) : aiVector3D();
+        unsigned int best = numFaces;
+        float bestScore = FLT_MAX;
+        for (unsigned int i = 0; i < current.mVertexCount; ++i) {
+            const unsigned int v = meshletVertices[current.mVertexOffset + i];
+            const unsigned int *list = adj.GetAdjacentTriangles(v);
+            const unsigned int live = adj.GetNumTrianglesPtr(v);
+            for (unsigned int j = 0; j < live; ++j) {
+                const unsigned int t = list[j];
+                unsigned int extra = 0;
+                bool dangling = false;
+                for (unsigned int k = 0; k < 3; ++k) {
+                    const unsigned int w = indices[t * 3 + k];
+                    extra += NotInMeshlet == localIndex[w] ? 1 : 0;
+                    dangling |= 1 == adj.GetNumTrianglesPtr(w);
+                }
+                // ties are broken by a term below 1, so it never outweighs a vertex
+                const float spread = static_cast<float>(1 - normals[t] * axis) * 0.5f;
+                const float distance = static_cast<float>((centers[t] - center).Length());
+                float score = 0 == extra ? 0.f : (dangling ? 1.f : static_cast<float>(extra) + 1.f);
+                score += ConeWeight * spread + (1.f - ConeWeight) * distance / (distance + expectedRadius);
+                if (score < bestScore || (score == bestScore && t < best)) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+        if (numFaces == best) {
+            while (assigned[nextSeed]) {
+                ++nextSeed;
+            }
+            best = nextSeed;
+        }
+
+        unsigned int extra = 0;
+        for (unsigned int k = 0; k < 3; ++k) {
+            extra += NotInMeshlet == localIndex[indices[best * 3 + k]] ? 1 : 0;
+        }
+        if (current.mVertexCount + extra > mConfigMaxVertices || current.mFaceCount >= mConfigMaxFaces) {
+            for (unsigned int i = 0; i < current.mVertexCount; ++i) {
+                localIndex[meshletVertices[current.mVertexOffset + i]] = NotInMeshlet;
+            }
+            meshlets.push_back(current);
+            current = aiMeshlet();
+            current.mVertexOffset = static_cast<unsigned int>(meshletVertices.size());
+            current.mFaceOffset = static_cast<unsigned int>(order.size());
+            normalSum = aiVector3D();
+            positionSum = aiVector3D();
+        }
+
+        for (unsigned int k = 0; k < 3; ++k) {
+            const unsigned int v = indices[best * 3 + k];
+            if (NotInMeshlet == localIndex[v]) {
+                localIndex[v] = current.mVertexCount++;
+                meshletVertices.push_back(v);
+                positionSum += mesh->mVertices[v];
+            }
+            meshletIndices.push_back(static_cast<unsigned char>(localIndex[v]));
+            RemoveTriangle(adj, v, best);
+        }
+        assigned[best] = true;
+        order.push_back(best);
+        ++current.mFaceCount;
+        normalSum += normals[best];
+    }
+    meshlets.push_back(current);
+
+    for (aiMeshlet &meshlet : meshlets) {
+        ComputeSphere(mesh, &meshletVertices[meshlet.mVertexOffset], meshlet.mVertexCount, meshlet);
+        ComputeCone(mesh, indices.data(), normals, &order[meshlet.mFaceOffset], meshlet);
+    }
+
+    // write the faces back in meshlet order, the faces of an index buffer point into it
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        unsigned int *out = triangles ? triangles + f * 3 : mesh->mFaces[f].mIndices;
+        std::copy(&indices[order[f] * 3], &indices[order[f] * 3] + 3, out);
+    }
+
+    mesh->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+    mesh->mMeshlets = new aiMeshlet[meshlets.size()];
+    std::copy(meshlets.begin(), meshlets.end(), mesh->mMeshlets);
+    mesh->mNumMeshletVertices = static_cast<unsigned int>(meshletVertices.size());
+    mesh->mMeshletVertices = new unsigned int[meshletVertices.size()];
+    std::copy(meshletVertices.begin(), meshletVertices.end(), mesh->mMeshletVertices);
+    mesh->mMeshletIndices = new unsigned char[meshletIndices.size()];
+    std::copy(meshletIndices.begin(), meshletIndices.end(), mesh->mMeshletIndices);
+
+    return mesh->mNumMeshlets;
+}
@@ -0,0 +1,99 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file GenerateMeshletsProcess.h
+ *  @brief Defines a post-processing step splitting meshes into meshlets,
+ *    see #AI_CONFIG_PP_GML_MAX_VERTICES.
+ */
+#pragma once
+#ifndef AI_GENERATEMESHLETSPROCESS_H_INC
+#define AI_GENERATEMESHLETSPROCESS_H_INC
+
+#include "Common/BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The GenerateMeshletsProcess splits each triangle mesh into meshlets of
+ *  adjacent triangles with a bounded number of vertices and triangles, and
+ *  computes a bounding sphere and a normal cone for each of them. There is
+ *  no aiPostProcessSteps flag left for it, the step is enabled with
+ *  #AI_CONFIG_PP_GML_MAX_VERTICES and runs after
+ *  #aiProcess_ImproveCacheLocality, whose face order seeds the meshlets.
+ */
+class ASSIMP_API GenerateMeshletsProcess : public BaseProcess {
+public:
+    GenerateMeshletsProcess();
+    ~GenerateMeshletsProcess();
+
+    // -------------------------------------------------------------------
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const override;
+
+    // -------------------------------------------------------------------
+    void SetupProperties(const Importer *pImp) override;
+
+    // -------------------------------------------------------------------
+    void Execute(aiScene *pScene) override;
+
+protected:
+    // -------------------------------------------------------------------
+    /** Splits a mesh into meshlets and reorders its faces to match.
+     *  @param mesh The mesh to process.
+     *  @return The number of meshlets, 0 if the mesh was skipped. */
+    unsigned int ProcessMesh(aiMesh *mesh) const;
+
+private:
+    //! Configuration parameter: vertices per meshlet, 0 disables the step
+    unsigned int mConfigMaxVertices;
+
+    //! Configuration parameter: triangles per meshlet
+    unsigned int mConfigMaxFaces;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENERATEMESHLETSPROCESS_H_INC
@@ -43,28 +43,614 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /** @file Implementation of the post processing step to improve the cache locality of a mesh.
  * <br>
- * The algorithm is roughly basing on this paper:
- * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
- *   .. although overdraw reduction isn't implemented yet ...
+ * Each triangle mesh runs through three passes:
+ * - The faces are sorted for the post-transform vertex cache with Tom Forsyth's "Linear-Speed
+ *   Vertex Cache Optimisation". Vertices are scored by their position in an LRU cache and by
+ *   the number of faces they have left, which depends less on the exact cache size of the
+ *   hardware than the FIFO model of the 'tipsify' algorithm. The latter is still available:
+ *   http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
+ * - The sorted faces are split into clusters where the cache is cold anyway, and the clusters
+ *   facing outwards are moved to the front, so that they occlude the rest of the mesh. This is
+ *   the overdraw reduction of the 'tipsify' paper.
+ * - The vertices are sorted in the order the faces reference them first.
+ *
+ * Large meshes are split into parts of consecutive faces, which are sorted for the cache and
+ * split into clusters in parallel. Only the clusters are sorted for the whole mesh.
+ *
+ * The passes follow the vertex cache, overdraw and vertex fetch optimizers of meshoptimizer.
  */
 
 // internal headers
 #include "PostProcessing/ImproveCacheLocality.h"
+#include "Common/TaskScheduler.h"
 #include "Common/VertexTriangleAdjacency.h"
 
-#include <assimp/StringUtils.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
-#include <stdio.h>
-#include <stack>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <vector>
 
 using namespace Assimp;
 
+namespace {
+
+// Marks the end of a chain of adjacent faces
+const unsigned int NoFace = ~0u;
+
+// Marks vertices which haven't been assigned a new index yet
+const unsigned int NoVertex = ~0u;
+
+// Vertices with more faces left than this all get the same valence score
+const unsigned int MaxValence = 32;
+
+// Size of the cache the tuned vertex scores are meant for
+const unsigned int TunedCacheSize = 16;
+
+// Faces per part of a mesh. The parts are optimized in parallel, their size doesn't depend on
+// the number of threads so that neither does the result.
+const unsigned int PartFaces = 1u << 16;
+
+// Width and height of the grid the overdraw is measured on
+const int OverdrawViewport = 256;
+
+// ------------------------------------------------------------------------------------------------
+// Puts the vertices of a triangle into a FIFO cache modelled by per-vertex time stamps and returns
+// the number of cache misses. Advancing the time by more than the cache size flushes the cache.
+inline unsigned int UpdateCache(const unsigned int *tri, unsigned int cacheSize, unsigned int *stamps, unsigned int &time) {
+    unsigned int misses = 0;
+    for (unsigned int i = 0; i < 3; ++i) {
+        if (time - stamps[tri[i]] > cacheSize) {
+            stamps[tri[i]] = time++;
+            ++misses;
+        }
+    }
+    return misses;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Counts the misses of a FIFO cache when rendering the triangles in the given order
+unsigned int CountCacheMisses(const std::vector<unsigned int> &indices, unsigned int numVertices, unsigned int cacheSize) {
+    std::vector<unsigned int> stamps(numVertices, 0);
+    unsigned int time = cacheSize + 1, misses = 0;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        misses += UpdateCache(&indices[i], cacheSize, stamps.data(), time);
+    }
+    return misses;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sorts the triangles for a FIFO cache of the given size following the 'tipsify' paper and
+// returns the number of cache misses of the new order. All faces around the current vertex are
+// emitted at once, the next vertex is picked among those just emitted by how long it will stay
+// in the cache, falling back to the most recently emitted vertex with faces left.
+unsigned int OptimizeVertexCacheFifo(const std::vector<unsigned int> &indices, std::vector<unsigned int> &output, unsigned int numVertices, unsigned int cacheSize) {
+    const unsigned int numFaces = static_cast<unsigned int>(indices.size() / 3);
+    VertexTriangleAdjacency adj(indices.data(), numFaces, numVertices, true);
+
+    // the adjacency lists stay untouched, only the number of live faces per vertex goes down
+    unsigned int *live = adj.mLiveTriangles;
+    const std::vector<unsigned int> numAdjacent(live, live + numVertices);
+
+    std::vector<unsigned int> stamps(numVertices, 0);
+    std::vector<unsigned int> deadEnd;
+    deadEnd.reserve(indices.size());
+    std::vector<unsigned char> emitted(numFaces, 0);
+
+    output.resize(indices.size());
+    unsigned int *out = output.data();
+
+    unsigned int time = cacheSize + 1, misses = 0, cursor = 0, vertex = 0;
+    while (NoVertex != vertex) {
+        const size_t firstCandidate = deadEnd.size();
+
+        const unsigned int *list = adj.GetAdjacentTriangles(vertex);
+        for (unsigned int i = 0; i < numAdjacent[vertex]; ++i) {
+            const unsigned int face = list[i];
+            if (emitted[face]) {
+                continue;
+            }
+            emitted[face] = 1;
+
+            const unsigned int *tri = &indices[face * 3];
+            for (unsigned int j = 0; j < 3; ++j) {
+                const unsigned int v = tri[j];
+                *out++ = v;
+
+                // the current vertex has no faces left afterwards anyway
+                if (v != vertex) {
+                    deadEnd.push_back(v);
+                    --live[v];
+                }
+            }
+            misses += UpdateCache(tri, cacheSize, stamps.data(), time);
+        }
+        live[vertex] = 0;
+
+        // prefer the oldest vertex which still stays in the cache while its faces are emitted
+        vertex = NoVertex;
+        int bestPriority = -1;
+        for (size_t i = firstCandidate; i < deadEnd.size(); ++i) {
+            const unsigned int v = deadEnd[i];
+            if (!live[v]) {
+                continue;
+            }
+            const unsigned int age = time - stamps[v];
+            const int priority = age + 2 * live[v] <= cacheSize ? static_cast<int>(age) : 0;
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                vertex = v;
+            }
+        }
+        while (NoVertex == vertex && !deadEnd.empty()) {
+            const unsigned int v = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[v]) {
+                vertex = v;
+            }
+        }
+        while (NoVertex == vertex && cursor < numVertices) {
+            if (live[cursor]) {
+                vertex = cursor;
+            }
+            ++cursor;
+        }
+    }
+    return misses;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Vertex scores for an LRU cache of the given size. Recently used vertices score high, vertices
+// with only a few faces left get a bonus, which finishes them off instead of leaving single faces
+// behind that cost a miss each later on. Caches of TunedCacheSize and more entries use the scores
+// meshoptimizer tuned for the 16 entry caches of current GPUs, smaller caches the formula of
+// Forsyth's paper. All combinations are precomputed in a table.
+struct VertexScores {
+    explicit VertexScores(unsigned int cacheSize) : mTable((cacheSize + 1) * MaxValence) {
+        static const float TunedCache[TunedCacheSize] = {
+            0.779f, 0.791f, 0.789f, 0.981f, 0.843f, 0.726f, 0.847f, 0.882f,
+            0.867f, 0.799f, 0.642f, 0.613f, 0.600f, 0.568f, 0.372f, 0.234f
+        };
+        static const float TunedValence[] = {
+            0.f, 0.995f, 0.713f, 0.450f, 0.404f, 0.059f, 0.005f, 0.147f, 0.006f
+        };
+        const unsigned int numTunedValences = sizeof(TunedValence) / sizeof(TunedValence[0]);
+
+        // the first entry is for vertices which aren't cached
+        const bool tuned = cacheSize >= TunedCacheSize;
+        std::vector<float> cache(cacheSize + 1, 0.f);
+        for (unsigned int i = 0; i < cacheSize; ++i) {
+            if (tuned) {
+                cache[i + 1] = i < TunedCacheSize ? TunedCache[i] : 0.f;
+            } else {
+                // the vertices of the last face score a bit lower, so that the next face
+                // doesn't just repeat them
+                cache[i + 1] = i < 3 ? 0.75f : std::pow(1.f - float(i - 3) / float(cacheSize - 3), 1.5f);
+            }
+        }
+        float valence[MaxValence];
+        for (unsigned int i = 0; i < MaxValence; ++i) {
+            if (tuned) {
+                valence[i] = TunedValence[std::min(i, numTunedValences - 1)];
+            } else {
+                valence[i] = i ? 2.f / std::sqrt(float(i)) : 0.f;
+            }
+        }
+        for (unsigned int i = 0; i <= cacheSize; ++i) {
+            for (unsigned int j = 0; j < MaxValence; ++j) {
+                mTable[i * MaxValence + j] = cache[i] + valence[j];
+            }
+        }
+    }
+
+    // Score of a vertex at the given cache position, -1 if it isn't cached
+    float Get(int cachePos, unsigned int liveFaces) const {
+        return mTable[(cachePos + 1) * MaxValence + std::min(liveFaces, MaxValence - 1)];
+    }
+
+    std::vector<float> mTable;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Removes an emitted face from the live part of a vertex's adjacency list
+void RemoveFace(VertexTriangleAdjacency &adj, unsigned int vertex, unsigned int face) {
+    unsigned int *list = adj.GetAdjacentTriangles(vertex);
+    unsigned int &live = adj.GetNumTrianglesPtr(vertex);
+    for (unsigned int i = 0; i < live; ++i) {
+        if (list[i] == face) {
+            list[i] = list[--live];
+            return;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sorts the triangles for the post-transform vertex cache. Only the faces of the cached vertices
+// are rescored after each face, so the time is linear in the number of faces.
+void OptimizeVertexCache(const std::vector<unsigned int> &indices, std::vector<unsigned int> &output, unsigned int numVertices, const VertexScores &scores, unsigned int cacheSize) {
+    const unsigned int numFaces = static_cast<unsigned int>(indices.size() / 3);
+    VertexTriangleAdjacency adj(indices.data(), numFaces, numVertices, true);
+    const unsigned int *live = adj.mLiveTriangles;
+
+    std::vector<float> vertexScores(numVertices);
+    for (unsigned int v = 0; v < numVertices; ++v) {
+        vertexScores[v] = scores.Get(-1, live[v]);
+    }
+    std::vector<float> faceScores(numFaces);
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        const unsigned int *tri = &indices[f * 3];
+        faceScores[f] = vertexScores[tri[0]] + vertexScores[tri[1]] + vertexScores[tri[2]];
+    }
+
+    // the cache holds the vertices of the last face in front of the previous cache contents
+    std::vector<unsigned int> cache(cacheSize + 3), newCache(cacheSize + 3);
+    unsigned int cacheCount = 0;
+
+    output.resize(indices.size());
+    unsigned int *out = output.data();
+    std::vector<unsigned char> emitted(numFaces, 0);
+
+    unsigned int face = 0, cursor = 0;
+    for (unsigned int n = 0; n < numFaces; ++n) {
+        // at a dead end continue with the next face in input order
+        if (NoFace == face) {
+            while (emitted[cursor]) {
+                ++cursor;
+            }
+            face = cursor;
+        }
+        const unsigned int a = indices[face * 3], b = indices[face * 3 + 1], c = indices[face * 3 + 2];
+        *out++ = a;
+        *out++ = b;
+        *out++ = c;
+        emitted[face] = 1;
+
+        RemoveFace(adj, a, face);
+        RemoveFace(adj, b, face);
+        RemoveFace(adj, c, face);
+
+        // duplicates are skipped by advancing the count only for new vertices
+        unsigned int newCount = 1;
+        newCache[0] = a;
+        newCache[newCount] = b;
+        newCount += b != a;
+        newCache[newCount] = c;
+        newCount += c != a && c != b;
+        for (unsigned int i = 0; i < cacheCount; ++i) {
+            const unsigned int v = cache[i];
+            newCache[newCount] = v;
+            newCount += v != a && v != b && v != c;
+        }
+
+        // rescore the cached vertices and their faces, the best of these faces is the next one.
+        // Vertices pushed out of the cache are rescored once more and then dropped, vertices
+        // without faces left don't matter anymore.
+        face = NoFace;
+        float best = -1.f;
+        for (unsigned int i = 0; i < newCount; ++i) {
+            const unsigned int v = newCache[i];
+            const unsigned int numLive = live[v];
+            if (0 == numLive) {
+                continue;
+            }
+            const float score = scores.Get(i < cacheSize ? static_cast<int>(i) : -1, numLive);
+            const float diff = score - vertexScores[v];
+            vertexScores[v] = score;
+
+            const unsigned int *list = adj.GetAdjacentTriangles(v);
+            for (unsigned int j = 0; j < numLive; ++j) {
+                const unsigned int f = list[j];
+                const float faceScore = faceScores[f] + diff;
+                faceScores[f] = faceScore;
+                if (faceScore > best) {
+                    best = faceScore;
+                    face = f;
+                }
+            }
+        }
+        cache.swap(newCache);
+        cacheCount = std::min(newCount, cacheSize);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Consecutive faces of a mesh, which can be optimized independently of the others. Cluster
+// boundaries are face indices of the part.
+struct MeshPart {
+    //! Faces with indices into mVertices
+    std::vector<unsigned int> mIndices;
+
+    //! Mesh vertex of each vertex of the part
+    std::vector<unsigned int> mVertices;
+
+    //! Cache misses of the faces in input order
+    unsigned int mMissesIn = 0;
+
+    //! Sum of the positions of all face corners
+    aiVector3D mPositionSum;
+};
+
+// A run of faces of a part which is moved as a whole by the overdraw optimization
+struct Cluster {
+    unsigned int mPart = 0, mBegin = 0, mEnd = 0;
+
+    //! Area weighted center, not yet divided by the area, normal and area of the faces
+    aiVector3D mCenter, mNormal;
+    ai_real mArea = 0;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Sorts the faces of a part for the cache and, if the threshold is at least 1, splits them into
+// clusters for the overdraw optimization. Splits are placed where the cache is cold anyway or
+// where a cluster has reached threshold times the ACMR of the patch it belongs to.
+void OptimizePart(MeshPart &part, unsigned int partIndex, std::vector<Cluster> &clusters, const aiMesh *mesh,
+        const VertexScores *scores, unsigned int cacheSize, float threshold) {
+    std::vector<unsigned int> &indices = part.mIndices;
+    const unsigned int numFaces = static_cast<unsigned int>(indices.size() / 3);
+    const unsigned int numVertices = static_cast<unsigned int>(part.mVertices.size());
+
+    // faces optimized before, for a cache that behaves differently, can come out worse.
+    // They keep their order then.
+    part.mMissesIn = CountCacheMisses(indices, numVertices, cacheSize);
+    std::vector<unsigned int> optimized;
+    unsigned int missesOut;
+    if (nullptr != scores) {
+        OptimizeVertexCache(indices, optimized, numVertices, *scores, cacheSize);
+        missesOut = CountCacheMisses(optimized, numVertices, cacheSize);
+    } else {
+        missesOut = OptimizeVertexCacheFifo(indices, optimized, numVertices, cacheSize);
+    }
+    if (missesOut < part.mMissesIn) {
+        indices.swap(optimized);
+    }
+
+    for (unsigned int index : indices) {
+        part.mPositionSum += mesh->mVertices[part.mVertices[index]];
+    }
+
+    Cluster cluster;
+    cluster.mPart = partIndex;
+    if (threshold < 1.f) {
+        cluster.mEnd = numFaces;
+        clusters.push_back(cluster);
+        return;
+    }
+
+    std::vector<unsigned int> stamps(numVertices, 0);
+    unsigned int time = cacheSize + 1;
+
+    // a face missing all of its vertices starts a new patch of the mesh
+    std::vector<unsigned int> patches;
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        if (3 == UpdateCache(&indices[f * 3], cacheSize, stamps.data(), time) || 0 == f) {
+            patches.push_back(f);
+        }
+    }
+
+    const size_t firstCluster = clusters.size();
+    for (size_t p = 0; p < patches.size(); ++p) {
+        const unsigned int begin = patches[p];
+        const unsigned int end = p + 1 < patches.size() ? patches[p + 1] : numFaces;
+
+        unsigned int misses = 0;
+        time += cacheSize + 1;
+        for (unsigned int f = begin; f < end; ++f) {
+            misses += UpdateCache(&indices[f * 3], cacheSize, stamps.data(), time);
+        }
+        const float limit = threshold * float(misses) / float(end - begin);
+
+        cluster.mBegin = begin;
+        unsigned int clusterMisses = 0, clusterFaces = 0;
+        time += cacheSize + 1;
+        for (unsigned int f = begin; f < end; ++f) {
+            clusterMisses += UpdateCache(&indices[f * 3], cacheSize, stamps.data(), time);
+            if (float(clusterMisses) <= limit * float(++clusterFaces)) {
+                cluster.mEnd = f + 1;
+                clusters.push_back(cluster);
+                cluster.mBegin = f + 1;
+                clusterMisses = clusterFaces = 0;
+                time += cacheSize + 1;
+            }
+        }
+        // the last cluster is rarely good enough on its own, merge it with the one before
+        if (cluster.mBegin != begin) {
+            clusters.back().mEnd = end;
+        } else {
+            cluster.mEnd = end;
+            clusters.push_back(cluster);
+        }
+    }
+
+    for (size_t c = firstCluster; c < clusters.size(); ++c) {
+        Cluster &cl = clusters[c];
+        for (unsigned int f = cl.mBegin; f < cl.mEnd; ++f) {
+            const aiVector3D &p0 = mesh->mVertices[part.mVertices[indices[f * 3]]];
+            const aiVector3D &p1 = mesh->mVertices[part.mVertices[indices[f * 3 + 1]]];
+            const aiVector3D &p2 = mesh->mVertices[part.mVertices[indices[f * 3 + 2]]];
+            const aiVector3D n = (p1 - p0) ^ (p2 - p0);
+            const ai_real area = n.Length();
+            cl.mCenter += (p0 + p1 + p2) * (area / 3);
+            cl.mNormal += n;
+            cl.mArea += area;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Rasterizes a triangle given in grid coordinates into one of two layers of the overdraw grid,
+// one for each side the triangle can be seen from. Pixels are drawn if their center is covered
+// and they pass the depth test, the top-left rule keeps shared edges from being drawn twice.
+void Rasterize(std::vector<float> &depth, std::vector<unsigned int> &counts, aiVector3D v1, aiVector3D v2, aiVector3D v3) {
+    // depth gradients of the triangle's plane
+    const float det = (v2.x - v1.x) * (v3.y - v1.y) - (v2.y - v1.y) * (v3.x - v1.x);
+    if (det == 0.f) {
+        return;
+    }
+    float dzdx = ((v2.z - v1.z) * (v3.y - v1.y) - (v2.y - v1.y) * (v3.z - v1.z)) / det;
+    float dzdy = ((v2.x - v1.x) * (v3.z - v1.z) - (v2.z - v1.z) * (v3.x - v1.x)) / det;
+
+    // counter-clockwise triangles face the viewer looking down the z axis, for whom larger depth
+    // values are closer. The others go to the second layer, seen from the opposite direction.
+    float z1 = v1.z;
+    const int layer = det > 0.f ? 0 : 1;
+    if (layer) {
+        z1 = -z1;
+        dzdx = -dzdx;
+        dzdy = -dzdy;
+    } else {
+        // the edge tests below expect clockwise corners
+        std::swap(v2, v3);
+    }
+
+    // 28.4 fixed point coordinates
+    const int X1 = int(16.f * v1.x + 0.5f), X2 = int(16.f * v2.x + 0.5f), X3 = int(16.f * v3.x + 0.5f);
+    const int Y1 = int(16.f * v1.y + 0.5f), Y2 = int(16.f * v2.y + 0.5f), Y3 = int(16.f * v3.y + 0.5f);
+
+    // pixels whose center lies in the bounding rectangle
+    const int minx = std::max((std::min(X1, std::min(X2, X3)) + 7) >> 4, 0);
+    const int maxx = std::min((std::max(X1, std::max(X2, X3)) + 7) >> 4, OverdrawViewport);
+    const int miny = std::max((std::min(Y1, std::min(Y2, Y3)) + 7) >> 4, 0);
+    const int maxy = std::min((std::max(Y1, std::max(Y2, Y3)) + 7) >> 4, OverdrawViewport);
+
+    const int DX12 = X1 - X2, DX23 = X2 - X3, DX31 = X3 - X1;
+    const int DY12 = Y1 - Y2, DY23 = Y2 - Y3, DY31 = Y3 - Y1;
+    const int TL1 = DY12 < 0 || (DY12 == 0 && DX12 > 0);
+    const int TL2 = DY23 < 0 || (DY23 == 0 && DX23 > 0);
+    const int TL3 = DY31 < 0 || (DY31 == 0 && DX31 > 0);
+
+    // edge functions and depth at the center of the first pixel
+    const int FX = (minx << 4) + 8, FY = (miny << 4) + 8;
+    int CY1 = DX12 * (FY - Y1) - DY12 * (FX - X1) + TL1 - 1;
+    int CY2 = DX23 * (FY - Y2) - DY23 * (FX - X2) + TL2 - 1;
+    int CY3 = DX31 * (FY - Y3) - DY31 * (FX - X3) + TL3 - 1;
+    float ZY = z1 + (dzdx * float(FX - X1) + dzdy * float(FY - Y1)) * (1.f / 16.f);
+
+    for (int y = miny; y < maxy; ++y) {
+        int CX1 = CY1, CX2 = CY2, CX3 = CY3;
+        float ZX = ZY;
+        for (int x = minx; x < maxx; ++x) {
+            if ((CX1 | CX2 | CX3) >= 0) {
+                const size_t pixel = (static_cast<size_t>(y) * OverdrawViewport + x) * 2 + layer;
+                if (ZX >= depth[pixel]) {
+                    depth[pixel] = ZX;
+                    ++counts[pixel];
+                }
+            }
+            CX1 -= DY12 * 16;
+            CX2 -= DY23 * 16;
+            CX3 -= DY31 * 16;
+            ZX += dzdx;
+        }
+        CY1 += DX12 * 16;
+        CY2 += DX23 * 16;
+        CY3 += DX31 * 16;
+        ZY += dzdy;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Renders the mesh from all six axis directions and counts the covered pixels and the pixels
+// passing the depth test. Their ratio is the overdraw, 1 if no pixel is drawn twice.
+void AnalyzeOverdraw(const aiMesh *mesh, uint64_t &covered, uint64_t &shaded) {
+    aiVector3D min(ai_real(1e10)), max(ai_real(-1e10));
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        for (unsigned int k = 0; k < 3; ++k) {
+            const aiVector3D &p = mesh->mVertices[mesh->mFaces[f].mIndices[k]];
+            min = aiVector3D(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+            max = aiVector3D(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+        }
+    }
+    const ai_real extent = std::max(max.x - min.x, std::max(max.y - min.y, max.z - min.z));
+    if (!(extent > 0)) {
+        return;
+    }
+    const ai_real scale = OverdrawViewport / extent;
+
+    std::vector<float> depth(OverdrawViewport * OverdrawViewport * 2);
+    std::vector<unsigned int> counts(depth.size());
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+        std::fill(depth.begin(), depth.end(), -FLT_MAX);
+        std::fill(counts.begin(), counts.end(), 0u);
+
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            aiVector3D v[3];
+            for (unsigned int k = 0; k < 3; ++k) {
+                const aiVector3D p = (mesh->mVertices[mesh->mFaces[f].mIndices[k]] - min) * scale;
+                v[k] = aiVector3D(p[(axis + 1) % 3], p[(axis + 2) % 3], p[axis]);
+            }
+            Rasterize(depth, counts, v[0], v[1], v[2]);
+        }
+        for (unsigned int count : counts) {
+            covered += count > 0;
+            shaded += count;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Ratio of shaded to covered pixels
+inline double Overdraw(uint64_t covered, uint64_t shaded) {
+    return covered ? double(shaded) / double(covered) : 0.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reorders an array of per-vertex data
+template <typename T>
+void ReorderVertices(T *data, const std::vector<unsigned int> &remap) {
+    if (nullptr == data) {
+        return;
+    }
+    const std::vector<T> copy(data, data + remap.size());
+    for (size_t i = 0; i < remap.size(); ++i) {
+        data[remap[i]] = copy[i];
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves every vertex of the mesh to its new index, the faces have been remapped already
+void RemapVertices(aiMesh *mesh, const std::vector<unsigned int> &remap) {
+    ReorderVertices(mesh->mVertices, remap);
+    ReorderVertices(mesh->mNormals, remap);
+    ReorderVertices(mesh->mTangents, remap);
+    ReorderVertices(mesh->mBitangents, remap);
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        ReorderVertices(mesh->mColors[c], remap);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        ReorderVertices(mesh->mTextureCoords[c], remap);
+    }
+    for (unsigned int a = 0; a < mesh->mNumAnimMeshes; ++a) {
+        aiAnimMesh *anim = mesh->mAnimMeshes[a];
+        ReorderVertices(anim->mVertices, remap);
+        ReorderVertices(anim->mNormals, remap);
+        ReorderVertices(anim->mTangents, remap);
+        ReorderVertices(anim->mBitangents, remap);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            ReorderVertices(anim->mColors[c], remap);
+        }
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+            ReorderVertices(anim->mTextureCoords[c], remap);
+        }
+    }
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        aiBone *bone = mesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            bone->mWeights[w].mVertexId = remap[bone->mWeights[w].mVertexId];
+        }
+    }
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ImproveCacheLocalityProcess::ImproveCacheLocalityProcess()
-: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE) {
+: mConfigCacheDepth(PP_ICL_PTCACHE_SIZE)
+, mConfigLruScoring(true)
+, mConfigOverdrawThreshold(PP_ICL_OVERDRAW_THRESHOLD)
+, mConfigReorderVertices(true) {
     // empty
 }
 
@@ -80,11 +666,24 @@ bool ImproveCacheLocalityProcess::IsActive( unsigned int pFlags) const {
     return (pFlags & aiProcess_ImproveCacheLocality) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The triangles are reordered within the index buffer
+bool ImproveCacheLocalityProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration
 void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp) {
     // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
     mConfigCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE,PP_ICL_PTCACHE_SIZE);
+    if (mConfigCacheDepth < 3) {
+        ASSIMP_LOG_WARN("ImproveCacheLocalityProcess: cache size ", mConfigCacheDepth, " is too small, using ", PP_ICL_PTCACHE_SIZE);
+        mConfigCacheDepth = PP_ICL_PTCACHE_SIZE;
+    }
+    mConfigLruScoring = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_LRU_SCORING,true);
+    mConfigOverdrawThreshold = pImp->GetPropertyFloat(AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD,PP_ICL_OVERDRAW_THRESHOLD);
+    mConfigReorderVertices = pImp->GetPropertyBool(AI_CONFIG_PP_ICL_REORDER_VERTICES,true);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -97,19 +696,53 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
 
     ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
 
-    float out = 0.f;
-    unsigned int numf = 0, numm = 0;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; ++a ){
-        const float res = ProcessMesh( pScene->mMeshes[a],a);
-        if (res) {
-            numf += pScene->mMeshes[a]->mNumFaces;
-            out  += res;
-            ++numm;
+    // measuring the overdraw takes longer than the optimization, it's only done for verbose logging
+    const bool collectStats = !DefaultLogger::isNullLogger();
+    const bool analyzeOverdraw = collectStats && DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE;
+
+    // meshes are independent of each other, report and sum up the results in mesh order
+    std::vector<MeshStats> results(pScene->mNumMeshes);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        ProcessMesh( pScene->mMeshes[a],results[a],collectStats,analyzeOverdraw);
+    });
+
+    if (collectStats) {
+        MeshStats sum;
+        unsigned int numm = 0;
+        for( unsigned int a = 0; a < pScene->mNumMeshes; ++a ){
+            const MeshStats &res = results[a];
+            if (MeshStats::NoTriangles == res.mStatus) {
+                ASSIMP_LOG_ERROR("Mesh ", a, ": This algorithm works on triangle meshes only");
+            } else if (MeshStats::NotShared == res.mStatus) {
+                // the JoinIdenticalVertices process has not been executed on this mesh
+                ASSIMP_LOG_WARN("Mesh ", a, ": Not suitable for vcache optimization");
+            } else if (MeshStats::Processed == res.mStatus) {
+                // very intense verbose logging ... prepare for much text if there are many meshes
+                if (analyzeOverdraw) {
+                    ASSIMP_LOG_VERBOSE_DEBUG("Mesh ", a, " | ACMR in: ", float(res.mMissesIn) / res.mNumFaces,
+                            " out: ", float(res.mMissesOut) / res.mNumFaces,
+                            " | ATVR in: ", float(res.mMissesIn) / res.mNumVertices, " out: ", float(res.mMissesOut) / res.mNumVertices,
+                            " | overdraw in: ", Overdraw(res.mCoveredIn, res.mShadedIn), " out: ", Overdraw(res.mCoveredOut, res.mShadedOut));
+                }
+                sum.mNumFaces += res.mNumFaces;
+                sum.mNumVertices += res.mNumVertices;
+                sum.mMissesIn += res.mMissesIn;
+                sum.mMissesOut += res.mMissesOut;
+                sum.mCoveredIn += res.mCoveredIn;
+                sum.mShadedIn += res.mShadedIn;
+                sum.mCoveredOut += res.mCoveredOut;
+                sum.mShadedOut += res.mShadedOut;
+                ++numm;
+            }
         }
-    }
-    if (!DefaultLogger::isNullLogger()) {
-        if (numf > 0) {
-            ASSIMP_LOG_INFO("Cache relevant are ", numm, " meshes (", numf, " faces). Average output ACMR is ", out / numf);
+        if (sum.mNumFaces > 0) {
+            ASSIMP_LOG_INFO("Cache relevant are ", numm, " meshes (", sum.mNumFaces, " faces). ACMR in: ",
+                    float(sum.mMissesIn) / sum.mNumFaces, " out: ", float(sum.mMissesOut) / sum.mNumFaces,
+                    " | ATVR in: ", float(sum.mMissesIn) / sum.mNumVertices, " out: ", float(sum.mMissesOut) / sum.mNumVertices);
+            if (sum.mCoveredIn > 0) {
+                ASSIMP_LOG_VERBOSE_DEBUG("Average overdraw in: ", Overdraw(sum.mCoveredIn, sum.mShadedIn),
+                        " out: ", Overdraw(sum.mCoveredOut, sum.mShadedOut));
+            }
         }
         ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
     }
@@ -117,263 +750,175 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
 
 // ------------------------------------------------------------------------------------------------
 // Improves the cache coherency of a specific mesh
-ai_real ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshNum) {
-    // TODO: rewrite this to use std::vector or boost::shared_array
+void ImproveCacheLocalityProcess::ProcessMesh( aiMesh* pMesh, MeshStats& stats, bool collectStats, bool analyzeOverdraw) {
     ai_assert(nullptr != pMesh);
 
     // Check whether the input data is valid
     // - there must be vertices and faces
     // - all faces must be triangulated or we can't operate on them
     if (!pMesh->HasFaces() || !pMesh->HasPositions())
-        return static_cast<ai_real>(0.f);
+        return;
 
-    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
-        ASSIMP_LOG_ERROR("This algorithm works on triangle meshes only");
-        return static_cast<ai_real>(0.f);
+    if ((pMesh->mPrimitiveTypes & ~aiPrimitiveType_NGONEncodingFlag) != aiPrimitiveType_TRIANGLE) {
+        stats.mStatus = MeshStats::NoTriangles;
+        return;
     }
 
-    if(pMesh->mNumVertices <= mConfigCacheDepth) {
-        return static_cast<ai_real>(0.f);
+    // split the faces into parts with their own vertex indices. A vertex gets a new index in
+    // every part it is used in, the vertices are counted along the way.
+    const unsigned int numParts = (pMesh->mNumFaces + PartFaces - 1) / PartFaces;
+    std::vector<MeshPart> parts(numParts);
+    std::vector<unsigned int> partOf(pMesh->mNumVertices, NoVertex), localOf(pMesh->mNumVertices);
+    unsigned int numReferenced = 0;
+
+    // the statistics are measured on the whole mesh
+    std::vector<unsigned int> stamps;
+    unsigned int time = mConfigCacheDepth + 1, missesIn = 0;
+    if (collectStats) {
+        stamps.resize(pMesh->mNumVertices, 0);
     }
 
-    ai_real fACMR = 3.f;
-    const aiFace* const pcEnd = pMesh->mFaces+pMesh->mNumFaces;
-
-    // Input ACMR is for logging purposes only
-    if (!DefaultLogger::isNullLogger())     {
-
-        unsigned int* piFIFOStack = new unsigned int[mConfigCacheDepth];
-        memset(piFIFOStack,0xff,mConfigCacheDepth*sizeof(unsigned int));
-        unsigned int* piCur = piFIFOStack;
-        const unsigned int* const piCurEnd = piFIFOStack + mConfigCacheDepth;
-
-        // count the number of cache misses
-        unsigned int iCacheMisses = 0;
-        for (const aiFace* pcFace = pMesh->mFaces;pcFace != pcEnd;++pcFace) {
-            for (unsigned int qq = 0; qq < 3;++qq) {
-                bool bInCache = false;
-                for (unsigned int* pp = piFIFOStack;pp < piCurEnd;++pp) {
-                    if (*pp == pcFace->mIndices[qq])    {
-                        // the vertex is in cache
-                        bInCache = true;
-                        break;
-                    }
-                }
-                if (!bInCache)  {
-                    ++iCacheMisses;
-                    if (piCurEnd == piCur) {
-                        piCur = piFIFOStack;
-                    }
-                    *piCur++ = pcFace->mIndices[qq];
-                }
+    // pure triangle meshes with an index buffer have a flat copy of the indices already
+    unsigned int* const piTriangles = 3 == pMesh->mFaceStride ? pMesh->mIndexBuffer : nullptr;
+    for (unsigned int p = 0; p < numParts; ++p) {
+        MeshPart &part = parts[p];
+        const unsigned int begin = p * PartFaces, end = std::min(begin + PartFaces, pMesh->mNumFaces);
+        part.mIndices.resize((end - begin) * 3);
+        unsigned int *out = part.mIndices.data();
+        for (unsigned int a = begin; a < end; ++a, out += 3) {
+            const aiFace &face = pMesh->mFaces[a];
+            const unsigned int *tri = piTriangles ? piTriangles + a * 3 : face.mIndices;
+            if (!piTriangles && 3 != face.mNumIndices) {
+                stats.mStatus = MeshStats::NoTriangles;
+                return;
             }
-        }
-        delete[] piFIFOStack;
-        fACMR = (ai_real) iCacheMisses / pMesh->mNumFaces;
-        if (3.0 == fACMR)   {
-            char szBuff[128]; // should be sufficiently large in every case
-
-            // the JoinIdenticalVertices process has not been executed on this
-            // mesh, otherwise this value would normally be at least minimally
-            // smaller than 3.0 ...
-            ai_snprintf(szBuff,128,"Mesh %u: Not suitable for vcache optimization",meshNum);
-            ASSIMP_LOG_WARN(szBuff);
-            return static_cast<ai_real>(0.f);
-        }
-    }
-
-    // first we need to build a vertex-triangle adjacency list
-    VertexTriangleAdjacency adj(pMesh->mFaces,pMesh->mNumFaces, pMesh->mNumVertices,true);
-
-    // build a list to store per-vertex caching time stamps
-    unsigned int* const piCachingStamps = new unsigned int[pMesh->mNumVertices];
-    memset(piCachingStamps,0x0,pMesh->mNumVertices*sizeof(unsigned int));
-
-    // allocate an empty output index buffer. We store the output indices in one large array.
-    // Since the number of triangles won't change the input faces can be reused. This is how
-    // we save thousands of redundant mini allocations for aiFace::mIndices
-    const unsigned int iIdxCnt = pMesh->mNumFaces*3;
-    unsigned int* const piIBOutput = new unsigned int[iIdxCnt];
-    unsigned int* piCSIter = piIBOutput;
-
-    // allocate the flag array to hold the information
-    // whether a face has already been emitted or not
-    std::vector<bool> abEmitted(pMesh->mNumFaces,false);
-
-    // dead-end vertex index stack
-    std::stack<unsigned int, std::vector<unsigned int> > sDeadEndVStack;
-
-    // create a copy of the piNumTriPtr buffer
-    unsigned int* const piNumTriPtr = adj.mLiveTriangles;
-    const std::vector<unsigned int> piNumTriPtrNoModify(piNumTriPtr, piNumTriPtr + pMesh->mNumVertices);
-
-    // get the largest number of referenced triangles and allocate the "candidate buffer"
-    unsigned int iMaxRefTris = 0; {
-        const unsigned int* piCur = adj.mLiveTriangles;
-        const unsigned int* const piCurEnd = adj.mLiveTriangles+pMesh->mNumVertices;
-        for (;piCur != piCurEnd;++piCur) {
-            iMaxRefTris = std::max(iMaxRefTris,*piCur);
-        }
-    }
-    ai_assert(iMaxRefTris > 0);
-    unsigned int* piCandidates = new unsigned int[iMaxRefTris*3];
-    unsigned int iCacheMisses = 0;
-
-    // ...................................................................................
-    /** PSEUDOCODE for the algorithm
-
-        A = Build-Adjacency(I) Vertex-triangle adjacency
-        L = Get-Triangle-Counts(A) Per-vertex live triangle counts
-        C = Zero(Vertex-Count(I)) Per-vertex caching time stamps
-        D = Empty-Stack() Dead-end vertex stack
-        E = False(Triangle-Count(I)) Per triangle emitted flag
-        O = Empty-Index-Buffer() Empty output buffer
-        f = 0 Arbitrary starting vertex
-        s = k+1, i = 1 Time stamp and cursor
-        while f >= 0 For all valid fanning vertices
-            N = Empty-Set() 1-ring of next candidates
-            for each Triangle t in Neighbors(A, f)
-                if !Emitted(E,t)
-                    for each Vertex v in t
-                        Append(O,v) Output vertex
-                        Push(D,v) Add to dead-end stack
-                        Insert(N,v) Register as candidate
-                        L[v] = L[v]-1 Decrease live triangle count
-                        if s-C[v] > k If not in cache
-                            C[v] = s Set time stamp
-                            s = s+1 Increment time stamp
-                    E[t] = true Flag triangle as emitted
-            Select next fanning vertex
-            f = Get-Next-Vertex(I,i,k,N,C,s,L,D)
-        return O
-        */
-    // ...................................................................................
-
-    int ivdx = 0;
-    int ics = 1;
-    int iStampCnt = mConfigCacheDepth+1;
-    while (ivdx >= 0)   {
-
-        unsigned int icnt = piNumTriPtrNoModify[ivdx];
-        unsigned int* piList = adj.GetAdjacentTriangles(ivdx);
-        unsigned int* piCurCandidate = piCandidates;
-
-        // get all triangles in the neighborhood
-        for (unsigned int tri = 0; tri < icnt;++tri)    {
-
-            // if they have not yet been emitted, add them to the output IB
-            const unsigned int fidx = *piList++;
-            if (!abEmitted[fidx])   {
-
-                // so iterate through all vertices of the current triangle
-                const aiFace* pcFace = &pMesh->mFaces[ fidx ];
-                unsigned nind = pcFace->mNumIndices;
-                for (unsigned ind = 0; ind < nind; ind++) {
-                    unsigned dp = pcFace->mIndices[ind];
-
-                    // the current vertex won't have any free triangles after this step
-                    if (ivdx != (int)dp) {
-                        // append the vertex to the dead-end stack
-                        sDeadEndVStack.push(dp);
-
-                        // register as candidate for the next step
-                        *piCurCandidate++ = dp;
-
-                        // decrease the per-vertex triangle counts
-                        piNumTriPtr[dp]--;
-                    }
-
-                    // append the vertex to the output index buffer
-                    *piCSIter++ = dp;
-
-                    // if the vertex is not yet in cache, set its cache count
-                    if (iStampCnt-piCachingStamps[dp] > mConfigCacheDepth) {
-                        piCachingStamps[dp] = iStampCnt++;
-                        ++iCacheMisses;
-                    }
+            if (collectStats) {
+                missesIn += UpdateCache(tri, mConfigCacheDepth, stamps.data(), time);
+            }
+            for (unsigned int k = 0; k < 3; ++k) {
+                const unsigned int v = tri[k];
+                if (partOf[v] != p) {
+                    numReferenced += NoVertex == partOf[v];
+                    partOf[v] = p;
+                    localOf[v] = static_cast<unsigned int>(part.mVertices.size());
+                    part.mVertices.push_back(v);
                 }
-                // flag triangle as emitted
-                abEmitted[fidx] = true;
+                out[k] = localOf[v];
             }
         }
+    }
 
-        // the vertex has now no living adjacent triangles anymore
-        piNumTriPtr[ivdx] = 0;
+    // if no vertex is shared by two faces, the JoinIdenticalVertices process has not been
+    // executed on this mesh and there is nothing to gain
+    if (numReferenced == pMesh->mNumFaces * 3) {
+        stats.mStatus = MeshStats::NotShared;
+        return;
+    }
 
-        // get next fanning vertex
-        ivdx = -1;
-        int max_priority = -1;
-        for (unsigned int* piCur = piCandidates;piCur != piCurCandidate;++piCur)    {
-            const unsigned int dp = *piCur;
+    if (collectStats) {
+        stats.mNumFaces = pMesh->mNumFaces;
+        stats.mNumVertices = numReferenced;
+        stats.mMissesIn = missesIn;
+        if (analyzeOverdraw) {
+            AnalyzeOverdraw(pMesh, stats.mCoveredIn, stats.mShadedIn);
+        }
+    }
 
-            // must have live triangles
-            if (piNumTriPtr[dp] > 0)    {
-                int priority = 0;
+    // sort the faces of each part for the cache and split them into clusters
+    const VertexScores scores(mConfigLruScoring ? mConfigCacheDepth : 0);
+    std::vector<std::vector<Cluster>> partClusters(numParts);
+    const std::function<void(unsigned int)> optimize = [&](unsigned int p) {
+        OptimizePart(parts[p], p, partClusters[p], pMesh, mConfigLruScoring ? &scores : nullptr,
+                mConfigCacheDepth, mConfigOverdrawThreshold);
+    };
+    if (nullptr != scheduler) {
+        scheduler->ParallelFor(numParts, optimize);
+    } else {
+        for (unsigned int p = 0; p < numParts; ++p) {
+            optimize(p);
+        }
+    }
 
-                // will the vertex be in cache, even after fanning occurs?
-                unsigned int tmp;
-                if ((tmp = iStampCnt-piCachingStamps[dp]) + 2*piNumTriPtr[dp] <= mConfigCacheDepth) {
-                    priority = tmp;
-                }
+    std::vector<const Cluster *> order;
+    aiVector3D meshCenter;
+    for (unsigned int p = 0; p < numParts; ++p) {
+        for (const Cluster &cluster : partClusters[p]) {
+            order.push_back(&cluster);
+        }
+        meshCenter += parts[p].mPositionSum;
+    }
 
-                // keep best candidate
-                if (priority > max_priority) {
-                    max_priority = priority;
-                    ivdx = dp;
-                }
-            }
+    // move the clusters facing outwards to the front. The sort key of a cluster is how far its
+    // area weighted center lies in front of the mesh center along its average normal.
+    if (mConfigOverdrawThreshold >= 1.f && order.size() > 1) {
+        meshCenter /= static_cast<ai_real>(pMesh->mNumFaces * 3);
+        std::vector<ai_real> keys(order.size());
+        for (size_t c = 0; c < order.size(); ++c) {
+            const Cluster &cluster = *order[c];
+            aiVector3D normal = cluster.mNormal;
+            keys[c] = cluster.mArea > 0 ? (cluster.mCenter / cluster.mArea - meshCenter) * normal.NormalizeSafe() : 0;
         }
-        // did we reach a dead end?
-        if (-1 == ivdx) {
-            // need to get a non-local vertex for which we have a good chance that it is still
-            // in the cache ...
-            while (!sDeadEndVStack.empty()) {
-                unsigned int iCachedIdx = sDeadEndVStack.top();
-                sDeadEndVStack.pop();
-                if (piNumTriPtr[ iCachedIdx ] > 0)  {
-                    ivdx = iCachedIdx;
-                    break;
-                }
-            }
+        std::vector<unsigned int> sorted(order.size());
+        for (unsigned int c = 0; c < sorted.size(); ++c) {
+            sorted[c] = c;
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [&keys](unsigned int a, unsigned int b) {
+            return keys[a] > keys[b];
+        });
+        std::vector<const Cluster *> sortedOrder(order.size());
+        for (size_t c = 0; c < sorted.size(); ++c) {
+            sortedOrder[c] = order[sorted[c]];
+        }
+        order.swap(sortedOrder);
+    }
 
-            if (-1 == ivdx) {
-                // well, there isn't such a vertex. Simply get the next vertex in input order and
-                // hope it is not too bad ...
-                while (ics < (int)pMesh->mNumVertices)  {
-                    ++ics;
-                    if (piNumTriPtr[ics] > 0)   {
-                        ivdx = ics;
-                        break;
+    // write the faces back in the new order, the faces of an index buffer point into it and
+    // are updated along with it. The vertices get new indices in the order the faces use them
+    // first, which only helps fetching them and doesn't change the statistics.
+    std::vector<unsigned int> remap;
+    unsigned int next = 0;
+    if (mConfigReorderVertices) {
+        remap.resize(pMesh->mNumVertices, NoVertex);
+    }
+    unsigned int missesOut = 0, a = 0;
+    time += mConfigCacheDepth + 1;
+    for (const Cluster *cluster : order) {
+        const MeshPart &part = parts[cluster->mPart];
+        for (unsigned int f = cluster->mBegin; f < cluster->mEnd; ++f, ++a) {
+            unsigned int *tri = piTriangles ? piTriangles + a * 3 : pMesh->mFaces[a].mIndices;
+            for (unsigned int k = 0; k < 3; ++k) {
+                unsigned int v = part.mVertices[part.mIndices[f * 3 + k]];
+                if (mConfigReorderVertices) {
+                    if (NoVertex == remap[v]) {
+                        remap[v] = next++;
                     }
+                    v = remap[v];
                 }
+                tri[k] = v;
+            }
+            if (collectStats) {
+                missesOut += UpdateCache(tri, mConfigCacheDepth, stamps.data(), time);
             }
         }
     }
-    ai_real fACMR2 = 0.0f;
-    if (!DefaultLogger::isNullLogger()) {
-        fACMR2 = (float)iCacheMisses / pMesh->mNumFaces;
-
-        // very intense verbose logging ... prepare for much text if there are many meshes
-        if ( DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
-            ASSIMP_LOG_VERBOSE_DEBUG("Mesh %u | ACMR in: ", meshNum, " out: ", fACMR, " | ~", fACMR2, ((fACMR - fACMR2) / fACMR) * 100.f);
+    if (mConfigReorderVertices) {
+        // unreferenced vertices go last
+        for (unsigned int &index : remap) {
+            if (NoVertex == index) {
+                index = next++;
+            }
         }
-
-        fACMR2 *= pMesh->mNumFaces;
-    }
-    // sort the output index buffer back to the input array
-    piCSIter = piIBOutput;
-    for (aiFace* pcFace = pMesh->mFaces; pcFace != pcEnd;++pcFace)  {
-        unsigned nind = pcFace->mNumIndices;
-        unsigned * ind = pcFace->mIndices;
-        if (nind > 0) ind[0] = *piCSIter++;
-        if (nind > 1) ind[1] = *piCSIter++;
-        if (nind > 2) ind[2] = *piCSIter++;
+        RemapVertices(pMesh, remap);
     }
 
-    // delete temporary storage
-    delete[] piCachingStamps;
-    delete[] piIBOutput;
-    delete[] piCandidates;
+    if (collectStats) {
+        stats.mMissesOut = missesOut;
+        if (analyzeOverdraw) {
+            AnalyzeOverdraw(pMesh, stats.mCoveredOut, stats.mShadedOut);
+        }
+    }
 
-    return fACMR2;
+    // the faces no longer follow each other the way the polygons they were made of did
+    pMesh->mPrimitiveTypes &= ~aiPrimitiveType_NGONEncodingFlag;
+    stats.mStatus = MeshStats::Processed;
 }
@@ -49,6 +49,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/types.h>
 
+#include <cstdint>
+
 struct aiMesh;
 
 namespace Assimp
@@ -56,8 +58,10 @@ namespace Assimp
 
 // ---------------------------------------------------------------------------
 /** The ImproveCacheLocalityProcess reorders all faces for improved vertex
- *  cache locality. It tries to arrange all faces to fans and to render
- *  faces which share vertices directly one after the other.
+ *  cache locality. The faces are sorted for a post-transform vertex cache,
+ *  groups of them are rearranged to reduce overdraw afterwards and the
+ *  vertices are sorted in the order the faces use them. Large meshes are
+ *  optimized in parts, which run in parallel.
  *
  *  @note This step expects triagulated input data.
  */
@@ -74,6 +78,9 @@ public:
     // Check whether the pp step is active
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const;
+
     // -------------------------------------------------------------------
     // Executes the pp step on a given scene
     void Execute( aiScene* pScene);
@@ -83,17 +90,56 @@ public:
     void SetupProperties(const Importer* pImp);
 
 protected:
+    // -------------------------------------------------------------------
+    /** Outcome and statistics of a mesh, before and after the step. The
+     *  statistics are only collected if there is a logger. Meshes are
+     *  processed in parallel, so nothing is logged until all are done. */
+    struct MeshStats {
+        enum Status {
+            Skipped,        //!< No faces or no positions
+            Processed,
+            NoTriangles,    //!< Contains other primitives than triangles
+            NotShared       //!< No vertex is shared by two faces
+        };
+        Status mStatus = Skipped;
+
+        //! Number of faces and of vertices referenced by them
+        unsigned int mNumFaces = 0, mNumVertices = 0;
+
+        //! Vertex cache misses
+        unsigned int mMissesIn = 0, mMissesOut = 0;
+
+        //! Pixels covered by the mesh and pixels passing the depth test
+        //! when it is rendered from all six axis directions, only
+        //! measured for verbose logging
+        uint64_t mCoveredIn = 0, mShadedIn = 0, mCoveredOut = 0, mShadedOut = 0;
+    };
+
     // -------------------------------------------------------------------
     /** Executes the postprocessing step on the given mesh
      * @param pMesh The mesh to process.
-     * @param meshNum Index of the mesh to process
+     * @param stats Receives the outcome and the statistics of the mesh
+     * @param collectStats Whether to collect the cache statistics
+     * @param analyzeOverdraw Whether to measure the overdraw as well
      */
-    ai_real ProcessMesh( aiMesh* pMesh, unsigned int meshNum);
+    void ProcessMesh( aiMesh* pMesh, MeshStats& stats, bool collectStats, bool analyzeOverdraw);
 
 private:
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int mConfigCacheDepth;
+
+    //! Configuration parameter: whether the faces are sorted for an LRU
+    //! cache with Forsyth's scores instead of a FIFO cache.
+    bool mConfigLruScoring;
+
+    //! Configuration parameter: factor by which the overdraw optimization
+    //! may raise the ACMR of parts of a mesh, below 1 disables it.
+    float mConfigOverdrawThreshold;
+
+    //! Configuration parameter: whether the vertices are reordered
+    //! for fetch locality.
+    bool mConfigReorderVertices;
 };
 
 } // end of namespace Assimp
@@ -72,6 +72,12 @@ JoinVerticesProcess::~JoinVerticesProcess() {
 bool JoinVerticesProcess::IsActive( unsigned int pFlags) const {
     return (pFlags & aiProcess_JoinIdenticalVertices) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// The indices are remapped in place
+bool JoinVerticesProcess::SupportsIndexBuffers() const {
+    return true;
+}
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene) {
@@ -85,10 +91,14 @@ void JoinVerticesProcess::Execute( aiScene* pScene) {
         }
     }
 
-    // execute the step
+    // execute the step, meshes are independent of each other
+    std::vector<int> numVertices(pScene->mNumMeshes, 0);
+    ForEachMesh(pScene->mNumMeshes, [&](unsigned int a) {
+        numVertices[a] = ProcessMesh( pScene->mMeshes[a],a);
+    });
     int iNumVertices = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++) {
-        iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+        iNumVertices += numVertices[a];
     }
 
     pScene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
@@ -264,10 +274,16 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
     // multiple meshes)
     std::unordered_set<unsigned int> usedVertexIndices;
     usedVertexIndices.reserve(pMesh->mNumVertices);
-    for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
-        aiFace& face = pMesh->mFaces[a];
-        for( unsigned int b = 0; b < face.mNumIndices; b++) {
-            usedVertexIndices.insert(face.mIndices[b]);
+    if (pMesh->HasIndexBuffer()) {
+        for( unsigned int a = 0; a < pMesh->mNumIndices; a++) {
+            usedVertexIndices.insert(pMesh->mIndexBuffer[a]);
+        }
+    } else {
+        for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
+            aiFace& face = pMesh->mFaces[a];
+            for( unsigned int b = 0; b < face.mNumIndices; b++) {
+                usedVertexIndices.insert(face.mIndices[b]);
+            }
         }
     }
 
@@ -283,30 +299,8 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
     static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
     std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
 
-    // float posEpsilonSqr;
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
-
-    typedef std::pair<SpatialSort,float> SpatPair;
-    if (shared) {
-        std::vector<SpatPair >* avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-        if (avf)    {
-            SpatPair& blubb = (*avf)[meshIndex];
-            vertexFinder  = &blubb.first;
-            // posEpsilonSqr = blubb.second;
-        }
-    }
-    if (!vertexFinder)  {
-        // bad, need to compute it.
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-        vertexFinder = &_vertexFinder;
-        // posEpsilonSqr = ComputePositionEpsilon(pMesh);
-    }
-
-    // Again, better waste some bytes than a realloc ...
-    std::vector<unsigned int> verticesFound;
-    verticesFound.reserve(10);
+    // Vertices are welded by exact attribute equality through the hash map below, a spatial
+    // lookup (and the shared one from ComputeSpatialSortProcess) is not needed.
 
     // Run an optimized code path if we don't have multiple UVs or vertex colors.
     // This should yield false in more than 99% of all imports ...
@@ -376,11 +370,17 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
         }
     }
 
-    // adjust the indices in all faces
-    for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
-        aiFace& face = pMesh->mFaces[a];
-        for( unsigned int b = 0; b < face.mNumIndices; b++) {
-            face.mIndices[b] = replaceIndex[face.mIndices[b]] & ~0x80000000;
+    // adjust the indices in all faces, the faces of an index buffer are adjusted with it
+    if (pMesh->HasIndexBuffer()) {
+        for( unsigned int a = 0; a < pMesh->mNumIndices; a++) {
+            pMesh->mIndexBuffer[a] = replaceIndex[pMesh->mIndexBuffer[a]] & ~0x80000000;
+        }
+    } else {
+        for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
+            aiFace& face = pMesh->mFaces[a];
+            for( unsigned int b = 0; b < face.mNumIndices; b++) {
+                face.mIndices[b] = replaceIndex[face.mIndices[b]] & ~0x80000000;
+            }
         }
     }
 
@@ -49,9 +49,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
 
 #include "Common/BaseProcess.h"
 #include <assimp/ParsingUtils.h>
+#include <assimp/SpatialHashGrid.h>
 #include <assimp/SpatialSort.h>
 
 #include <list>
@@ -331,6 +334,48 @@ const char *MappingTypeToString(aiTextureMapping in);
 // Split a mesh given a list of faces to be contained in the sub mesh
 aiMesh *MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags);
 
+// -------------------------------------------------------------------------------
+// Finds vertices close to a given position. Forwards to a SpatialSort or,
+// with AI_CONFIG_PP_SPATIAL_HASH_GRID, to a SpatialHashGrid.
+class SpatialIndex {
+public:
+    explicit SpatialIndex(bool useHashGrid = false) :
+            mUseHashGrid(useHashGrid) {}
+
+    void Fill(const aiVector3D *pPositions, unsigned int pNumPositions, unsigned int pElementOffset) {
+        if (mUseHashGrid) {
+            mHashGrid.Fill(pPositions, pNumPositions, pElementOffset);
+        } else {
+            mSort.Fill(pPositions, pNumPositions, pElementOffset);
+        }
+    }
+
+    void FindPositions(const aiVector3D &pPosition, ai_real pRadius, std::vector<unsigned int> &poResults) const {
+        if (mUseHashGrid) {
+            mHashGrid.FindPositions(pPosition, pRadius, poResults);
+        } else {
+            mSort.FindPositions(pPosition, pRadius, poResults);
+        }
+    }
+
+    void FindIdenticalPositions(const aiVector3D &pPosition, std::vector<unsigned int> &poResults) const {
+        if (mUseHashGrid) {
+            mHashGrid.FindIdenticalPositions(pPosition, poResults);
+        } else {
+            mSort.FindIdenticalPositions(pPosition, poResults);
+        }
+    }
+
+    unsigned int GenerateMappingTable(std::vector<unsigned int> &fill, ai_real pRadius) const {
+        return mUseHashGrid ? mHashGrid.GenerateMappingTable(fill, pRadius) : mSort.GenerateMappingTable(fill, pRadius);
+    }
+
+private:
+    bool mUseHashGrid;
+    SpatialSort mSort;
+    SpatialHashGrid mHashGrid;
+};
+
 // -------------------------------------------------------------------------------
 // Utility post-process step to share the spatial sort tree between
 // all steps which use it to speedup its computations.
@@ -340,11 +385,19 @@ class ComputeSpatialSortProcess : public BaseProcess {
                                                            aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
+    bool SupportsIndexBuffers() const {
+        return true;
+    }
+
+    void SetupProperties(const Importer *pImp) {
+        mUseHashGrid = pImp->GetPropertyBool(AI_CONFIG_PP_SPATIAL_HASH_GRID, false);
+    }
+
     void Execute(aiScene *pScene) {
-        typedef std::pair<SpatialSort, ai_real> _Type;
+        typedef std::pair<SpatialIndex, ai_real> _Type;
         ASSIMP_LOG_DEBUG("Generate spatially-sorted vertex cache");
 
-        std::vector<_Type> *p = new std::vector<_Type>(pScene->mNumMeshes);
+        std::vector<_Type> *p = new std::vector<_Type>(pScene->mNumMeshes, _Type(SpatialIndex(mUseHashGrid), ai_real(0)));
         std::vector<_Type>::iterator it = p->begin();
 
         for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it) {
@@ -356,6 +409,8 @@ class ComputeSpatialSortProcess : public BaseProcess {
 
         shared->AddProperty(AI_SPP_SPATIAL_SORT, p);
     }
+
+    bool mUseHashGrid = false;
 };
 
 // -------------------------------------------------------------------------------
@@ -366,6 +421,10 @@ class DestroySpatialSortProcess : public BaseProcess {
                                                         aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
     }
 
+    bool SupportsIndexBuffers() const {
+        return true;
+    }
+
     void Execute(aiScene * /*pScene*/) {
         shared->RemoveProperty(AI_SPP_SPATIAL_SORT);
     }
@@ -76,6 +76,18 @@ bool RemoveRedundantMatsProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_RemoveRedundantMaterials) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// The faces are not touched
+bool RemoveRedundantMatsProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Neither the faces nor the vertices are touched
+bool RemoveRedundantMatsProcess::KeepsMeshlets() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup import properties
 void RemoveRedundantMatsProcess::SetupProperties(const Importer* pImp)
@@ -69,6 +69,12 @@ public:
     // Check whether step is active
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const;
+
+    // -------------------------------------------------------------------
+    bool KeepsMeshlets() const;
+
     // -------------------------------------------------------------------
     // Execute step on a given scene
     void Execute( aiScene* pScene);
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "SortByPTypeProcess.h"
 #include "ProcessHelper.h"
+#include "Common/MeshIndexBuffer.h"
 #include <assimp/Exceptional.h>
 
 using namespace Assimp;
@@ -71,6 +72,12 @@ bool SortByPTypeProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_SortByPType) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Meshes that are split release their index buffer first
+bool SortByPTypeProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 void SortByPTypeProcess::SetupProperties(const Importer *pImp) {
     mConfigRemoveMeshes = pImp->GetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, 0);
@@ -173,6 +180,9 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
         }
         bAnyChanges = true;
 
+        // the submeshes take over the index arrays of the faces
+        ReleaseIndexBuffer(mesh);
+
         // reuse our current mesh arrays for the submesh
         // with the largest number of primitives
         unsigned int aiNumPerPType[4] = { 0, 0, 0, 0 };
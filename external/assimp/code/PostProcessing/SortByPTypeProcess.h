@@ -66,6 +66,9 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const;
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -62,6 +62,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/TriangulateProcess.h"
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/PolyTools.h"
+#include "Common/MeshIndexBuffer.h"
 
 #include <memory>
 #include <cstdint>
@@ -178,6 +179,12 @@ bool TriangulateProcess::IsActive( unsigned int pFlags) const
     return (pFlags & aiProcess_Triangulate) != 0;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Triangulated meshes get a new index buffer
+bool TriangulateProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void TriangulateProcess::Execute( aiScene* pScene)
@@ -222,8 +229,8 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
         return false;
     }
 
-    // Find out how many output faces we'll get
-    uint32_t numOut = 0, max_out = 0;
+    // Find out how many output faces and indices we'll get
+    uint32_t numOut = 0, numOutIndices = 0, max_out = 0;
     bool get_normals = true;
     for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
         aiFace& face = pMesh->mFaces[a];
@@ -232,10 +239,11 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
         }
         if( face.mNumIndices <= 3) {
             numOut++;
-
+            numOutIndices += face.mNumIndices;
         }
         else {
             numOut += face.mNumIndices-2;
+            numOutIndices += (face.mNumIndices-2)*3;
             max_out = std::max(max_out,face.mNumIndices);
         }
     }
@@ -259,7 +267,9 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
     // The mesh becomes NGON encoded now, during the triangulation process.
     pMesh->mPrimitiveTypes |= aiPrimitiveType_NGONEncodingFlag;
 
+    // the output faces point into a single index buffer
     aiFace* out = new aiFace[numOut](), *curOut = out;
+    unsigned int* outIndices = new unsigned int[numOutIndices], *curIndex = outIndices;
     std::vector<aiVector3D> temp_verts3d(max_out+2); /* temporary storage for vertices */
     std::vector<aiVector2D> temp_verts(max_out+2);
 
@@ -305,8 +315,9 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
         {
             aiFace& nface = *curOut++;
             nface.mNumIndices = face.mNumIndices;
-            nface.mIndices    = face.mIndices;
-            face.mIndices = nullptr;
+            nface.mIndices    = curIndex;
+            std::copy(face.mIndices, face.mIndices + face.mNumIndices, curIndex);
+            curIndex += face.mNumIndices;
 
             // points and lines don't require ngon encoding (and are not supported either!)
             if (nface.mNumIndices == 3) ngonEncoder.ngonEncodeTriangle(&nface);
@@ -347,7 +358,8 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 
             aiFace& nface = *curOut++;
             nface.mNumIndices = 3;
-            nface.mIndices = face.mIndices;
+            nface.mIndices = curIndex;
+            curIndex += 3;
 
             nface.mIndices[0] = temp[start_vertex];
             nface.mIndices[1] = temp[(start_vertex + 1) % 4];
@@ -355,15 +367,13 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 
             aiFace& sface = *curOut++;
             sface.mNumIndices = 3;
-            sface.mIndices = new unsigned int[3];
+            sface.mIndices = curIndex;
+            curIndex += 3;
 
             sface.mIndices[0] = temp[start_vertex];
             sface.mIndices[1] = temp[(start_vertex + 2) % 4];
             sface.mIndices[2] = temp[(start_vertex + 3) % 4];
 
-            // prevent double deletion of the indices field
-            face.mIndices = nullptr;
-
             ngonEncoder.ngonEncodeQuad(&nface, &sface);
 
             continue;
@@ -531,10 +541,8 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 
                 aiFace& nface = *curOut++;
                 nface.mNumIndices = 3;
-
-                if (!nface.mIndices) {
-                    nface.mIndices = new unsigned int[3];
-                }
+                nface.mIndices = curIndex;
+                curIndex += 3;
 
                 // setup indices for the new triangle ...
                 nface.mIndices[0] = prev;
@@ -549,9 +557,8 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
                 // We have three indices forming the last 'ear' remaining. Collect them.
                 aiFace& nface = *curOut++;
                 nface.mNumIndices = 3;
-                if (!nface.mIndices) {
-                    nface.mIndices = new unsigned int[3];
-                }
+                nface.mIndices = curIndex;
+                curIndex += 3;
 
                 for (tmp = 0; done[tmp]; ++tmp);
                 nface.mIndices[0] = tmp;
@@ -607,9 +614,6 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
             ngonEncoder.ngonEncodeTriangle(f);
             ++f;
         }
-
-        delete[] face.mIndices;
-        face.mIndices = nullptr;
     }
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -617,11 +621,12 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh)
 #endif
 
     // kill the old faces
-    delete [] pMesh->mFaces;
+    DeleteFaces(pMesh);
 
     // ... and store the new ones
     pMesh->mFaces    = out;
     pMesh->mNumFaces = (unsigned int)(curOut-out); /* not necessarily equal to numOut */
+    AttachIndexBuffer(pMesh, outIndices, (unsigned int)(curIndex-outIndices));
     return true;
 }
 
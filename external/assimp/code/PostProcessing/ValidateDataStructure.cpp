@@ -72,6 +72,18 @@ ValidateDSProcess::~ValidateDSProcess() {}
 bool ValidateDSProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_ValidateDataStructure) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// The index buffers are validated along with the faces
+bool ValidateDSProcess::SupportsIndexBuffers() const {
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The meshlets are validated along with the faces
+bool ValidateDSProcess::KeepsMeshlets() const {
+    return true;
+}
 // ------------------------------------------------------------------------------------------------
 AI_WONT_RETURN void ValidateDSProcess::ReportError(const char *msg, ...) {
     ai_assert(nullptr != msg);
@@ -288,11 +300,15 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
 
     Validate(&pMesh->mName);
 
+    // before the ScenePreprocessor ran, meshes with an index buffer may have no faces yet
+    const bool bFaceViews = pMesh->mFaces || !pMesh->mIndexBuffer;
+
     for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
-        aiFace &face = pMesh->mFaces[i];
+        const unsigned int numIndices = bFaceViews ? pMesh->mFaces[i].mNumIndices : pMesh->GetFaceSize(i);
+        const unsigned int *indices = bFaceViews ? pMesh->mFaces[i].mIndices : pMesh->mIndexBuffer + pMesh->GetFaceOffset(i);
 
         if (pMesh->mPrimitiveTypes) {
-            switch (face.mNumIndices) {
+            switch (numIndices) {
             case 0:
                 ReportError("aiMesh::mFaces[%i].mNumIndices is 0", i);
                 break;
@@ -327,7 +343,7 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
             };
         }
 
-        if (!face.mIndices)
+        if (!indices)
             ReportError("aiMesh::mFaces[%i].mIndices is nullptr", i);
     }
 
@@ -349,22 +365,49 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
     }
 
     // faces, too
-    if (!pMesh->mNumFaces || (!pMesh->mFaces && !mScene->mFlags)) {
+    if (!pMesh->mNumFaces || (!pMesh->mFaces && !pMesh->mIndexBuffer && !mScene->mFlags)) {
         ReportError("Mesh %s contains no faces", pMesh->mName.C_Str());
     }
 
+    // the faces must match the layout of the index buffer
+    if (pMesh->mIndexBuffer) {
+        if (pMesh->mFaceOffsets) {
+            if (pMesh->mFaceOffsets[pMesh->mNumFaces] != pMesh->mNumIndices) {
+                ReportError("aiMesh::mFaceOffsets[%u] is not aiMesh::mNumIndices", pMesh->mNumFaces);
+            }
+            for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+                if (pMesh->mFaceOffsets[i] > pMesh->mFaceOffsets[i + 1]) {
+                    ReportError("aiMesh::mFaceOffsets[%u] is larger than the next offset", i);
+                }
+            }
+        } else if (!pMesh->mFaceStride || pMesh->mNumFaces * pMesh->mFaceStride != pMesh->mNumIndices) {
+            ReportError("aiMesh::mFaceStride does not match aiMesh::mNumIndices");
+        }
+
+        for (unsigned int i = 0; pMesh->mFaces && i < pMesh->mNumFaces; ++i) {
+            const aiFace &face = pMesh->mFaces[i];
+            if (face.mIndices != pMesh->mIndexBuffer + pMesh->GetFaceOffset(i) ||
+                    face.mNumIndices != pMesh->GetFaceSize(i)) {
+                ReportError("aiMesh::mFaces[%u] does not point to its indices in aiMesh::mIndexBuffer", i);
+            }
+        }
+    } else if (pMesh->mFaceOffsets || pMesh->mNumIndices) {
+        ReportError("aiMesh::mFaceOffsets or aiMesh::mNumIndices is set without an index buffer");
+    }
+
     // now check whether the face indexing layout is correct:
     // unique vertices, pseudo-indexed.
     std::vector<bool> abRefList;
     abRefList.resize(pMesh->mNumVertices, false);
     for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
-        aiFace &face = pMesh->mFaces[i];
-        if (face.mNumIndices > AI_MAX_FACE_INDICES) {
-            ReportError("Face %u has too many faces: %u, but the limit is %u", i, face.mNumIndices, AI_MAX_FACE_INDICES);
+        const unsigned int numIndices = bFaceViews ? pMesh->mFaces[i].mNumIndices : pMesh->GetFaceSize(i);
+        const unsigned int *indices = bFaceViews ? pMesh->mFaces[i].mIndices : pMesh->mIndexBuffer + pMesh->GetFaceOffset(i);
+        if (numIndices > AI_MAX_FACE_INDICES) {
+            ReportError("Face %u has too many faces: %u, but the limit is %u", i, numIndices, AI_MAX_FACE_INDICES);
         }
 
-        for (unsigned int a = 0; a < face.mNumIndices; ++a) {
-            if (face.mIndices[a] >= pMesh->mNumVertices) {
+        for (unsigned int a = 0; a < numIndices; ++a) {
+            if (indices[a] >= pMesh->mNumVertices) {
                 ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range", i, a);
             }
             // the MSB flag is temporarily used by the extra verbose
@@ -376,7 +419,7 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
                 ReportError("aiMesh::mVertices[%i] is referenced twice - second "
                     "time by aiMesh::mFaces[%i]::mIndices[%i]",face.mIndices[a],i,a);
             }*/
-            abRefList[face.mIndices[a]] = true;
+            abRefList[indices[a]] = true;
         }
     }
 
@@ -390,6 +433,42 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
         ReportWarning("There are unreferenced vertices");
     }
 
+    // the meshlets must cover all faces in order and match their indices
+    if (pMesh->mMeshlets || pMesh->mNumMeshlets) {
+        if (!pMesh->mMeshlets || !pMesh->mNumMeshlets || !pMesh->mMeshletVertices || !pMesh->mMeshletIndices) {
+            ReportError("aiMesh::mMeshlets is set without its vertices or indices");
+        }
+        unsigned int nextFace = 0;
+        for (unsigned int m = 0; m < pMesh->mNumMeshlets; ++m) {
+            const aiMeshlet &meshlet = pMesh->mMeshlets[m];
+            if (meshlet.mFaceOffset != nextFace || !meshlet.mFaceCount || meshlet.mFaceCount > pMesh->mNumFaces - nextFace) {
+                ReportError("aiMesh::mMeshlets[%u] does not continue the faces of the previous meshlet", m);
+            }
+            if (!meshlet.mVertexCount || meshlet.mVertexCount > AI_MAX_MESHLET_VERTICES ||
+                    meshlet.mVertexOffset > pMesh->mNumMeshletVertices ||
+                    meshlet.mVertexCount > pMesh->mNumMeshletVertices - meshlet.mVertexOffset) {
+                ReportError("aiMesh::mMeshlets[%u] has an invalid vertex range", m);
+            }
+            for (unsigned int i = nextFace; i < nextFace + meshlet.mFaceCount; ++i) {
+                const unsigned int numIndices = bFaceViews ? pMesh->mFaces[i].mNumIndices : pMesh->GetFaceSize(i);
+                const unsigned int *indices = bFaceViews ? pMesh->mFaces[i].mIndices : pMesh->mIndexBuffer + pMesh->GetFaceOffset(i);
+                if (3 != numIndices) {
+                    ReportError("aiMesh::mFaces[%u] is part of a meshlet but not a triangle", i);
+                }
+                for (unsigned int a = 0; a < 3; ++a) {
+                    const unsigned int local = pMesh->mMeshletIndices[i * 3 + a];
+                    if (local >= meshlet.mVertexCount || pMesh->mMeshletVertices[meshlet.mVertexOffset + local] != indices[a]) {
+                        ReportError("aiMesh::mMeshletIndices[%u] does not match aiMesh::mFaces[%u]", i * 3 + a, i);
+                    }
+                }
+            }
+            nextFace += meshlet.mFaceCount;
+        }
+        if (nextFace != pMesh->mNumFaces) {
+            ReportError("aiMesh::mMeshlets do not cover all faces");
+        }
+    }
+
     // texture channel 2 may not be set if channel 1 is zero ...
     {
         unsigned int i = 0;
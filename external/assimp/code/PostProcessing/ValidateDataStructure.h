@@ -80,6 +80,12 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    bool SupportsIndexBuffers() const;
+
+    // -------------------------------------------------------------------
+    bool KeepsMeshlets() const;
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -311,7 +311,7 @@ private:
 };
 
 // --------------------------------------------------------------------------------------------
-BlobIOStream::~BlobIOStream() {
+inline BlobIOStream::~BlobIOStream() {
     if (nullptr != creator) {
         creator->OnDestruct(file, this);
     }
@@ -124,6 +124,17 @@ public:
      *  See fflush() for more details.
      */
     virtual void Flush() = 0;
+
+    // -------------------------------------------------------------------
+    /** @brief Direct access to the complete file contents
+     *
+     *  Streams that already hold the file in memory, such as memory
+     *  mapped files or MemoryIOStream, return a pointer to FileSize()
+     *  bytes here so loaders can parse in place instead of reading a
+     *  copy. The pointer stays valid until the stream is closed, the
+     *  read cursor is not affected.
+     *  @return nullptr if the stream has no such view (the default). */
+    virtual const uint8_t *GetContents() const;
 }; //! class IOStream
 
 // ----------------------------------------------------------------------------------
@@ -137,6 +148,12 @@ AI_FORCE_INLINE
 IOStream::~IOStream() {
     // empty
 }
+
+// ----------------------------------------------------------------------------------
+AI_FORCE_INLINE
+const uint8_t *IOStream::GetContents() const {
+    return nullptr;
+}
 // ----------------------------------------------------------------------------------
 
 } //!namespace Assimp
@@ -0,0 +1,159 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ImportMetrics.h
+ *  @brief Per-step measurements of an import, see Importer::GetImportMetrics()
+ */
+#pragma once
+#ifndef AI_IMPORTMETRICS_H_INC
+#define AI_IMPORTMETRICS_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/defs.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+struct aiScene;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Measurements of a single step of an import.
+ *
+ *  Memory is sampled as the peak resident set size of the whole process after
+ *  the step, a step that raised it compared to the previous one set a new high
+ *  water mark. CPU time is the time consumed by all threads of the process.
+ */
+struct ImportStep {
+    /** Name of the step: "read" (file lookup and format detection), "import"
+     *  (the format loader), "validate", "preprocess", "postprocess" for a
+     *  customized step or the class name of a post-processing step, e.g.
+     *  "JoinVerticesProcess". */
+    std::string mName;
+
+    /** Start of the step in seconds since the import began, monotonic clock */
+    double mStart;
+
+    /** Elapsed wall time in seconds, monotonic clock */
+    double mWallTime;
+
+    /** CPU time used by the process during the step in seconds, 0 if unknown */
+    double mCpuTime;
+
+    /** Peak resident set size of the process after the step in bytes, 0 if unknown */
+    uint64_t mPeakMemory;
+
+    /** Number of meshes, vertices and faces in the scene before the step */
+    unsigned int mMeshesIn;
+    uint64_t mVerticesIn;
+    uint64_t mFacesIn;
+
+    /** Number of meshes, vertices and faces in the scene after the step */
+    unsigned int mMeshesOut;
+    uint64_t mVerticesOut;
+    uint64_t mFacesOut;
+
+    ImportStep() :
+            mName(), mStart(0.0), mWallTime(0.0), mCpuTime(0.0), mPeakMemory(0),
+            mMeshesIn(0), mVerticesIn(0), mFacesIn(0),
+            mMeshesOut(0), mVerticesOut(0), mFacesOut(0) {
+        // empty
+    }
+};
+
+// ---------------------------------------------------------------------------
+/** Measurements of the last import of an Importer.
+ *
+ *  Recorded when #AI_CONFIG_GLOB_MEASURE_TIME is enabled. ReadFile() starts a
+ *  new record, post-processing applied later on is appended to it.
+ */
+class ASSIMP_API ImportMetrics {
+public:
+    ImportMetrics();
+
+    /** The file that was imported */
+    std::string mFile;
+
+    /** All steps in the order they ran */
+    std::vector<ImportStep> mSteps;
+
+    // -------------------------------------------------------------------
+    /** Removes all steps and restarts the clock. */
+    void Clear();
+
+    // -------------------------------------------------------------------
+    /** Returns the wall time from the start of the import to the end of
+     *  the last step in seconds. */
+    double GetTotalWallTime() const;
+
+    // -------------------------------------------------------------------
+    /** Returns the steps in Chrome's trace event format, the JSON can be
+     *  loaded into chrome://tracing or Perfetto. */
+    std::string ToChromeTrace() const;
+
+    // -------------------------------------------------------------------
+    /** Starts measuring a step, called by the Importer.
+     *  @param name Name of the step
+     *  @param scene Scene the step works on, may be nullptr */
+    void BeginStep(const char *name, const aiScene *scene);
+
+    // -------------------------------------------------------------------
+    /** Finishes the step started last.
+     *  @param scene Scene after the step, may be nullptr */
+    void EndStep(const aiScene *scene);
+
+private:
+    std::chrono::steady_clock::time_point mOrigin;
+    std::chrono::steady_clock::time_point mStepStart;
+    double mStepCpuStart;
+    bool mInStep;
+};
+
+} // namespace Assimp
+
+#endif // AI_IMPORTMETRICS_H_INC
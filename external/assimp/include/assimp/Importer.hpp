@@ -68,6 +68,7 @@ class Importer;
 class IOStream;
 class IOSystem;
 class ProgressHandler;
+class ImportMetrics;
 
 // =======================================================================
 // Plugin development
@@ -640,6 +641,17 @@ public:
      *   is (naturally) not included.*/
     void GetMemoryRequirements(aiMemoryInfo &in) const;
 
+    // -------------------------------------------------------------------
+    /** Returns the measurements of the last import.
+     *
+     * Wall time, CPU time, peak memory and the mesh, vertex and face
+     * counts before and after every step of #ReadFile() and the
+     * post-processing applied afterwards. Steps are only recorded while
+     * #AI_CONFIG_GLOB_MEASURE_TIME is enabled, otherwise the list is empty.
+     * Include <assimp/ImportMetrics.h> for the declaration.
+     * @return Metrics of the last import, valid until the next #ReadFile()*/
+    const ImportMetrics &GetImportMetrics() const;
+
     // -------------------------------------------------------------------
     /** Enables "extra verbose" mode.
      *
@@ -142,6 +142,12 @@ public:
         ai_assert(false); // won't be needed
     }
 
+    // -------------------------------------------------------------------
+    // The whole buffer, loaders can parse it in place
+    const uint8_t *GetContents() const {
+        return buffer;
+    }
+
 private:
     const uint8_t* buffer;
     size_t length,pos;
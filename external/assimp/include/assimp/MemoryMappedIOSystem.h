@@ -0,0 +1,112 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file MemoryMappedIOSystem.h
+ *  @brief IOSystem that maps files into memory instead of reading them
+ */
+#pragma once
+#ifndef AI_MEMORYMAPPEDIOSYSTEM_H_INC
+#define AI_MEMORYMAPPEDIOSYSTEM_H_INC
+
+#ifdef __GNUC__
+#   pragma GCC system_header
+#endif
+
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** IOStream over a file mapped into memory.
+ *
+ *  GetContents() returns the mapping, so loaders that support it parse the
+ *  file in place and the OS pages it in on demand instead of the loader
+ *  holding a full copy. The mapping is private: pages written to by a
+ *  loader are copied and the file itself is never modified. */
+class ASSIMP_API MemoryMappedIOStream : public IOStream {
+    friend class MemoryMappedIOSystem;
+
+protected:
+    MemoryMappedIOStream(uint8_t *pData, size_t pSize, void *pMapping);
+
+public:
+    /** Destructor public to allow simple deletion to unmap the file. */
+    ~MemoryMappedIOStream() override;
+
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override;
+
+    /** Always fails, mapped streams are read-only. */
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override;
+
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+    size_t Tell() const override;
+    size_t FileSize() const override;
+    void Flush() override;
+
+    const uint8_t *GetContents() const override;
+
+private:
+    uint8_t *mData;
+    size_t mSize;
+    size_t mPos;
+    void *mMapping; ///< file mapping handle on Windows, unused elsewhere
+};
+
+// ---------------------------------------------------------------------------
+/** DefaultIOSystem that memory maps files opened for reading.
+ *
+ *  Binary FBX, STL, glb and Assbin files are then parsed straight from the
+ *  mapping, which saves a full copy of the file and roughly halves the peak
+ *  memory use on very large assets. Files that cannot be mapped (empty files,
+ *  pipes) and files opened for writing go through DefaultIOSystem.
+ *  Install it with Importer::SetIOHandler(). */
+class ASSIMP_API MemoryMappedIOSystem : public DefaultIOSystem {
+public:
+    // -------------------------------------------------------------------
+    /** Open a new file with a given path. */
+    IOStream *Open(const char *pFile, const char *pMode = "rb") override;
+};
+
+} // namespace Assimp
+
+#endif // AI_MEMORYMAPPEDIOSYSTEM_H_INC
@@ -330,6 +330,35 @@ public:
      */
     static void CopyScene(aiScene **dest, const aiScene *source, bool allocate = true);
 
+    // -------------------------------------------------------------------
+    /** Get a copy of a scene that shares immutable arrays with the source
+     *
+     *  Mesh, texture and animation arrays the source keeps in reference
+     *  counted scene buffers are not duplicated, the copy points to them
+     *  and shares ownership of the buffers. All other data is copied as
+     *  by CopyScene(). Use MakeSceneShareable() once on a scene to move
+     *  all its arrays into such buffers, so that any number of copies
+     *  cost little more than the scene graph.
+     *
+     *  Shared arrays are treated as read-only. Post-processing and
+     *  exporting a scene duplicate the arrays of those parts of the scene
+     *  the active steps write to before running them. Code writing to
+     *  the arrays of a shared scene directly must use CopyScene() instead.
+     *  @param dest Receives a pointer to the destination scene
+     *  @param src Source scene - remains unmodified.
+     */
+    static void CopySceneShared(aiScene **dest, const aiScene *source);
+
+    // -------------------------------------------------------------------
+    /** Move the mesh, texture and animation arrays of a scene into
+     *  reference counted buffers for CopySceneShared()
+     *
+     *  The contents of the scene do not change, but its arrays must no
+     *  longer be freed or replaced by the caller.
+     *  @param scene Scene to prepare
+     */
+    static void MakeSceneShareable(aiScene *scene);
+
     // -------------------------------------------------------------------
     /** Get a flat copy of a scene
      *
@@ -0,0 +1,189 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** Hash grid alternative to SpatialSort for finding vertices close to a given location */
+#pragma once
+#ifndef AI_SPATIALHASHGRID_H_INC
+#define AI_SPATIALHASHGRID_H_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+#include <cstdint>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Drop-in alternative to SpatialSort with the same query interface. Positions are bucketed
+ * into a uniform grid whose cell size is derived from the bounding box and the vertex count,
+ * the occupied cells are stored in Morton order and found through an open-addressing hash table.
+ * A query only visits the cells overlapping its radius, so the cost no longer depends on how
+ * many vertices happen to share a band along the SpatialSort plane. This keeps dense scans
+ * and CAD meshes, where SpatialSort degrades towards O(n) per query, close to O(1).
+ * Select it for the post-processing steps with #AI_CONFIG_PP_SPATIAL_HASH_GRID. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API SpatialHashGrid {
+public:
+    SpatialHashGrid();
+
+    // ------------------------------------------------------------------------------------
+    /** Constructs the grid from the given position array. The class will only refer
+     * to the positions by index.
+     * @param pPositions Pointer to the first position vector of the array.
+     * @param pNumPositions Number of vectors to expect in that array.
+     * @param pElementOffset Offset in bytes from the beginning of one vector in memory
+     *   to the beginning of the next vector. */
+    SpatialHashGrid(const aiVector3D *pPositions, unsigned int pNumPositions,
+            unsigned int pElementOffset);
+
+    /** Destructor */
+    ~SpatialHashGrid();
+
+    // ------------------------------------------------------------------------------------
+    /** Sets the input data. This replaces existing data, if any.
+     *  The new data receives new indices in ascending order.
+     * @see SpatialSort::Fill() */
+    void Fill(const aiVector3D *pPositions, unsigned int pNumPositions,
+            unsigned int pElementOffset,
+            bool pFinalize = true);
+
+    // ------------------------------------------------------------------------------------
+    /** Same as #Fill(), except the method appends to existing data. */
+    void Append(const aiVector3D *pPositions, unsigned int pNumPositions,
+            unsigned int pElementOffset,
+            bool pFinalize = true);
+
+    // ------------------------------------------------------------------------------------
+    /** Builds the grid. Required before one of the query methods can be called. */
+    void Finalize();
+
+    // ------------------------------------------------------------------------------------
+    /** Fills an array with the indices of all positions closer than pRadius to the given
+     * position. The indices are grouped by grid cell, not sorted by distance.
+     * @param pPosition The position to look for vertices.
+     * @param pRadius Maximal distance from the position a vertex may have to be counted in.
+     * @param poResults The container to store the indices of the found positions.
+     *   Will be emptied by the call so it may contain anything.*/
+    void FindPositions(const aiVector3D &pPosition, ai_real pRadius,
+            std::vector<unsigned int> &poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Fills an array with indices of all positions identical to the given position, that
+     *  is each coordinate differs by at most four units in the last place.
+     * @param pPosition The position to look for vertices.
+     * @param poResults The container to store the indices of the found positions.
+     *   Will be emptied by the call so it may contain anything.*/
+    void FindIdenticalPositions(const aiVector3D &pPosition,
+            std::vector<unsigned int> &poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Compute a table that maps each vertex ID referring to a spatially close
+     *  enough position to the same output ID. Output IDs are assigned in ascending order
+     *  of the first vertex of each group.
+     * @param fill Will be filled with numPositions entries.
+     * @param pRadius Maximal distance from the position a vertex may have to
+     *   be counted in.
+     *  @return Number of unique vertices (n).  */
+    unsigned int GenerateMappingTable(std::vector<unsigned int> &fill,
+            ai_real pRadius) const;
+
+protected:
+    /** Integer cell coordinate of a position along one axis, clamped to the grid. */
+    uint32_t CellCoord(ai_real pValue, unsigned int pAxis) const;
+
+    /** Index into mCells of the cell with the given Morton key, UINT_MAX if it is empty. */
+    unsigned int FindCell(uint64_t pKey) const;
+
+    /** Calls pFunc for every stored entry in the cells within pRadius of pPosition. */
+    template <typename Func>
+    void ForEachCandidate(const aiVector3D &pPosition, ai_real pRadius, Func pFunc) const;
+
+protected:
+    /** A stored position with its vertex index and the Morton key of its cell. */
+    struct Entry {
+        unsigned int mIndex; ///< The vertex referred by this entry
+        aiVector3D mPosition; ///< Position
+        uint64_t mKey; ///< Morton key of the cell, set by Finalize
+
+        Entry(unsigned int pIndex, const aiVector3D &pPosition) :
+                mIndex(pIndex), mPosition(pPosition), mKey(0) {
+            // empty
+        }
+
+        bool operator<(const Entry &e) const {
+            return mKey < e.mKey || (mKey == e.mKey && mIndex < e.mIndex);
+        }
+    };
+
+    /** An occupied grid cell, a range of mPositions. */
+    struct Cell {
+        uint64_t mKey;
+        unsigned int mBegin;
+        unsigned int mEnd;
+    };
+
+    /// all positions, sorted by the Morton key of their cell
+    std::vector<Entry> mPositions;
+
+    /// occupied cells in Morton order
+    std::vector<Cell> mCells;
+
+    /// open-addressing hash table, index into mCells + 1, 0 marks a free slot
+    std::vector<unsigned int> mTable;
+
+    /// lower corner of the grid, the minimum of all positions
+    aiVector3D mMin;
+
+    /// edge length of a cell and its reciprocal
+    ai_real mCellSize;
+    ai_real mInvCellSize;
+
+    /// false until the Finalize method is called.
+    bool mFinalized;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_SPATIALHASHGRID_H_INC
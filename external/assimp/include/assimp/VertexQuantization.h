@@ -0,0 +1,211 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  VertexQuantization.h
+ *  @brief Encoders for packing vertex attributes into compact GPU formats.
+ *
+ *  Positions are stored as signed normalized 16 bit integers relative to the
+ *  bounding box of their mesh, normals and tangents as octahedral encoded
+ *  signed normalized 16 bit pairs and texture coordinates as half floats.
+ *  A vertex of position, normal, tangent and one UV channel shrinks from
+ *  44 to 20 bytes (with padding for the 16 bit position).
+ */
+#pragma once
+#ifndef AI_VERTEXQUANTIZATION_H_INC
+#define AI_VERTEXQUANTIZATION_H_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/aabb.h>
+#include <assimp/types.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace Assimp {
+namespace Quantization {
+
+// ------------------------------------------------------------------------------------------------
+/** Encodes a value in [-1, 1] as signed normalized 16 bit integer, values outside are clamped. */
+inline int16_t EncodeSnorm16(ai_real v) {
+    v = std::max(ai_real(-1.0), std::min(ai_real(1.0), v));
+    return static_cast<int16_t>(std::lround(v * ai_real(32767.0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Decodes a signed normalized 16 bit integer, the inverse of EncodeSnorm16(). */
+inline ai_real DecodeSnorm16(int16_t v) {
+    return std::max(ai_real(-1.0), ai_real(v) / ai_real(32767.0));
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Converts a float to IEEE 754 half precision, rounding to nearest. Values too large for a
+ *  half become infinity, values too small flush to zero, NaNs become quiet NaNs. */
+inline uint16_t EncodeHalf(float v) {
+    uint32_t bits;
+    ::memcpy(&bits, &v, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000;
+    const uint32_t em = bits & 0x7fffffff;
+
+    // rebias the exponent from 127 to 15 and round the mantissa
+    uint32_t h = (em - (112u << 23) + (1u << 12)) >> 13;
+    // below the smallest normal half, exponent -14
+    h = em < (113u << 23) ? 0 : h;
+    // above the largest half, exponent 15
+    h = em >= (143u << 23) ? 0x7c00 : h;
+    h = em > (255u << 23) ? 0x7e00 : h;
+    return static_cast<uint16_t>(sign | h);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Converts an IEEE 754 half to float, the inverse of EncodeHalf(). */
+inline float DecodeHalf(uint16_t h) {
+    const uint32_t sign = uint32_t(h & 0x8000) << 16;
+    const uint32_t exponent = (h >> 10) & 0x1f;
+    const uint32_t mantissa = h & 0x3ff;
+
+    uint32_t bits;
+    if (exponent == 0) {
+        // zero or denormal, the value is mantissa * 2^-24
+        const float v = float(mantissa) * (1.0f / 16777216.0f);
+        ::memcpy(&bits, &v, sizeof(bits));
+        bits |= sign;
+    } else if (exponent == 0x1f) {
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float v;
+    ::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Encodes a unit vector with octahedral mapping into two signed normalized 16 bit values.
+ *  The vector is projected onto the octahedron |x| + |y| + |z| = 1 whose lower half is folded
+ *  over the upper one. The error stays below 0.005 degrees; the vector needn't be normalized,
+ *  a zero vector becomes (0, 0, 1). */
+inline void EncodeOctahedral(const aiVector3D &n, int16_t &x, int16_t &y) {
+    const ai_real l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (l1 <= ai_real(0.0)) {
+        x = y = 0;
+        return;
+    }
+
+    ai_real u = n.x / l1, v = n.y / l1;
+    if (n.z < ai_real(0.0)) {
+        const ai_real fu = (ai_real(1.0) - std::abs(v)) * (u >= ai_real(0.0) ? ai_real(1.0) : ai_real(-1.0));
+        const ai_real fv = (ai_real(1.0) - std::abs(u)) * (v >= ai_real(0.0) ? ai_real(1.0) : ai_real(-1.0));
+        u = fu;
+        v = fv;
+    }
+    x = EncodeSnorm16(u);
+    y = EncodeSnorm16(v);
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Decodes an octahedral encoded unit vector, the inverse of EncodeOctahedral(). Shaders
+ *  reading the attributes as normalized values decode them the same way:
+ *  @code
+ *  vec3 n = vec3(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+ *  float t = max(-n.z, 0.0);
+ *  n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+ *  n = normalize(n);
+ *  @endcode */
+inline aiVector3D DecodeOctahedral(int16_t x, int16_t y) {
+    aiVector3D n(DecodeSnorm16(x), DecodeSnorm16(y), ai_real(0.0));
+    n.z = ai_real(1.0) - std::abs(n.x) - std::abs(n.y);
+    const ai_real t = std::max(-n.z, ai_real(0.0));
+    n.x += n.x >= ai_real(0.0) ? -t : t;
+    n.y += n.y >= ai_real(0.0) ? -t : t;
+    return n.Normalize();
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Maps positions within a bounding box to signed normalized 16 bit integers.
+ *  All axes share one scale, the half of the longest box edge, so the dequantization
+ *  position = mOffset + mScale * q is a uniform scale and translation that can be merged
+ *  into the model matrix without distorting normals. */
+struct PositionQuantization {
+    /// Center of the bounding box
+    aiVector3D mOffset;
+
+    /// Half of the longest edge of the bounding box, 1 if the box is empty
+    ai_real mScale;
+
+    PositionQuantization() :
+            mOffset(), mScale(ai_real(1.0)) {
+        // empty
+    }
+
+    explicit PositionQuantization(const aiAABB &box) :
+            mOffset((box.mMin + box.mMax) * ai_real(0.5)), mScale(ai_real(1.0)) {
+        const aiVector3D extent = box.mMax - box.mMin;
+        const ai_real edge = std::max(extent.x, std::max(extent.y, extent.z));
+        if (edge > ai_real(0.0)) {
+            mScale = edge * ai_real(0.5);
+        }
+    }
+
+    /** Quantizes a position inside the box, positions outside are clamped to it. */
+    void Encode(const aiVector3D &p, int16_t &x, int16_t &y, int16_t &z) const {
+        const ai_real invScale = ai_real(1.0) / mScale;
+        x = EncodeSnorm16((p.x - mOffset.x) * invScale);
+        y = EncodeSnorm16((p.y - mOffset.y) * invScale);
+        z = EncodeSnorm16((p.z - mOffset.z) * invScale);
+    }
+
+    /** Restores a quantized position, the error is at most mScale / 65534 per axis. */
+    aiVector3D Decode(int16_t x, int16_t y, int16_t z) const {
+        return mOffset + aiVector3D(DecodeSnorm16(x), DecodeSnorm16(y), DecodeSnorm16(z)) * mScale;
+    }
+};
+
+} // namespace Quantization
+} // namespace Assimp
+
+#endif // AI_VERTEXQUANTIZATION_H_INC
@@ -21,8 +21,13 @@
 #   pragma GCC system_header
 #endif
 
+#include <cfloat>
+#include <clocale>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <string>
 #include <stdint.h>
 #include <assimp/defs.h>
 
@@ -33,10 +38,22 @@
 
 #ifdef _MSC_VER
 #  include <stdint.h>
+#  include <intrin.h>
 #else
 #  include <assimp/Compiler/pstdint.h>
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define AI_FAST_ATOF_USE_SSE2
+#endif
+
+// The bulk parsers rely on products and quotients of doubles being correctly rounded,
+// which does not hold if the FPU evaluates them in extended precision.
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD >= 0 && FLT_EVAL_METHOD <= 1) || defined(_M_X64) || defined(_M_ARM64)
+#   define AI_FAST_ATOF_EXACT_FPU
+#endif
+
 namespace Assimp {
 
 const double fast_atof_table[16] =  {  // we write [16] here instead of [] to work around a swig bug
@@ -380,6 +397,400 @@ ai_real fast_atof( const char** inout) {
     return ret;
 }
 
+namespace Intern {
+
+// ------------------------------------------------------------------------------------
+// Helpers of the bulk parsers below
+// ------------------------------------------------------------------------------------
+inline
+bool IsArraySeparator(char in, bool comma_separated) {
+    return in == ' ' || in == '\t' || in == '\n' || in == '\r' || in == '\f' || (comma_separated && in == ',');
+}
+
+inline
+unsigned int CountTrailingZeros(unsigned int in) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, in);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(in));
+#endif
+}
+
+// Returns the number of decimal digits at in, 16 characters at a time if possible
+inline
+size_t CountDigits(const char* in, const char* end) {
+    const char* begin = in;
+#ifdef AI_FAST_ATOF_USE_SSE2
+    const __m128i zero = _mm_set1_epi8('0'), nine = _mm_set1_epi8(9);
+    while (end - in >= 16) {
+        // characters below '0' wrap around and compare greater than 9, too
+        const __m128i v = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), zero);
+        const unsigned int digits = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, nine), v)));
+        if (digits != 0xffff) {
+            return static_cast<size_t>(in - begin) + CountTrailingZeros(~digits & 0xffff);
+        }
+        in += 16;
+    }
+#endif
+    while (in != end && static_cast<unsigned char>(*in - '0') <= 9) {
+        ++in;
+    }
+    return static_cast<size_t>(in - begin);
+}
+
+#ifndef AI_BUILD_BIG_ENDIAN
+// Converts eight digits, the first one in the lowest byte, with digit values instead of characters.
+// Combines pairs, then quadruples, then both halves.
+inline
+uint64_t ParseEightDigits(uint64_t chunk) {
+    chunk = (chunk * 10) + (chunk >> 8);
+    return (((chunk & 0x000000ff000000ffull) * (100 + (1000000ull << 32))) +
+            (((chunk >> 16) & 0x000000ff000000ffull) * (1 + (10000ull << 32)))) >> 32;
+}
+#endif
+
+// Appends count decimal digits at in to value, eight at a time if at least eight characters
+// up to end can be read
+inline
+uint64_t AccumulateDigits(const char* in, size_t count, const char* end, uint64_t value) {
+#ifndef AI_BUILD_BIG_ENDIAN
+    static const uint64_t pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+    uint64_t chunk;
+    for (; count >= 8 && end - in >= 8; count -= 8, in += 8) {
+        ::memcpy(&chunk, in, 8);
+        value = value * pow10[8] + ParseEightDigits(chunk - 0x3030303030303030ull);
+    }
+    if (count && end - in >= 8) {
+        // shift the characters behind the digits out and pad with leading zeros,
+        // borrows of the subtraction only run into the discarded bytes
+        ::memcpy(&chunk, in, 8);
+        chunk = (chunk - 0x3030303030303030ull) << (8 * (8 - count));
+        return value * pow10[count] + ParseEightDigits(chunk);
+    }
+#endif
+    for (; count; --count, ++in) {
+        value = value * 10 + static_cast<unsigned int>(*in - '0');
+    }
+    return value;
+}
+
+// Converts a double which is exactly rounded from the parsed decimal to Real.
+// Rounding once more is only wrong if the double lies halfway between two floats.
+inline
+bool NarrowExact(double in, double& out) {
+    out = in;
+    return true;
+}
+
+inline
+bool NarrowExact(double in, float& out) {
+    uint64_t bits;
+    ::memcpy(&bits, &in, sizeof(bits));
+    if ((bits & 0x1fffffffull) == 0x10000000ull) {
+        return false;
+    }
+    out = static_cast<float>(in);
+    return true;
+}
+
+inline
+void ParseExact(const char* in, double& out) {
+    out = ::strtod(in, nullptr);
+}
+
+inline
+void ParseExact(const char* in, float& out) {
+    out = ::strtof(in, nullptr);
+}
+
+#ifdef AI_FAST_ATOF_EXACT_FPU
+const double exact_pow10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Clinger's fast path: if the significand and the power of ten are exact doubles,
+// so is the correctly rounded product or quotient
+template<typename Real>
+inline
+bool ScaleExact(uint64_t significand, int exponent, Real& out) {
+    if (significand > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+        return false;
+    }
+    const double d = static_cast<double>(significand);
+    return NarrowExact(exponent < 0 ? d / exact_pow10[-exponent] : d * exact_pow10[exponent], out);
+}
+
+#if defined(AI_FAST_ATOF_USE_SSE2) && !defined(AI_BUILD_BIG_ENDIAN)
+// Parses the common case of an unsigned decimal with up to eight digits before and after
+// the decimal point and an optional exponent from a single 16 byte load. At least 32
+// characters must be readable at in. Returns the end of the number, nullptr for everything else.
+template<typename Real>
+inline
+const char* ParseShortDecimal(const char* in, bool comma_separated, Real& out) {
+    const __m128i v = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), _mm_set1_epi8('0'));
+    const unsigned int digits = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(9)), v)));
+    const unsigned int intCount = CountTrailingZeros(~digits);
+    if (intCount > 8) {
+        return nullptr;
+    }
+
+    static const uint64_t pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+    uint64_t chunk;
+    uint64_t significand = 0;
+    if (intCount) {
+        ::memcpy(&chunk, in, 8);
+        significand = ParseEightDigits((chunk - 0x3030303030303030ull) << (8 * (8 - intCount)));
+    }
+
+    const char* c = in + intCount;
+    unsigned int fracCount = 0;
+    if (*c == '.') {
+        // bits above the loaded characters are zero, too long fractions end up at
+        // a digit and are rejected below
+        fracCount = CountTrailingZeros(~(digits >> (intCount + 1)));
+        if (fracCount > 8) {
+            return nullptr;
+        }
+        if (fracCount) {
+            ::memcpy(&chunk, c + 1, 8);
+            significand = significand * pow10[fracCount] + ParseEightDigits((chunk - 0x3030303030303030ull) << (8 * (8 - fracCount)));
+        }
+        c += 1 + fracCount;
+    }
+    if (intCount + fracCount == 0) {
+        return nullptr;
+    }
+
+    int exponent = 0;
+    if (*c == 'e' || *c == 'E') {
+        ++c;
+        const bool negative = (*c == '-');
+        if (negative || *c == '+') {
+            ++c;
+        }
+        if (static_cast<unsigned char>(*c - '0') > 9) {
+            return nullptr;
+        }
+        for (unsigned int i = 0; static_cast<unsigned char>(*c - '0') <= 9; ++i, ++c) {
+            if (i == 4) {
+                return nullptr;
+            }
+            exponent = exponent * 10 + (*c - '0');
+        }
+        exponent = negative ? -exponent : exponent;
+    }
+
+    if ((*c != '\0' && !IsArraySeparator(*c, comma_separated)) ||
+            !ScaleExact(significand, exponent - static_cast<int>(fracCount), out)) {
+        return nullptr;
+    }
+    return c;
+}
+#endif
+#endif // AI_FAST_ATOF_EXACT_FPU
+
+// Correctly rounded conversion of a token the fast path cannot handle exactly.
+// strtod is exact, but reads the decimal point of the current locale.
+template<typename Real>
+inline
+void ParseExact(const char* begin, const char* end, Real& out) {
+    char buffer[64];
+    std::string heap;
+    char* token = buffer;
+    const size_t length = static_cast<size_t>(end - begin);
+    if (length >= sizeof(buffer)) {
+        heap.resize(length + 1);
+        token = &heap[0];
+    }
+    ::memcpy(token, begin, length);
+    token[length] = '\0';
+
+    const char point = *::localeconv()->decimal_point;
+    if (point != '.') {
+        char* dot = ::strchr(token, '.');
+        if (dot) {
+            *dot = point;
+        }
+    }
+    ParseExact(token, out);
+}
+
+// Parses the number at in with fast_atoreal_move, which knows about nan, inf and
+// decimal commas and throws on malformed numbers. The copy keeps its error
+// messages inside the token.
+template<typename Real, typename ExceptionType>
+inline
+const char* ParseSpecial(const char* in, const char* end, Real& out, bool check_comma) {
+    const char* tokenEnd = in;
+    while (tokenEnd != end && *tokenEnd != '\0' && !IsArraySeparator(*tokenEnd, !check_comma)) {
+        ++tokenEnd;
+    }
+    const std::string token(in, tokenEnd);
+    const char* consumed = fast_atoreal_move<Real, ExceptionType>(token.c_str(), out, check_comma);
+    return in + (consumed - token.c_str());
+}
+
+} // namespace Intern
+
+// ------------------------------------------------------------------------------------
+//! Parses up to max_count real numbers separated by whitespace (and commas, if
+//! comma_separated is set) from [c, end) into out. Parsing stops at end, at a
+//! terminating zero and in front of the first token which does not look like a
+//! number; count receives the number of values read.
+//!
+//! Unlike fast_atoreal_move, the results are correctly rounded. Plain decimals
+//! are converted with SIMD digit scanning and a single exact multiplication or
+//! division if possible and with strtod otherwise. nan, inf and decimal commas
+//! are handled by fast_atoreal_move, which also throws on malformed numbers.
+//! @return The character behind the last value read.
+// ------------------------------------------------------------------------------------
+template<typename Real, typename ExceptionType = DeadlyImportError>
+inline
+const char* fast_atoreal_array(const char* c, const char* end, Real* out, size_t max_count, size_t& count,
+        bool comma_separated = false) {
+    count = 0;
+    const char* last = c;
+    while (count < max_count) {
+        while (c != end && Intern::IsArraySeparator(*c, comma_separated)) {
+            ++c;
+        }
+        if (c == end || *c == '\0') {
+            break;
+        }
+
+        const char* token = c;
+        const bool negative = (*c == '-');
+        if (negative || *c == '+') {
+            ++c;
+        }
+
+        Real value;
+#if defined(AI_FAST_ATOF_EXACT_FPU) && defined(AI_FAST_ATOF_USE_SSE2) && !defined(AI_BUILD_BIG_ENDIAN)
+        if (end - c >= 32) {
+            const char* next = Intern::ParseShortDecimal(c, comma_separated, value);
+            if (next) {
+                out[count++] = negative ? -value : value;
+                c = last = next;
+                continue;
+            }
+        }
+#endif
+
+        const char* intBegin = c;
+        size_t intCount = Intern::CountDigits(c, end);
+        c += intCount;
+
+        const char* fracBegin = c;
+        size_t fracCount = 0;
+        if (c != end && *c == '.') {
+            fracBegin = ++c;
+            fracCount = Intern::CountDigits(c, end);
+            c += fracCount;
+        }
+
+        int exponent = 0;
+        bool exact = (intCount + fracCount != 0);
+        if (exact && c != end && (*c == 'e' || *c == 'E')) {
+            const char* e = c + 1;
+            const bool negativeExponent = (e != end && *e == '-');
+            if (e != end && (negativeExponent || *e == '+')) {
+                ++e;
+            }
+            const size_t expCount = Intern::CountDigits(e, end);
+            if (expCount == 0) {
+                exact = false;
+            } else {
+                // leave extreme exponents to strtod
+                exponent = expCount > 4 ? 100000 : static_cast<int>(Intern::AccumulateDigits(e, expCount, end, 0));
+                exponent = negativeExponent ? -exponent : exponent;
+                c = e + expCount;
+            }
+        }
+
+        if (!exact || (c != end && *c != '\0' && !Intern::IsArraySeparator(*c, comma_separated))) {
+            // nan, inf, decimal commas or garbage
+            const char ch = *token == '-' || *token == '+' ? token[1] : token[0];
+            if (!((ch >= '0' && ch <= '9') || ch == '.' || ch == ',' || ch == 'n' || ch == 'N' || ch == 'i' || ch == 'I')) {
+                c = token;
+                break;
+            }
+            c = Intern::ParseSpecial<Real, ExceptionType>(token, end, out[count++], !comma_separated);
+            last = c;
+            continue;
+        }
+
+        // drop leading and trailing zeros, the remaining digits form the significand
+        while (intCount && *intBegin == '0') {
+            ++intBegin;
+            --intCount;
+        }
+        while (fracCount && fracBegin[fracCount - 1] == '0') {
+            --fracCount;
+        }
+        exponent -= static_cast<int>(fracCount);
+        if (intCount == 0) {
+            while (fracCount && *fracBegin == '0') {
+                ++fracBegin;
+                --fracCount;
+            }
+        }
+
+        value = Real(0);
+        bool done = (intCount + fracCount == 0);
+#ifdef AI_FAST_ATOF_EXACT_FPU
+        if (!done && intCount + fracCount <= 19) {
+            const uint64_t significand = Intern::AccumulateDigits(fracBegin, fracCount, end,
+                    Intern::AccumulateDigits(intBegin, intCount, end, 0));
+            done = Intern::ScaleExact(significand, exponent, value);
+        }
+#endif
+        if (!done) {
+            Intern::ParseExact(negative || *token == '+' ? token + 1 : token, c, value);
+        }
+        out[count++] = negative ? -value : value;
+        last = c;
+    }
+    return last;
+}
+
+// ------------------------------------------------------------------------------------
+//! Parses up to max_count integers separated by whitespace (and commas, if
+//! comma_separated is set) from [c, end) into out, wrapping around on overflow
+//! like strtol10. Parsing stops at end, at a terminating zero and in front of
+//! the first token which is not an integer; count receives the number of values read.
+//! @return The character behind the last value read.
+// ------------------------------------------------------------------------------------
+inline
+const char* strtol10_array(const char* c, const char* end, int* out, size_t max_count, size_t& count,
+        bool comma_separated = false) {
+    count = 0;
+    const char* last = c;
+    while (count < max_count) {
+        while (c != end && Intern::IsArraySeparator(*c, comma_separated)) {
+            ++c;
+        }
+        if (c == end) {
+            break;
+        }
+
+        const bool negative = (*c == '-');
+        const char* digits = (negative || *c == '+') ? c + 1 : c;
+        const size_t digitCount = Intern::CountDigits(digits, end);
+        const char* tokenEnd = digits + digitCount;
+        if (digitCount == 0 || (tokenEnd != end && *tokenEnd != '\0' && !Intern::IsArraySeparator(*tokenEnd, comma_separated))) {
+            break;
+        }
+
+        const unsigned int value = static_cast<unsigned int>(Intern::AccumulateDigits(digits, digitCount, end, 0));
+        out[count++] = static_cast<int>(negative ? 0u - value : value);
+        c = last = tokenEnd;
+    }
+    return last;
+}
+
 } //! namespace Assimp
 
 #endif // FAST_A_TO_F_H_INCLUDED
@@ -933,6 +933,14 @@ public:
 
     /** Storage allocated */
     unsigned int mNumAllocated;
+
+    /**  Internal data, do not touch. Lookup index over mProperties,
+     *   maintained by the aiMaterial member functions. */
+#ifdef __cplusplus
+    void *mPrivate;
+#else
+    char *mPrivate;
+#endif
 };
 
 // Go back to extern "C" again
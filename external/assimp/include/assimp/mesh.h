@@ -96,6 +96,12 @@ extern "C" {
 #define AI_MAX_FACES 0x7fffffff
 #endif
 
+/** @def AI_MAX_MESHLET_VERTICES
+ *  Maximum number of vertices per meshlet. Not configurable, the local
+ *  indices of a meshlet are stored in a byte. */
+
+#define AI_MAX_MESHLET_VERTICES 0x100
+
 /** @def AI_MAX_NUMBER_OF_COLOR_SETS
  *  Supported number of vertex color sets per mesh. */
 
@@ -578,6 +584,59 @@ enum aiMorphingMethod {
 #endif
 }; //! enum aiMorphingMethod
 
+// ---------------------------------------------------------------------------
+/** @brief A small cluster of triangles of a mesh, see aiMesh::mMeshlets.
+ *
+ * The faces of a meshlet are contiguous in aiMesh::mFaces. The meshlet
+ * addresses its vertices through a local list, so the local triangle
+ * indices fit in a byte and a renderer can cull and draw each meshlet on
+ * its own.
+ */
+struct aiMeshlet {
+    /** Start of the meshlet's vertices in aiMesh::mMeshletVertices. */
+    unsigned int mVertexOffset;
+
+    /** Number of vertices, at most #AI_MAX_MESHLET_VERTICES. */
+    unsigned int mVertexCount;
+
+    /** Index of the meshlet's first face. Its local triangle indices
+     *  start at aiMesh::mMeshletIndices[3 * mFaceOffset]. */
+    unsigned int mFaceOffset;
+
+    /** Number of faces. */
+    unsigned int mFaceCount;
+
+    /** Bounding sphere of the meshlet's vertices. */
+    C_STRUCT aiVector3D mCenter;
+    ai_real mRadius;
+
+    /** Normal cone of the meshlet's triangles. All triangles face away
+     *  from a viewer at position p if
+     *  dot(normalize(mConeApex - p), mConeAxis) >= mConeCutoff.
+     *  A cutoff of 1 means the cone is too wide for culling. */
+    C_STRUCT aiVector3D mConeApex;
+    C_STRUCT aiVector3D mConeAxis;
+    ai_real mConeCutoff;
+
+#ifdef __cplusplus
+
+    //! Default constructor. Initializes all members to 0
+    aiMeshlet() AI_NO_EXCEPT
+            : mVertexOffset(0),
+              mVertexCount(0),
+              mFaceOffset(0),
+              mFaceCount(0),
+              mCenter(),
+              mRadius(0),
+              mConeApex(),
+              mConeAxis(),
+              mConeCutoff(1) {
+        // empty
+    }
+
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
 *
@@ -695,6 +754,8 @@ struct aiMesh {
     * This array is always present in a mesh, its size is given
     * in mNumFaces. If the #AI_SCENE_FLAGS_NON_VERBOSE_FORMAT
     * is NOT set each face references an unique set of vertices.
+    * If the mesh has an index buffer, see #mIndexBuffer, the index
+    * arrays of the faces point into it.
     */
     C_STRUCT aiFace *mFaces;
 
@@ -753,6 +814,54 @@ struct aiMesh {
      */
     C_STRUCT aiString **mTextureCoordsNames;
 
+    /** Optional flat index buffer holding the indices of all faces,
+    * face after face. nullptr if not present, mNumIndices in size.
+    * If present, the aiFace::mIndices arrays of #mFaces are not
+    * allocated separately but point into this buffer, the mesh
+    * owns it. Such face index arrays must not be freed or replaced,
+    * and the number of indices of a face must not change.
+    * Use #mFaceStride or #mFaceOffsets to walk the faces without
+    * touching #mFaces.
+    */
+    unsigned int *mIndexBuffer;
+
+    /** The number of indices in #mIndexBuffer. */
+    unsigned int mNumIndices;
+
+    /** Start of each face in #mIndexBuffer, mNumFaces + 1 in size
+    * with the last entry being mNumIndices. nullptr if all faces
+    * have #mFaceStride indices.
+    */
+    unsigned int *mFaceOffsets;
+
+    /** Number of indices of every face if #mFaceOffsets is nullptr,
+    * usually 3. 0 if the faces differ in size.
+    */
+    unsigned int mFaceStride;
+
+    /** The number of meshlets in #mMeshlets. */
+    unsigned int mNumMeshlets;
+
+    /** Optional split of the faces into meshlets. nullptr if not
+    * present. The meshlets cover all faces, in order. They stay valid
+    * only as long as the faces and vertex positions are unchanged.
+    */
+    C_STRUCT aiMeshlet *mMeshlets;
+
+    /** The vertices of all meshlets, as indices into the vertex
+    * arrays of the mesh, mNumMeshletVertices in size.
+    */
+    unsigned int *mMeshletVertices;
+
+    /** The number of entries in #mMeshletVertices. */
+    unsigned int mNumMeshletVertices;
+
+    /** The faces as triangles of local meshlet vertex indices,
+    * mNumFaces * 3 in size. Entry i of a meshlet refers to
+    * mMeshletVertices[aiMeshlet::mVertexOffset + i].
+    */
+    unsigned char *mMeshletIndices;
+
 #ifdef __cplusplus
 
     //! Default constructor. Initializes all members to 0
@@ -775,7 +884,16 @@ struct aiMesh {
               mAnimMeshes(nullptr),
               mMethod(0),
               mAABB(),
-              mTextureCoordsNames(nullptr) {
+              mTextureCoordsNames(nullptr),
+              mIndexBuffer(nullptr),
+              mNumIndices(0),
+              mFaceOffsets(nullptr),
+              mFaceStride(0),
+              mNumMeshlets(0),
+              mMeshlets(nullptr),
+              mMeshletVertices(nullptr),
+              mNumMeshletVertices(0),
+              mMeshletIndices(nullptr) {
         for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
             mNumUVComponents[a] = 0;
             mTextureCoords[a] = nullptr;
@@ -824,7 +942,19 @@ struct aiMesh {
             delete[] mAnimMeshes;
         }
 
+        // face indices pointing into the index buffer are freed with it
+        if (mIndexBuffer && mFaces) {
+            for (unsigned int a = 0; a < mNumFaces; a++) {
+                mFaces[a].mIndices = nullptr;
+            }
+        }
         delete[] mFaces;
+        delete[] mIndexBuffer;
+        delete[] mFaceOffsets;
+
+        delete[] mMeshlets;
+        delete[] mMeshletVertices;
+        delete[] mMeshletIndices;
     }
 
     //! Check whether the mesh contains positions. Provided no special
@@ -835,6 +965,24 @@ struct aiMesh {
     //! are set this should always return true
     bool HasFaces() const { return mFaces != nullptr && mNumFaces > 0; }
 
+    //! Check whether the face indices are stored in a flat index buffer
+    bool HasIndexBuffer() const { return mIndexBuffer != nullptr; }
+
+    //! Start of a face in the index buffer
+    //! \param pIndex Index of the face
+    unsigned int GetFaceOffset(unsigned int pIndex) const {
+        return mFaceOffsets ? mFaceOffsets[pIndex] : pIndex * mFaceStride;
+    }
+
+    //! Number of indices of a face in the index buffer
+    //! \param pIndex Index of the face
+    unsigned int GetFaceSize(unsigned int pIndex) const {
+        return mFaceOffsets ? mFaceOffsets[pIndex + 1] - mFaceOffsets[pIndex] : mFaceStride;
+    }
+
+    //! Check whether the faces are split into meshlets
+    bool HasMeshlets() const { return mMeshlets != nullptr && mNumMeshlets > 0; }
+
     //! Check whether the mesh contains normal vectors
     bool HasNormals() const { return mNormals != nullptr && mNumVertices > 0; }
 
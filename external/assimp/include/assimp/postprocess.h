@@ -279,14 +279,22 @@ enum aiPostProcessSteps
     /** <hr>Reorders triangles for better vertex cache locality.
      *
      * The step tries to improve the ACMR (average post-transform vertex cache
-     * miss ratio) for all meshes. The implementation runs in O(n) and is
-     * roughly based on the 'tipsify' algorithm (see <a href="
+     * miss ratio) for all meshes. The implementation runs in O(n): the
+     * triangles are sorted with Tom Forsyth's 'Linear-Speed Vertex Cache
+     * Optimisation', clusters of them are sorted to reduce overdraw as
+     * described in the 'tipsify' paper (<a href="
      * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf">this
-     * paper</a>).
+     * paper</a>), and the vertices are sorted in the order the triangles use
+     * them for better vertex fetch locality. Large meshes are split into
+     * parts which are optimized in parallel if #AI_CONFIG_PP_THREAD_COUNT
+     * allows it.
      *
      * If you intend to render huge models in hardware, this step might
-     * be of interest to you. The <tt>#AI_CONFIG_PP_ICL_PTCACHE_SIZE</tt>
-     * importer property can be used to fine-tune the cache optimization.
+     * be of interest to you. The <tt>#AI_CONFIG_PP_ICL_PTCACHE_SIZE</tt>,
+     * <tt>#AI_CONFIG_PP_ICL_LRU_SCORING</tt>,
+     * <tt>#AI_CONFIG_PP_ICL_OVERDRAW_THRESHOLD</tt> and
+     * <tt>#AI_CONFIG_PP_ICL_REORDER_VERTICES</tt> importer properties can be
+     * used to fine-tune the optimization.
      */
     aiProcess_ImproveCacheLocality = 0x800,
 
@@ -0,0 +1,17 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#ifndef EMPTYDEMO_BOUNDS_H
+#define EMPTYDEMO_BOUNDS_H
+
+#include <glm/glm.hpp>
+
+// axis aligned bounding box
+struct Bounds
+{
+    glm::vec3 min;
+    glm::vec3 max;
+};
+
+#endif //EMPTYDEMO_BOUNDS_H
@@ -38,212 +38,163 @@
 #include <filesystem>
 
 #include "Log/Log.h"
+#include "Culling.h"
+#include "LightGrid.h"
+#include "Mesh.h"
+#include "MeshLoader.h"
+#include "RenderQueue.h"
+#include "SceneLoader.h"
+#include "ThreadPool.h"
 
 
-struct Mesh
-{
-    bgfx::VertexBufferHandle vertexBuffer = BGFX_INVALID_HANDLE;
-    bgfx::IndexBufferHandle indexBuffer = BGFX_INVALID_HANDLE;
-    unsigned int material = 0; // index into materials vector
-
-    //bgfx::OcclusionQueryHandle occlusionQuery = BGFX_INVALID_HANDLE;
-
-    // bgfx vertex attributes
-    // initialized by Scene
-    struct PosNormalTangentTex0Vertex
-    {
-        float x, y, z;    // position
-        uint32_t color;   // color
-        float nx, ny, nz; // normal
-        float tx, ty, tz; // tangent
-        float u, v;       // UV coordinates
+bgfx::UniformHandle dUniform = BGFX_INVALID_HANDLE;
 
-        static void init()
+static const bgfx::EmbeddedShader kEmbeddedShaders[] =
         {
-            layout.begin()
-                    .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
-                    .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
-                    .add(bgfx::Attrib::Normal, 3, bgfx::AttribType::Float)
-                    .add(bgfx::Attrib::Tangent, 3, bgfx::AttribType::Float)
-                    .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
-                    .end();
-        }
-        static bgfx::VertexLayout layout;
-    };
-};
-
-bgfx::VertexLayout Mesh::PosNormalTangentTex0Vertex::layout;
-
-
-Mesh loadMesh(const aiMesh* mesh)
-{
-    Mesh::PosNormalTangentTex0Vertex::init();
-
-    if(mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE)
-        throw std::runtime_error("Mesh has incompatible primitive type");
-
-    if(mesh->mNumVertices > (std::numeric_limits<uint16_t>::max() + 1u))
-        throw std::runtime_error("Mesh has too many vertices (> uint16_t::max + 1)");
-
-    constexpr size_t coords = 0;
-    bool hasTexture = mesh->mNumUVComponents[coords] == 2 && mesh->mTextureCoords[coords] != nullptr;
-
-    // vertices
-
-    uint32_t stride = Mesh::PosNormalTangentTex0Vertex::layout.getStride();
-
-    const bgfx::Memory* vertexMem = bgfx::alloc(mesh->mNumVertices * stride);
-
-    for(unsigned int i = 0; i < mesh->mNumVertices; i++)
-    {
-        unsigned int offset = i * stride;
-        Mesh::PosNormalTangentTex0Vertex& vertex = *(Mesh::PosNormalTangentTex0Vertex*)(vertexMem->data + offset);
-
-        aiVector3D pos = mesh->mVertices[i];
-
-        vertex.x = pos.x / 500.0f;
-        vertex.y = pos.y / 500.0f;
-        vertex.z = pos.z / 500.0f;
-
-        std::cout << pos.x << ", " << pos.y << ", "<< pos.z << std::endl;
-
-        aiVector3D nrm = mesh->mNormals[i];
-        vertex.nx = nrm.x;
-        vertex.ny = nrm.y;
-        vertex.nz = nrm.z;
+                BGFX_EMBEDDED_SHADER(vs_basic),
+                BGFX_EMBEDDED_SHADER(fs_basic),
+                BGFX_EMBEDDED_SHADER_END()
+        };
 
-        aiVector3D tan = mesh->mTangents[i];
-        vertex.tx = tan.x;
-        vertex.ty = tan.y;
-        vertex.tz = tan.z;
+// buffer stages of the clustered light data, see LightGrid for the layout
+constexpr uint8_t kClusterRecordsStage = 0;
+constexpr uint8_t kClusterLightIndicesStage = 1;
 
-        if(hasTexture)
-        {
-            aiVector3D uv = mesh->mTextureCoords[coords][i];
-            vertex.u = uv.x;
-            vertex.v = uv.y;
-        }
-        // else
-        {
-            vertex.color = 0xFFFFFFFF;
-        }
+class Cluster  final : public big2::AppExtensionBase {
+public:
+    std::vector<PointLight> pointLights;
+    std::vector<SpotLight> spotLights;
+
+    // takes effect on the next frame
+    void SetLightGridConfig(const LightGridConfig& config) {
+        lightGrid_.setConfig(config);
+        gridWidth_ = gridHeight_ = 0;
     }
 
-    bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(vertexMem, Mesh::PosNormalTangentTex0Vertex::layout);
-
-    // indices (triangles)
-
-    const bgfx::Memory* iMem = bgfx::alloc(mesh->mNumFaces * 3 * sizeof(uint16_t));
-    uint16_t* indices = (uint16_t*)iMem->data;
-
-    for(unsigned int i = 0; i < mesh->mNumFaces; i++)
-    {
-        assert(mesh->mFaces[i].mNumIndices == 3);
-        indices[(3 * i) + 0] = (uint16_t)mesh->mFaces[i].mIndices[0];
-        indices[(3 * i) + 1] = (uint16_t)mesh->mFaces[i].mIndices[1];
-        indices[(3 * i) + 2] = (uint16_t)mesh->mFaces[i].mIndices[2];
+protected:
+    void OnFrameBegin() override {
+        AppExtensionBase::OnFrameBegin();
+        // grow the mesh list while the scene is still loading
+        sceneLoader_.uploadPending(sceneMeshes, kUploadBudgetPerFrame);
     }
 
-    bgfx::IndexBufferHandle ibh = bgfx::createIndexBuffer(iMem);
-
-    return { vbh, ibh, mesh->mMaterialIndex };
-}
-
-
-bool fileExists(const std::string& name) {
-    return std::filesystem::exists(name);
-}
-
-std::vector<Mesh> loadMeshFromFile(const char* file) {
-
-    std::vector<Mesh> meshes;
+    void UpdateLightGrid() {
+        const bgfx::Stats* stats = bgfx::getStats();
+        const uint16_t width = std::max<uint16_t>(stats->width, 1);
+        const uint16_t height = std::max<uint16_t>(stats->height, 1);
+
+        // froxel bounds only change with the projection
+        if(width != gridWidth_ || height != gridHeight_) {
+            const float aspect = float(width) / float(height);
+            proj_ = bgfx::getCaps()->homogeneousDepth
+                    ? glm::perspectiveLH_NO(glm::radians(fovY_), aspect, zNear_, zFar_)
+                    : glm::perspectiveLH_ZO(glm::radians(fovY_), aspect, zNear_, zFar_);
+            lightGrid_.build(proj_, zNear_, zFar_);
+            gridWidth_ = width;
+            gridHeight_ = height;
+        }
 
-    if( !fileExists(file)){
-        std::cout << "Error, " << file << " not exists!" <<std::endl;
-        return meshes;
-    }
+        lightGrid_.assign(view_, pointLights, spotLights);
 
-    Assimp::Importer importer;
-
-    // Settings for aiProcess_SortByPType
-    // only take triangles or higher (polygons are triangulated during import)
-    importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_LINE | aiPrimitiveType_POINT);
-    // Settings for aiProcess_SplitLargeMeshes
-    // Limit vertices to 65k (we use 16-bit indices)
-    importer.SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT, std::numeric_limits<uint16_t>::max());
-
-    unsigned int flags =
-            aiProcessPreset_TargetRealtime_Quality |                     // some optimizations and safety checks
-            aiProcess_OptimizeMeshes |                                   // minimize number of meshes
-            aiProcess_PreTransformVertices |                             // apply node matrices
-            aiProcess_FixInfacingNormals | aiProcess_TransformUVCoords | // apply UV transformations
-            //aiProcess_FlipWindingOrder   | // we cull clock-wise, keep the default CCW winding order
-            aiProcess_MakeLeftHanded | // we set GLM_FORCE_LEFT_HANDED and use left-handed bx matrix functions
-            aiProcess_FlipUVs;         // bimg loads textures with flipped Y (top left is 0,0)
-
-    const aiScene* scene = nullptr;
-    try
-    {
-        scene = importer.ReadFile(file, flags);
-    }
-    catch (const std::exception& e)
-    {
-        std::cout << e.what() << std::endl;
+        const std::vector<LightGrid::ClusterRecord>& records = lightGrid_.getRecords();
+        bgfx::update(clusterRecordsBuffer_, 0,
+                     bgfx::copy(records.data(), uint32_t(records.size() * sizeof(LightGrid::ClusterRecord))));
+        const std::vector<uint32_t>& indices = lightGrid_.getLightIndices();
+        if(!indices.empty()) {
+            bgfx::update(clusterLightIndicesBuffer_, 0,
+                         bgfx::copy(indices.data(), uint32_t(indices.size() * sizeof(uint32_t))));
+        }
     }
 
+    // one draw item and culler instance per meshlet, meshes without meshlets count as one cluster
+    void RebuildRenderQueue() {
+        renderQueue_.clear();
+        clusters_.clear();
+        // PreTransformVertices already applied the node matrices
+        const uint32_t identity = renderQueue_.addTransform(glm::identity<glm::mat4>());
+        for (const Mesh& mesh : sceneMeshes)
+        {
+            const size_t first = clusters_.size();
+            if (mesh.meshlets.empty())
+            {
+                Meshlet whole;
+                whole.bounds = mesh.bounds;
+                clusters_.push_back(whole);
+            }
+            else
+            {
+                clusters_.insert(clusters_.end(), mesh.meshlets.begin(), mesh.meshlets.end());
+            }
+            // the back faces of two-sided materials are visible, neither the cone test
+            // nor the rasterizer may cull them
+            if (mesh.twoSided)
+            {
+                for (size_t i = first; i < clusters_.size(); i++)
+                    clusters_[i].coneCutoff = 1.0f;
+            }
+
+            RenderQueue::DrawItem item;
+            item.program = program_;
+            item.material = mesh.material;
+            item.state = mesh.twoSided ? 0 : BGFX_STATE_CULL_CW;
+            item.vertexBuffer = mesh.vertexBuffer;
+            item.indexBuffer = mesh.indexBuffer;
+            // compact vertices are dequantized by their model matrix
+            item.transform = mesh.compact ? renderQueue_.addTransform(mesh.dequantization()) : identity;
+            for (size_t i = first; i < clusters_.size(); i++)
+            {
+                item.firstIndex = clusters_[i].firstIndex;
+                item.indexCount = clusters_[i].indexCount;
+                item.id = uint32_t(i);
+                renderQueue_.add(item);
+            }
+        }
+        queuedMeshes_ = sceneMeshes.size();
 
-
-    if (!scene) { return meshes; }
-
-    for (unsigned int i = 0; i < scene->mNumMeshes; i++)
-    {
-        meshes.push_back(loadMesh(scene->mMeshes[i]));
+        std::vector<Bounds> bounds;
+        bounds.reserve(clusters_.size());
+        for (const Meshlet& cluster : clusters_)
+            bounds.push_back(cluster.bounds);
+        culler_.build(bounds);
     }
 
-    return meshes;
-}
-
-bgfx::UniformHandle dUniform = BGFX_INVALID_HANDLE;
-
-void demoSetUniform(const glm::mat4& modelMat)
-{
-    glm::mat3 normalMat = glm::transpose(glm::adjugate(glm::mat3(modelMat)));
-    bgfx::setUniform(dUniform, glm::value_ptr(normalMat));
-}
-
-static const bgfx::EmbeddedShader kEmbeddedShaders[] =
+    void CullClusters() {
+        culler_.cull(proj_ * view_, bgfx::getCaps()->homogeneousDepth, visibleClusters_);
+        // the scene is in world space, see RebuildRenderQueue
+        const glm::vec3 camera = glm::vec3(glm::inverse(view_)[3]);
+        clusterVisibility_.assign(clusters_.size(), 0);
+        backfacingClusters_ = 0;
+        for (uint32_t index : visibleClusters_)
         {
-                BGFX_EMBEDDED_SHADER(vs_basic),
-                BGFX_EMBEDDED_SHADER(fs_basic),
-                BGFX_EMBEDDED_SHADER_END()
-        };
-
-class Cluster  final : public big2::AppExtensionBase {
-protected:
-    void OnFrameBegin() override {
-        AppExtensionBase::OnFrameBegin();
+            if (clusters_[index].facesAway(camera))
+                backfacingClusters_++;
+            else
+                clusterVisibility_[index] = 1;
+        }
     }
+
     void OnRender(big2::Window &window) override {
         AppExtensionBase::OnRender(window);
-        bgfx::setState(
-                BGFX_STATE_WRITE_R
-                | BGFX_STATE_WRITE_G
-                | BGFX_STATE_WRITE_B
-                | BGFX_STATE_WRITE_A
-        );
 
-        for (const Mesh& mesh : sceneMeshes)
-        {
-            glm::mat4 model = glm::identity<glm::mat4>();
-            bgfx::setTransform(glm::value_ptr(model));
-            demoSetUniform(model);
-            bgfx::setVertexBuffer(0, mesh.vertexBuffer);
-            bgfx::setIndexBuffer(mesh.indexBuffer);
-            //const Material& mat = scene->materials[mesh.material];
-            //uint64_t materialState = pbr.bindMaterial(mat);
-            //bgfx::setState(state | materialState);
-            bgfx::submit(window.GetView(), program_, 0, ~BGFX_DISCARD_BINDINGS);
-        }
+        UpdateLightGrid();
+
+        // the queue is retained, it only changes while meshes are still streaming in
+        if(queuedMeshes_ != sceneMeshes.size())
+            RebuildRenderQueue();
+        CullClusters();
+
+        bgfx::setViewTransform(window.GetView(), glm::value_ptr(view_), glm::value_ptr(proj_));
+
+        bgfx::setBuffer(kClusterRecordsStage, clusterRecordsBuffer_, bgfx::Access::Read);
+        bgfx::setBuffer(kClusterLightIndicesStage, clusterLightIndicesBuffer_, bgfx::Access::Read);
+        // clusters facing away were skipped in CullClusters, the rasterizer culls the remaining
+        // back faces of one-sided materials (DrawItem::state)
+        renderQueue_.submit(window.GetView(),
+                            BGFX_STATE_WRITE_R
+                            | BGFX_STATE_WRITE_G
+                            | BGFX_STATE_WRITE_B
+                            | BGFX_STATE_WRITE_A,
+                            &clusterVisibility_);
 
         bgfx::discard(BGFX_DISCARD_ALL);
 
@@ -251,6 +202,15 @@ protected:
 #if BIG2_IMGUI_ENABLED
         BIG2_SCOPE_VAR(big2::ImGuiFrameScoped) {
         ImGui::ShowDemoWindow();
+
+        const FrustumCuller::Stats& cullStats = culler_.getStats();
+        ImGui::Begin("Culling");
+        ImGui::Text("clusters: %u", cullStats.instances);
+        ImGui::Text("tested: %u (%u nodes)", cullStats.tested, cullStats.nodesVisited);
+        ImGui::Text("culled: %u", cullStats.culled);
+        ImGui::Text("backfacing: %u", backfacingClusters_);
+        ImGui::Text("draw calls: %u", renderQueue_.getStats().draws);
+        ImGui::End();
       }
 #endif // BIG2_IMGUI_ENABLED
     }
@@ -267,13 +227,20 @@ protected:
                 true
         );
 
-        sceneMeshes = loadMeshFromFile("E:\\DigitalAssetsCreateTool\\learn-bgfx\\assets\\models\\cube-1mx1m.fbx");
+        sceneLoader_.load("E:\\DigitalAssetsCreateTool\\learn-bgfx\\assets\\models\\cube-1mx1m.fbx");
 
         dUniform = bgfx::createUniform("normMat", bgfx::UniformType::Mat3 );
+        renderQueue_.setNormalMatrixUniform(dUniform);
+
+        // index buffers are the only bgfx buffers with a plain uint32 element type
+        constexpr uint16_t kLightBufferFlags = BGFX_BUFFER_INDEX32 | BGFX_BUFFER_COMPUTE_READ | BGFX_BUFFER_ALLOW_RESIZE;
+        clusterRecordsBuffer_ = bgfx::createDynamicIndexBuffer(lightGrid_.clusterCount() * 4, kLightBufferFlags);
+        clusterLightIndicesBuffer_ = bgfx::createDynamicIndexBuffer(1, kLightBufferFlags);
     }
 
     void OnTerminate() override {
         AppExtensionBase::OnTerminate();
+        sceneLoader_.cancel();
         program_.Destroy();
 
         for (Mesh& mesh : sceneMeshes)
@@ -284,13 +251,44 @@ protected:
             mesh.indexBuffer = BGFX_INVALID_HANDLE;
         }
         sceneMeshes.clear();
+        renderQueue_.clear();
+        clusters_.clear();
+        queuedMeshes_ = 0;
         bgfx::destroy(dUniform);
+        bgfx::destroy(clusterRecordsBuffer_);
+        bgfx::destroy(clusterLightIndicesBuffer_);
     }
 
 private:
     big2::ProgramScopedHandle program_;
 
+    ThreadPool pool_;
+    MeshLoaderConfig meshLoaderConfig_;
+    SceneLoader sceneLoader_ { pool_, meshLoaderConfig_ };
+    // bytes of vertex and index data handed to bgfx per frame while loading
+    static constexpr size_t kUploadBudgetPerFrame = 8 * 1024 * 1024;
+
+    LightGrid lightGrid_ { pool_ };
+    bgfx::DynamicIndexBufferHandle clusterRecordsBuffer_ = BGFX_INVALID_HANDLE;
+    bgfx::DynamicIndexBufferHandle clusterLightIndicesBuffer_ = BGFX_INVALID_HANDLE;
+    uint16_t gridWidth_ = 0;
+    uint16_t gridHeight_ = 0;
+
+    glm::mat4 view_ = glm::identity<glm::mat4>();
+    glm::mat4 proj_ = glm::identity<glm::mat4>();
+    float fovY_ = 60.0f;
+    float zNear_ = 0.1f;
+    float zFar_ = 1000.0f;
+
     std::vector<Mesh> sceneMeshes;
+    RenderQueue renderQueue_;
+
+    std::vector<Meshlet> clusters_; // by DrawItem::id
+    size_t queuedMeshes_ = 0;
+    FrustumCuller culler_ { pool_ };
+    std::vector<uint32_t> visibleClusters_;
+    std::vector<uint8_t> clusterVisibility_;
+    uint32_t backfacingClusters_ = 0;
 };
 
 
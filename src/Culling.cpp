@@ -0,0 +1,252 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#include "Culling.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLUSTER_CULLING_SSE 1
+#include <xmmintrin.h>
+#endif
+
+void FrustumCuller::build(const std::vector<Bounds>& instanceBounds)
+{
+    instanceCount = instanceBounds.size();
+    nodes.clear();
+    leafBoxes.clear();
+    order.resize(instanceCount);
+    if(instanceCount == 0)
+        return;
+
+    std::vector<glm::vec3> centers(instanceCount);
+    for(uint32_t i = 0; i < instanceCount; i++)
+    {
+        order[i] = i;
+        centers[i] = (instanceBounds[i].min + instanceBounds[i].max) * 0.5f;
+    }
+
+    nodes.reserve(2 * (instanceCount / kLeafSize + 1));
+    nodes.emplace_back();
+    buildNode(0, 0, uint32_t(instanceCount), instanceBounds, centers);
+}
+
+void FrustumCuller::buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count,
+                              const std::vector<Bounds>& instanceBounds, const std::vector<glm::vec3>& centers)
+{
+    Bounds bounds { glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest()) };
+    Bounds centerBounds = bounds;
+    for(uint32_t i = first; i < first + count; i++)
+    {
+        const Bounds& b = instanceBounds[order[i]];
+        bounds.min = glm::min(bounds.min, b.min);
+        bounds.max = glm::max(bounds.max, b.max);
+        centerBounds.min = glm::min(centerBounds.min, centers[order[i]]);
+        centerBounds.max = glm::max(centerBounds.max, centers[order[i]]);
+    }
+
+    Node node;
+    node.bounds = bounds;
+    node.instanceFirst = first;
+    node.instanceCount = count;
+    node.left = 0;
+    node.leaf = 0;
+    node.isLeaf = count <= kLeafSize;
+
+    if(node.isLeaf)
+    {
+        LeafBoxes boxes {};
+        for(uint32_t lane = 0; lane < count; lane++)
+        {
+            const Bounds& b = instanceBounds[order[first + lane]];
+            boxes.minX[lane] = b.min.x;
+            boxes.minY[lane] = b.min.y;
+            boxes.minZ[lane] = b.min.z;
+            boxes.maxX[lane] = b.max.x;
+            boxes.maxY[lane] = b.max.y;
+            boxes.maxZ[lane] = b.max.z;
+        }
+        node.leaf = uint32_t(leafBoxes.size());
+        leafBoxes.push_back(boxes);
+        nodes[nodeIndex] = node;
+        return;
+    }
+
+    // median split along the longest axis of the centers
+    const glm::vec3 extent = centerBounds.max - centerBounds.min;
+    const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    const uint32_t half = count / 2;
+    std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                     [&](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+
+    node.left = uint32_t(nodes.size());
+    nodes[nodeIndex] = node;
+    nodes.emplace_back();
+    nodes.emplace_back();
+    buildNode(node.left, first, half, instanceBounds, centers);
+    buildNode(node.left + 1, first + half, count - half, instanceBounds, centers);
+}
+
+FrustumCuller::Containment FrustumCuller::classify(const Bounds& bounds) const
+{
+    Containment result = Containment::Inside;
+    for(const glm::vec4& plane : planes)
+    {
+        // corner furthest along the plane normal, and the one opposite to it
+        const glm::vec3 p(plane.x > 0.0f ? bounds.max.x : bounds.min.x,
+                          plane.y > 0.0f ? bounds.max.y : bounds.min.y,
+                          plane.z > 0.0f ? bounds.max.z : bounds.min.z);
+        const glm::vec3 n(plane.x > 0.0f ? bounds.min.x : bounds.max.x,
+                          plane.y > 0.0f ? bounds.min.y : bounds.max.y,
+                          plane.z > 0.0f ? bounds.min.z : bounds.max.z);
+        if(glm::dot(glm::vec3(plane), p) + plane.w < 0.0f)
+            return Containment::Outside;
+        if(glm::dot(glm::vec3(plane), n) + plane.w < 0.0f)
+            result = Containment::Intersecting;
+    }
+    return result;
+}
+
+void FrustumCuller::acceptSubtree(const Node& node, TaskResult& result) const
+{
+    result.visible.insert(result.visible.end(),
+                          order.begin() + node.instanceFirst,
+                          order.begin() + node.instanceFirst + node.instanceCount);
+}
+
+void FrustumCuller::testLeaf(const Node& node, TaskResult& result) const
+{
+    const LeafBoxes& boxes = leafBoxes[node.leaf];
+    unsigned int outside = 0; // bit per lane
+
+#if CLUSTER_CULLING_SSE
+    __m128 outsideMask = _mm_setzero_ps();
+    for(const glm::vec4& plane : planes)
+    {
+        const __m128 px = _mm_load_ps(plane.x > 0.0f ? boxes.maxX : boxes.minX);
+        const __m128 py = _mm_load_ps(plane.y > 0.0f ? boxes.maxY : boxes.minY);
+        const __m128 pz = _mm_load_ps(plane.z > 0.0f ? boxes.maxZ : boxes.minZ);
+        __m128 d = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+        d = _mm_add_ps(d, _mm_mul_ps(py, _mm_set1_ps(plane.y)));
+        d = _mm_add_ps(d, _mm_mul_ps(pz, _mm_set1_ps(plane.z)));
+        outsideMask = _mm_or_ps(outsideMask, _mm_cmplt_ps(d, _mm_setzero_ps()));
+    }
+    outside = unsigned(_mm_movemask_ps(outsideMask));
+#else
+    for(const glm::vec4& plane : planes)
+    {
+        const float* px = plane.x > 0.0f ? boxes.maxX : boxes.minX;
+        const float* py = plane.y > 0.0f ? boxes.maxY : boxes.minY;
+        const float* pz = plane.z > 0.0f ? boxes.maxZ : boxes.minZ;
+        for(uint32_t lane = 0; lane < kLeafSize; lane++)
+        {
+            float d = px[lane] * plane.x + py[lane] * plane.y + pz[lane] * plane.z + plane.w;
+            outside |= (d < 0.0f ? 1u : 0u) << lane;
+        }
+    }
+#endif
+
+    result.stats.tested += node.instanceCount;
+    for(uint32_t lane = 0; lane < node.instanceCount; lane++)
+    {
+        if(!(outside & (1u << lane)))
+            result.visible.push_back(order[node.instanceFirst + lane]);
+    }
+}
+
+void FrustumCuller::traverse(uint32_t nodeIndex, TaskResult& result) const
+{
+    const Node& node = nodes[nodeIndex];
+    result.stats.nodesVisited++;
+
+    switch(classify(node.bounds))
+    {
+        case Containment::Outside:
+            return;
+        case Containment::Inside:
+            acceptSubtree(node, result);
+            return;
+        case Containment::Intersecting:
+            break;
+    }
+
+    if(node.isLeaf)
+    {
+        testLeaf(node, result);
+    }
+    else
+    {
+        traverse(node.left, result);
+        traverse(node.left + 1, result);
+    }
+}
+
+void FrustumCuller::cull(const glm::mat4& viewProj, bool homogeneousDepth, std::vector<uint32_t>& visible)
+{
+    visible.clear();
+    stats = {};
+    stats.instances = uint32_t(instanceCount);
+    if(instanceCount == 0)
+        return;
+
+    // planes from the rows of the clip matrix (Gribb/Hartmann), normals point inwards
+    auto row = [&](int i) { return glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]); };
+    const glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+    planes[0] = r3 + r0; // left
+    planes[1] = r3 - r0; // right
+    planes[2] = r3 + r1; // bottom
+    planes[3] = r3 - r1; // top
+    planes[4] = homogeneousDepth ? r3 + r2 : r2; // near
+    planes[5] = r3 - r2; // far
+    for(glm::vec4& plane : planes)
+        plane /= glm::length(glm::vec3(plane));
+
+    // split the top of the tree into enough subtrees to keep every worker busy,
+    // replacing nodes by their children in place keeps the output order stable
+    const size_t targetTasks = size_t(pool.workerCount() + 1) * 4;
+    tasks.assign(1, 0);
+    bool expanded = true;
+    while(tasks.size() < targetTasks && expanded)
+    {
+        expanded = false;
+        std::vector<uint32_t> next;
+        next.reserve(tasks.size() * 2);
+        for(uint32_t task : tasks)
+        {
+            const Node& node = nodes[task];
+            if(node.isLeaf)
+            {
+                next.push_back(task);
+            }
+            else
+            {
+                next.push_back(node.left);
+                next.push_back(node.left + 1);
+                expanded = true;
+            }
+        }
+        tasks.swap(next);
+    }
+
+    results.resize(tasks.size());
+    pool.parallelFor(tasks.size(), 1, [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            results[i].visible.clear();
+            results[i].stats = {};
+            traverse(tasks[i], results[i]);
+        }
+    });
+
+    for(const TaskResult& result : results)
+    {
+        visible.insert(visible.end(), result.visible.begin(), result.visible.end());
+        stats.tested += result.stats.tested;
+        stats.nodesVisited += result.stats.nodesVisited;
+    }
+    stats.visible = uint32_t(visible.size());
+    stats.culled = stats.instances - stats.visible;
+}
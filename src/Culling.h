@@ -0,0 +1,92 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#ifndef EMPTYDEMO_CULLING_H
+#define EMPTYDEMO_CULLING_H
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Bounds.h"
+#include "ThreadPool.h"
+
+// View frustum culling of mesh instances against a BVH.
+// Nodes that are completely inside or outside the frustum accept or reject
+// their whole subtree, leaves test up to four instance boxes at once (SSE where available).
+// Subtrees below the top levels are traversed in parallel on the worker pool.
+class FrustumCuller
+{
+public:
+    struct Stats
+    {
+        uint32_t instances = 0; // total instances in the BVH
+        uint32_t tested = 0;    // instance boxes tested against the frustum
+        uint32_t culled = 0;    // instances rejected, individually or with their node
+        uint32_t visible = 0;
+        uint32_t nodesVisited = 0;
+    };
+
+    explicit FrustumCuller(ThreadPool& pool) : pool(pool) { }
+
+    // world space bounds per instance, the instance index is what cull() reports
+    void build(const std::vector<Bounds>& instanceBounds);
+
+    // fills visible with the indices of instances intersecting the frustum of viewProj,
+    // the order only depends on the BVH, not on thread timing
+    // homogeneousDepth selects [-1,1] instead of [0,1] clip space depth (bgfx::Caps::homogeneousDepth)
+    void cull(const glm::mat4& viewProj, bool homogeneousDepth, std::vector<uint32_t>& visible);
+
+    const Stats& getStats() const { return stats; }
+    size_t size() const { return instanceCount; }
+
+private:
+    static constexpr uint32_t kLeafSize = 4;
+
+    struct Node
+    {
+        Bounds bounds;
+        uint32_t left;          // inner node: children at left and left + 1
+        uint32_t leaf;          // leaf node: index into leafBoxes
+        uint32_t instanceFirst; // range in order[] covered by the subtree
+        uint32_t instanceCount;
+        bool isLeaf;
+    };
+
+    // up to four boxes in SoA layout, lanes past the node instance count are ignored
+    struct alignas(16) LeafBoxes
+    {
+        float minX[kLeafSize], minY[kLeafSize], minZ[kLeafSize];
+        float maxX[kLeafSize], maxY[kLeafSize], maxZ[kLeafSize];
+    };
+
+    struct TaskResult
+    {
+        std::vector<uint32_t> visible;
+        Stats stats;
+    };
+
+    enum class Containment { Outside, Intersecting, Inside };
+
+    void buildNode(uint32_t node, uint32_t first, uint32_t count,
+                   const std::vector<Bounds>& instanceBounds, const std::vector<glm::vec3>& centers);
+    Containment classify(const Bounds& bounds) const;
+    void traverse(uint32_t node, TaskResult& result) const;
+    void testLeaf(const Node& node, TaskResult& result) const;
+    void acceptSubtree(const Node& node, TaskResult& result) const;
+
+    ThreadPool& pool;
+    size_t instanceCount = 0;
+    std::vector<Node> nodes;
+    std::vector<LeafBoxes> leafBoxes;
+    std::vector<uint32_t> order; // instance indices in BVH order
+
+    glm::vec4 planes[6];
+    std::vector<uint32_t> tasks; // subtree roots traversed in parallel
+    std::vector<TaskResult> results;
+    Stats stats;
+};
+
+#endif //EMPTYDEMO_CULLING_H
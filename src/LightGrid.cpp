@@ -0,0 +1,284 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#include "LightGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <glm/gtc/constants.hpp>
+
+namespace
+{
+
+bool sphereIntersectsBounds(const glm::vec3& center, float radius, const LightGrid::Bounds& b)
+{
+    glm::vec3 closest = glm::clamp(center, b.min, b.max);
+    glm::vec3 d = closest - center;
+    return glm::dot(d, d) <= radius * radius;
+}
+
+} // namespace
+
+void LightGrid::setConfig(const LightGridConfig& newConfig)
+{
+    config = newConfig;
+    config.gridX = std::max(config.gridX, 1u);
+    config.gridY = std::max(config.gridY, 1u);
+    config.gridZ = std::max(config.gridZ, 1u);
+    bounds.clear();
+}
+
+uint32_t LightGrid::depthSlice(float depth) const
+{
+    if(depth <= zNear)
+        return 0;
+    float slice = std::floor(std::log(depth / zNear) * depthScale);
+    return (uint32_t)std::min(slice, float(config.gridZ - 1));
+}
+
+void LightGrid::build(const glm::mat4& proj, float nearPlane, float farPlane)
+{
+    zNear = nearPlane;
+    zFar = farPlane;
+    depthScale = float(config.gridZ) / std::log(zFar / zNear);
+
+    const glm::mat4 invProj = glm::inverse(proj);
+
+    // direction of the view ray through an NDC xy position, scaled to unit depth
+    // unprojecting on the far plane works for both [0,1] and [-1,1] clip depth
+    auto ray = [&](float x, float y)
+    {
+        glm::vec4 p = invProj * glm::vec4(x, y, 1.0f, 1.0f);
+        glm::vec3 r = glm::vec3(p) / p.w;
+        return r / std::abs(r.z);
+    };
+    depthSign = ray(0.0f, 0.0f).z < 0.0f ? -1.0f : 1.0f;
+
+    // corner rays are shared by neighbouring tiles
+    const uint32_t cornersX = config.gridX + 1;
+    const uint32_t cornersY = config.gridY + 1;
+    std::vector<glm::vec3> rays(cornersX * cornersY);
+    for(uint32_t y = 0; y < cornersY; y++)
+    {
+        for(uint32_t x = 0; x < cornersX; x++)
+        {
+            float ndcX = -1.0f + 2.0f * float(x) / float(config.gridX);
+            float ndcY = -1.0f + 2.0f * float(y) / float(config.gridY);
+            rays[x + y * cornersX] = ray(ndcX, ndcY);
+        }
+    }
+
+    bounds.resize(clusterCount());
+    for(uint32_t z = 0; z < config.gridZ; z++)
+    {
+        float sliceNear = zNear * std::pow(zFar / zNear, float(z) / float(config.gridZ));
+        float sliceFar = zNear * std::pow(zFar / zNear, float(z + 1) / float(config.gridZ));
+        for(uint32_t y = 0; y < config.gridY; y++)
+        {
+            for(uint32_t x = 0; x < config.gridX; x++)
+            {
+                const glm::vec3 corners[4] = {
+                    rays[x + y * cornersX],
+                    rays[(x + 1) + y * cornersX],
+                    rays[x + (y + 1) * cornersX],
+                    rays[(x + 1) + (y + 1) * cornersX]
+                };
+                Bounds b { glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest()) };
+                for(const glm::vec3& corner : corners)
+                {
+                    b.min = glm::min(b.min, glm::min(corner * sliceNear, corner * sliceFar));
+                    b.max = glm::max(b.max, glm::max(corner * sliceNear, corner * sliceFar));
+                }
+                bounds[clusterIndex(x, y, z)] = b;
+            }
+        }
+    }
+}
+
+void LightGrid::assign(const glm::mat4& view, const std::vector<PointLight>& pointLights, const std::vector<SpotLight>& spotLights)
+{
+    if(bounds.size() != clusterCount())
+        throw std::runtime_error("LightGrid::build must be called before assign");
+
+    const size_t pointCount = pointLights.size();
+    const size_t spotCount = spotLights.size();
+
+    // transform to view space, spot lights get a bounding sphere for the coarse test
+    spheres.resize(pointCount + spotCount);
+    cones.resize(spotCount);
+    pool.parallelFor(pointCount, 1024, [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            const PointLight& light = pointLights[i];
+            spheres[i] = { glm::vec3(view * glm::vec4(light.position, 1.0f)), light.radius, (uint32_t)i };
+        }
+    });
+    pool.parallelFor(spotCount, 1024, [&](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            const SpotLight& light = spotLights[i];
+            ViewCone& cone = cones[i];
+            cone.apex = glm::vec3(view * glm::vec4(light.position, 1.0f));
+            cone.direction = glm::normalize(glm::vec3(view * glm::vec4(light.direction, 0.0f)));
+            cone.range = light.radius;
+            cone.cosAngle = std::cos(light.outerAngle);
+            cone.sinAngle = std::sin(light.outerAngle);
+
+            // smallest sphere around the cone
+            ViewSphere& sphere = spheres[pointCount + i];
+            sphere.index = (uint32_t)i;
+            if(light.outerAngle > glm::quarter_pi<float>())
+            {
+                sphere.center = cone.apex + cone.direction * (cone.cosAngle * cone.range);
+                sphere.radius = cone.sinAngle * cone.range;
+            }
+            else
+            {
+                sphere.radius = cone.range / (2.0f * cone.cosAngle);
+                sphere.center = cone.apex + cone.direction * sphere.radius;
+            }
+        }
+    });
+
+    // bucket lights by the depth slices they overlap
+    // spheres are visited in order so every bucket lists point lights before spot lights
+    sliceLights.resize(config.gridZ);
+    for(std::vector<uint32_t>& slice : sliceLights)
+        slice.clear();
+    for(uint32_t i = 0; i < (uint32_t)spheres.size(); i++)
+    {
+        const ViewSphere& sphere = spheres[i];
+        float depth = sphere.center.z * depthSign;
+        if(depth + sphere.radius < zNear || depth - sphere.radius > zFar)
+            continue;
+        uint32_t first = depthSlice(depth - sphere.radius);
+        uint32_t last = depthSlice(depth + sphere.radius);
+        for(uint32_t z = first; z <= last; z++)
+            sliceLights[z].push_back(i);
+    }
+
+    records.resize(clusterCount());
+    clusterLights.resize(clusterCount());
+    sliceIndices.resize(config.gridZ);
+    pool.parallelFor(config.gridZ, 1, [&](size_t begin, size_t end)
+    {
+        for(size_t z = begin; z < end; z++)
+            assignSlice((uint32_t)z, sliceIndices[z]);
+    });
+
+    // concatenate the slices in order, so the output doesn't depend on thread timing
+    size_t total = 0;
+    for(const std::vector<uint32_t>& slice : sliceIndices)
+        total += slice.size();
+    lightIndices.resize(total);
+
+    const uint32_t clustersPerSlice = config.gridX * config.gridY;
+    uint32_t base = 0;
+    for(uint32_t z = 0; z < config.gridZ; z++)
+    {
+        const std::vector<uint32_t>& slice = sliceIndices[z];
+        std::copy(slice.begin(), slice.end(), lightIndices.begin() + base);
+        for(uint32_t c = z * clustersPerSlice; c < (z + 1) * clustersPerSlice; c++)
+            records[c].offset += base;
+        base += (uint32_t)slice.size();
+    }
+}
+
+void LightGrid::assignSlice(uint32_t z, std::vector<uint32_t>& out)
+{
+    const uint32_t pointCount = (uint32_t)(spheres.size() - cones.size());
+    const uint32_t first = clusterIndex(0, 0, z);
+    const uint32_t last = clusterIndex(0, 0, z + 1);
+
+    for(uint32_t cluster = first; cluster < last; cluster++)
+        clusterLights[cluster].clear();
+
+    // x extent of a froxel only depends on its column and y extent on its row,
+    // so every light only needs exact tests against the rectangle of tiles its sphere overlaps
+    auto overlap = [](float lo, float hi, float boundsMin, float boundsMax)
+    {
+        return boundsMax >= lo && boundsMin <= hi;
+    };
+
+    for(uint32_t candidate : sliceLights[z])
+    {
+        const ViewSphere& sphere = spheres[candidate];
+
+        uint32_t x0 = config.gridX, x1 = 0;
+        for(uint32_t x = 0; x < config.gridX; x++)
+        {
+            const Bounds& b = bounds[clusterIndex(x, 0, z)];
+            if(overlap(sphere.center.x - sphere.radius, sphere.center.x + sphere.radius, b.min.x, b.max.x))
+            {
+                x0 = std::min(x0, x);
+                x1 = x;
+            }
+        }
+        uint32_t y0 = config.gridY, y1 = 0;
+        for(uint32_t y = 0; y < config.gridY; y++)
+        {
+            const Bounds& b = bounds[clusterIndex(0, y, z)];
+            if(overlap(sphere.center.y - sphere.radius, sphere.center.y + sphere.radius, b.min.y, b.max.y))
+            {
+                y0 = std::min(y0, y);
+                y1 = y;
+            }
+        }
+
+        for(uint32_t y = y0; y <= y1 && y0 < config.gridY; y++)
+        {
+            for(uint32_t x = x0; x <= x1 && x0 < config.gridX; x++)
+            {
+                const uint32_t cluster = clusterIndex(x, y, z);
+                const Bounds& b = bounds[cluster];
+                std::vector<uint32_t>& lights = clusterLights[cluster];
+
+                if(lights.size() >= config.maxLightsPerCluster)
+                    continue;
+                if(!sphereIntersectsBounds(sphere.center, sphere.radius, b))
+                    continue;
+
+                if(candidate >= pointCount)
+                {
+                    // cone against the bounding sphere of the cluster
+                    const ViewCone& cone = cones[sphere.index];
+                    const glm::vec3 center = (b.min + b.max) * 0.5f;
+                    const float radius = glm::length(b.max - center);
+                    glm::vec3 v = center - cone.apex;
+                    float lenSq = glm::dot(v, v);
+                    float v1Len = glm::dot(v, cone.direction);
+                    float distClosest = cone.cosAngle * std::sqrt(std::max(lenSq - v1Len * v1Len, 0.0f)) - v1Len * cone.sinAngle;
+                    bool angleCull = distClosest > radius;
+                    bool frontCull = v1Len > radius + cone.range;
+                    bool backCull = v1Len < -radius;
+                    if(angleCull || frontCull || backCull)
+                        continue;
+                }
+                lights.push_back(candidate);
+            }
+        }
+    }
+
+    // flatten, offsets are relative to the start of this slice until assign() rebases them
+    out.clear();
+    for(uint32_t cluster = first; cluster < last; cluster++)
+    {
+        const std::vector<uint32_t>& lights = clusterLights[cluster];
+        ClusterRecord& record = records[cluster];
+        record = { (uint32_t)out.size(), 0, 0, 0 };
+        for(uint32_t candidate : lights)
+        {
+            if(candidate < pointCount)
+                record.pointCount++;
+            else
+                record.spotCount++;
+            out.push_back(spheres[candidate].index);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#ifndef EMPTYDEMO_LIGHTGRID_H
+#define EMPTYDEMO_LIGHTGRID_H
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ThreadPool.h"
+
+// Lights are given in world space, the grid works in view space.
+struct PointLight
+{
+    glm::vec3 position;
+    float radius;
+    glm::vec3 color;
+    float intensity;
+};
+
+struct SpotLight
+{
+    glm::vec3 position;
+    float radius;
+    glm::vec3 direction; // normalized
+    float outerAngle;    // half angle in radians
+    glm::vec3 color;
+    float intensity;
+};
+
+struct LightGridConfig
+{
+    // number of froxels along screen x, screen y and view depth
+    uint32_t gridX = 16;
+    uint32_t gridY = 8;
+    uint32_t gridZ = 24;
+    // per-cluster cap, keeps the index list bounded with pathological light setups
+    uint32_t maxLightsPerCluster = 256;
+};
+
+// Froxel (view-frustum cluster) grid with CPU light assignment.
+// Depth slices are exponential between the near and far plane of the projection
+// passed to build(). The result is a compact light index list plus one record per
+// cluster that points into it, laid out so it can be uploaded 1:1 as uvec4/uint buffers:
+//   cluster = x + y * gridX + z * gridX * gridY
+//   indices[offset .. offset + pointCount)                       -> point light indices
+//   indices[offset + pointCount .. offset + pointCount + spotCount) -> spot light indices
+// Nothing in here touches bgfx, so it runs without a GPU (e.g. under the Noop renderer).
+class LightGrid
+{
+public:
+    struct ClusterRecord
+    {
+        uint32_t offset;
+        uint32_t pointCount;
+        uint32_t spotCount;
+        uint32_t padding;
+    };
+
+    struct Bounds
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    explicit LightGrid(ThreadPool& pool) : pool(pool) { }
+
+    void setConfig(const LightGridConfig& config);
+    const LightGridConfig& getConfig() const { return config; }
+
+    // recomputes the froxel bounds, only needed when the projection or the grid dimensions change
+    // nearPlane/farPlane must match the ones baked into proj
+    void build(const glm::mat4& proj, float nearPlane, float farPlane);
+
+    // assigns lights to clusters, view transforms world space light positions to view space
+    void assign(const glm::mat4& view, const std::vector<PointLight>& pointLights, const std::vector<SpotLight>& spotLights);
+
+    uint32_t clusterCount() const { return config.gridX * config.gridY * config.gridZ; }
+    uint32_t clusterIndex(uint32_t x, uint32_t y, uint32_t z) const { return x + y * config.gridX + z * config.gridX * config.gridY; }
+    // depth slice for a positive view-space depth, clamped to the grid
+    uint32_t depthSlice(float depth) const;
+
+    const std::vector<Bounds>& getBounds() const { return bounds; }
+    const std::vector<ClusterRecord>& getRecords() const { return records; }
+    const std::vector<uint32_t>& getLightIndices() const { return lightIndices; }
+
+private:
+    struct ViewSphere
+    {
+        glm::vec3 center;
+        float radius;
+        uint32_t index;
+    };
+
+    struct ViewCone
+    {
+        glm::vec3 apex;
+        float range;
+        glm::vec3 direction;
+        float cosAngle;
+        float sinAngle;
+    };
+
+    void assignSlice(uint32_t z, std::vector<uint32_t>& out);
+
+    ThreadPool& pool;
+    LightGridConfig config;
+    float zNear = 0.1f;
+    float zFar = 1000.0f;
+    float depthScale = 0.0f; // gridZ / log(zFar / zNear)
+    float depthSign = 1.0f;  // +1 for left-handed view space, -1 for right-handed
+
+    std::vector<Bounds> bounds;
+    std::vector<ClusterRecord> records;
+    std::vector<uint32_t> lightIndices;
+
+    // per-frame scratch
+    std::vector<ViewSphere> spheres;    // point lights followed by spot light bounding spheres
+    std::vector<ViewCone> cones;        // indexed like the spot light entries in spheres
+    std::vector<std::vector<uint32_t>> sliceLights;   // sphere indices overlapping each depth slice
+    std::vector<std::vector<uint32_t>> clusterLights; // sphere indices per cluster
+    std::vector<std::vector<uint32_t>> sliceIndices;  // assignment output per depth slice
+};
+
+#endif //EMPTYDEMO_LIGHTGRID_H
@@ -0,0 +1,109 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#ifndef EMPTYDEMO_MESH_H
+#define EMPTYDEMO_MESH_H
+
+#include <bgfx/bgfx.h>
+#include <cstdint>
+#include <vector>
+
+#include "Bounds.h"
+
+// cluster of triangles drawn as one range of the mesh index buffer, see aiMesh::mMeshlets
+struct Meshlet
+{
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    Bounds bounds {};        // box around the bounding sphere, for the frustum culler
+    glm::vec3 center {};     // bounding sphere, object space, scaled like the vertices
+    float radius = 0.0f;
+    glm::vec3 coneAxis {};   // normal cone of the triangles we treat as back faces
+    float coneCutoff = 1.0f; // 1 disables the cone test
+
+    // true if all triangles face away from a camera at cameraPosition (object space),
+    // the apex free cone test of meshoptimizer, conservative for the whole bounding sphere
+    bool facesAway(const glm::vec3& cameraPosition) const
+    {
+        if(coneCutoff >= 1.0f)
+            return false;
+        const glm::vec3 toCenter = center - cameraPosition;
+        return glm::dot(toCenter, coneAxis) >= coneCutoff * glm::length(toCenter) + radius;
+    }
+};
+
+struct Mesh
+{
+    bgfx::VertexBufferHandle vertexBuffer = BGFX_INVALID_HANDLE;
+    bgfx::IndexBufferHandle indexBuffer = BGFX_INVALID_HANDLE;
+    unsigned int material = 0; // index into materials vector
+    bool twoSided = false;     // AI_MATKEY_TWOSIDED, back faces are drawn and never culled
+    Bounds bounds {};          // object space, scaled like the vertices
+    std::vector<Meshlet> meshlets; // empty if the mesh is drawn as a whole
+    // vertexBuffer holds CompactVertex, whose positions are dequantized by the draw transform
+    bool compact = false;
+    glm::vec3 positionOffset {};
+    float positionScale = 1.0f;
+
+    //bgfx::OcclusionQueryHandle occlusionQuery = BGFX_INVALID_HANDLE;
+
+    // bgfx vertex attributes
+    // initialized by Scene
+    struct PosNormalTangentTex0Vertex
+    {
+        float x, y, z;    // position
+        uint32_t color;   // color
+        float nx, ny, nz; // normal
+        float tx, ty, tz; // tangent
+        float u, v;       // UV coordinates
+
+        static void init()
+        {
+            layout.begin()
+                    .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+                    .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+                    .add(bgfx::Attrib::Normal, 3, bgfx::AttribType::Float)
+                    .add(bgfx::Attrib::Tangent, 3, bgfx::AttribType::Float)
+                    .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+                    .end();
+        }
+        static bgfx::VertexLayout layout;
+    };
+
+    // quantized vertex, 24 instead of 48 bytes (see MeshLoaderConfig::compactVertices)
+    // the vertex shader has to decode it:
+    // position: snorm16 in the mesh box, dequantization() maps it to object space
+    // normal, tangent: octahedral snorm16 pairs, see Assimp::Quantization::DecodeOctahedral
+    // uv: half floats, needs BGFX_CAPS_VERTEX_ATTRIB_HALF
+    struct CompactVertex
+    {
+        int16_t x, y, z, w; // w is 1, not every renderer has 3 component 16-bit attributes
+        uint32_t color;     // color
+        int16_t nx, ny;     // normal
+        int16_t tx, ty;     // tangent
+        uint16_t u, v;      // UV coordinates
+
+        static void init()
+        {
+            layout.begin()
+                    .add(bgfx::Attrib::Position, 4, bgfx::AttribType::Int16, true)
+                    .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+                    .add(bgfx::Attrib::Normal, 2, bgfx::AttribType::Int16, true)
+                    .add(bgfx::Attrib::Tangent, 2, bgfx::AttribType::Int16, true)
+                    .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Half)
+                    .end();
+        }
+        static bgfx::VertexLayout layout;
+    };
+
+    // model matrix of compact vertices, a uniform scale keeps the normal matrix valid
+    glm::mat4 dequantization() const
+    {
+        glm::mat4 model(positionScale);
+        model[3] = glm::vec4(positionOffset, 1.0f);
+        return model;
+    }
+};
+
+#endif //EMPTYDEMO_MESH_H
@@ -0,0 +1,268 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#include "MeshLoader.h"
+
+#include <assimp/VertexQuantization.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+bgfx::VertexLayout Mesh::PosNormalTangentTex0Vertex::layout;
+bgfx::VertexLayout Mesh::CompactVertex::layout;
+
+namespace
+{
+
+template<typename Index>
+void convertIndices(const aiMesh* mesh, Index* indices, const MeshLoaderConfig& config, ThreadPool& pool)
+{
+    // triangle meshes with an index buffer are copied straight from it
+    const unsigned int* buffer = mesh->mFaceStride == 3 ? mesh->mIndexBuffer : nullptr;
+    pool.parallelFor(mesh->mNumFaces, config.chunkSize, [&](size_t begin, size_t end)
+    {
+        if(buffer)
+        {
+            for(size_t i = 3 * begin; i < 3 * end; i++)
+                indices[i] = (Index)buffer[i];
+            return;
+        }
+        for(size_t i = begin; i < end; i++)
+        {
+            const aiFace& face = mesh->mFaces[i];
+            assert(face.mNumIndices == 3);
+            indices[(3 * i) + 0] = (Index)face.mIndices[0];
+            indices[(3 * i) + 1] = (Index)face.mIndices[1];
+            indices[(3 * i) + 2] = (Index)face.mIndices[2];
+        }
+    });
+}
+
+void convertVertices(const aiMesh* mesh, Mesh::PosNormalTangentTex0Vertex* vertices, const MeshLoaderConfig& config, ThreadPool& pool)
+{
+    constexpr size_t coords = 0;
+    const aiVector3D* positions = mesh->mVertices;
+    const aiVector3D* normals = mesh->mNormals;
+    const aiVector3D* tangents = mesh->mTangents;
+    const aiVector3D* uvs = mesh->mNumUVComponents[coords] == 2 ? mesh->mTextureCoords[coords] : nullptr;
+    const float scale = config.scale;
+
+    // one pass per attribute keeps the inner loops branch free so they vectorize,
+    // missing attributes are zeroed
+    pool.parallelFor(mesh->mNumVertices, config.chunkSize, [=](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            vertices[i].x = positions[i].x * scale;
+            vertices[i].y = positions[i].y * scale;
+            vertices[i].z = positions[i].z * scale;
+            vertices[i].color = 0xFFFFFFFF;
+        }
+        if(normals)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                vertices[i].nx = normals[i].x;
+                vertices[i].ny = normals[i].y;
+                vertices[i].nz = normals[i].z;
+            }
+        }
+        else
+        {
+            for(size_t i = begin; i < end; i++)
+                vertices[i].nx = vertices[i].ny = vertices[i].nz = 0.0f;
+        }
+        if(tangents)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                vertices[i].tx = tangents[i].x;
+                vertices[i].ty = tangents[i].y;
+                vertices[i].tz = tangents[i].z;
+            }
+        }
+        else
+        {
+            for(size_t i = begin; i < end; i++)
+                vertices[i].tx = vertices[i].ty = vertices[i].tz = 0.0f;
+        }
+        if(uvs)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                vertices[i].u = uvs[i].x;
+                vertices[i].v = uvs[i].y;
+            }
+        }
+        else
+        {
+            for(size_t i = begin; i < end; i++)
+                vertices[i].u = vertices[i].v = 0.0f;
+        }
+    });
+}
+
+void convertCompactVertices(const aiMesh* mesh, const Assimp::Quantization::PositionQuantization& quantization,
+                            Mesh::CompactVertex* vertices, const MeshLoaderConfig& config, ThreadPool& pool)
+{
+    using namespace Assimp::Quantization;
+
+    constexpr size_t coords = 0;
+    const aiVector3D* positions = mesh->mVertices;
+    const aiVector3D* normals = mesh->mNormals;
+    const aiVector3D* tangents = mesh->mTangents;
+    const aiVector3D* uvs = mesh->mNumUVComponents[coords] == 2 ? mesh->mTextureCoords[coords] : nullptr;
+
+    // same passes as convertVertices, missing attributes are zeroed
+    // (a zero octahedral pair decodes to +Z)
+    pool.parallelFor(mesh->mNumVertices, config.chunkSize, [=, &quantization](size_t begin, size_t end)
+    {
+        for(size_t i = begin; i < end; i++)
+        {
+            quantization.Encode(positions[i], vertices[i].x, vertices[i].y, vertices[i].z);
+            vertices[i].w = std::numeric_limits<int16_t>::max();
+            vertices[i].color = 0xFFFFFFFF;
+        }
+        if(normals)
+        {
+            for(size_t i = begin; i < end; i++)
+                EncodeOctahedral(normals[i], vertices[i].nx, vertices[i].ny);
+        }
+        else
+        {
+            for(size_t i = begin; i < end; i++)
+                vertices[i].nx = vertices[i].ny = 0;
+        }
+        if(tangents)
+        {
+            for(size_t i = begin; i < end; i++)
+                EncodeOctahedral(tangents[i], vertices[i].tx, vertices[i].ty);
+        }
+        else
+        {
+            for(size_t i = begin; i < end; i++)
+                vertices[i].tx = vertices[i].ty = 0;
+        }
+        if(uvs)
+        {
+            for(size_t i = begin; i < end; i++)
+            {
+                vertices[i].u = EncodeHalf(uvs[i].x);
+                vertices[i].v = EncodeHalf(uvs[i].y);
+            }
+        }
+        else
+        {
+            for(size_t i = begin; i < end; i++)
+                vertices[i].u = vertices[i].v = 0;
+        }
+    });
+}
+
+} // namespace
+
+MeshData convertMesh(const aiMesh* mesh, const aiMaterial* material, const MeshLoaderConfig& config, ThreadPool& pool)
+{
+    if(mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE)
+        throw std::runtime_error("Mesh has incompatible primitive type");
+
+    MeshData data;
+    data.material = mesh->mMaterialIndex;
+    int twoSided = 0;
+    if(material && material->Get(AI_MATKEY_TWOSIDED, twoSided) == aiReturn_SUCCESS)
+        data.twoSided = twoSided != 0;
+
+    // bounds, compact vertices are quantized against them
+    const aiVector3D* positions = mesh->mVertices;
+    const float scale = config.scale;
+    aiAABB aabb = mesh->mAABB;
+    if(aabb.mMin == aabb.mMax && mesh->mNumVertices > 0)
+    {
+        aabb.mMin = aabb.mMax = positions[0];
+        for(unsigned int i = 1; i < mesh->mNumVertices; i++)
+        {
+            aabb.mMin.x = std::min(aabb.mMin.x, positions[i].x);
+            aabb.mMin.y = std::min(aabb.mMin.y, positions[i].y);
+            aabb.mMin.z = std::min(aabb.mMin.z, positions[i].z);
+            aabb.mMax.x = std::max(aabb.mMax.x, positions[i].x);
+            aabb.mMax.y = std::max(aabb.mMax.y, positions[i].y);
+            aabb.mMax.z = std::max(aabb.mMax.z, positions[i].z);
+        }
+    }
+    const glm::vec3 a = glm::vec3(aabb.mMin.x, aabb.mMin.y, aabb.mMin.z) * scale;
+    const glm::vec3 b = glm::vec3(aabb.mMax.x, aabb.mMax.y, aabb.mMax.z) * scale;
+    data.bounds = { glm::min(a, b), glm::max(a, b) };
+
+    if(config.compactVertices)
+    {
+        // the config scale goes into the dequantization transform
+        const Assimp::Quantization::PositionQuantization quantization(aabb);
+        data.positionOffset = glm::vec3(quantization.mOffset.x, quantization.mOffset.y, quantization.mOffset.z) * scale;
+        data.positionScale = quantization.mScale * scale;
+        data.compactVertices.resize(mesh->mNumVertices);
+        convertCompactVertices(mesh, quantization, data.compactVertices.data(), config, pool);
+    }
+    else
+    {
+        data.vertices.resize(mesh->mNumVertices);
+        convertVertices(mesh, data.vertices.data(), config, pool);
+    }
+
+    // meshlets, each one is a range of the triangle list
+    data.meshlets.resize(mesh->mNumMeshlets);
+    const float coneSign = config.mirrored ? -1.0f : 1.0f;
+    for(unsigned int i = 0; i < mesh->mNumMeshlets; i++)
+    {
+        const aiMeshlet& src = mesh->mMeshlets[i];
+        Meshlet& dst = data.meshlets[i];
+        dst.firstIndex = 3 * src.mFaceOffset;
+        dst.indexCount = 3 * src.mFaceCount;
+        dst.center = glm::vec3(src.mCenter.x, src.mCenter.y, src.mCenter.z) * scale;
+        dst.radius = src.mRadius * scale;
+        dst.bounds = { dst.center - glm::vec3(dst.radius), dst.center + glm::vec3(dst.radius) };
+        dst.coneAxis = glm::vec3(src.mConeAxis.x, src.mConeAxis.y, src.mConeAxis.z) * coneSign;
+        dst.coneCutoff = src.mConeCutoff;
+    }
+
+    // indices (triangles)
+    data.index32 = mesh->mNumVertices > (std::numeric_limits<uint16_t>::max() + 1u);
+    if(data.index32)
+    {
+        data.indices.resize(size_t(mesh->mNumFaces) * 3 * sizeof(uint32_t));
+        convertIndices(mesh, (uint32_t*)data.indices.data(), config, pool);
+    }
+    else
+    {
+        data.indices.resize(size_t(mesh->mNumFaces) * 3 * sizeof(uint16_t));
+        convertIndices(mesh, (uint16_t*)data.indices.data(), config, pool);
+    }
+
+    return data;
+}
+
+Mesh uploadMesh(const MeshData& data)
+{
+    Mesh::PosNormalTangentTex0Vertex::init();
+    assert(Mesh::PosNormalTangentTex0Vertex::layout.getStride() == sizeof(Mesh::PosNormalTangentTex0Vertex));
+    Mesh::CompactVertex::init();
+    assert(Mesh::CompactVertex::layout.getStride() == sizeof(Mesh::CompactVertex));
+
+    const bool compact = !data.compactVertices.empty();
+    const void* vertices = compact ? (const void*)data.compactVertices.data() : (const void*)data.vertices.data();
+    const bgfx::Memory* vertexMem = bgfx::copy(vertices, uint32_t(data.vertexBytes()));
+    bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(vertexMem, compact ? Mesh::CompactVertex::layout
+                                                                               : Mesh::PosNormalTangentTex0Vertex::layout);
+
+    const bgfx::Memory* iMem = bgfx::copy(data.indices.data(), uint32_t(data.indexBytes()));
+    bgfx::IndexBufferHandle ibh = bgfx::createIndexBuffer(iMem, data.index32 ? BGFX_BUFFER_INDEX32 : BGFX_BUFFER_NONE);
+
+    return { vbh, ibh, data.material, data.twoSided, data.bounds, data.meshlets, compact, data.positionOffset, data.positionScale };
+}
+
+Mesh loadMesh(const aiMesh* mesh, const aiMaterial* material, const MeshLoaderConfig& config, ThreadPool& pool)
+{
+    return uploadMesh(convertMesh(mesh, material, config, pool));
+}
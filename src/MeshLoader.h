@@ -0,0 +1,72 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#ifndef EMPTYDEMO_MESHLOADER_H
+#define EMPTYDEMO_MESHLOADER_H
+
+#include <cstdint>
+#include <vector>
+
+#include <assimp/material.h>
+#include <assimp/mesh.h>
+
+#include "Mesh.h"
+#include "ThreadPool.h"
+
+struct MeshLoaderConfig
+{
+    // uniform scale applied to positions
+    float scale = 1.0f / 500.0f;
+    // vertices (and faces) converted per task
+    size_t chunkSize = 16 * 1024;
+    // meshlet size for per cluster culling (AI_CONFIG_PP_GML_MAX_VERTICES/_FACES), 0 vertices draws whole meshes
+    unsigned int meshletVertices = 64;
+    unsigned int meshletTriangles = 124;
+    // positions were mirrored by aiProcess_MakeLeftHanded, which keeps the winding,
+    // so the triangles assimp sees as front faces are our back faces
+    bool mirrored = true;
+    // quantize the vertices into Mesh::CompactVertex, needs a vertex shader decoding them
+    // half float UVs get coarse for heavily tiled textures (1/1024 steps from 1 to 2, 1/512 up to 4...)
+    bool compactVertices = false;
+};
+
+// CPU side result of converting one aiMesh, ready to be handed to bgfx.
+// Kept separate from the upload so conversion can run on any thread.
+struct MeshData
+{
+    std::vector<Mesh::PosNormalTangentTex0Vertex> vertices;
+    // used instead of vertices with MeshLoaderConfig::compactVertices
+    std::vector<Mesh::CompactVertex> compactVertices;
+    glm::vec3 positionOffset {};
+    float positionScale = 1.0f;
+    // raw uint16_t or uint32_t (index32) triangle list
+    std::vector<uint8_t> indices;
+    bool index32 = false;
+    unsigned int material = 0;
+    bool twoSided = false;
+    Bounds bounds {};
+    std::vector<Meshlet> meshlets;
+
+    size_t vertexBytes() const
+    {
+        return vertices.size() * sizeof(Mesh::PosNormalTangentTex0Vertex) +
+               compactVertices.size() * sizeof(Mesh::CompactVertex);
+    }
+    size_t indexBytes() const { return indices.size(); }
+};
+
+// converts the SoA attribute arrays of a triangle mesh into interleaved vertices and a triangle list
+// bounds come from aiMesh::mAABB (aiProcess_GenBoundingBoxes) or are computed if that is empty
+// meshlets are taken over as index ranges, assimp already sorted the faces by meshlet
+// uses 32-bit indices only when the mesh has more than 65536 vertices
+// compact vertices are quantized against the bounds, which must contain every vertex
+// material is the one of the mesh, it may be null, only AI_MATKEY_TWOSIDED is read
+MeshData convertMesh(const aiMesh* mesh, const aiMaterial* material, const MeshLoaderConfig& config, ThreadPool& pool);
+
+// creates the bgfx buffers, must be called on the thread that owns the bgfx API
+Mesh uploadMesh(const MeshData& data);
+
+Mesh loadMesh(const aiMesh* mesh, const aiMaterial* material, const MeshLoaderConfig& config, ThreadPool& pool);
+
+#endif //EMPTYDEMO_MESHLOADER_H
@@ -0,0 +1,125 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+
+#include <glm/gtc/type_ptr.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/matrix_operation.hpp>
+
+void RenderQueue::clear()
+{
+    models.clear();
+    normalMatrices.clear();
+    items.clear();
+    batches.clear();
+    dirty = false;
+}
+
+uint32_t RenderQueue::addTransform(const glm::mat4& model)
+{
+    models.push_back(model);
+    normalMatrices.push_back(glm::transpose(glm::adjugate(glm::mat3(model))));
+    return uint32_t(models.size() - 1);
+}
+
+void RenderQueue::add(const DrawItem& item)
+{
+    items.push_back(item);
+    dirty = true;
+}
+
+uint64_t RenderQueue::sortKey(const DrawItem& item)
+{
+    // program | material | vertex buffer | index buffer, 16 bits each
+    return (uint64_t(item.program.idx) << 48) |
+           (uint64_t(std::min(item.material, 0xFFFFu)) << 32) |
+           (uint64_t(item.vertexBuffer.idx) << 16) |
+           uint64_t(item.indexBuffer.idx);
+}
+
+void RenderQueue::setIndexBuffer(const DrawItem& item, uint32_t indexCount)
+{
+    if(indexCount != 0)
+        bgfx::setIndexBuffer(item.indexBuffer, item.firstIndex, indexCount);
+    else
+        bgfx::setIndexBuffer(item.indexBuffer);
+}
+
+void RenderQueue::prepare()
+{
+    std::stable_sort(items.begin(), items.end(), [](const DrawItem& a, const DrawItem& b)
+    {
+        return sortKey(a) < sortKey(b);
+    });
+
+    batches.clear();
+    for(uint32_t i = 0; i < items.size(); i++)
+    {
+        const DrawItem& item = items[i];
+        if(!batches.empty())
+        {
+            const DrawItem& first = items[batches.back().first];
+            if(sortKey(first) == sortKey(item) && first.state == item.state)
+            {
+                batches.back().count++;
+                continue;
+            }
+        }
+        batches.push_back({ i, 1 });
+    }
+    dirty = false;
+}
+
+void RenderQueue::submit(bgfx::ViewId view, uint64_t state, const std::vector<uint8_t>* visible)
+{
+    if(dirty)
+        prepare();
+
+    stats = {};
+
+    constexpr uint8_t discard = uint8_t(~BGFX_DISCARD_BINDINGS);
+
+    for(const Batch& batch : batches)
+    {
+        batchItems.clear();
+        for(uint32_t i = batch.first; i < batch.first + batch.count; i++)
+        {
+            if(!visible || (*visible)[items[i].id])
+                batchItems.push_back(i);
+        }
+        if(batchItems.empty())
+            continue;
+        stats.items += uint32_t(batchItems.size());
+
+        for(size_t next = 0; next < batchItems.size(); next++)
+        {
+            const DrawItem& item = items[batchItems[next]];
+
+            // ranges continuing each other with the same transform are drawn at once,
+            // items of a batch keep the order they were added in
+            uint32_t indexCount = item.indexCount;
+            while(indexCount != 0 && next + 1 < batchItems.size())
+            {
+                const DrawItem& following = items[batchItems[next + 1]];
+                if(following.transform != item.transform || following.indexCount == 0 ||
+                   following.firstIndex != item.firstIndex + indexCount)
+                    break;
+                indexCount += following.indexCount;
+                next++;
+            }
+
+            bgfx::setTransform(glm::value_ptr(models[item.transform]));
+            if(bgfx::isValid(normalMatrixUniform))
+                bgfx::setUniform(normalMatrixUniform, glm::value_ptr(normalMatrices[item.transform]));
+            bgfx::setVertexBuffer(0, item.vertexBuffer);
+            setIndexBuffer(item, indexCount);
+            bgfx::setState(state | item.state);
+            bgfx::submit(view, item.program, 0, discard);
+            stats.draws++;
+        }
+    }
+}
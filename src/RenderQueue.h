@@ -0,0 +1,80 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#ifndef EMPTYDEMO_RENDERQUEUE_H
+#define EMPTYDEMO_RENDERQUEUE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <bgfx/bgfx.h>
+#include <glm/glm.hpp>
+
+// Retained list of draws, sorted by program, material and buffers.
+// Visible draws of neighbouring index ranges with the same state (e.g. the
+// meshlets of a mesh) are merged into one draw. The queue is only rebuilt when
+// the scene changes, submit() just walks the prepared batches.
+class RenderQueue
+{
+public:
+    struct DrawItem
+    {
+        bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+        unsigned int material = 0;
+        uint64_t state = 0; // ORed into the state passed to submit, e.g. the cull mode of the material
+        bgfx::VertexBufferHandle vertexBuffer = BGFX_INVALID_HANDLE;
+        bgfx::IndexBufferHandle indexBuffer = BGFX_INVALID_HANDLE;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0; // 0 draws the whole index buffer
+        uint32_t transform = 0; // from addTransform
+        uint32_t id = 0;        // index into the visibility mask passed to submit
+    };
+
+    struct Stats
+    {
+        uint32_t draws = 0; // submitted draw calls
+        uint32_t items = 0; // visible draw items covered
+    };
+
+    // uniform receiving the cached normal matrix (mat3) for non-instanced draws
+    void setNormalMatrixUniform(bgfx::UniformHandle uniform) { normalMatrixUniform = uniform; }
+
+    void clear();
+
+    // stores the model matrix together with its normal matrix, returns the index for DrawItem::transform
+    uint32_t addTransform(const glm::mat4& model);
+    void add(const DrawItem& item);
+
+    // submits all draws, bindings made before the call (e.g. buffers) are kept for every draw
+    // with a visibility mask only items with visible[item.id] != 0 are drawn
+    void submit(bgfx::ViewId view, uint64_t state, const std::vector<uint8_t>* visible = nullptr);
+
+    const Stats& getStats() const { return stats; }
+    size_t size() const { return items.size(); }
+
+private:
+    struct Batch
+    {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    static uint64_t sortKey(const DrawItem& item);
+    // binds the index range of item, extended to indexCount indices
+    static void setIndexBuffer(const DrawItem& item, uint32_t indexCount);
+    void prepare();
+
+    bgfx::UniformHandle normalMatrixUniform = BGFX_INVALID_HANDLE;
+
+    std::vector<glm::mat4> models;
+    std::vector<glm::mat3> normalMatrices;
+    std::vector<DrawItem> items;
+    std::vector<Batch> batches;
+    std::vector<uint32_t> batchItems; // visible items of the current batch
+    bool dirty = false;
+
+    Stats stats;
+};
+
+#endif //EMPTYDEMO_RENDERQUEUE_H
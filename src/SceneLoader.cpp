@@ -0,0 +1,180 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#include "SceneLoader.h"
+
+#include <filesystem>
+#include <iostream>
+
+#include <assimp/Importer.hpp>
+#include <assimp/MemoryMappedIOSystem.h>
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+namespace
+{
+
+// forwards assimp progress to the loader, returning false aborts the import
+class ImportProgressHandler : public Assimp::ProgressHandler
+{
+public:
+    ImportProgressHandler(std::atomic<float>& progress, const std::atomic<bool>& cancelled) :
+        progress(progress), cancelled(cancelled) { }
+
+    bool Update(float percentage) override
+    {
+        if(percentage >= 0.0f)
+            progress = std::min(percentage, 1.0f);
+        return !cancelled;
+    }
+
+private:
+    std::atomic<float>& progress;
+    const std::atomic<bool>& cancelled;
+};
+
+} // namespace
+
+SceneLoader::~SceneLoader()
+{
+    cancel();
+}
+
+void SceneLoader::load(const std::string& file)
+{
+    cancel();
+
+    cancelled = false;
+    importing = true;
+    importProgress = 0.0f;
+    meshesConverted = 0;
+    meshCount = 0;
+    task = pool.enqueue([this, file] { run(file); });
+}
+
+void SceneLoader::cancel()
+{
+    cancelled = true;
+    if(task.valid())
+        task.wait();
+    task = {};
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+}
+
+bool SceneLoader::isLoading() const
+{
+    if(importing)
+        return true;
+    std::lock_guard<std::mutex> lock(mutex);
+    return !pending.empty();
+}
+
+float SceneLoader::getProgress() const
+{
+    const unsigned int total = meshCount;
+    const float conversion = total ? float(meshesConverted) / float(total) : (importing ? 0.0f : 1.0f);
+    return importProgress * 0.5f + conversion * 0.5f;
+}
+
+size_t SceneLoader::uploadPending(std::vector<Mesh>& meshes, size_t byteBudget)
+{
+    size_t uploaded = 0;
+    for(;;)
+    {
+        MeshData data;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(pending.empty())
+                break;
+            const size_t bytes = pending.front().vertexBytes() + pending.front().indexBytes();
+            // always make progress, even if a single mesh is larger than the budget
+            if(uploaded != 0 && uploaded + bytes > byteBudget)
+                break;
+            data = std::move(pending.front());
+            pending.pop_front();
+        }
+        uploaded += data.vertexBytes() + data.indexBytes();
+        meshes.push_back(uploadMesh(data));
+    }
+    return uploaded;
+}
+
+void SceneLoader::run(const std::string& file)
+{
+    struct ImportingScope
+    {
+        std::atomic<bool>& flag;
+        ~ImportingScope() { flag = false; }
+    } scope { importing };
+
+    if(!std::filesystem::exists(file))
+    {
+        std::cout << "Error, " << file << " not exists!" << std::endl;
+        return;
+    }
+
+    Assimp::Importer importer;
+    // the importer owns the handlers
+    importer.SetProgressHandler(new ImportProgressHandler(importProgress, cancelled));
+    // binary FBX/glb/STL are parsed straight from the mapped file instead of a copy
+    importer.SetIOHandler(new Assimp::MemoryMappedIOSystem());
+
+    // Settings for aiProcess_SortByPType
+    // only take triangles or higher (polygons are triangulated during import)
+    importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_LINE | aiPrimitiveType_POINT);
+    // aiProcess_SplitLargeMeshes keeps its default limit,
+    // meshes above 65k vertices get 32-bit indices (see convertMesh)
+    // meshlets for per cluster culling, built along with aiProcess_ImproveCacheLocality
+    importer.SetPropertyInteger(AI_CONFIG_PP_GML_MAX_VERTICES, int(config.meshletVertices));
+    importer.SetPropertyInteger(AI_CONFIG_PP_GML_MAX_FACES, int(config.meshletTriangles));
+
+    unsigned int flags =
+            aiProcessPreset_TargetRealtime_Quality |                     // some optimizations and safety checks
+            aiProcess_OptimizeMeshes |                                   // minimize number of meshes
+            aiProcess_PreTransformVertices |                             // apply node matrices
+            aiProcess_FixInfacingNormals | aiProcess_TransformUVCoords | // apply UV transformations
+            //aiProcess_FlipWindingOrder   | // we cull clock-wise, keep the default CCW winding order
+            aiProcess_MakeLeftHanded | // we set GLM_FORCE_LEFT_HANDED and use left-handed bx matrix functions
+            aiProcess_FlipUVs |        // bimg loads textures with flipped Y (top left is 0,0)
+            aiProcess_GenBoundingBoxes; // mesh AABBs for culling
+
+    const aiScene* scene = nullptr;
+    try
+    {
+        scene = importer.ReadFile(file, flags);
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << e.what() << std::endl;
+    }
+
+    if (!scene)
+    {
+        if(!cancelled)
+            std::cout << "Error, failed to load " << file << ": " << importer.GetErrorString() << std::endl;
+        return;
+    }
+    importProgress = 1.0f;
+    meshCount = scene->mNumMeshes;
+
+    for (unsigned int i = 0; i < scene->mNumMeshes && !cancelled; i++)
+    {
+        try
+        {
+            const aiMesh* mesh = scene->mMeshes[i];
+            const aiMaterial* material = mesh->mMaterialIndex < scene->mNumMaterials ? scene->mMaterials[mesh->mMaterialIndex] : nullptr;
+            MeshData data = convertMesh(mesh, material, config, pool);
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(std::move(data));
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+        meshesConverted++;
+    }
+}
@@ -0,0 +1,65 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#ifndef EMPTYDEMO_SCENELOADER_H
+#define EMPTYDEMO_SCENELOADER_H
+
+#include <atomic>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+#include "MeshLoader.h"
+#include "ThreadPool.h"
+
+// Imports a scene file on the worker pool and hands out the converted meshes
+// in small batches, so rendering starts right away and the scene fills in over time.
+// Import, post-processing and vertex conversion run on workers; only the
+// bgfx buffer creation in uploadPending happens on the render thread.
+class SceneLoader
+{
+public:
+    SceneLoader(ThreadPool& pool, const MeshLoaderConfig& config) : pool(pool), config(config) { }
+    // cancels a running import and waits for it
+    ~SceneLoader();
+
+    SceneLoader(const SceneLoader&) = delete;
+    SceneLoader& operator=(const SceneLoader&) = delete;
+
+    // starts importing file in the background, a previous load is cancelled first
+    void load(const std::string& file);
+
+    // call once per frame on the render thread: creates buffers for converted meshes
+    // until byteBudget is used up (at least one mesh per call) and appends them to meshes
+    // returns the number of bytes uploaded
+    size_t uploadPending(std::vector<Mesh>& meshes, size_t byteBudget);
+
+    void cancel();
+
+    // true until the import finished and every mesh was uploaded
+    bool isLoading() const;
+    // 0..1, assimp import (read + post-processing) counts for the first half, mesh conversion for the rest
+    float getProgress() const;
+
+private:
+    void run(const std::string& file);
+
+    ThreadPool& pool;
+    MeshLoaderConfig config;
+
+    std::future<void> task;
+    std::atomic<bool> cancelled { false };
+    std::atomic<bool> importing { false };
+    std::atomic<float> importProgress { 0.0f };
+    std::atomic<unsigned int> meshesConverted { 0 };
+    std::atomic<unsigned int> meshCount { 0 };
+
+    mutable std::mutex mutex;
+    std::deque<MeshData> pending;
+};
+
+#endif //EMPTYDEMO_SCENELOADER_H
@@ -0,0 +1,152 @@
+//
+// Created by admin on 2026/10/17.
+//
+
+#ifndef EMPTYDEMO_THREADPOOL_H
+#define EMPTYDEMO_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fixed-size worker pool shared by the CPU side of the renderer
+// (light assignment, mesh conversion, culling, background loading).
+// parallelFor lets the calling thread take part in the work, so it is safe
+// to call from inside a task that is itself running on the pool.
+class ThreadPool
+{
+public:
+    // workerCount == 0 picks hardware_concurrency() - 1 (the caller is the extra thread)
+    explicit ThreadPool(unsigned int workerCount = 0)
+    {
+        if(workerCount == 0)
+        {
+            unsigned int hw = std::thread::hardware_concurrency();
+            workerCount = hw > 1 ? hw - 1 : 1;
+        }
+        workers.reserve(workerCount);
+        for(unsigned int i = 0; i < workerCount; i++)
+            workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(std::thread& worker : workers)
+            worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned int workerCount() const
+    {
+        return (unsigned int)workers.size();
+    }
+
+    // queue a task, the future becomes ready once it ran on a worker
+    template<typename Func>
+    std::future<void> enqueue(Func&& func)
+    {
+        auto task = std::make_shared<std::packaged_task<void()>>(std::forward<Func>(func));
+        std::future<void> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([task] { (*task)(); });
+        }
+        wake.notify_one();
+        return result;
+    }
+
+    // calls func(begin, end) for consecutive ranges of [0, count), at most grainSize long,
+    // and blocks until all of them are done
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& func)
+    {
+        if(count == 0)
+            return;
+        grainSize = std::max<size_t>(grainSize, 1);
+        const size_t chunks = (count + grainSize - 1) / grainSize;
+        if(chunks == 1)
+        {
+            func(0, count);
+            return;
+        }
+
+        struct Job
+        {
+            std::atomic<size_t> next { 0 };
+            std::atomic<size_t> done { 0 };
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+        auto job = std::make_shared<Job>();
+
+        auto run = [job, chunks, count, grainSize, &func]
+        {
+            size_t chunk;
+            while((chunk = job->next.fetch_add(1)) < chunks)
+            {
+                size_t begin = chunk * grainSize;
+                func(begin, std::min(begin + grainSize, count));
+                if(job->done.fetch_add(1) + 1 == chunks)
+                {
+                    std::lock_guard<std::mutex> lock(job->mutex);
+                    job->finished.notify_all();
+                }
+            }
+        };
+
+        // helpers only pick up chunks that are left when they get scheduled,
+        // a late helper finds nothing to do and exits immediately
+        const size_t helpers = std::min<size_t>(workers.size(), chunks - 1);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(size_t i = 0; i < helpers; i++)
+                tasks.emplace_back(run);
+        }
+        wake.notify_all();
+
+        run();
+
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->finished.wait(lock, [&] { return job->done.load() == chunks; });
+    }
+
+private:
+    void workerLoop()
+    {
+        for(;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if(stopping && tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
+
+#endif //EMPTYDEMO_THREADPOOL_H